@@ -0,0 +1,154 @@
+/**************************************************************************/
+/*  profile_zones.cpp                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "profile_zones.h"
+
+#include "core/io/file_access.h"
+#include "core/os/memory.h"
+#include "core/os/thread.h"
+
+#include <chrono>
+
+std::atomic<bool> ProfileZones::capturing = { false };
+std::atomic<ProfileZones::ThreadBuffer *> ProfileZones::buffers = { nullptr };
+uint64_t ProfileZones::capture_begin = 0;
+// Bumped when the buffers are freed, so threads drop their cached pointer.
+std::atomic<uint32_t> ProfileZones::buffer_generation = { 1 };
+thread_local ProfileZones::ThreadBuffer *ProfileZones::thread_buffer = nullptr;
+thread_local uint32_t ProfileZones::thread_buffer_generation = 0;
+
+uint64_t ProfileZones::get_ticks_nsec() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ProfileZones::ThreadBuffer *ProfileZones::_get_thread_buffer() {
+	uint32_t generation = buffer_generation.load(std::memory_order_acquire);
+	if (likely(thread_buffer && thread_buffer_generation == generation)) {
+		return thread_buffer;
+	}
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->thread_id = Thread::get_caller_id();
+	buffer->events = memnew_arr(Event, EVENT_BUFFER_SIZE);
+
+	// Buffers are only ever prepended, so this never races with readers walking the list.
+	buffer->next = buffers.load(std::memory_order_relaxed);
+	while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+
+	thread_buffer = buffer;
+	thread_buffer_generation = generation;
+	return buffer;
+}
+
+void ProfileZones::record(const char *p_name, uint64_t p_begin, uint64_t p_end) {
+	if (unlikely(!is_capturing())) {
+		return;
+	}
+
+	// Only this thread writes to its buffer, and buffers are kept until shutdown, so nothing is locked.
+	ThreadBuffer *buffer = _get_thread_buffer();
+	uint64_t index = buffer->written.load(std::memory_order_relaxed);
+	Event &event = buffer->events[index & (EVENT_BUFFER_SIZE - 1)];
+	event.name = p_name;
+	event.begin = p_begin;
+	event.end = p_end;
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void ProfileZones::start_capture() {
+	ERR_FAIL_COND_MSG(is_capturing(), "Profile zones are already being captured.");
+
+	// Events of previous captures are left in the buffers, they're told apart by time when saving.
+	capture_begin = get_ticks_nsec();
+	capturing.store(true, std::memory_order_release);
+}
+
+void ProfileZones::stop_capture() {
+	capturing.store(false, std::memory_order_release);
+}
+
+static String _format_usec(uint64_t p_nsec) {
+	String fraction = itos(p_nsec % 1000).lpad(3, "0");
+	return String::num_uint64(p_nsec / 1000) + "." + fraction;
+}
+
+Error ProfileZones::save_chrome_trace(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(is_capturing(), ERR_BUSY, "Stop capturing profile zones before saving them.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Can't open profile trace file at path: \"%s\".", p_path));
+
+	f->store_string("{\"traceEvents\":[\n");
+	bool first = true;
+	for (ThreadBuffer *buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+		// A zone that checked for the capture before it stopped may still be recorded, one per thread at most.
+		// It overwrites the slot of the oldest event, which is left out.
+		uint64_t written = buffer->written.load(std::memory_order_acquire);
+		uint64_t count = MIN(written, (uint64_t)EVENT_BUFFER_SIZE - 1);
+		uint64_t from = written - count;
+		while (from < written && buffer->events[from & (EVENT_BUFFER_SIZE - 1)].end < capture_begin) {
+			from++; // Recorded by a previous capture.
+		}
+		if (from == written) {
+			continue;
+		}
+
+		String tid = String::num_uint64(buffer->thread_id);
+		String thread_name = buffer->thread_id == Thread::MAIN_ID ? String("Main thread") : "Thread " + tid;
+		f->store_string(String(first ? "" : ",\n") + "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":\"" + thread_name + "\"}}");
+		first = false;
+
+		for (uint64_t i = from; i < written; i++) {
+			const Event &event = buffer->events[i & (EVENT_BUFFER_SIZE - 1)];
+			// Zones that were already open when the capture started are clipped to its beginning.
+			uint64_t begin = MAX(event.begin, capture_begin) - capture_begin;
+			uint64_t end = MAX(event.end, capture_begin) - capture_begin;
+			f->store_string(",\n{\"name\":\"" + String::utf8(event.name).json_escape() + "\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":" + _format_usec(begin) + ",\"dur\":" + _format_usec(end - begin) + "}");
+		}
+	}
+	f->store_string("\n],\"displayTimeUnit\":\"ns\"}\n");
+
+	return OK;
+}
+
+void ProfileZones::free_buffers() {
+	ERR_FAIL_COND_MSG(is_capturing(), "Stop capturing profile zones before freeing them.");
+
+	ThreadBuffer *buffer = buffers.exchange(nullptr, std::memory_order_acq_rel);
+	buffer_generation.fetch_add(1, std::memory_order_acq_rel);
+	while (buffer) {
+		ThreadBuffer *next = buffer->next;
+		memdelete_arr(buffer->events);
+		memdelete(buffer);
+		buffer = next;
+	}
+}
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  profile_zones.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PROFILE_ZONES_H
+#define PROFILE_ZONES_H
+
+#include "core/error/error_list.h"
+#include "core/typedefs.h"
+
+#include <atomic>
+
+class String;
+
+// Records timed zones of engine code into per-thread ring buffers, which can
+// be saved in the Chrome trace event format (viewable in Perfetto or
+// chrome://tracing). Zones nest by time, so the hierarchy is kept without
+// storing it. Recording only happens between start_capture() and
+// stop_capture(); otherwise a zone costs a single relaxed load.
+class ProfileZones {
+public:
+	// Events per thread; once full, the oldest ones are overwritten. One slot is kept
+	// free for a zone still being recorded while saving, so one less is saved.
+	static constexpr uint32_t EVENT_BUFFER_SIZE = 1 << 16;
+
+private:
+	struct Event {
+		const char *name = nullptr;
+		uint64_t begin = 0;
+		uint64_t end = 0;
+	};
+
+	struct ThreadBuffer {
+		uint64_t thread_id = 0;
+		std::atomic<uint64_t> written = { 0 };
+		Event *events = nullptr;
+		ThreadBuffer *next = nullptr;
+	};
+
+	static std::atomic<bool> capturing;
+	static std::atomic<ThreadBuffer *> buffers;
+	static uint64_t capture_begin;
+	static std::atomic<uint32_t> buffer_generation;
+	static thread_local ThreadBuffer *thread_buffer;
+	static thread_local uint32_t thread_buffer_generation;
+
+	static ThreadBuffer *_get_thread_buffer();
+
+public:
+	static _FORCE_INLINE_ bool is_capturing() { return capturing.load(std::memory_order_relaxed); }
+	static uint64_t get_ticks_nsec();
+
+	static void record(const char *p_name, uint64_t p_begin, uint64_t p_end);
+
+	static void start_capture();
+	static void stop_capture();
+	static Error save_chrome_trace(const String &p_path);
+	// Only once no other thread can record anymore, at shutdown.
+	static void free_buffers();
+};
+
+class ProfileZone {
+	const char *name = nullptr;
+	uint64_t begin = 0;
+
+public:
+	_FORCE_INLINE_ ProfileZone(const char *p_name) {
+		if (unlikely(ProfileZones::is_capturing())) {
+			name = p_name;
+			begin = ProfileZones::get_ticks_nsec();
+		}
+	}
+	_FORCE_INLINE_ ~ProfileZone() {
+		if (unlikely(name)) {
+			ProfileZones::record(name, begin, ProfileZones::get_ticks_nsec());
+		}
+	}
+};
+
+#define _PROFILE_ZONE_VAR_INNER(m_line) _profile_zone_##m_line
+#define _PROFILE_ZONE_VAR(m_line) _PROFILE_ZONE_VAR_INNER(m_line)
+
+// Times the rest of the enclosing scope. The name must be a string literal,
+// or otherwise outlive the capture.
+#define GODOT_PROFILE_ZONE(m_name) ProfileZone _PROFILE_ZONE_VAR(__LINE__)(m_name)
+
+#endif // PROFILE_ZONES_H
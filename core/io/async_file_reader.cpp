@@ -0,0 +1,274 @@
+/**************************************************************************/
+/*  async_file_reader.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "async_file_reader.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+
+AsyncFileReader *AsyncFileReader::singleton = nullptr;
+AsyncFileReader::CreateFunc AsyncFileReader::create_func = AsyncFileReader::_create_builtin<AsyncFileReader>;
+
+// Set while a completion callback runs, which can't wait for batches.
+static thread_local bool in_completion_callback = false;
+
+bool AsyncFileReader::resolve_request(const Request &p_request, Location &r_location) {
+	String path = p_request.path;
+	uint64_t base = 0;
+	uint64_t size = UINT64_MAX;
+
+	PackedData *packed_data = PackedData::get_singleton();
+	if (packed_data && !packed_data->is_disabled()) {
+		String pack;
+		if (packed_data->get_file_location(path, pack, base, size)) {
+			path = pack;
+		} else if (packed_data->has_path(path)) {
+			return false; // Encrypted, compressed, or in a pack that isn't a plain PCK.
+		}
+	}
+
+	if (path.begins_with("res://") || path.begins_with("user://")) {
+		if (!ProjectSettings::get_singleton()) {
+			return false;
+		}
+		path = ProjectSettings::get_singleton()->globalize_path(path);
+		if (path.begins_with("res://") || path.begins_with("user://")) {
+			return false;
+		}
+	}
+
+	r_location.os_path = path;
+	r_location.offset = base + MIN(p_request.offset, size);
+
+	uint64_t available = size - MIN(p_request.offset, size);
+	if (p_request.buffer == nullptr && p_request.length == 0) {
+		r_location.length = available;
+	} else {
+		r_location.length = MIN(p_request.length, available);
+	}
+	return true;
+}
+
+void AsyncFileReader::read_request(Request &p_request) {
+	Error err = OK;
+	Ref<FileAccess> f = FileAccess::open(p_request.path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		p_request.error = err != OK ? err : ERR_FILE_CANT_OPEN;
+		return;
+	}
+
+	uint64_t file_length = f->get_length();
+	if (p_request.offset >= file_length) {
+		return;
+	}
+	f->seek(p_request.offset);
+
+	if (p_request.buffer) {
+		p_request.bytes_read = f->get_buffer(p_request.buffer, p_request.length);
+		return;
+	}
+
+	uint64_t to_prefetch = file_length - p_request.offset;
+	if (p_request.length != 0) {
+		to_prefetch = MIN(p_request.length, to_prefetch);
+	}
+
+	// Prefetching through FileAccess means reading the range and dropping it. Mapped
+	// files only need to be touched once per page.
+	uint64_t mapped_length = 0;
+	const uint8_t *mapped = f->get_mapped_buffer(mapped_length);
+	if (mapped != nullptr && p_request.offset + to_prefetch <= mapped_length) {
+		const volatile uint8_t *ptr = mapped + p_request.offset;
+		uint8_t sink = 0;
+		for (uint64_t i = 0; i < to_prefetch; i += 4096) {
+			sink ^= ptr[i];
+		}
+		(void)sink;
+		p_request.bytes_read = to_prefetch;
+		return;
+	}
+
+	uint8_t scratch[16384];
+	while (p_request.bytes_read < to_prefetch) {
+		uint64_t read = f->get_buffer(scratch, MIN(to_prefetch - p_request.bytes_read, (uint64_t)sizeof(scratch)));
+		if (read == 0) {
+			break;
+		}
+		p_request.bytes_read += read;
+	}
+}
+
+void AsyncFileReader::request_completed(Batch *p_batch) {
+	if (p_batch->pending.decrement() > 0) {
+		return;
+	}
+
+	if (p_batch->callback) {
+		in_completion_callback = true;
+		p_batch->callback(p_batch->userdata, p_batch->id);
+		in_completion_callback = false;
+		{
+			MutexLock lock(mutex);
+			batches.erase(p_batch->id);
+		}
+		memdelete(p_batch);
+	} else {
+		p_batch->done.post();
+	}
+}
+
+void AsyncFileReader::_pool_read(void *p_userdata, uint32_t p_index) {
+	Batch *batch = (Batch *)p_userdata;
+	read_request(batch->requests[p_index]);
+	singleton->request_completed(batch);
+}
+
+void AsyncFileReader::_submit(Batch *p_batch) {
+	// Read before submitting, batches with a callback may be gone as soon as they're submitted.
+	bool waitable = p_batch->callback == nullptr;
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&AsyncFileReader::_pool_read, p_batch, p_batch->count, -1, false, "AsyncFileReader");
+
+	if (waitable) {
+		p_batch->pool_group = group;
+	} else {
+		MutexLock lock(mutex);
+		pool_groups.push_back(group);
+	}
+}
+
+void AsyncFileReader::_reap_pool_groups(bool p_wait_all) {
+	// Groups of fire-and-forget batches still need to be waited for so the pool can reclaim them.
+	LocalVector<WorkerThreadPool::GroupID> to_wait;
+	{
+		MutexLock lock(mutex);
+		for (uint32_t i = 0; i < pool_groups.size(); i++) {
+			if (p_wait_all || WorkerThreadPool::get_singleton()->is_group_task_completed(pool_groups[i])) {
+				to_wait.push_back(pool_groups[i]);
+				pool_groups.remove_at_unordered(i);
+				i--;
+			}
+		}
+	}
+	for (WorkerThreadPool::GroupID group : to_wait) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	}
+}
+
+AsyncFileReader *AsyncFileReader::create() {
+	return create_func();
+}
+
+AsyncFileReader::BatchID AsyncFileReader::add_read_batch(Request *p_requests, uint32_t p_count, CompletionFunc p_callback, void *p_userdata) {
+	ERR_FAIL_NULL_V(p_requests, INVALID_BATCH_ID);
+	ERR_FAIL_COND_V(p_count == 0, INVALID_BATCH_ID);
+
+	_reap_pool_groups(false);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_requests[i].bytes_read = 0;
+		p_requests[i].error = OK;
+	}
+
+	Batch *batch = memnew(Batch);
+	batch->requests = p_requests;
+	batch->count = p_count;
+	batch->pending.set(p_count);
+	batch->callback = p_callback;
+	batch->userdata = p_userdata;
+
+	BatchID id;
+	{
+		MutexLock lock(mutex);
+		id = ++last_batch_id;
+		batch->id = id;
+		batches.insert(id, batch);
+	}
+
+	_submit(batch);
+	return id;
+}
+
+bool AsyncFileReader::is_read_batch_completed(BatchID p_batch) const {
+	MutexLock lock(mutex);
+	HashMap<BatchID, Batch *>::ConstIterator E = batches.find(p_batch);
+	// Batches with a callback are released as soon as they complete.
+	return !E || E->value->pending.get() == 0;
+}
+
+Error AsyncFileReader::wait_for_read_batch_completion(BatchID p_batch) {
+	ERR_FAIL_COND_V_MSG(in_completion_callback, ERR_BUSY, "Read batches can't be waited for from a completion callback, as the batch may need the same thread to complete.");
+
+	Batch *batch = nullptr;
+	{
+		MutexLock lock(mutex);
+		HashMap<BatchID, Batch *>::Iterator E = batches.find(p_batch);
+		ERR_FAIL_COND_V_MSG(!E, ERR_INVALID_PARAMETER, "Invalid read batch ID: " + itos(p_batch) + ".");
+		ERR_FAIL_COND_V_MSG(E->value->callback != nullptr, ERR_INVALID_PARAMETER, "Read batches with a completion callback can't be waited for.");
+		batch = E->value;
+		batches.remove(E);
+	}
+
+	if (batch->pool_group != WorkerThreadPool::INVALID_TASK_ID) {
+		// Lets this thread help with the reads if it's a pool thread, rather than blocking it.
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->pool_group);
+	}
+	batch->done.wait();
+
+	Error err = OK;
+	for (uint32_t i = 0; i < batch->count; i++) {
+		if (batch->requests[i].error != OK) {
+			err = batch->requests[i].error;
+			break;
+		}
+	}
+	memdelete(batch);
+	return err;
+}
+
+AsyncFileReader::AsyncFileReader() {
+	singleton = this;
+}
+
+AsyncFileReader::~AsyncFileReader() {
+	_reap_pool_groups(true);
+
+	for (const KeyValue<BatchID, Batch *> &E : batches) {
+		// Never waited for.
+		if (E.value->pool_group != WorkerThreadPool::INVALID_TASK_ID) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(E.value->pool_group);
+		}
+		memdelete(E.value);
+	}
+	batches.clear();
+
+	singleton = nullptr;
+}
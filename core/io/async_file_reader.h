@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*  async_file_reader.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ASYNC_FILE_READER_H
+#define ASYNC_FILE_READER_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Reads lists of file ranges in the background. The default implementation runs the
+// reads on the WorkerThreadPool through FileAccess; platforms can install a backend
+// that hands them to the kernel instead, so many reads are in flight at once.
+class AsyncFileReader {
+public:
+	typedef int64_t BatchID;
+	typedef void (*CompletionFunc)(void *p_userdata, BatchID p_batch);
+	typedef AsyncFileReader *(*CreateFunc)();
+
+	enum {
+		INVALID_BATCH_ID = -1,
+	};
+
+	struct Request {
+		String path; // Any path FileAccess can open, including files inside loaded packs.
+		uint64_t offset = 0;
+		// Bytes to read into `buffer`. If `buffer` is null, the range is only brought into the
+		// OS cache so a later synchronous read is fast; a length of zero then means "up to the end".
+		uint64_t length = 0;
+		uint8_t *buffer = nullptr;
+
+		// Filled in on completion.
+		uint64_t bytes_read = 0;
+		Error error = OK;
+	};
+
+protected:
+	struct Batch {
+		BatchID id = INVALID_BATCH_ID;
+		Request *requests = nullptr;
+		uint32_t count = 0;
+		SafeNumeric<uint32_t> pending;
+		CompletionFunc callback = nullptr;
+		void *userdata = nullptr;
+		WorkerThreadPool::GroupID pool_group = WorkerThreadPool::INVALID_TASK_ID;
+		Semaphore done;
+	};
+
+	// A request resolved to a range of a plain OS file.
+	struct Location {
+		String os_path;
+		uint64_t offset = 0;
+		uint64_t length = 0;
+	};
+
+	static bool resolve_request(const Request &p_request, Location &r_location);
+
+	// Reads `p_request` synchronously through FileAccess.
+	static void read_request(Request &p_request);
+
+	// Called once per request of `p_batch`, from any thread, when it's done.
+	void request_completed(Batch *p_batch);
+
+	// Issues every request of `p_batch`. Must not block on the reads themselves.
+	virtual void _submit(Batch *p_batch);
+
+private:
+	static AsyncFileReader *singleton;
+	static CreateFunc create_func;
+
+	template <typename T>
+	static AsyncFileReader *_create_builtin() {
+		return memnew(T);
+	}
+
+	Mutex mutex;
+	BatchID last_batch_id = 0;
+	HashMap<BatchID, Batch *> batches;
+	LocalVector<WorkerThreadPool::GroupID> pool_groups;
+
+	static void _pool_read(void *p_userdata, uint32_t p_index);
+	void _reap_pool_groups(bool p_wait_all);
+
+public:
+	static AsyncFileReader *get_singleton() { return singleton; }
+
+	template <typename T>
+	static void make_default() {
+		create_func = _create_builtin<T>;
+	}
+
+	static AsyncFileReader *create();
+
+	// Whether requests without a buffer for `p_path` are passed to the OS as a hint, rather
+	// than served by reading the data on a thread.
+	virtual bool can_prefetch_without_reading(const String &p_path) const { return false; }
+
+	// `p_requests` must stay alive until the batch completes. If `p_callback` is given, it's
+	// called from a background thread once every request is done and the batch is released
+	// right after; otherwise the batch must be waited for with wait_for_read_batch_completion().
+	// Callbacks may run on the thread that completes every batch, so they must not wait for one.
+	BatchID add_read_batch(Request *p_requests, uint32_t p_count, CompletionFunc p_callback = nullptr, void *p_userdata = nullptr);
+	bool is_read_batch_completed(BatchID p_batch) const;
+	// Returns the first error among the requests of the batch, or OK. Fails if called from a completion callback.
+	Error wait_for_read_batch_completion(BatchID p_batch);
+
+	AsyncFileReader();
+	virtual ~AsyncFileReader();
+};
+
+#endif // ASYNC_FILE_READER_H
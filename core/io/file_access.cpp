@@ -499,6 +499,23 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+const uint8_t *FileAccess::get_buffer_view(uint64_t p_length, Vector<uint8_t> &r_storage) {
+	const uint64_t position = get_position();
+	uint64_t mapped_length = 0;
+	const uint8_t *mapped = get_mapped_buffer(mapped_length);
+	if (mapped != nullptr && position <= mapped_length && p_length <= mapped_length - position) {
+		seek(position + p_length);
+		return mapped + position;
+	}
+
+	Error err = r_storage.resize(p_length);
+	ERR_FAIL_COND_V_MSG(err != OK, nullptr, "Can't resize data to " + itos(p_length) + " elements.");
+	if (get_buffer(r_storage.ptrw(), p_length) != p_length) {
+		return nullptr; // Not enough data left.
+	}
+	return r_storage.ptr();
+}
+
 String FileAccess::get_as_utf8_string(bool p_skip_cr) const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -150,6 +150,8 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual const uint8_t *get_mapped_buffer(uint64_t &r_length) const { return nullptr; } ///< get the whole file in place (e.g. memory-mapped) if supported, valid until the file is closed
+	const uint8_t *get_buffer_view(uint64_t p_length, Vector<uint8_t> &r_storage); ///< get the next p_length bytes, pointing into the mapped file when possible and reading them into r_storage otherwise
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
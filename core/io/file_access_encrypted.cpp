@@ -234,6 +234,15 @@ uint64_t FileAccessEncrypted::get_buffer(uint8_t *p_dst, uint64_t p_length) cons
 	return to_copy;
 }
 
+const uint8_t *FileAccessEncrypted::get_mapped_buffer(uint64_t &r_length) const {
+	if (writing) {
+		return nullptr;
+	}
+	// The whole file is decrypted when opened for reading.
+	r_length = get_length();
+	return data.ptr();
+}
+
 Error FileAccessEncrypted::get_error() const {
 	return eofed ? ERR_FILE_EOF : OK;
 }
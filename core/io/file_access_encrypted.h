@@ -75,6 +75,7 @@ public:
 
 	virtual uint8_t get_8() const override; ///< get a byte
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t &r_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
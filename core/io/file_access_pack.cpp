@@ -31,13 +31,19 @@
 #include "file_access_pack.h"
 
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 #include <stdio.h>
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
+	// The pack may have changed since it was last mapped.
+	_unmap_pack(p_path);
+
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
 			return OK;
@@ -47,7 +53,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +61,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -118,6 +125,89 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	memdelete(p_dir);
 }
 
+Ref<FileAccess> PackedData::open_pack(const String &p_pack, const uint8_t *&r_mapped, uint64_t &r_length) {
+	r_mapped = nullptr;
+	r_length = 0;
+
+	MutexLock lock(mapped_packs_mutex);
+	HashMap<String, MappedPack>::Iterator E = mapped_packs.find(p_pack);
+	if (E) {
+		r_mapped = E->value.data;
+		r_length = E->value.length;
+		return E->value.file;
+	}
+
+	Ref<FileAccess> file = FileAccess::open(p_pack, FileAccess::READ);
+	if (file.is_null()) {
+		return file;
+	}
+	// Failures aren't remembered, the caller reads from the file instead.
+	MappedPack mapped_pack;
+	mapped_pack.data = file->get_mapped_buffer(mapped_pack.length);
+	if (mapped_pack.data != nullptr) {
+		mapped_pack.file = file;
+		mapped_packs.insert(p_pack, mapped_pack);
+		r_mapped = mapped_pack.data;
+		r_length = mapped_pack.length;
+	}
+	return file;
+}
+
+void PackedData::_unmap_pack(const String &p_pack) {
+	// Files opened from the pack keep the mapping they use alive.
+	MutexLock lock(mapped_packs_mutex);
+	mapped_packs.erase(p_pack);
+}
+
+bool PackedData::_remove_pack_files(PackedDir *p_dir, const String &p_dir_path, const String &p_pack) {
+	LocalVector<String> removed_files;
+	for (const String &E : p_dir->files) {
+		PathMD5 pmd5(p_dir_path.path_join(E).md5_buffer());
+		HashMap<PathMD5, PackedFile, PathMD5>::Iterator F = files.find(pmd5);
+		if (F && F->value.pack == p_pack) {
+			files.remove(F);
+			removed_files.push_back(E);
+		}
+	}
+	for (const String &E : removed_files) {
+		p_dir->files.erase(E);
+	}
+
+	LocalVector<String> removed_dirs;
+	for (const KeyValue<String, PackedDir *> &E : p_dir->subdirs) {
+		if (_remove_pack_files(E.value, p_dir_path.path_join(E.key), p_pack)) {
+			_free_packed_dirs(E.value);
+			removed_dirs.push_back(E.key);
+		}
+	}
+	for (const String &E : removed_dirs) {
+		p_dir->subdirs.erase(E);
+	}
+
+	return p_dir->files.is_empty() && p_dir->subdirs.is_empty();
+}
+
+void PackedData::remove_pack(const String &p_path) {
+	_remove_pack_files(root, "res://", p_path);
+	_unmap_pack(p_path);
+}
+
+bool PackedData::get_file_location(const String &p_path, String &r_pack, uint64_t &r_offset, uint64_t &r_size) {
+	PathMD5 pmd5(p_path.simplify_path().md5_buffer());
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
+	if (!E || E->value.offset == 0 || E->value.encrypted || E->value.compressed) {
+		return false;
+	}
+	if (dynamic_cast<PackedSourcePCK *>(E->value.src) == nullptr) {
+		return false; // Other sources may not store files as plain byte ranges.
+	}
+
+	r_pack = E->value.pack;
+	r_offset = E->value.offset;
+	r_size = E->value.size;
+	return true;
+}
+
 PackedData::~PackedData() {
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
@@ -203,7 +293,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_COMPRESSED, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -255,7 +345,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 	}
 
 	return true;
@@ -273,7 +363,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -281,7 +373,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -289,7 +381,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -310,18 +404,29 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (compressed) {
+		const uint8_t *block = _get_block(pos / block_size);
+		if (block == nullptr) {
+			eof = true;
+			return 0;
+		}
+		return block[pos++ % block_size];
+	}
+	if (mapped) {
+		return mapped[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!mapped && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -334,21 +439,56 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	if (compressed && to_read > 0) {
+		uint64_t read = _read_compressed(p_dst, to_read);
+		if (read < (uint64_t)to_read) {
+			eof = true;
+		}
+		pos += read;
+		return read;
+	}
+
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (mapped) {
+		memcpy(p_dst, mapped + pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_mapped_buffer(uint64_t &r_length) const {
+	if (compressed) {
+		return nullptr;
+	}
+	if (mapped) {
+		r_length = pf.size;
+		return mapped;
+	}
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+
+	// Encrypted files are decrypted in memory.
+	uint64_t length = 0;
+	const uint8_t *data = f->get_mapped_buffer(length);
+	if (data == nullptr || off > length || pf.size > length - off) {
+		return nullptr;
+	}
+	r_length = pf.size;
+	return data + off;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!mapped && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -376,11 +516,254 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapping = Ref<FileAccess>();
+	mapped = nullptr;
+	compressed_buffer.clear();
+	block_cache.clear();
+	cached_block = -1;
+}
+
+// Set on the stored size of the blocks that are kept uncompressed.
+static const uint32_t PACK_BLOCK_STORED = 1u << 31;
+
+bool FileAccessPack::_read_stored(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const {
+	if (mapped) {
+		if (p_offset > mapped_length || p_length > mapped_length - p_offset) {
+			return false;
+		}
+		memcpy(p_dst, mapped + p_offset, p_length);
+		return true;
+	}
+	f->seek(off + p_offset);
+	return f->get_buffer(p_dst, p_length) == p_length;
+}
+
+const uint8_t *FileAccessPack::_get_stored(uint64_t p_offset, uint64_t p_length) const {
+	if (mapped) {
+		return mapped + p_offset; // Checked against the mapped length when opening.
+	}
+	if ((uint64_t)compressed_buffer.size() < p_length) {
+		compressed_buffer.resize(p_length);
+	}
+	if (!_read_stored(p_offset, compressed_buffer.ptrw(), p_length)) {
+		return nullptr;
+	}
+	return compressed_buffer.ptr();
+}
+
+bool FileAccessPack::_decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const {
+	const CompressedBlock &block = blocks[p_block];
+	uint32_t length = MIN((uint64_t)block_size, pf.size - (uint64_t)p_block * block_size);
+	if (block.stored) {
+		memcpy(p_dst, p_src, length);
+		return true;
+	}
+	return Compression::decompress(p_dst, length, p_src, block.size, compression_mode) == (int)length;
+}
+
+void FileAccessPack::_decompress_blocks_task(void *p_userdata) {
+	BlockDecompression *bd = (BlockDecompression *)p_userdata;
+	const FileAccessPack *file = bd->file;
+	while (!bd->failed.is_set()) {
+		uint32_t i = bd->next.postincrement();
+		if (i >= bd->count) {
+			break;
+		}
+		uint32_t block = bd->from + i;
+		const uint8_t *src = bd->src + (file->blocks[block].offset - bd->src_offset);
+		if (!file->_decompress_block(block, src, bd->dst + (uint64_t)i * file->block_size)) {
+			bd->failed.set();
+		}
+	}
+}
+
+bool FileAccessPack::_decompress_blocks(uint32_t p_from, uint32_t p_count, uint8_t *p_dst) const {
+	const CompressedBlock &first = blocks[p_from];
+	const CompressedBlock &last = blocks[p_from + p_count - 1];
+
+	BlockDecompression bd;
+	bd.file = this;
+	bd.src_offset = first.offset;
+	bd.src = _get_stored(first.offset, last.offset + last.size - first.offset);
+	bd.dst = p_dst;
+	bd.from = p_from;
+	bd.count = p_count;
+	if (bd.src == nullptr) {
+		return false;
+	}
+
+	// Blocks are independent, so long reads are spread over the worker threads.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	uint32_t helpers = 0;
+	if (p_count >= 4 && pool != nullptr && pool->get_thread_count() > 1) {
+		helpers = MIN(p_count - 1, (uint32_t)pool->get_thread_count() - 1);
+	}
+
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	tasks.resize(helpers);
+	for (uint32_t i = 0; i < helpers; i++) {
+		tasks[i] = pool->add_native_task(&FileAccessPack::_decompress_blocks_task, &bd, true, "Decompress PCK blocks");
+	}
+	_decompress_blocks_task(&bd);
+	for (uint32_t i = 0; i < helpers; i++) {
+		pool->wait_for_task_completion(tasks[i]);
+	}
+
+	return !bd.failed.is_set();
+}
+
+const uint8_t *FileAccessPack::_get_block(uint32_t p_block) const {
+	if (cached_block == p_block) {
+		return block_cache.ptr();
+	}
+	cached_block = -1;
+
+	const CompressedBlock &block = blocks[p_block];
+	const uint8_t *src = _get_stored(block.offset, block.size);
+	ERR_FAIL_NULL_V_MSG(src, nullptr, "Can't read compressed block from pack-referenced file '" + String(pf.pack) + "'.");
+	ERR_FAIL_COND_V_MSG(!_decompress_block(p_block, src, block_cache.ptrw()), nullptr, "Can't decompress block from pack-referenced file '" + String(pf.pack) + "'.");
+
+	cached_block = p_block;
+	return block_cache.ptr();
+}
+
+uint64_t FileAccessPack::_read_compressed(uint8_t *p_dst, uint64_t p_length) const {
+	uint64_t position = pos;
+	uint64_t end = pos + p_length;
+
+	while (position < end) {
+		uint32_t block = position / block_size;
+		uint64_t block_offset = position % block_size;
+
+		// Whole blocks are decompressed straight into the destination.
+		uint32_t full_end = end == pf.size ? blocks.size() : end / block_size;
+		if (block_offset == 0 && full_end > block) {
+			uint32_t count = full_end - block;
+			ERR_FAIL_COND_V_MSG(!_decompress_blocks(block, count, p_dst), position - pos, "Can't decompress blocks from pack-referenced file '" + String(pf.pack) + "'.");
+			uint64_t read = MIN((uint64_t)count * block_size, end - position);
+			p_dst += read;
+			position += read;
+			continue;
+		}
+
+		const uint8_t *data = _get_block(block);
+		if (data == nullptr) {
+			break;
+		}
+		uint64_t read = MIN((uint64_t)block_size - block_offset, end - position);
+		memcpy(p_dst, data + block_offset, read);
+		p_dst += read;
+		position += read;
+	}
+
+	return position - pos;
+}
+
+Error FileAccessPack::_open_compressed() {
+	uint8_t header[8];
+	ERR_FAIL_COND_V(!_read_stored(0, header, 8), ERR_FILE_CORRUPT);
+	uint32_t mode = decode_uint32(header);
+	block_size = decode_uint32(header + 4);
+	ERR_FAIL_COND_V(mode > Compression::MODE_BROTLI || block_size == 0 || block_size >= PACK_BLOCK_STORED, ERR_FILE_CORRUPT);
+	compression_mode = (Compression::Mode)mode;
+
+	uint64_t block_count = (pf.size + block_size - 1) / block_size;
+	ERR_FAIL_COND_V(block_count > UINT32_MAX, ERR_FILE_CORRUPT);
+	Vector<uint8_t> sizes;
+	sizes.resize(block_count * 4);
+	ERR_FAIL_COND_V(!_read_stored(8, sizes.ptrw(), sizes.size()), ERR_FILE_CORRUPT);
+
+	blocks.resize(block_count);
+	uint64_t offset = 8 + block_count * 4;
+	for (uint64_t i = 0; i < block_count; i++) {
+		uint32_t size = decode_uint32(sizes.ptr() + i * 4);
+		CompressedBlock &block = blocks.write[i];
+		block.offset = offset;
+		block.size = size & ~PACK_BLOCK_STORED;
+		block.stored = size & PACK_BLOCK_STORED;
+		ERR_FAIL_COND_V(block.stored && block.size != MIN((uint64_t)block_size, pf.size - i * block_size), ERR_FILE_CORRUPT);
+		offset += block.size;
+	}
+	ERR_FAIL_COND_V(mapped && offset > mapped_length, ERR_FILE_CORRUPT);
+
+	block_cache.resize(block_size);
+	compressed = true;
+	return OK;
+}
+
+Vector<uint8_t> FileAccessPack::compress_blocks(const uint8_t *p_data, uint64_t p_size, Compression::Mode p_mode, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0 || p_block_size >= PACK_BLOCK_STORED, Vector<uint8_t>());
+
+	uint64_t block_count = (p_size + p_block_size - 1) / p_block_size;
+	ERR_FAIL_COND_V(block_count > UINT32_MAX, Vector<uint8_t>());
+
+	Vector<uint8_t> entry;
+	entry.resize(8 + block_count * 4);
+	encode_uint32(p_mode, entry.ptrw());
+	encode_uint32(p_block_size, entry.ptrw() + 4);
+
+	Vector<uint8_t> buffer;
+	buffer.resize(Compression::get_max_compressed_buffer_size(p_block_size, p_mode));
+
+	for (uint64_t i = 0; i < block_count; i++) {
+		const uint8_t *src = p_data + i * p_block_size;
+		uint32_t length = MIN((uint64_t)p_block_size, p_size - i * p_block_size);
+		int compressed_size = Compression::compress(buffer.ptrw(), src, length, p_mode);
+
+		uint64_t ofs = entry.size();
+		uint32_t stored_size;
+		if (compressed_size > 0 && (uint32_t)compressed_size < length) {
+			entry.resize(ofs + compressed_size);
+			memcpy(entry.ptrw() + ofs, buffer.ptr(), compressed_size);
+			stored_size = compressed_size;
+		} else {
+			entry.resize(ofs + length);
+			memcpy(entry.ptrw() + ofs, src, length);
+			stored_size = length | PACK_BLOCK_STORED;
+		}
+		encode_uint32(stored_size, entry.ptrw() + 8 + i * 4);
+	}
+
+	return entry;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	Ref<FileAccess> pack_file;
+	if (!pf.encrypted) {
+		// Read straight from the mapped pack when possible, saving a file handle per open file.
+		const uint8_t *pack = nullptr;
+		uint64_t pack_length = 0;
+		pack_file = PackedData::get_singleton()->open_pack(pf.pack, pack, pack_length);
+		if (pack != nullptr) {
+			if (off <= pack_length && (pf.compressed || pf.size <= pack_length - off)) {
+				mapping = pack_file;
+				mapped = pack + off;
+				mapped_length = pack_length - off;
+			}
+			pack_file = Ref<FileAccess>(); // Shared, can't be read from.
+		}
+	}
+
+	if (!mapped) {
+		_open_file(pack_file);
+	}
+
+	if (pf.compressed && is_open()) {
+		Error err = _open_compressed();
+		if (err != OK) {
+			close();
+			ERR_FAIL_MSG("Can't open compressed pack-referenced file '" + String(pf.pack) + "'.");
+		}
+	}
+}
+
+void FileAccessPack::_open_file(const Ref<FileAccess> &p_pack_file) {
+	f = p_pack_file.is_valid() ? p_pack_file : FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
@@ -402,8 +785,6 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -31,17 +31,24 @@
 #ifndef FILE_ACCESS_PACK_H
 #define FILE_ACCESS_PACK_H
 
+#include "core/io/compression.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 #include "core/templates/rb_map.h"
+#include "core/templates/safe_refcount.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION 2
+// The version of packs with PACK_FILE_COMPRESSED entries, which older versions can't read.
+#define PACK_FORMAT_VERSION_COMPRESSED 3
+// Uncompressed size of the blocks of newly written block-compressed entries.
+#define PACK_COMPRESSED_BLOCK_SIZE (64 * 1024)
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -49,7 +56,8 @@ enum PackFlags {
 };
 
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
 class PackSource;
@@ -67,6 +75,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
 	};
 
 private:
@@ -106,21 +115,40 @@ private:
 	static PackedData *singleton;
 	bool disabled = false;
 
+	struct MappedPack {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t length = 0;
+	};
+
+	// Packs are mapped once and shared by every file opened from them, until they're added again.
+	HashMap<String, MappedPack> mapped_packs;
+	Mutex mapped_packs_mutex;
+
 	void _free_packed_dirs(PackedDir *p_dir);
+	void _unmap_pack(const String &p_pack);
+	bool _remove_pack_files(PackedDir *p_dir, const String &p_dir_path, const String &p_pack);
+	// Returns the shared mapping of the pack in `r_mapped`, or a file opened for the caller when it can't be mapped.
+	Ref<FileAccess> open_pack(const String &p_pack, const uint8_t *&r_mapped, uint64_t &r_length);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+	// Removes the files added from the pack. Files it replaced aren't restored, and none of its directories may be open.
+	void remove_pack(const String &p_path);
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
 
+	// Where the unencrypted and uncompressed PCK entry for `p_path` is stored, for reading it without FileAccess.
+	bool get_file_location(const String &p_path, String &r_pack, uint64_t &r_offset, uint64_t &r_size);
+
 	_FORCE_INLINE_ Ref<DirAccess> try_open_directory(const String &p_path);
 	_FORCE_INLINE_ bool has_directory(const String &p_path);
 
@@ -148,7 +176,50 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	Ref<FileAccess> mapping; // Keeps the mapped pack alive.
+	const uint8_t *mapped = nullptr;
+	uint64_t mapped_length = 0;
 	Ref<FileAccess> f;
+
+	// Block-compressed entries start with the compression mode, the block size and the
+	// compressed size of every block, followed by the blocks. Only the blocks that are read
+	// get decompressed, so seeking doesn't need to decompress what comes before.
+	struct CompressedBlock {
+		uint64_t offset = 0; // From the start of the entry.
+		uint32_t size = 0;
+		bool stored = false; // Kept uncompressed, as it didn't get any smaller.
+	};
+
+	bool compressed = false;
+	Compression::Mode compression_mode = Compression::MODE_ZSTD;
+	uint32_t block_size = 0;
+	Vector<CompressedBlock> blocks;
+	mutable Vector<uint8_t> compressed_buffer;
+	mutable Vector<uint8_t> block_cache;
+	mutable int64_t cached_block = -1;
+
+	struct BlockDecompression {
+		const FileAccessPack *file = nullptr;
+		const uint8_t *src = nullptr;
+		uint64_t src_offset = 0;
+		uint8_t *dst = nullptr;
+		uint32_t from = 0;
+		uint32_t count = 0;
+		SafeNumeric<uint32_t> next;
+		SafeFlag failed;
+	};
+
+	static void _decompress_blocks_task(void *p_userdata);
+
+	bool _read_stored(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) const;
+	const uint8_t *_get_stored(uint64_t p_offset, uint64_t p_length) const;
+	bool _decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const;
+	bool _decompress_blocks(uint32_t p_from, uint32_t p_count, uint8_t *p_dst) const;
+	const uint8_t *_get_block(uint32_t p_block) const;
+	uint64_t _read_compressed(uint8_t *p_dst, uint64_t p_length) const;
+	void _open_file(const Ref<FileAccess> &p_pack_file);
+	Error _open_compressed();
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -172,6 +243,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t &r_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -187,6 +259,9 @@ public:
 
 	virtual void close() override;
 
+	// Encodes `p_data` as a block-compressed entry, for the files stored with PACK_FILE_COMPRESSED.
+	static Vector<uint8_t> compress_blocks(const uint8_t *p_data, uint64_t p_size, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = PACK_COMPRESSED_BLOCK_SIZE);
+
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
 };
 
@@ -40,13 +40,17 @@ class PCKPacker : public RefCounted {
 
 	Ref<FileAccess> file;
 	int alignment = 0;
-	uint64_t ofs = 0;
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
 
 	static void _bind_methods();
 
+#ifndef DISABLE_DEPRECATED
+	Error _add_file_bind_compat_pck_compression(const String &p_file, const String &p_src, bool p_encrypt = false);
+	static void _bind_compatibility_methods();
+#endif
+
 	struct File {
 		String path;
 		String src_path;
@@ -54,12 +58,14 @@ class PCKPacker : public RefCounted {
 		uint64_t size = 0;
 		bool encrypted = false;
 		Vector<uint8_t> md5;
+		bool compress = false;
+		bool compressed = false; // Set by flush(), if compressing was worth it.
 	};
 	Vector<File> files;
 
 public:
 	Error pck_start(const String &p_file, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
-	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false);
+	Error add_file(const String &p_file, const String &p_src, bool p_encrypt = false, bool p_compress = false);
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
@@ -33,10 +33,14 @@
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
+#include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/thread_safe.h"
 #include "core/version.h"
 
 //#define print_bl(m_what) print_line(m_what)
@@ -410,11 +414,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					}
 
 					//always use internal cache for loading internal resources
-					if (!internal_index_cache.has(path)) {
+					const HashMap<String, Ref<Resource>> &index_cache = shared_internal_index_cache ? *shared_internal_index_cache : internal_index_cache;
+					HashMap<String, Ref<Resource>>::ConstIterator E = index_cache.find(path);
+					if (!E) {
 						WARN_PRINT(String("Couldn't load resource (no cache): " + path).utf8().get_data());
 						r_v = Variant();
 					} else {
-						r_v = internal_index_cache[path];
+						r_v = E->value;
 					}
 				} break;
 				case OBJECT_EXTERNAL_RESOURCE: {
@@ -428,8 +434,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						path = ProjectSettings::get_singleton()->localize_path(res_path.get_base_dir().path_join(path));
 					}
 
-					if (remaps.find(path)) {
-						path = remaps[path];
+					const HashMap<String, String> &path_remaps = shared_remaps ? *shared_remaps : remaps;
+					if (path_remaps.has(path)) {
+						path = path_remaps[path];
 					}
 
 					Ref<Resource> res = ResourceLoader::load(path, exttype, cache_mode_for_external);
@@ -448,7 +455,7 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
-						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
+						const Ref<ResourceLoader::LoadToken> &load_token = external_resources[erindex].load_token;
 						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
 							Ref<Resource> res = ResourceLoader::_load_complete(*load_token.ptr(), &err);
@@ -680,199 +687,362 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
-Error ResourceLoaderBinary::load() {
-	if (error != OK) {
-		return error;
-	}
+Error ResourceLoaderBinary::_instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
 
-	for (int i = 0; i < external_resources.size(); i++) {
-		String path = external_resources[i].path;
+	//maybe it is loaded already
+	String path;
+	String id;
 
-		if (remaps.has(path)) {
-			path = remaps[path];
-		}
+	if (!main) {
+		path = internal_resources[p_index].path;
 
-		if (!path.contains("://") && path.is_relative_path()) {
-			// path is relative to file being loaded, so convert to a resource path
-			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
 		}
 
-		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
-		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
-		if (!external_resources[i].load_token.is_valid()) {
-			if (!ResourceLoader::get_abort_on_missing_resources()) {
-				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
-			} else {
-				error = ERR_FILE_MISSING_DEPENDENCIES;
-				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				internal_index_cache[path] = cached;
+				r_res = Ref<Resource>();
+				return OK;
 			}
 		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
+	uint64_t offset = internal_resources[p_index].offset;
 
-		//maybe it is loaded already
-		String path;
-		String id;
+	f->seek(offset);
 
-		if (!main) {
-			path = internal_resources[i].path;
+	String t = get_unicode_string();
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+	Ref<Resource> res;
+	Resource *r = nullptr;
 
-				internal_resources.write[i].path = path; // Update path.
+	MissingResource *missing_resource = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
+		}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
+				} else {
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
 			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
 			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		uint64_t offset = internal_resources[i].offset;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
+		}
+		r->set_scene_unique_id(id);
+	}
 
-		f->seek(offset);
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
 
-		String t = get_unicode_string();
+	r_res = res;
+	r_missing_resource = missing_resource;
+	return OK;
+}
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+Error ResourceLoaderBinary::_parse_internal_resource_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource) {
+	int pc = f->get_32();
 
-		MissingResource *missing_resource = nullptr;
+	//set properties
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+	Dictionary missing_resource_properties;
+
+	for (int j = 0; j < pc; j++) {
+		StringName name = _get_string();
+
+		if (name == StringName()) {
+			ERR_FAIL_V(ERR_FILE_CORRUPT);
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
-			}
 
-			if (res.is_null()) {
-				//did not replace
+		Variant value;
 
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
-				}
+		Error err = parse_variant(value);
+		if (err) {
+			return err;
+		}
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-				}
+		bool set_valid = true;
+		if (value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+			// If the property being set is a missing resource (and the parent is not),
+			// then setting it will most likely not work.
+			// Instead, save it as metadata.
 
-				res = Ref<Resource>(r);
+			Ref<MissingResource> mr = value;
+			if (mr.is_valid()) {
+				missing_resource_properties[name] = mr;
+				set_valid = false;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
-				} else {
-					r->set_path_cache(path);
+		if (value.get_type() == Variant::ARRAY) {
+			Array set_array = value;
+			bool is_get_valid = false;
+			Variant get_value = p_res->get(name, &is_get_valid);
+			if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+				Array get_array = get_value;
+				if (!set_array.is_same_typed(get_array)) {
+					value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 				}
 			}
-			r->set_scene_unique_id(id);
 		}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+		if (set_valid) {
+			p_res->set(name, value);
 		}
+	}
 
-		int pc = f->get_32();
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
 
-		//set properties
+	if (!missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	}
 
-		Dictionary missing_resource_properties;
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
 
-		for (int j = 0; j < pc; j++) {
-			StringName name = _get_string();
+	return OK;
+}
 
-			if (name == StringName()) {
-				error = ERR_FILE_CORRUPT;
-				ERR_FAIL_V(ERR_FILE_CORRUPT);
-			}
+void ResourceLoaderBinary::_decode_internal_resource(void *p_userdata) {
+	DecodeTask *task = (DecodeTask *)p_userdata;
+	const ResourceLoaderBinary *owner = task->owner;
+
+	// Counts as part of the load, so resources defer their connections to the queue of the decode,
+	// which the loading thread flushes once all are decoded, rather than racing on shared ones.
+	CallQueue *prev_queue = MessageQueue::get_singleton() != MessageQueue::get_main_singleton() ? MessageQueue::get_singleton() : nullptr;
+	bool prev_safe_for_nodes = is_current_thread_safe_for_nodes();
+	MessageQueue::set_thread_singleton_override(owner->call_queue);
+	set_current_thread_safe_for_nodes(true);
+	ResourceLoader::load_nesting++;
+
+	ResourceLoaderBinary decoder;
+	decoder.local_path = owner->local_path;
+	decoder.res_path = owner->res_path;
+	decoder.ver_format = owner->ver_format;
+	decoder.string_map = owner->string_map;
+	decoder.using_named_scene_ids = owner->using_named_scene_ids;
+	decoder.using_uids = owner->using_uids;
+	decoder.external_resources = owner->external_resources;
+	decoder.internal_resources = owner->internal_resources;
+	decoder.shared_internal_index_cache = &owner->internal_index_cache;
+	decoder.shared_remaps = &owner->remaps;
+	decoder.cache_mode = owner->cache_mode;
+	decoder.cache_mode_for_external = owner->cache_mode_for_external;
+
+	Ref<FileAccessMemory> fa;
+	fa.instantiate();
+	fa->open_custom(owner->decode_data, owner->decode_data_length);
+	fa->set_big_endian(owner->f->is_big_endian());
+	fa->real_is_double = owner->f->real_is_double;
+	fa->seek(task->properties_offset - owner->decode_data_offset);
+	decoder.f = fa;
+
+	task->error = decoder._parse_internal_resource_properties(task->resource, task->missing_resource);
+
+	ResourceLoader::load_nesting--;
+	set_current_thread_safe_for_nodes(prev_safe_for_nodes);
+	MessageQueue::set_thread_singleton_override(prev_queue);
+}
 
-			Variant value;
+Error ResourceLoaderBinary::_decode_internal_resources_threaded() {
+	int count = internal_resources.size() - 1; // The main resource is decoded last, on this thread.
+
+	// Create every resource first, so they can be referred to no matter which task decodes them.
+	LocalVector<DecodeTask> tasks;
+	tasks.resize(count);
+	for (int i = 0; i < count; i++) {
+		DecodeTask &task = tasks[i];
+		task.owner = this;
+		Error err = _instantiate_internal_resource(i, task.resource, task.missing_resource);
+		if (err != OK) {
+			return err;
+		}
+		task.properties_offset = f->get_position();
+		if (task.resource.is_valid()) {
+			resource_cache.push_back(task.resource);
+		}
+	}
 
-			error = parse_variant(value);
-			if (error) {
-				return error;
-			}
+	// Decoding tasks can't wait for external resources themselves, as a load can only be awaited once.
+	for (int i = 0; i < external_resources.size(); i++) {
+		if (external_resources[i].load_token.is_valid()) {
+			Error err;
+			ResourceLoader::_load_complete(*external_resources[i].load_token.ptr(), &err);
+		}
+	}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+	uint64_t data_end = f->get_length();
+	decode_data_offset = data_end;
+	for (int i = 0; i < count; i++) {
+		if (tasks[i].resource.is_valid()) {
+			decode_data_offset = MIN(decode_data_offset, tasks[i].properties_offset);
+		}
+	}
+	if (decode_data_offset == data_end) {
+		return OK; // Everything was cached.
+	}
+	decode_data_length = data_end - decode_data_offset;
+	f->seek(decode_data_offset);
+	Vector<uint8_t> decode_storage;
+	decode_data = f->get_buffer_view(decode_data_length, decode_storage);
+	ERR_FAIL_NULL_V_MSG(decode_data, ERR_FILE_CORRUPT, "Premature end of file (EOF): " + local_path + ".");
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
-			}
+	// Never the loading thread's own queue, which only that thread may flush.
+	CallQueue decode_queue;
+	call_queue = &decode_queue;
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
+	for (int i = 0; i < count; i++) {
+		DecodeTask &task = tasks[i];
+		if (task.resource.is_null()) {
+			continue;
+		}
+
+		Vector<WorkerThreadPool::TaskID> dependencies;
+		for (int dependency : internal_resources[i].dependencies) {
+			// Files are written with dependencies first, anything else can't be waited for.
+			if (dependency >= 0 && dependency < i && tasks[dependency].task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				dependencies.push_back(tasks[dependency].task_id);
 			}
+		}
+		task.task_id = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(&ResourceLoaderBinary::_decode_internal_resource, &task, dependencies, false, "ResourceLoaderBinary");
+	}
 
-			if (set_valid) {
-				res->set(name, value);
+	Error err = OK;
+	for (int i = 0; i < count; i++) {
+		DecodeTask &task = tasks[i];
+		if (task.task_id == WorkerThreadPool::INVALID_TASK_ID) {
+			continue;
+		}
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task.task_id);
+		if (task.error != OK && err == OK) {
+			err = task.error;
+		}
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
+	}
+
+	// Calls deferred while decoding, like connections to shared sub-resources, run one after another here.
+	decode_queue.flush();
+	call_queue = nullptr;
+
+	decode_data = nullptr;
+	decode_data_length = 0;
+	return err;
+}
+
+Error ResourceLoaderBinary::load() {
+	if (error != OK) {
+		return error;
+	}
+
+	for (int i = 0; i < external_resources.size(); i++) {
+		String path = external_resources[i].path;
+
+		if (remaps.has(path)) {
+			path = remaps[path];
+		}
+
+		if (!path.contains("://") && path.is_relative_path()) {
+			// path is relative to file being loaded, so convert to a resource path
+			path = ProjectSettings::get_singleton()->localize_path(path.get_base_dir().path_join(external_resources[i].path));
+		}
+
+		external_resources.write[i].path = path; //remap happens here, not on load because on load it can actually be used for filesystem dock resource remap
+		external_resources.write[i].load_token = ResourceLoader::_load_start(path, external_resources[i].type, use_sub_threads ? ResourceLoader::LOAD_THREAD_DISTRIBUTE : ResourceLoader::LOAD_THREAD_FROM_CURRENT, cache_mode_for_external);
+		if (!external_resources[i].load_token.is_valid()) {
+			if (!ResourceLoader::get_abort_on_missing_resources()) {
+				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
+			} else {
+				error = ERR_FILE_MISSING_DEPENDENCIES;
+				ERR_FAIL_V_MSG(error, "Can't load dependency: " + path + ".");
 			}
 		}
+	}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
+	int first_sequential = 0;
+	if (use_sub_threads && has_internal_dependencies && internal_resources.size() > 2 && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+		// The file says which internal resources refer to which, so the independent ones are decoded in parallel.
+		error = _decode_internal_resources_threaded();
+		if (error != OK) {
+			return error;
 		}
+		first_sequential = internal_resources.size() - 1;
+	}
+
+	for (int i = first_sequential; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+
+		error = _instantiate_internal_resource(i, res, missing_resource);
+		if (error != OK) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		error = _parse_internal_resource_properties(res, missing_resource);
+		if (error != OK) {
+			return error;
+		}
 
 		if (progress) {
 			*progress = (i + 1) / float(internal_resources.size());
@@ -1104,6 +1274,24 @@ void ResourceLoaderBinary::open(Ref<FileAccess> p_f, bool p_no_resources, bool p
 
 	print_bl("int resources: " + itos(int_resources_size));
 
+	if (flags & ResourceFormatSaverBinaryInstance::FORMAT_FLAG_HAS_INTERNAL_DEPENDENCIES) {
+		for (uint32_t i = 0; i < int_resources_size; i++) {
+			uint32_t dependency_count = f->get_32();
+			if (dependency_count > int_resources_size) {
+				error = ERR_FILE_CORRUPT;
+				f.unref();
+				ERR_FAIL_MSG("Invalid internal resource dependencies: " + local_path + ".");
+			}
+			Vector<int> &dependencies = internal_resources.write[i].dependencies;
+			dependencies.resize(dependency_count);
+			for (uint32_t j = 0; j < dependency_count; j++) {
+				uint32_t dependency = f->get_32();
+				dependencies.write[j] = dependency < int_resources_size ? dependency : -1;
+			}
+		}
+		has_internal_dependencies = true;
+	}
+
 	if (f->eof_reached()) {
 		error = ERR_FILE_CORRUPT;
 		f.unref();
@@ -2088,6 +2276,39 @@ void ResourceFormatSaverBinaryInstance::_find_resources(const Variant &p_variant
 	}
 }
 
+void ResourceFormatSaverBinaryInstance::_find_internal_dependencies(const Variant &p_variant, const HashMap<Ref<Resource>, int> &p_resource_map, HashSet<int> &r_dependencies) {
+	// Mirrors which resources write_variant() stores as internal.
+	switch (p_variant.get_type()) {
+		case Variant::OBJECT: {
+			Ref<Resource> res = p_variant;
+			if (res.is_null() || !res->is_built_in() || res->get_meta(SNAME("_skip_save_"), false)) {
+				return;
+			}
+			HashMap<Ref<Resource>, int>::ConstIterator E = p_resource_map.find(res);
+			if (E) {
+				r_dependencies.insert(E->value);
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array varray = p_variant;
+			for (const Variant &v : varray) {
+				_find_internal_dependencies(v, p_resource_map, r_dependencies);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			for (const Variant &E : keys) {
+				_find_internal_dependencies(E, p_resource_map, r_dependencies);
+				_find_internal_dependencies(d[E], p_resource_map, r_dependencies);
+			}
+		} break;
+		default: {
+		}
+	}
+}
+
 void ResourceFormatSaverBinaryInstance::save_unicode_string(Ref<FileAccess> p_f, const String &p_string, bool p_bit_on_len) {
 	CharString utf8 = p_string.utf8();
 	if (p_bit_on_len) {
@@ -2175,7 +2396,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 	String script_class;
 	{
-		uint32_t format_flags = FORMAT_FLAG_NAMED_SCENE_IDS | FORMAT_FLAG_UIDS;
+		uint32_t format_flags = FORMAT_FLAG_NAMED_SCENE_IDS | FORMAT_FLAG_UIDS | FORMAT_FLAG_HAS_INTERNAL_DEPENDENCIES;
 #ifdef REAL_T_IS_DOUBLE
 		format_flags |= FORMAT_FLAG_REAL_T_IS_DOUBLE;
 #endif
@@ -2330,6 +2551,25 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 		resource_map[r] = res_index++;
 	}
 
+	// Which internal resources each one refers to, so loaders can decode independent ones in parallel.
+	// Old loaders skip this, as they seek straight to the offsets in the table above.
+	for (const ResourceData &rd : resources) {
+		HashSet<int> dependencies;
+		for (const Property &p : rd.properties) {
+			_find_internal_dependencies(p.value, resource_map, dependencies);
+		}
+		Vector<int> sorted_dependencies;
+		for (int dependency : dependencies) {
+			sorted_dependencies.push_back(dependency);
+		}
+		sorted_dependencies.sort();
+
+		f->store_32(sorted_dependencies.size());
+		for (int dependency : sorted_dependencies) {
+			f->store_32(dependency);
+		}
+	}
+
 	Vector<uint64_t> ofs_table;
 
 	//now actually save the resources
@@ -34,6 +34,10 @@
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
+
+class CallQueue;
+class MissingResource;
 
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
@@ -73,10 +77,31 @@ class ResourceLoaderBinary {
 	struct IntResource {
 		String path;
 		uint64_t offset;
+		Vector<int> dependencies; // Indices of the internal resources it refers to, if the file records them.
 	};
 
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
+	bool has_internal_dependencies = false;
+
+	// Set on the loaders decoding internal resources on worker threads, so they use the cache and remaps of the main one.
+	const HashMap<String, Ref<Resource>> *shared_internal_index_cache = nullptr;
+	const HashMap<String, String> *shared_remaps = nullptr;
+
+	struct DecodeTask {
+		const ResourceLoaderBinary *owner = nullptr;
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		uint64_t properties_offset = 0;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		Error error = OK;
+	};
+
+	// The properties of all internal resources, while they are decoded in parallel.
+	const uint8_t *decode_data = nullptr;
+	uint64_t decode_data_offset = 0;
+	uint64_t decode_data_length = 0;
+	CallQueue *call_queue = nullptr;
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
@@ -91,6 +116,11 @@ class ResourceLoaderBinary {
 
 	Error parse_variant(Variant &r_v);
 
+	Error _instantiate_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource);
+	Error _parse_internal_resource_properties(const Ref<Resource> &p_res, MissingResource *p_missing_resource);
+	Error _decode_internal_resources_threaded();
+	static void _decode_internal_resource(void *p_userdata);
+
 	HashMap<String, Ref<Resource>> dependency_cache;
 
 public:
@@ -160,6 +190,7 @@ class ResourceFormatSaverBinaryInstance {
 
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
+	static void _find_internal_dependencies(const Variant &p_variant, const HashMap<Ref<Resource>, int> &p_resource_map, HashSet<int> &r_dependencies);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
 
@@ -169,6 +200,7 @@ public:
 		FORMAT_FLAG_UIDS = 2,
 		FORMAT_FLAG_REAL_T_IS_DOUBLE = 4,
 		FORMAT_FLAG_HAS_SCRIPT_CLASS = 8,
+		FORMAT_FLAG_HAS_INTERNAL_DEPENDENCIES = 16,
 
 		// Amount of reserved 32-bit fields in resource header
 		RESERVED_FIELDS = 11
@@ -31,6 +31,7 @@
 #include "resource_loader.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/async_file_reader.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
@@ -299,6 +300,7 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	if (cleaning_tasks) {
 		load_task.status = THREAD_LOAD_FAILED;
 		thread_load_mutex.unlock();
+		_release_prefetched_loads(load_task);
 		return;
 	}
 	thread_load_mutex.unlock();
@@ -325,6 +327,10 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		MessageQueue::get_singleton()->flush();
 	}
 
+	// Loads started ahead that weren't needed are dropped before the result is published, so they're out of the cache
+	// by the time it's collected.
+	_release_prefetched_loads(load_task);
+
 	thread_load_mutex.lock();
 
 	load_task.resource = res;
@@ -400,6 +406,30 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	}
 }
 
+// Done by the load they were started for, rather than by the thread that started them, which must not block.
+void ResourceLoader::_release_prefetched_loads(ThreadLoadTask &p_load_task) {
+	LocalVector<Ref<LoadToken>> prefetched_loads;
+	{
+		MutexLock thread_load_lock(thread_load_mutex);
+		// Starting them only takes as long as queuing them.
+		while (p_load_task.prefetches_in_progress > 0) {
+			prefetched_loads_cond_var.wait(thread_load_lock);
+		}
+		prefetched_loads = p_load_task.prefetched_loads;
+		p_load_task.prefetched_loads.clear();
+		// The load is still in progress until its result is published, so that alone can't tell.
+		p_load_task.prefetches_closed = true;
+	}
+
+	// Awaited before they're released, as releasing the last reference to a load in progress
+	// would free the task data it's still using.
+	for (const Ref<LoadToken> &load_token : prefetched_loads) {
+		Error err;
+		_load_complete(*load_token.ptr(), &err);
+	}
+	prefetched_loads.clear();
+}
+
 static String _validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -430,6 +460,10 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 		user_load_tokens[p_path] = token.ptr();
 		print_lt("REQUEST: user load tokens: " + itos(user_load_tokens.size()));
 		thread_load_mutex.unlock();
+
+		if (!prefetch_manifest.is_empty()) {
+			_prefetch_dependencies(token, _validate_local_path(p_path), p_use_sub_threads, p_cache_mode);
+		}
 		return OK;
 	} else {
 		return FAILED;
@@ -462,6 +496,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	ThreadLoadTask unregistered_load_task; // Once set, must be valid up to the call to do the load.
 	ThreadLoadTask *load_task_ptr = nullptr;
 	bool run_on_current_thread = false;
+	String prefetch_path;
 	{
 		MutexLock thread_load_lock(thread_load_mutex);
 
@@ -519,9 +554,14 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task_ptr->thread_id = Thread::get_caller_id();
 		} else {
 			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr);
+			prefetch_path = load_task_ptr->remapped_path;
 		}
 	}
 
+	if (!prefetch_path.is_empty()) {
+		_prefetch_resource_files({ prefetch_path });
+	}
+
 	if (run_on_current_thread) {
 		_thread_load_function(load_task_ptr);
 		if (ignoring_cache) {
@@ -532,6 +572,106 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 	return load_token;
 }
 
+static void _prefetch_done(void *p_userdata, AsyncFileReader::BatchID p_batch) {
+	memdelete_arr((AsyncFileReader::Request *)p_userdata);
+}
+
+// Starts reading the files threaded loads are going to open, so the I/O overlaps
+// with the wait for a pool thread and with other loads being decoded. Only done when
+// the OS can be asked to do it, reading the files ahead on pool threads would take
+// them from the loads and read everything twice.
+void ResourceLoader::_prefetch_resource_files(const Vector<String> &p_remapped_paths) {
+	AsyncFileReader *reader = AsyncFileReader::get_singleton();
+	if (!reader || p_remapped_paths.is_empty()) {
+		return;
+	}
+
+	LocalVector<String> paths;
+	for (const String &remapped_path : p_remapped_paths) {
+		String path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(remapped_path);
+		if (path.is_empty()) {
+			path = remapped_path;
+		}
+		if (reader->can_prefetch_without_reading(path)) {
+			paths.push_back(path);
+		}
+	}
+	if (paths.is_empty()) {
+		return;
+	}
+
+	AsyncFileReader::Request *requests = memnew_arr(AsyncFileReader::Request, paths.size());
+	for (uint32_t i = 0; i < paths.size(); i++) {
+		requests[i].path = paths[i];
+	}
+	reader->add_read_batch(requests, paths.size(), &_prefetch_done, requests);
+}
+
+void ResourceLoader::_prefetch_dependencies(const Ref<LoadToken> &p_load_token, const String &p_local_path, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
+	const Vector<String> *dependencies = prefetch_manifest.getptr(p_local_path);
+	if (!dependencies) {
+		return;
+	}
+
+	if (p_load_token->local_path.is_empty()) {
+		return; // Loads ignoring the cache run to completion when started.
+	}
+	const bool start_loads = p_use_sub_threads && p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE;
+	{
+		MutexLock thread_load_lock(thread_load_mutex);
+		HashMap<String, ThreadLoadTask>::Iterator E = thread_load_tasks.find(p_load_token->local_path);
+		if (!E || E->value.prefetches_closed) {
+			return;
+		}
+		if (start_loads) {
+			// Makes the load wait for the loads started ahead, to release the ones it didn't need.
+			E->value.prefetches_in_progress++;
+		}
+	}
+
+	if (!start_loads) {
+		// Everything is decoded by a single thread, so only the reads are started ahead.
+		Vector<String> remapped_paths;
+		for (const String &dependency : *dependencies) {
+			if (!ResourceCache::has(dependency)) {
+				remapped_paths.push_back(_path_remap(dependency));
+			}
+		}
+		_prefetch_resource_files(remapped_paths);
+		return;
+	}
+
+	// Loading the whole dependency closure right away lets it be read and decoded in parallel,
+	// instead of one level of the dependency tree at a time. The manifest lists dependents
+	// before their dependencies, so no load ends up awaiting an older one.
+	LocalVector<Ref<LoadToken>> loads;
+	for (const String &dependency : *dependencies) {
+		if (ResourceCache::has(dependency)) {
+			continue;
+		}
+		{
+			// Loads started before this one are left to whoever started them, it couldn't await them.
+			MutexLock thread_load_lock(thread_load_mutex);
+			if (thread_load_tasks.has(dependency)) {
+				continue;
+			}
+		}
+		Ref<LoadToken> load_token = _load_start(dependency, String(), LOAD_THREAD_DISTRIBUTE, ResourceFormatLoader::CACHE_MODE_REUSE);
+		if (load_token.is_valid()) {
+			loads.push_back(load_token);
+		}
+	}
+
+	// Still registered, as the caller holds the token.
+	MutexLock thread_load_lock(thread_load_mutex);
+	ThreadLoadTask &load_task = thread_load_tasks[p_load_token->local_path];
+	for (const Ref<LoadToken> &load_token : loads) {
+		load_task.prefetched_loads.push_back(load_token);
+	}
+	load_task.prefetches_in_progress--;
+	prefetched_loads_cond_var.notify_all();
+}
+
 float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	if (thread_load_tasks.has(p_path)) {
 		ThreadLoadTask &load_task = thread_load_tasks[p_path];
@@ -1200,6 +1340,98 @@ void ResourceLoader::clear_path_remaps() {
 	path_remaps.clear();
 }
 
+String ResourceLoader::get_prefetch_manifest_file() {
+	return ProjectSettings::get_singleton()->get_project_data_path().path_join("prefetch_manifest.bin");
+}
+
+Error ResourceLoader::save_prefetch_manifest(const String &p_file, const HashMap<String, Vector<String>> &p_manifest) {
+	Ref<FileAccess> f = FileAccess::open(p_file, FileAccess::WRITE);
+	if (f.is_null()) {
+		return ERR_CANT_OPEN;
+	}
+
+	// Paths are stored once, and referred to by index.
+	HashMap<String, uint32_t> path_indices;
+	Vector<String> paths;
+	for (const KeyValue<String, Vector<String>> &E : p_manifest) {
+		if (!path_indices.has(E.key)) {
+			path_indices.insert(E.key, paths.size());
+			paths.push_back(E.key);
+		}
+		for (const String &dependency : E.value) {
+			if (!path_indices.has(dependency)) {
+				path_indices.insert(dependency, paths.size());
+				paths.push_back(dependency);
+			}
+		}
+	}
+
+	f->store_32(paths.size());
+	for (const String &path : paths) {
+		CharString cs = path.utf8();
+		f->store_32(cs.length());
+		f->store_buffer((const uint8_t *)cs.ptr(), cs.length());
+	}
+
+	f->store_32(p_manifest.size());
+	for (const KeyValue<String, Vector<String>> &E : p_manifest) {
+		f->store_32(path_indices[E.key]);
+		f->store_32(E.value.size());
+		for (const String &dependency : E.value) {
+			f->store_32(path_indices[dependency]);
+		}
+	}
+
+	return OK;
+}
+
+void ResourceLoader::load_prefetch_manifest(const String &p_file) {
+	String manifest_file = p_file.is_empty() ? get_prefetch_manifest_file() : p_file;
+	if (!FileAccess::exists(manifest_file)) {
+		return; // Only written in exported projects.
+	}
+
+	prefetch_manifest.clear();
+
+	Ref<FileAccess> f = FileAccess::open(manifest_file, FileAccess::READ);
+	ERR_FAIL_COND_MSG(f.is_null(), "Cannot open resource prefetch manifest '" + manifest_file + "'.");
+
+	Vector<String> paths;
+	paths.resize(f->get_32());
+	for (int i = 0; i < paths.size(); i++) {
+		uint32_t len = f->get_32();
+		CharString cs;
+		cs.resize(len + 1);
+		ERR_FAIL_COND(f->get_buffer((uint8_t *)cs.ptrw(), len) != len);
+		cs[len] = 0;
+		paths.write[i].parse_utf8(cs.ptr());
+	}
+
+	uint32_t entry_count = f->get_32();
+	for (uint32_t i = 0; i < entry_count && !f->eof_reached(); i++) {
+		uint32_t path_index = f->get_32();
+		Vector<String> dependencies;
+		dependencies.resize(f->get_32());
+		for (int j = 0; j < dependencies.size(); j++) {
+			uint32_t dependency_index = f->get_32();
+			if (dependency_index >= (uint32_t)paths.size()) {
+				prefetch_manifest.clear();
+				ERR_FAIL_MSG("Resource prefetch manifest '" + manifest_file + "' is corrupt.");
+			}
+			dependencies.write[j] = paths[dependency_index];
+		}
+		if (path_index >= (uint32_t)paths.size()) {
+			prefetch_manifest.clear();
+			ERR_FAIL_MSG("Resource prefetch manifest '" + manifest_file + "' is corrupt.");
+		}
+		prefetch_manifest[paths[path_index]] = dependencies;
+	}
+}
+
+void ResourceLoader::clear_prefetch_manifest() {
+	prefetch_manifest.clear();
+}
+
 void ResourceLoader::set_load_callback(ResourceLoadedCallback p_callback) {
 	_loaded_callback = p_callback;
 }
@@ -1298,6 +1530,7 @@ thread_local HashMap<int, HashMap<String, Ref<Resource>>> ResourceLoader::res_re
 template <>
 thread_local uint32_t SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG>::count = 0;
 SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG> ResourceLoader::thread_load_mutex;
+ConditionVariable ResourceLoader::prefetched_loads_cond_var;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
 bool ResourceLoader::cleaning_tasks = false;
 
@@ -1306,5 +1539,6 @@ HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 SelfList<Resource>::List ResourceLoader::remapped_list;
 HashMap<String, Vector<String>> ResourceLoader::translation_remaps;
 HashMap<String, String> ResourceLoader::path_remaps;
+HashMap<String, Vector<String>> ResourceLoader::prefetch_manifest;
 
 ResourceLoaderImport ResourceLoader::import = nullptr;
@@ -148,6 +148,7 @@ private:
 	static bool create_missing_resources_if_class_unavailable;
 	static HashMap<String, Vector<String>> translation_remaps;
 	static HashMap<String, String> path_remaps;
+	static HashMap<String, Vector<String>> prefetch_manifest;
 
 	static String _path_remap(const String &p_path, bool *r_translation_remapped = nullptr);
 	friend class Resource;
@@ -155,6 +156,7 @@ private:
 	static SelfList<Resource>::List remapped_list;
 
 	friend class ResourceFormatImporter;
+	friend class ResourceLoaderBinary;
 
 	static Ref<Resource> _load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress);
 
@@ -181,9 +183,15 @@ private:
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
 		HashSet<String> sub_tasks;
+		LocalVector<Ref<LoadToken>> prefetched_loads; // Started ahead from the prefetch manifest, released once this load is done.
+		uint32_t prefetches_in_progress = 0; // Loads being started ahead, handed over to `prefetched_loads` when all are.
+		bool prefetches_closed = false; // Set once `prefetched_loads` are taken to be released, no more can be started.
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _release_prefetched_loads(ThreadLoadTask &p_load_task);
+	static void _prefetch_resource_files(const Vector<String> &p_remapped_paths);
+	static void _prefetch_dependencies(const Ref<LoadToken> &p_load_token, const String &p_local_path, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode);
 
 	static thread_local int load_nesting;
 	static thread_local WorkerThreadPool::TaskID caller_task_id;
@@ -191,6 +199,7 @@ private:
 	static thread_local Vector<String> *load_paths_stack; // A pointer to avoid broken TLS implementations from double-running the destructor.
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static ConditionVariable prefetched_loads_cond_var; // Notified when loads started ahead are handed over.
 	static bool cleaning_tasks;
 
 	static HashMap<String, LoadToken *> user_load_tokens;
@@ -259,6 +268,11 @@ public:
 	static void load_path_remaps();
 	static void clear_path_remaps();
 
+	static String get_prefetch_manifest_file();
+	static Error save_prefetch_manifest(const String &p_file, const HashMap<String, Vector<String>> &p_manifest);
+	static void load_prefetch_manifest(const String &p_file = String()); // The one exported with the project if empty.
+	static void clear_prefetch_manifest();
+
 	static void reload_translation_remaps();
 	static void load_translation_remaps();
 	static void clear_translation_remaps();
@@ -33,6 +33,8 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
@@ -58,13 +60,72 @@
 		mutex.unlock();                           \
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+// Taken with the chain locked. A single atomic increment per push, which orders pushes that happen
+// one after another across threads even when a clock would give them the same time.
+uint64_t CallQueue::_next_sequence() {
+	return push_sequence.increment();
+}
+
+CallQueue::ThreadChain *CallQueue::_get_thread_chain() {
+	std::atomic<ThreadChain *> &slot = chains[Thread::get_caller_id() & (THREAD_CHAIN_COUNT - 1)];
+	ThreadChain *chain = slot.load(std::memory_order_acquire);
+	if (unlikely(!chain)) {
+		MutexLock lock(mutex);
+		chain = slot.load(std::memory_order_relaxed);
+		if (!chain) {
+			chain = memnew(ThreadChain);
+			slot.store(chain, std::memory_order_release);
+		}
+	}
+	return chain;
+}
+
+// Must be called with the chain locked. Returns nullptr if the queue is out of pages.
+uint8_t *CallQueue::_alloc_message(ThreadChain *p_chain, uint32_t p_room_needed) {
+	uint32_t page_count = p_chain->pages.size();
+	if (page_count == 0 || (p_chain->page_bytes[page_count - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		uint32_t used = pages_used.increment();
+		if (used > max_pages) {
+			pages_used.decrement();
+			return nullptr;
+		}
+		peak_pages_used.exchange_if_greater(used);
+
+		Page *page;
+		if (p_chain->spare_pages.size()) {
+			page = p_chain->spare_pages[p_chain->spare_pages.size() - 1];
+			p_chain->spare_pages.remove_at(p_chain->spare_pages.size() - 1);
+		} else {
+			page = allocator->alloc();
+			pages_allocated.increment();
+		}
+		p_chain->pages.push_back(page);
+		p_chain->page_bytes.push_back(0);
+		page_count++;
+	}
+
+	return &p_chain->pages[page_count - 1]->data[p_chain->page_bytes[page_count - 1]];
+}
+
+void CallQueue::_recycle_page(ThreadChain *p_chain, Page *p_page) {
+	p_chain->lock.lock();
+	p_chain->spare_pages.push_back(p_page);
+	p_chain->lock.unlock();
+	pages_used.decrement();
+}
+
+uint32_t CallQueue::_destroy_message(Message *p_message) {
+	uint32_t advance = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+		advance += sizeof(Variant) * p_message->args;
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+	p_message->~Message();
+	return advance;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -88,24 +149,17 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
+	ThreadChain *chain = _get_thread_chain();
+	chain->lock.lock();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _alloc_message(chain, room_needed);
+	if (!buffer_end) {
+		chain->lock.unlock();
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -117,6 +171,7 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
 		msg->type |= FLAG_NULL_IS_OK;
 	}
+	msg->sequence = _next_sequence();
 
 	buffer_end += sizeof(Message);
 
@@ -126,82 +181,72 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	chain->page_bytes[chain->page_bytes.size() - 1] += room_needed;
+	chain->lock.unlock();
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
+	ThreadChain *chain = _get_thread_chain();
+	chain->lock.lock();
 
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	uint8_t *buffer_end = _alloc_message(chain, room_needed);
+	if (!buffer_end) {
+		chain->lock.unlock();
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
+	msg->sequence = _next_sequence();
 
 	buffer_end += sizeof(Message);
 
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	chain->page_bytes[chain->page_bytes.size() - 1] += room_needed;
+	chain->lock.unlock();
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
+	ThreadChain *chain = _get_thread_chain();
+	chain->lock.lock();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _alloc_message(chain, room_needed);
+	if (!buffer_end) {
+		chain->lock.unlock();
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
+	msg->sequence = _next_sequence();
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	chain->page_bytes[chain->page_bytes.size() - 1] += room_needed;
+	chain->lock.unlock();
 
 	return OK;
 }
@@ -226,80 +271,126 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 Error CallQueue::flush() {
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
-		// Never allocated
+	if (flushing) {
 		UNLOCK_MUTEX;
-		return OK; // Do nothing.
+		return ERR_BUSY;
 	}
 
-	if (flushing) {
+	if (pages_used.get() == 0) {
 		UNLOCK_MUTEX;
-		return ERR_BUSY;
+		return OK; // Do nothing.
 	}
 
 	flushing = true;
+	UNLOCK_MUTEX;
 
-	uint32_t i = 0;
-	uint32_t offset = 0;
-
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+	LocalVector<ThreadChain *> active_chains;
 
-		Message *message = (Message *)&page->data[offset];
+	while (true) {
+		// Only messages pushed before the cutoff are guaranteed to be in the pages detached below,
+		// since their sequence number is taken with the chain locked. Later ones wait for the next round.
+		uint64_t cutoff = push_sequence.get();
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+		active_chains.clear();
+		for (uint32_t i = 0; i < THREAD_CHAIN_COUNT; i++) {
+			ThreadChain *chain = chains[i].load(std::memory_order_acquire);
+			if (!chain) {
+				continue;
+			}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+			chain->lock.lock();
+			for (uint32_t j = 0; j < chain->pages.size(); j++) {
+				chain->flush_pages.push_back(chain->pages[j]);
+				chain->flush_page_bytes.push_back(chain->page_bytes[j]);
+			}
+			chain->pages.clear();
+			chain->page_bytes.clear();
+			chain->lock.unlock();
 
-		Object *target = message->callable.get_object();
+			if (chain->flush_page < chain->flush_pages.size()) {
+				active_chains.push_back(chain);
+			}
+		}
 
-		UNLOCK_MUTEX;
+		if (active_chains.is_empty()) {
+			break;
+		}
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+		while (true) {
+			// Merge the chains by picking the oldest message among their heads.
+			ThreadChain *chain = nullptr;
+			Message *message = nullptr;
+			for (ThreadChain *E : active_chains) {
+				if (E->flush_page == E->flush_pages.size()) {
+					continue;
 				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
+				Message *head = (Message *)&E->flush_pages[E->flush_page]->data[E->flush_offset];
+				if (head->sequence > cutoff) {
+					continue;
 				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
+				if (!message || head->sequence < message->sequence) {
+					chain = E;
+					message = head;
 				}
-			} break;
-		}
+			}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			if (!message) {
+				break;
+			}
+
+			uint32_t advance = sizeof(Message);
+			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+				advance += sizeof(Variant) * message->args;
 			}
-		}
 
-		message->~Message();
+			// Pre-advance so this function is reentrant.
+			uint32_t page_index = chain->flush_page;
+			chain->flush_offset += advance;
+			if (chain->flush_offset == chain->flush_page_bytes[page_index]) {
+				chain->flush_page++;
+				chain->flush_offset = 0;
+			}
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			Object *target = message->callable.get_object();
+
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
+			}
+
+			_destroy_message(message);
+
+			if (chain->flush_page != page_index) {
+				_recycle_page(chain, chain->flush_pages[page_index]);
+				if (chain->flush_page == chain->flush_pages.size()) {
+					chain->flush_pages.clear();
+					chain->flush_page_bytes.clear();
+					chain->flush_page = 0;
+				}
+			}
 		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	flush_time_usec.add(OS::get_singleton()->get_ticks_usec() - flush_begin);
 
+	LOCK_MUTEX;
 	flushing = false;
 	UNLOCK_MUTEX;
 	return OK;
@@ -308,41 +399,28 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
+	for (uint32_t i = 0; i < THREAD_CHAIN_COUNT; i++) {
+		ThreadChain *chain = chains[i].load(std::memory_order_acquire);
+		if (!chain) {
+			continue;
+		}
 
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
+		chain->lock.lock();
+		LocalVector<Page *> pages = chain->pages;
+		LocalVector<uint32_t> page_bytes = chain->page_bytes;
+		chain->pages.clear();
+		chain->page_bytes.clear();
+		chain->lock.unlock();
+
+		for (uint32_t j = 0; j < pages.size(); j++) {
+			uint32_t offset = 0;
+			while (offset < page_bytes[j]) {
+				offset += _destroy_message((Message *)&pages[j]->data[offset]);
 			}
-
-			message->~Message();
+			_recycle_page(chain, pages[j]);
 		}
 	}
 
-	pages_used = 1;
-	page_bytes[0] = 0;
-
 	UNLOCK_MUTEX;
 }
 
@@ -353,77 +431,73 @@ void CallQueue::statistics() {
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
+	for (uint32_t i = 0; i < THREAD_CHAIN_COUNT; i++) {
+		ThreadChain *chain = chains[i].load(std::memory_order_acquire);
+		if (!chain) {
+			continue;
+		}
 
-			//lock on each iteration, so a call can re-add itself to the message queue
+		chain->lock.lock();
+		for (uint32_t j = 0; j < chain->pages.size(); j++) {
+			uint32_t offset = 0;
+			while (offset < chain->page_bytes[j]) {
+				Message *message = (Message *)&chain->pages[j]->data[offset];
 
-			Message *message = (Message *)&page->data[offset];
+				uint32_t advance = sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+					advance += sizeof(Variant) * message->args;
+				}
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+				Object *target = message->callable.get_object();
 
-			Object *target = message->callable.get_object();
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
-			}
 
-			message->~Message();
+				offset += advance;
+			}
 		}
+		chain->lock.unlock();
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used.get(), pages_used.get() * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -446,18 +520,27 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
-	}
-
-	return true;
+	return pages_used.get() > 0;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return pages_allocated.get() * PAGE_SIZE_BYTES;
+}
+
+uint32_t CallQueue::get_pages_used() const {
+	return pages_used.get();
+}
+
+uint32_t CallQueue::get_peak_pages_used() const {
+	return peak_pages_used.get();
+}
+
+void CallQueue::reset_peak_pages_used() {
+	peak_pages_used.set(pages_used.get());
+}
+
+uint64_t CallQueue::get_flush_time_usec() const {
+	return flush_time_usec.get();
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -475,8 +558,15 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (uint32_t i = 0; i < THREAD_CHAIN_COUNT; i++) {
+		ThreadChain *chain = chains[i].load(std::memory_order_acquire);
+		if (!chain) {
+			continue;
+		}
+		for (uint32_t j = 0; j < chain->spare_pages.size(); j++) {
+			allocator->free(chain->spare_pages[j]);
+		}
+		memdelete(chain);
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
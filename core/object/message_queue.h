@@ -32,9 +32,11 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/object_id.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
@@ -66,39 +68,60 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	enum {
+		// Pushing threads are spread over this many page chains by thread ID.
+		THREAD_CHAIN_COUNT = 32,
+	};
+
+	struct Message {
+		Callable callable;
+		int16_t type;
+		union {
+			int16_t notification;
+			int16_t args;
+		};
+		uint64_t sequence; // Push order across threads, used to merge the chains when flushing.
+	};
+
+	// Each pushing thread appends to its own chain of pages, so pushes from different threads only share
+	// the sequence counter. The flushing thread detaches the filled pages and merges them by sequence number.
+	// Within a chain, messages are already in push order.
+	struct ThreadChain {
+		SpinLock lock;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		LocalVector<Page *> spare_pages;
+
+		// Only accessed by the flushing thread.
+		LocalVector<Page *> flush_pages;
+		LocalVector<uint32_t> flush_page_bytes;
+		uint32_t flush_page = 0;
+		uint32_t flush_offset = 0;
+	};
+
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	std::atomic<ThreadChain *> chains[THREAD_CHAIN_COUNT] = {};
+	SafeNumeric<uint64_t> push_sequence;
+	SafeNumeric<uint32_t> pages_allocated;
+	SafeNumeric<uint32_t> pages_used;
+	SafeNumeric<uint32_t> peak_pages_used;
+	SafeNumeric<uint64_t> flush_time_usec;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
 
-	struct Message {
-		Callable callable;
-		int16_t type;
-		union {
-			int16_t notification;
-			int16_t args;
-		};
-	};
-
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
-		}
-	}
-
-	void _add_page();
+	uint64_t _next_sequence();
+	ThreadChain *_get_thread_chain();
+	uint8_t *_alloc_message(ThreadChain *p_chain, uint32_t p_room_needed);
+	void _recycle_page(ThreadChain *p_chain, Page *p_page);
+	static uint32_t _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -153,6 +176,11 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
+	uint32_t get_pages_used() const;
+	uint32_t get_peak_pages_used() const;
+	void reset_peak_pages_used();
+	uint64_t get_flush_time_usec() const;
+
 	CallQueue(Allocator *p_custom_allocator = 0, uint32_t p_max_pages = 8192, const String &p_error_text = String());
 	virtual ~CallQueue();
 };
@@ -44,18 +44,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	Object *obj;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj = p_obj;
-		obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		obj->_lock_index.unref();
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1114,6 +1102,63 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData::DispatchTable *Object::SignalData::get_dispatch_table() const {
+	// The caller holds a reference until it's done emitting.
+	if (dispatch_table) {
+		dispatch_table->refcount.ref();
+	}
+	return dispatch_table;
+}
+
+void Object::SignalData::update_dispatch_table() {
+	clear_dispatch_table();
+	if (slot_map.is_empty()) {
+		return;
+	}
+
+	dispatch_table = memnew(DispatchTable);
+	dispatch_table->refcount.init();
+	dispatch_table->entries.resize(slot_map.size());
+
+	uint32_t i = 0;
+	for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+		DispatchTable::Entry &entry = dispatch_table->entries[i++];
+		entry.callable = slot_kv.value.conn.callable;
+		entry.flags = slot_kv.value.conn.flags;
+		dispatch_table->has_one_shot = dispatch_table->has_one_shot || (entry.flags & CONNECT_ONE_SHOT);
+	}
+}
+
+void Object::SignalData::clear_dispatch_table() {
+	if (dispatch_table && dispatch_table->refcount.unref()) {
+		memdelete(dispatch_table);
+	}
+	dispatch_table = nullptr;
+}
+
+Object::SignalData::SignalData(const SignalData &p_other) :
+		user(p_other.user),
+		slot_map(p_other.slot_map),
+		removable(p_other.removable) {
+	// Same connections, so the table can be shared.
+	dispatch_table = p_other.get_dispatch_table();
+}
+
+void Object::SignalData::operator=(const SignalData &p_other) {
+	if (this == &p_other) {
+		return;
+	}
+	clear_dispatch_table();
+	user = p_other.user;
+	slot_map = p_other.slot_map;
+	removable = p_other.removable;
+	dispatch_table = p_other.get_dispatch_table();
+}
+
+Object::SignalData::~SignalData() {
+	clear_dispatch_table();
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
@@ -1136,29 +1181,24 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	// Ensure that disconnecting the signal or even deleting the object
 	// will not affect the signal calling.
-	Callable *slot_callables = (Callable *)alloca(sizeof(Callable) * s->slot_map.size());
-	uint32_t *slot_flags = (uint32_t *)alloca(sizeof(uint32_t) * s->slot_map.size());
-	uint32_t slot_count = 0;
-
-	for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-		memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-		slot_flags[slot_count] = slot_kv.value.conn.flags;
-		++slot_count;
+	SignalData::DispatchTable *dispatch_table = s->get_dispatch_table();
+	if (!dispatch_table) {
+		return OK; // Nothing connected.
 	}
 
-	DEV_ASSERT(slot_count == s->slot_map.size());
-
 	// Disconnect all one-shot connections before emitting to prevent recursion.
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+	if (dispatch_table->has_one_shot) {
+		for (const SignalData::DispatchTable::Entry &entry : dispatch_table->entries) {
+			bool disconnect = entry.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-		if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-			// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-			disconnect = false;
-		}
+			if (disconnect && (entry.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+				disconnect = false;
+			}
 #endif
-		if (disconnect) {
-			_disconnect(p_name, slot_callables[i]);
+			if (disconnect) {
+				_disconnect(p_name, entry.callable);
+			}
 		}
 	}
 
@@ -1166,9 +1206,9 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (const SignalData::DispatchTable::Entry &entry : dispatch_table->entries) {
+		const Callable &callable = entry.callable;
+		const uint32_t &flags = entry.flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1204,8 +1244,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
+	if (dispatch_table->refcount.unref()) {
+		memdelete(dispatch_table);
 	}
 
 	return err;
@@ -1421,6 +1461,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->update_dispatch_table();
 
 	return OK;
 }
@@ -1478,6 +1519,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->update_dispatch_table();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -36,9 +36,11 @@
 #include "core/object/object_id.h"
 #include "core/os/rw_lock.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/flat_hash_map.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -618,12 +620,36 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Snapshot of the connections used by emission, built again whenever they change.
+		// Emission only takes a reference, so it's safe from as many threads as reading
+		// the connections was, and callbacks can connect and disconnect while it's iterated.
+		struct DispatchTable {
+			struct Entry {
+				Callable callable;
+				uint32_t flags = 0;
+			};
+
+			SafeRefCount refcount;
+			LocalVector<Entry> entries;
+			bool has_one_shot = false;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		DispatchTable *dispatch_table = nullptr;
 		bool removable = false;
+
+		DispatchTable *get_dispatch_table() const;
+		void update_dispatch_table();
+		void clear_dispatch_table();
+
+		SignalData() {}
+		SignalData(const SignalData &p_other);
+		void operator=(const SignalData &p_other);
+		~SignalData();
 	};
 
-	HashMap<StringName, SignalData> signal_map;
+	FlatHashMap<StringName, SignalData> signal_map;
 	List<Connection> connections;
 #ifdef DEBUG_ENABLED
 	SafeRefCount _lock_index;
@@ -1006,6 +1032,23 @@ public:
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
+#ifdef DEBUG_ENABLED
+
+// Keeps the object from being freed while one of its methods runs, see Object::callp().
+struct _ObjectDebugLock {
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+
+#endif // DEBUG_ENABLED
+
 class ObjectDB {
 // This needs to add up to 63, 1 bit is for reference.
 #define OBJECTDB_VALIDATOR_BITS 39
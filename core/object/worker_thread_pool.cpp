@@ -54,6 +54,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
 	Task *prev_task = nullptr; // In case this is recursively called.
+	bool low_priority = p_task->low_priority; // The task may be gone by the time it's done.
 
 	bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
 	CallQueue *call_queue_backup = MessageQueue::get_singleton() != MessageQueue::get_main_singleton() ? MessageQueue::get_singleton() : nullptr;
@@ -93,12 +94,15 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			if (work_index >= p_task->group->max) {
 				break;
 			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
+			{
+				ThreadArenaScope arena_scope;
+				if (p_task->native_group_func) {
+					p_task->native_group_func(p_task->native_func_userdata, work_index);
+				} else if (p_task->template_userdata) {
+					p_task->template_userdata->callback_indexed(work_index);
+				} else {
+					p_task->callable.call(work_index);
+				}
 			}
 
 			// This is the only way to ensure posting is done when all tasks are really complete.
@@ -114,31 +118,40 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
+			// Mark as completed and release dependents while the group is guaranteed alive,
+			// since it can't be reclaimed until the semaphore is posted.
+			LocalVector<Task *> process_inline;
+			task_mutex.lock();
 			p_task->group->completed.set_to(true);
+			_release_dependents(p_task->group->dependents, process_inline);
+			task_mutex.unlock();
+			p_task->group->done_semaphore.post();
+			for (Task *task : process_inline) {
+				_process_task(task);
+			}
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
+		task_mutex.lock();
 		if (finished_users == max_users) {
 			// Get rid of the group, because nobody else is using it.
-			task_mutex.lock();
 			group_allocator.free(p_task->group);
-			task_mutex.unlock();
 		}
 
 		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
 		task_allocator.free(p_task);
 	} else {
-		if (p_task->native_func) {
-			p_task->native_func(p_task->native_func_userdata);
-		} else if (p_task->template_userdata) {
-			p_task->template_userdata->callback();
-			memdelete(p_task->template_userdata);
-		} else {
-			p_task->callable.call();
+		{
+			ThreadArenaScope arena_scope;
+			if (p_task->native_func) {
+				p_task->native_func(p_task->native_func_userdata);
+			} else if (p_task->template_userdata) {
+				p_task->template_userdata->callback();
+				memdelete(p_task->template_userdata);
+			} else {
+				p_task->callable.call();
+			}
 		}
 
 		task_mutex.lock();
@@ -154,12 +167,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		// Let dependents run.
+		if (p_task->dependents.size()) {
+			LocalVector<Task *> process_inline;
+			_release_dependents(p_task->dependents, process_inline);
+			if (unlikely(process_inline.size())) {
+				task_mutex.unlock();
+				for (Task *task : process_inline) {
+					_process_task(task);
+				}
+				task_mutex.lock();
+			}
+		}
 	}
 
 #ifdef THREADS_ENABLED
 	{
 		curr_thread.current_task = prev_task;
-		if (p_task->low_priority) {
+		if (low_priority) {
 			low_priority_threads_used--;
 
 			if (_try_promote_low_priority_task()) {
@@ -180,18 +205,18 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: take work from the own queue, or steal it from others, without touching the global lock.
+		Task *task_to_process = singleton->_pop_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
 			}
 			thread_data->signaled = false;
 
-			if (singleton->task_queue.first()) {
-				task_to_process = singleton->task_queue.first()->self();
-				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			// Tasks are always pushed with the task mutex held, so checking again here can't miss any.
+			task_to_process = singleton->_pop_task(thread_data);
+			if (!task_to_process) {
 				thread_data->cond_var.wait(lock);
 				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
 			}
@@ -203,6 +228,46 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	}
 }
 
+void WorkerThreadPool::_push_task(Task *p_task) {
+	// Spread tasks across the work queues. Idle threads will steal from the others anyway,
+	// but this way they rarely contend for the same queue.
+	ThreadData &th = threads[push_index];
+	push_index = (push_index + 1) % threads.size();
+
+	MutexLock lock(th.work_mutex);
+	th.work_queue.add_last(&p_task->task_elem);
+	th.work_queue_size.increment();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_task(ThreadData *p_thread_data) {
+	// The thread's own queue is tried first. Then, work is stolen from the others.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &th = threads[(p_thread_data->index + i) % thread_count];
+		if (th.work_queue_size.get() == 0) {
+			continue;
+		}
+
+		MutexLock lock(th.work_mutex);
+		SelfList<Task> *E = th.work_queue.first();
+		if (E) {
+			th.work_queue.remove(E);
+			th.work_queue_size.decrement();
+			return E->self();
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_queued_tasks() const {
+	for (const ThreadData &th : threads) {
+		if (th.work_queue_size.get()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
@@ -216,6 +281,14 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 		return;
 	}
 
+	_post_tasks(p_tasks, p_count, p_high_priority);
+
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
+	DEV_ASSERT(threads.size());
+
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
@@ -224,7 +297,7 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			_push_task(p_tasks[i]);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -237,8 +310,6 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	}
 
 	_notify_threads(caller_pool_thread, to_process, to_promote);
-
-	task_mutex.unlock();
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -309,7 +380,7 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
+		_push_task(low_prio_task);
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -317,11 +388,55 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+bool WorkerThreadPool::_add_dependencies(Task **p_tasks, uint32_t p_count, const Vector<TaskID> &p_dependencies) {
+	bool pending = false;
+	for (const TaskID &dependency : p_dependencies) {
+		LocalVector<Task *> *dependents = nullptr;
+		if (Task **taskp = tasks.getptr(dependency)) {
+			if (!(*taskp)->completed) {
+				dependents = &(*taskp)->dependents;
+			}
+		} else if (Group **groupp = groups.getptr(dependency)) {
+			if (!(*groupp)->completed.is_set()) {
+				dependents = &(*groupp)->dependents;
+			}
+		} else {
+			// Tasks and groups are removed once they have been waited for, so there's no telling whether they ran at all.
+			ERR_CONTINUE_MSG(true, vformat("Invalid Task or Group ID as dependency: %d. It may have been waited for already.", dependency));
+		}
+
+		if (dependents) {
+			for (uint32_t i = 0; i < p_count; i++) {
+				p_tasks[i]->dependencies_pending++;
+				dependents->push_back(p_tasks[i]);
+			}
+			pending = true;
+		}
+	}
+	return pending;
+}
+
+void WorkerThreadPool::_release_dependents(LocalVector<Task *> &p_dependents, LocalVector<Task *> &r_process_inline) {
+	for (Task *dependent : p_dependents) {
+		DEV_ASSERT(dependent->dependencies_pending > 0);
+		dependent->dependencies_pending--;
+		if (dependent->dependencies_pending == 0) {
+			if (threads.size() == 0) {
+				// No worker threads, so the caller is expected to process it once the mutex is unlocked.
+				r_process_inline.push_back(dependent);
+			} else {
+				_post_tasks(&dependent, 1, !dependent->low_priority);
+			}
+		}
+	}
+	p_dependents.clear();
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -332,8 +447,15 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->low_priority = !p_high_priority;
 	tasks.insert(id, task);
 
+	if (_add_dependencies(&task, 1, p_dependencies)) {
+		// It will be posted as soon as the last dependency completes.
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -343,6 +465,14 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description);
 }
 
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_with_dependencies(void (*p_func)(void *), void *p_userdata, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::add_task_with_dependencies(const Callable &p_action, const Vector<TaskID> &p_dependencies, bool p_high_priority, const String &p_description) {
+	return _add_task(p_action, nullptr, nullptr, nullptr, p_high_priority, p_description, p_dependencies);
+}
+
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 	task_mutex.lock();
 	const Task *const *taskp = tasks.getptr(p_task_id);
@@ -468,7 +598,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = _has_queued_tasks() ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -487,10 +617,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
-					task_to_process = task_queue.first()->self();
-					task_queue.remove(task_queue.first());
-				}
+				task_to_process = _pop_task(p_caller_pool_thread);
 
 				if (!task_to_process) {
 					p_caller_pool_thread->awaited_task = p_task;
@@ -546,7 +673,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const Vector<TaskID> &p_dependencies) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -580,6 +707,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->low_priority = !p_high_priority;
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -587,6 +715,12 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (_add_dependencies(tasks_posted, p_tasks, p_dependencies)) {
+		// They will be posted as soon as the last dependency completes.
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -600,6 +734,14 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_act
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_with_dependencies(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
+WorkerThreadPool::GroupID WorkerThreadPool::add_group_task_with_dependencies(const Callable &p_action, int p_elements, const Vector<TaskID> &p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies);
+}
+
 uint32_t WorkerThreadPool::get_group_processed_element_count(GroupID p_group) const {
 	task_mutex.lock();
 	const Group *const *groupp = groups.getptr(p_group);
@@ -627,18 +769,23 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #ifdef THREADS_ENABLED
 	task_mutex.lock();
 	Group **groupp = groups.getptr(p_group);
+	Group *group = groupp ? *groupp : nullptr; // Read while locked, since the map may be modified by other threads.
 	task_mutex.unlock();
-	if (!groupp) {
+	if (!group) {
 		ERR_FAIL_MSG("Invalid Group ID.");
 	}
 
 	{
-		Group *group = *groupp;
 
 		_unlock_unlockable_mutexes();
 		group->done_semaphore.wait();
 		_lock_unlockable_mutexes();
 
+		// Forget about the group before it may be reclaimed, so it can't be found anymore (e.g., as a dependency).
+		task_mutex.lock();
+		groups.erase(p_group);
+		task_mutex.unlock();
+
 		uint32_t max_users = group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = group->finished.increment(); // fetch happens before inc, so increment later.
 
@@ -649,10 +796,6 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 			task_mutex.unlock();
 		}
 	}
-
-	task_mutex.lock(); // This mutex is needed when Physics 2D and/or 3D is selected to run on a separate thread.
-	groups.erase(p_group);
-	task_mutex.unlock();
 #endif
 }
 
@@ -743,20 +886,27 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		tasks.clear();
 	}
 
 	threads.clear();
+
+	// Ready to be initialized again.
+	thread_ids.clear();
+	exit_threads = false;
 }
 
 void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_task", "action", "high_priority", "description"), &WorkerThreadPool::add_task, DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_task_completed", "task_id"), &WorkerThreadPool::is_task_completed);
 	ClassDB::bind_method(D_METHOD("wait_for_task_completion", "task_id"), &WorkerThreadPool::wait_for_task_completion);
+	ClassDB::bind_method(D_METHOD("add_task_with_dependencies", "action", "dependencies", "high_priority", "description"), &WorkerThreadPool::add_task_with_dependencies, DEFVAL(false), DEFVAL(String()));
 
 	ClassDB::bind_method(D_METHOD("add_group_task", "action", "elements", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("is_group_task_completed", "group_id"), &WorkerThreadPool::is_group_task_completed);
 	ClassDB::bind_method(D_METHOD("get_group_processed_element_count", "group_id"), &WorkerThreadPool::get_group_processed_element_count);
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
+	ClassDB::bind_method(D_METHOD("add_group_task_with_dependencies", "action", "elements", "dependencies", "tasks_needed", "high_priority", "description"), &WorkerThreadPool::add_group_task_with_dependencies, DEFVAL(-1), DEFVAL(false), DEFVAL(String()));
 }
 
 WorkerThreadPool::WorkerThreadPool() {
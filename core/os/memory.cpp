@@ -35,6 +35,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 void *operator new(size_t p_size, const char *p_description) {
 	return Memory::alloc_static(p_size, false);
@@ -191,6 +192,253 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+struct ThreadArena::Chunk {
+	Chunk *prev = nullptr;
+	size_t size = 0;
+	size_t used = 0;
+
+	_FORCE_INLINE_ uint8_t *get_data() { return (uint8_t *)this + HEADER_SIZE; }
+
+	static constexpr size_t HEADER_SIZE = 2 * Memory::DATA_OFFSET; // Keeps the data aligned like regular allocations.
+};
+
+struct ThreadArenaState {
+	ThreadArena::Chunk *current = nullptr; // Chunk allocations come from. Older ones are linked through prev.
+	ThreadArena::Chunk *spare = nullptr; // Standard sized chunks kept for reuse, also linked through prev.
+	const ThreadArena::Mark *scope_mark = nullptr; // Where the innermost scope started.
+	uint32_t scope_depth = 0;
+	uint64_t allocation_count = 0;
+	uint64_t usage = 0;
+	uint64_t max_usage = 0;
+
+	static void free_chunks(ThreadArena::Chunk *p_list);
+
+	bool is_in_innermost_scope(const uint8_t *p_mem) const;
+
+	~ThreadArenaState() {
+		free_chunks(current);
+		free_chunks(spare);
+	}
+};
+
+static thread_local ThreadArenaState thread_arena;
+
+SafeNumeric<uint64_t> ThreadArena::reserved;
+
+// Put in the element count slot of allocations made with no scope open, which come from the heap.
+static constexpr uint64_t ARENA_HEAP_TAG = 0x48454150;
+
+static _FORCE_INLINE_ bool _arena_is_heap(void *p_memory) {
+	return *(uint64_t *)((uint8_t *)p_memory - Memory::DATA_OFFSET + Memory::ELEMENT_OFFSET) == ARENA_HEAP_TAG;
+}
+
+static void *_arena_heap_alloc(size_t p_bytes) {
+	uint8_t *mem = (uint8_t *)Memory::alloc_static(p_bytes, true);
+	ERR_FAIL_NULL_V(mem, nullptr);
+	*(uint64_t *)(mem - Memory::DATA_OFFSET + Memory::ELEMENT_OFFSET) = ARENA_HEAP_TAG;
+	return mem;
+}
+
+static _FORCE_INLINE_ size_t _arena_align(size_t p_bytes) {
+	return (p_bytes + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+}
+
+// Allocations from outer scopes must outlive the innermost one, which resets the arena to where
+// it started when it ends. So they can't be resized or given back in place.
+bool ThreadArenaState::is_in_innermost_scope(const uint8_t *p_mem) const {
+	if (!scope_mark) {
+		return true;
+	}
+	for (ThreadArena::Chunk *chunk = current; chunk; chunk = chunk->prev) {
+		bool in_chunk = p_mem >= chunk->get_data() && p_mem < chunk->get_data() + chunk->used;
+		if (chunk == scope_mark->chunk) {
+			return in_chunk && p_mem >= chunk->get_data() + scope_mark->used;
+		}
+		if (in_chunk) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadArenaState::free_chunks(ThreadArena::Chunk *p_list) {
+	while (p_list) {
+		ThreadArena::Chunk *prev = p_list->prev;
+		ThreadArena::reserved.sub(p_list->size);
+		Memory::free_static(p_list);
+		p_list = prev;
+	}
+}
+
+ThreadArena::Chunk *ThreadArena::_grow(size_t p_bytes) {
+	static_assert(sizeof(Chunk) <= Chunk::HEADER_SIZE);
+	ThreadArenaState &state = thread_arena;
+
+	Chunk *chunk = nullptr;
+	if (p_bytes <= CHUNK_SIZE && state.spare) {
+		chunk = state.spare;
+		state.spare = chunk->prev;
+	} else {
+		// Allocations that don't fit in a standard chunk get one of their own.
+		size_t size = MAX(p_bytes, CHUNK_SIZE);
+		chunk = memnew_placement(Memory::alloc_static(Chunk::HEADER_SIZE + size), Chunk);
+		chunk->size = size;
+		reserved.add(size);
+	}
+
+	chunk->used = 0;
+	chunk->prev = state.current;
+	state.current = chunk;
+	return chunk;
+}
+
+void *ThreadArena::alloc(size_t p_bytes) {
+	ThreadArenaState &state = thread_arena;
+	if (unlikely(state.scope_depth == 0)) {
+		return _arena_heap_alloc(p_bytes); // Nothing would ever release it from the arena.
+	}
+
+	// Same layout as padded heap allocations, so the size is known when reallocating.
+	size_t needed = Memory::DATA_OFFSET + _arena_align(p_bytes);
+	Chunk *chunk = state.current;
+	if (unlikely(!chunk || chunk->used + needed > chunk->size)) {
+		chunk = _grow(needed);
+	}
+
+	uint8_t *mem = chunk->get_data() + chunk->used;
+	chunk->used += needed;
+	*(uint64_t *)(mem + Memory::SIZE_OFFSET) = p_bytes;
+	*(uint64_t *)(mem + Memory::ELEMENT_OFFSET) = 0;
+
+	state.allocation_count++;
+	state.usage += needed;
+	state.max_usage = MAX(state.max_usage, state.usage);
+
+	return mem + Memory::DATA_OFFSET;
+}
+
+void *ThreadArena::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+	if (_arena_is_heap(p_memory)) {
+		return Memory::realloc_static(p_memory, p_bytes, true);
+	}
+
+	ThreadArenaState &state = thread_arena;
+	uint8_t *mem = (uint8_t *)p_memory - Memory::DATA_OFFSET;
+	uint64_t *s = (uint64_t *)(mem + Memory::SIZE_OFFSET);
+	size_t old_bytes = *s;
+
+	if (unlikely(!state.is_in_innermost_scope(mem))) {
+		// Moving it to the innermost scope would release it too early.
+		void *new_memory = _arena_heap_alloc(p_bytes);
+		ERR_FAIL_NULL_V(new_memory, nullptr);
+		memcpy(new_memory, p_memory, MIN(old_bytes, p_bytes));
+		return new_memory;
+	}
+
+	Chunk *chunk = state.current;
+	if (chunk && (uint8_t *)p_memory + _arena_align(old_bytes) == chunk->get_data() + chunk->used) {
+		// Most recent allocation, so it can be resized in place if it fits.
+		size_t new_used = chunk->used - _arena_align(old_bytes) + _arena_align(p_bytes);
+		if (new_used <= chunk->size) {
+			state.usage = state.usage - chunk->used + new_used;
+			state.max_usage = MAX(state.max_usage, state.usage);
+			chunk->used = new_used;
+			*s = p_bytes;
+			return p_memory;
+		}
+	}
+
+	void *new_memory = alloc(p_bytes);
+	memcpy(new_memory, p_memory, MIN(old_bytes, p_bytes));
+	free(p_memory);
+	return new_memory;
+}
+
+void ThreadArena::free(void *p_ptr) {
+	ERR_FAIL_NULL(p_ptr);
+	if (_arena_is_heap(p_ptr)) {
+		Memory::free_static(p_ptr, true);
+		return;
+	}
+
+	ThreadArenaState &state = thread_arena;
+	uint8_t *mem = (uint8_t *)p_ptr - Memory::DATA_OFFSET;
+	size_t size = Memory::DATA_OFFSET + _arena_align(*(uint64_t *)(mem + Memory::SIZE_OFFSET));
+
+	// Only the most recent allocation can be given back right away. The rest waits for the scope to end.
+	Chunk *chunk = state.current;
+	if (chunk && mem + size == chunk->get_data() + chunk->used && state.is_in_innermost_scope(mem)) {
+		chunk->used -= size;
+		state.usage -= size;
+	}
+}
+
+bool ThreadArena::is_in_scope() {
+	return thread_arena.scope_depth > 0;
+}
+
+uint64_t ThreadArena::get_allocation_count() {
+	return thread_arena.allocation_count;
+}
+
+uint64_t ThreadArena::get_usage() {
+	return thread_arena.usage;
+}
+
+uint64_t ThreadArena::get_max_usage() {
+	return thread_arena.max_usage;
+}
+
+ThreadArena::Mark ThreadArena::_get_mark() {
+	ThreadArenaState &state = thread_arena;
+	Mark mark;
+	mark.chunk = state.current;
+	mark.used = state.current ? state.current->used : 0;
+	mark.usage = state.usage;
+	return mark;
+}
+
+void ThreadArena::_reset_to_mark(const Mark &p_mark) {
+	ThreadArenaState &state = thread_arena;
+	while (state.current != p_mark.chunk) {
+		Chunk *chunk = state.current;
+		state.current = chunk->prev;
+		if (chunk->size == CHUNK_SIZE) {
+			chunk->prev = state.spare;
+			state.spare = chunk;
+		} else {
+			reserved.sub(chunk->size);
+			Memory::free_static(chunk);
+		}
+	}
+
+	if (state.current) {
+		DEV_ASSERT(state.current->used >= p_mark.used);
+		state.current->used = p_mark.used;
+	}
+	state.usage = p_mark.usage;
+}
+
+ThreadArenaScope::ThreadArenaScope() {
+	mark = ThreadArena::_get_mark();
+	outer_mark = thread_arena.scope_mark;
+	thread_arena.scope_mark = &mark;
+	thread_arena.scope_depth++;
+}
+
+ThreadArenaScope::~ThreadArenaScope() {
+	thread_arena.scope_depth--;
+	thread_arena.scope_mark = outer_mark;
+	ThreadArena::_reset_to_mark(mark);
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
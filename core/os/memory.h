@@ -70,9 +70,72 @@ public:
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_memory, size_t p_bytes) { return Memory::realloc_static(p_memory, p_bytes, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+// Thread-local bump allocator for short-lived data (e.g., per-frame or per-task work lists).
+// Allocating is just moving a pointer forward, and nothing is really given back until the
+// innermost ThreadArenaScope of the thread ends, which releases everything allocated since
+// it started at once. Freeing or reallocating the most recent allocation is done in place.
+// Allocations made with no scope open, or reallocated in a scope nested in the one they were
+// made in, come from the heap instead.
+// Memory from the arena must never outlive the scope it was allocated in, nor be used from
+// another thread after that. The main loop and the worker thread pool open a scope for every
+// frame and task, respectively.
+class ThreadArena {
+	friend class ThreadArenaScope;
+	friend struct ThreadArenaState;
+
+	struct Chunk;
+
+	struct Mark {
+		Chunk *chunk = nullptr;
+		size_t used = 0;
+		uint64_t usage = 0;
+	};
+
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+	static SafeNumeric<uint64_t> reserved;
+
+	static Chunk *_grow(size_t p_bytes);
+	static Mark _get_mark();
+	static void _reset_to_mark(const Mark &p_mark);
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	static bool is_in_scope(); // Whether the current thread has any arena scope open.
+
+	// Statistics for the current thread.
+	static uint64_t get_allocation_count();
+	static uint64_t get_usage();
+	static uint64_t get_max_usage();
+
+	// Memory reserved by the arenas of all threads.
+	static uint64_t get_reserved() { return reserved.get(); }
+};
+
+class ThreadArenaScope {
+	ThreadArena::Mark mark;
+	const ThreadArena::Mark *outer_mark = nullptr;
+
+public:
+	ThreadArenaScope();
+	~ThreadArenaScope();
+};
+
+// Allocator for containers that can take one, like LocalVector.
+class ThreadArenaAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return ThreadArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_memory, size_t p_bytes) { return ThreadArena::realloc(p_memory, p_bytes); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { ThreadArena::free(p_ptr); }
+};
+
 void *operator new(size_t p_size, const char *p_description); ///< operator new that takes a description and uses MemoryStaticPool
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)); ///< operator new that takes a description and uses MemoryStaticPool
 
@@ -221,4 +284,18 @@ public:
 	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete(p_allocation); }
 };
 
+// Typed allocator for containers that can take one, like the elements of HashMap.
+template <typename T>
+class ThreadArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_placement(ThreadArena::alloc(sizeof(T)), T(p_args...)); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) {
+		if constexpr (!std::is_trivially_destructible_v<T>) {
+			p_allocation->~T();
+		}
+		ThreadArena::free(p_allocation);
+	}
+};
+
 #endif // MEMORY_H
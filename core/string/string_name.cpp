@@ -39,7 +39,9 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+std::atomic<StringName::_Table *> StringName::table = { nullptr };
+StringName::_Data *StringName::free_list = nullptr;
+uint32_t StringName::data_count = 0;
 
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
@@ -52,25 +54,166 @@ Mutex StringName::mutex;
 bool StringName::debug_stringname = false;
 #endif
 
+StringName::_Table *StringName::_create_table(uint32_t p_size) {
+	_Table *new_table = memnew(_Table);
+	new_table->mask = p_size - 1;
+	new_table->buckets = memnew_arr(std::atomic<_Data *>, p_size);
+	for (uint32_t i = 0; i < p_size; i++) {
+		new_table->buckets[i].store(nullptr, std::memory_order_relaxed);
+	}
+	return new_table;
+}
+
+void StringName::_grow_table() {
+	// Called with the mutex held. Entries are moved over one by one, so a
+	// lookup walking the old table may be redirected into the new one.
+	_Table *old_table = table.load(std::memory_order_relaxed);
+	_Table *new_table = _create_table((old_table->mask + 1) * 2);
+
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+		_Data *data = old_table->buckets[i].load(std::memory_order_relaxed);
+		while (data) {
+			_Data *next = data->next.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = new_table->buckets[data->hash.load(std::memory_order_relaxed) & new_table->mask];
+			data->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_release);
+			bucket.store(data, std::memory_order_relaxed);
+			data = next;
+		}
+	}
+
+	new_table->retired = old_table;
+	table.store(new_table, std::memory_order_release);
+}
+
+StringName::_Data *StringName::_insert_data(uint32_t p_hash, const String &p_name, const char *p_cname, bool p_static) {
+	// Called with the mutex held.
+	_Data *data = free_list;
+	if (data) {
+		free_list = data->next.load(std::memory_order_relaxed);
+	} else {
+		data = memnew(_Data);
+	}
+
+	data->name = p_name;
+	data->cname = p_cname;
+	data->hash.store(p_hash, std::memory_order_relaxed);
+	data->static_count.set(p_static ? 1 : 0);
+#ifdef DEBUG_ENABLED
+	data->debug_references.set(0);
+#endif
+	// Initializing the reference count publishes the fields above to lookups
+	// which may still reach this entry from its previous use.
+	data->refcount.init();
+
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		data->refcount.ref();
+		data->static_count.increment();
+	}
+#endif
+
+	if (data_count++ > table.load(std::memory_order_relaxed)->mask) {
+		_grow_table();
+	}
+
+	_Table *current_table = table.load(std::memory_order_relaxed);
+	std::atomic<_Data *> &bucket = current_table->buckets[p_hash & current_table->mask];
+	data->next.store(bucket.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	bucket.store(data, std::memory_order_release);
+
+	return data;
+}
+
+void StringName::_release_data(_Data *p_data) {
+	MutexLock lock(mutex);
+
+	if (CoreGlobals::leak_reporting_enabled && p_data->static_count.get() > 0) {
+		if (p_data->cname) {
+			ERR_PRINT("BUG: Unreferenced static string to 0: " + String(p_data->cname));
+		} else {
+			ERR_PRINT("BUG: Unreferenced static string to 0: " + String(p_data->name));
+		}
+	}
+
+	_Table *current_table = table.load(std::memory_order_relaxed);
+	std::atomic<_Data *> *link = &current_table->buckets[p_data->hash.load(std::memory_order_relaxed) & current_table->mask];
+	while (link->load(std::memory_order_relaxed) != p_data) {
+		_Data *data = link->load(std::memory_order_relaxed);
+		ERR_FAIL_NULL_MSG(data, "BUG: Released StringName is not in the table.");
+		link = &data->next;
+	}
+	// The entry keeps its own next pointer, so lookups currently on it can carry on.
+	link->store(p_data->next.load(std::memory_order_relaxed), std::memory_order_release);
+	data_count--;
+
+	// Entries are recycled rather than freed, see _Table.
+	p_data->name = String();
+	p_data->cname = nullptr;
+	p_data->next.store(free_list, std::memory_order_relaxed);
+	free_list = p_data;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_and_ref(uint32_t p_hash, const T &p_name) {
+	const _Table *current_table = table.load(std::memory_order_acquire);
+	_Data *data = current_table->buckets[p_hash & current_table->mask].load(std::memory_order_acquire);
+
+	while (data) {
+		// compare hash first
+		if (data->hash.load(std::memory_order_relaxed) == p_hash && data->refcount.ref()) {
+			// Once referenced, the entry can't be recycled while comparing.
+			if (data->hash.load(std::memory_order_relaxed) == p_hash && data->get_name() == p_name) {
+				return data;
+			}
+			if (data->refcount.unref()) {
+				_release_data(data);
+				return nullptr; // Let the caller retry with the mutex held.
+			}
+		}
+		data = data->next.load(std::memory_order_acquire);
+	}
+
+	// May be a false negative if the entries were moved or recycled meanwhile.
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_and_ref_locked(uint32_t p_hash, const T &p_name) {
+	const _Table *current_table = table.load(std::memory_order_relaxed);
+	_Data *data = current_table->buckets[p_hash & current_table->mask].load(std::memory_order_relaxed);
+
+	while (data) {
+		// Entries that already dropped to zero references are skipped, they are
+		// about to be released.
+		if (data->hash.load(std::memory_order_relaxed) == p_hash && data->get_name() == p_name && data->refcount.ref()) {
+			return data;
+		}
+		data = data->next.load(std::memory_order_relaxed);
+	}
+
+	return nullptr;
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
-	}
+	table.store(_create_table(STRING_TABLE_LEN), std::memory_order_release);
 	configured = true;
 }
 
 void StringName::cleanup() {
 	MutexLock lock(mutex);
 
+	_Table *current_table = table.load(std::memory_order_relaxed);
+
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+		for (uint32_t i = 0; i <= current_table->mask; i++) {
+			_Data *d = current_table->buckets[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -80,10 +223,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -93,9 +236,9 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+	for (uint32_t i = 0; i <= current_table->mask; i++) {
+		_Data *d = current_table->buckets[i].load(std::memory_order_relaxed);
+		while (d) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -106,13 +249,29 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_Data *next = d->next.load(std::memory_order_relaxed);
 			memdelete(d);
+			d = next;
 		}
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
+
+	while (free_list) {
+		_Data *next = free_list->next.load(std::memory_order_relaxed);
+		memdelete(free_list);
+		free_list = next;
+	}
+	while (current_table) {
+		_Table *retired = current_table->retired;
+		memdelete_arr(current_table->buckets);
+		memdelete(current_table);
+		current_table = retired;
+	}
+	table.store(nullptr, std::memory_order_relaxed);
+	data_count = 0;
+
 	configured = false;
 }
 
@@ -120,28 +279,7 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
-
-		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
-			if (_data->cname) {
-				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->cname));
-			} else {
-				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
-			}
-		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			if (_table[_data->idx] != _data) {
-				ERR_PRINT("BUG!");
-			}
-			_table[_data->idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		memdelete(_data);
+		_release_data(_data);
 	}
 
 	_data = nullptr;
@@ -216,56 +354,29 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_data = _find_and_ref(hash, p_name);
 
-	_data = _table[idx];
+	if (!_data) {
+		MutexLock lock(mutex);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
+		_data = _find_and_ref_locked(hash, p_name);
+		if (!_data) {
+			_data = _insert_data(hash, p_name, nullptr, p_static);
+			return;
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
+	// exists
+	if (p_static) {
+		_data->static_count.increment();
 	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		_data->debug_references.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -275,55 +386,29 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_data = _find_and_ref(hash, p_static_string.ptr);
 
-	_data = _table[idx];
+	if (!_data) {
+		MutexLock lock(mutex);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
+		_data = _find_and_ref_locked(hash, p_static_string.ptr);
+		if (!_data) {
+			_data = _insert_data(hash, String(), p_static_string.ptr, p_static);
+			return;
 		}
-		_data = _data->next;
 	}
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
+	// exists
+	if (p_static) {
+		_data->static_count.increment();
 	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		_data->debug_references.increment();
 	}
 #endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -335,54 +420,29 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_data = _table[idx];
+	_data = _find_and_ref(hash, p_name);
 
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(mutex);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+		_data = _find_and_ref_locked(hash, p_name);
+		if (!_data) {
+			_data = _insert_data(hash, p_name, nullptr, p_static);
+			return;
 		}
-#endif
-		return;
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
+	// exists
+	if (p_static) {
+		_data->static_count.increment();
+	}
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
+		_data->debug_references.increment();
 	}
 #endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName StringName::search(const char *p_name) {
@@ -393,25 +453,19 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_Data *_data = _table[idx];
+	_Data *_data = _find_and_ref(hash, p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
+	if (!_data) {
+		MutexLock lock(mutex);
+		_data = _find_and_ref_locked(hash, p_name);
 	}
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 
@@ -429,23 +483,16 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Data *_data = _find_and_ref(hash, p_name);
 
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
+	if (!_data) {
+		MutexLock lock(mutex);
+		_data = _find_and_ref_locked(hash, p_name);
 	}
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 		return StringName(_data);
 	}
 
@@ -455,26 +502,19 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
+	_Data *_data = _find_and_ref(hash, p_name);
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
+	if (!_data) {
+		MutexLock lock(mutex);
+		_data = _find_and_ref_locked(hash, p_name);
 	}
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 		return StringName(_data);
@@ -47,8 +47,7 @@ struct StaticCString {
 class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS, // Initial bucket count, the table grows when it's exceeded.
 	};
 
 	struct _Data {
@@ -57,17 +56,36 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx = 0;
-		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		std::atomic<uint32_t> hash = { 0 };
+		std::atomic<_Data *> next = { nullptr };
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	// Lookups walk the buckets without locking. Entries are only linked,
+	// unlinked and recycled with the mutex held, and are never freed before
+	// cleanup, so a concurrent lookup can at worst miss (and then retry with
+	// the mutex held), but never reads freed memory.
+	struct _Table {
+		uint32_t mask = 0;
+		std::atomic<_Data *> *buckets = nullptr;
+		_Table *retired = nullptr; // Smaller tables replaced by a resize.
+	};
+
+	static std::atomic<_Table *> table;
+	static _Data *free_list;
+	static uint32_t data_count;
+
+	static _Table *_create_table(uint32_t p_size);
+	static void _grow_table();
+	static _Data *_insert_data(uint32_t p_hash, const String &p_name, const char *p_cname, bool p_static);
+	static void _release_data(_Data *p_data);
+	template <typename T>
+	static _Data *_find_and_ref(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_find_and_ref_locked(uint32_t p_hash, const T &p_name);
 
 	_Data *_data = nullptr;
 
@@ -82,7 +100,7 @@ class StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
@@ -128,7 +146,7 @@ public:
 	}
 	_FORCE_INLINE_ uint32_t hash() const {
 		if (_data) {
-			return _data->hash;
+			return _data->hash.load(std::memory_order_relaxed);
 		} else {
 			return 0;
 		}
@@ -178,6 +196,10 @@ public:
 	void operator=(const StringName &p_name);
 	StringName(const char *p_name, bool p_static = false);
 	StringName(const StringName &p_name);
+	_FORCE_INLINE_ StringName(StringName &&p_name) {
+		_data = p_name._data;
+		p_name._data = nullptr;
+	}
 	StringName(const String &p_name, bool p_static = false);
 	StringName(const StaticCString &p_static_string, bool p_static = false);
 	StringName() {}
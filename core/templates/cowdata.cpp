@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  cowdata.cpp                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "cowdata.h"
+
+#ifdef DEV_ENABLED
+
+#include "core/string/print_string.h"
+#include "core/templates/sort_array.h"
+
+#include <atomic>
+
+namespace {
+
+// Fixed size open addressing table, so recording never allocates and is safe
+// to call from any thread, including while the memory allocator is in use.
+constexpr uint32_t COPY_SITE_MAX = 1024;
+
+struct CopySite {
+	std::atomic<const void *> site = { nullptr };
+	std::atomic<const char *> type = { nullptr };
+	std::atomic<uint64_t> copies = { 0 };
+	std::atomic<uint64_t> bytes = { 0 };
+};
+
+CopySite copy_sites[COPY_SITE_MAX];
+std::atomic<uint64_t> total_copies = { 0 };
+std::atomic<uint64_t> dropped_copies = { 0 };
+
+struct CopySiteSnapshot {
+	const void *site = nullptr;
+	const char *type = nullptr;
+	uint64_t copies = 0;
+	uint64_t bytes = 0;
+
+	bool operator<(const CopySiteSnapshot &p_other) const {
+		return bytes > p_other.bytes;
+	}
+};
+
+} // namespace
+
+void CowDataCopyStats::record(const void *p_call_site, const char *p_type, uint64_t p_bytes) {
+	total_copies.fetch_add(1, std::memory_order_relaxed);
+
+	uint32_t index = uint32_t((uintptr_t(p_call_site) >> 2) * 2654435761u) % COPY_SITE_MAX;
+	for (uint32_t i = 0; i < COPY_SITE_MAX; i++) {
+		CopySite &entry = copy_sites[index];
+		const void *current = entry.site.load(std::memory_order_acquire);
+		if (current == nullptr) {
+			if (entry.site.compare_exchange_strong(current, p_call_site, std::memory_order_acq_rel)) {
+				entry.type.store(p_type, std::memory_order_release);
+				current = p_call_site;
+			}
+		}
+		if (current == p_call_site) {
+			entry.copies.fetch_add(1, std::memory_order_relaxed);
+			entry.bytes.fetch_add(p_bytes, std::memory_order_relaxed);
+			return;
+		}
+		index = (index + 1) % COPY_SITE_MAX;
+	}
+
+	dropped_copies.fetch_add(1, std::memory_order_relaxed);
+}
+
+void CowDataCopyStats::print(uint32_t p_max_sites) {
+	CopySiteSnapshot snapshot[COPY_SITE_MAX];
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < COPY_SITE_MAX; i++) {
+		const void *site = copy_sites[i].site.load(std::memory_order_acquire);
+		if (site == nullptr || copy_sites[i].copies.load(std::memory_order_relaxed) == 0) {
+			continue;
+		}
+		CopySiteSnapshot &entry = snapshot[count++];
+		entry.site = site;
+		entry.type = copy_sites[i].type.load(std::memory_order_acquire);
+		entry.copies = copy_sites[i].copies.load(std::memory_order_relaxed);
+		entry.bytes = copy_sites[i].bytes.load(std::memory_order_relaxed);
+	}
+
+	if (count == 0) {
+		return;
+	}
+
+	SortArray<CopySiteSnapshot> sorter;
+	sorter.sort(snapshot, count);
+
+	print_line(vformat("Copy-on-write copies: %d total, %d call sites.", total_copies.load(), count));
+	for (uint32_t i = 0; i < MIN(count, p_max_sites); i++) {
+		const CopySiteSnapshot &entry = snapshot[i];
+		print_line(vformat("  %s: %d copies, %s bytes, %s", String::num_uint64(uint64_t(entry.site), 16), entry.copies, String::num_uint64(entry.bytes), entry.type ? entry.type : "?"));
+	}
+	if (dropped_copies.load() > 0) {
+		print_line(vformat("  (%d copies from call sites that did not fit in the table)", dropped_copies.load()));
+	}
+}
+
+void CowDataCopyStats::clear() {
+	for (uint32_t i = 0; i < COPY_SITE_MAX; i++) {
+		copy_sites[i].copies.store(0, std::memory_order_relaxed);
+		copy_sites[i].bytes.store(0, std::memory_order_relaxed);
+	}
+	total_copies.store(0);
+	dropped_copies.store(0);
+}
+
+const void *CowDataCopyStats::get_call_site() {
+	return COWDATA_CALL_SITE;
+}
+
+uint64_t CowDataCopyStats::get_total_copies() {
+	return total_copies.load();
+}
+
+#endif // DEV_ENABLED
@@ -48,6 +48,37 @@ class VMap;
 
 static_assert(std::is_trivially_destructible_v<std::atomic<uint64_t>>);
 
+#ifdef DEV_ENABLED
+// Tracks which call sites trigger copy-on-write duplications, to help finding
+// accidental copies of shared buffers. Sites are recorded as code addresses
+// (resolve them with `addr2line -i`) along with the element type.
+// Writes through the inlined accessors (ptrw(), set(), operator[]...) are recorded
+// where they were inlined into, and resizes where resize() was called from. So sites
+// point to the user code only when forced inlining is enabled. Otherwise, they point
+// to the container wrappers.
+class CowDataCopyStats {
+public:
+	static void record(const void *p_call_site, const char *p_type, uint64_t p_bytes);
+	// Returns the address it was called from. It's never inlined, so when called from
+	// inlined code, that's an address within the function the code was inlined into.
+	static _NO_INLINE_ const void *get_call_site();
+	static void print(uint32_t p_max_sites = 16);
+	static void clear();
+	static uint64_t get_total_copies();
+};
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define COWDATA_CALL_SITE _ReturnAddress()
+#define COWDATA_FUNCTION_NAME __FUNCSIG__
+#else
+#define COWDATA_CALL_SITE __builtin_return_address(0)
+#define COWDATA_FUNCTION_NAME __PRETTY_FUNCTION__
+#endif
+#else
+#define COWDATA_CALL_SITE nullptr
+#endif // DEV_ENABLED
+
 // Silence a false positive warning (see GH-52119).
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
@@ -163,10 +194,32 @@ private:
 	void _unref(void *p_data);
 	void _ref(const CowData *p_from);
 	void _ref(const CowData &p_from);
-	USize _copy_on_write();
+	// Writers that aren't inlined pass where they were called from.
+	_ALWAYS_INLINE_ USize _copy_on_write(const void *p_call_site = nullptr) {
+		if (!_ptr) {
+			return 0;
+		}
+		USize rc = _get_refcount()->get();
+		if (unlikely(rc > 1)) {
+#ifdef DEV_ENABLED
+			CowDataCopyStats::record(p_call_site ? p_call_site : CowDataCopyStats::get_call_site(), COWDATA_FUNCTION_NAME, uint64_t(*_get_size()) * sizeof(T));
+#endif
+			rc = _copy_shared();
+		}
+		return rc;
+	}
+	_NO_INLINE_ USize _copy_shared();
 
 public:
 	void operator=(const CowData<T> &p_from) { _ref(p_from); }
+	void operator=(CowData<T> &&p_from) {
+		if (_ptr == p_from._ptr) {
+			return;
+		}
+		_unref(_ptr);
+		_ptr = p_from._ptr;
+		p_from._ptr = nullptr;
+	}
 
 	_FORCE_INLINE_ T *ptrw() {
 		_copy_on_write();
@@ -239,6 +292,10 @@ public:
 	_FORCE_INLINE_ CowData() {}
 	_FORCE_INLINE_ ~CowData();
 	_FORCE_INLINE_ CowData(CowData<T> &p_from) { _ref(p_from); };
+	_FORCE_INLINE_ CowData(CowData<T> &&p_from) {
+		_ptr = p_from._ptr;
+		p_from._ptr = nullptr;
+	}
 };
 
 template <typename T>
@@ -269,43 +326,33 @@ void CowData<T>::_unref(void *p_data) {
 }
 
 template <typename T>
-typename CowData<T>::USize CowData<T>::_copy_on_write() {
-	if (!_ptr) {
-		return 0;
-	}
-
-	SafeNumeric<USize> *refc = _get_refcount();
-
-	USize rc = refc->get();
-	if (unlikely(rc > 1)) {
-		/* in use by more than me */
-		USize current_size = *_get_size();
-
-		uint8_t *mem_new = (uint8_t *)Memory::alloc_static(_get_alloc_size(current_size) + DATA_OFFSET, false);
-		ERR_FAIL_NULL_V(mem_new, 0);
-
-		SafeNumeric<USize> *_refc_ptr = _get_refcount_ptr(mem_new);
-		USize *_size_ptr = _get_size_ptr(mem_new);
-		T *_data_ptr = _get_data_ptr(mem_new);
-
-		new (_refc_ptr) SafeNumeric<USize>(1); //refcount
-		*(_size_ptr) = current_size; //size
-
-		// initialize new elements
-		if constexpr (std::is_trivially_copyable_v<T>) {
-			memcpy((uint8_t *)_data_ptr, _ptr, current_size * sizeof(T));
-		} else {
-			for (USize i = 0; i < current_size; i++) {
-				memnew_placement(&_data_ptr[i], T(_ptr[i]));
-			}
+typename CowData<T>::USize CowData<T>::_copy_shared() {
+	/* in use by more than me */
+	USize current_size = *_get_size();
+
+	uint8_t *mem_new = (uint8_t *)Memory::alloc_static(_get_alloc_size(current_size) + DATA_OFFSET, false);
+	ERR_FAIL_NULL_V(mem_new, 0);
+
+	SafeNumeric<USize> *_refc_ptr = _get_refcount_ptr(mem_new);
+	USize *_size_ptr = _get_size_ptr(mem_new);
+	T *_data_ptr = _get_data_ptr(mem_new);
+
+	new (_refc_ptr) SafeNumeric<USize>(1); //refcount
+	*(_size_ptr) = current_size; //size
+
+	// initialize new elements
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		memcpy((uint8_t *)_data_ptr, _ptr, current_size * sizeof(T));
+	} else {
+		for (USize i = 0; i < current_size; i++) {
+			memnew_placement(&_data_ptr[i], T(_ptr[i]));
 		}
+	}
 
-		_unref(_ptr);
-		_ptr = _data_ptr;
+	_unref(_ptr);
+	_ptr = _data_ptr;
 
-		rc = 1;
-	}
-	return rc;
+	return 1;
 }
 
 template <typename T>
@@ -327,7 +374,7 @@ Error CowData<T>::resize(Size p_size) {
 	}
 
 	// possibly changing size, copy on write
-	USize rc = _copy_on_write();
+	USize rc = _copy_on_write(COWDATA_CALL_SITE);
 
 	USize current_alloc_size = _get_alloc_size(current_size);
 	USize alloc_size;
@@ -0,0 +1,599 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FLAT_HASH_MAP_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FLAT_HASH_MAP_NEON
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * A HashMap implementation that stores keys and values inline in a single
+ * open-addressed array (a "Swiss table").
+ *
+ * A parallel array of control bytes holds 7 bits of the hash of each full slot
+ * (or an empty / deleted marker). Lookups probe groups of 16 control bytes at
+ * once, using SSE2 or NEON where available, and only compare keys whose stored
+ * hash bits match. Deleted slots are marked with a tombstone which is cleaned
+ * up on the next rehash.
+ *
+ * Like HashMap, elements are iterated in insertion order, as full slots are
+ * also linked in a list. Unlike HashMap, pointers to values are invalidated by
+ * insertions. Use it where lookups dominate.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class FlatHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = 16;
+	static constexpr uint32_t MIN_CAPACITY = GROUP_SIZE;
+
+private:
+	static constexpr uint8_t CTRL_EMPTY = 0x80;
+	static constexpr uint8_t CTRL_DELETED = 0xFE;
+	static constexpr uint32_t INVALID_POS = 0xFFFFFFFF;
+
+	typedef KeyValue<TKey, TValue> Slot;
+
+	// Neighbors of a full slot in insertion order.
+	struct Link {
+		uint32_t prev = INVALID_POS;
+		uint32_t next = INVALID_POS;
+	};
+
+	// Bitmask with one bit set per matching slot of a group.
+	struct BitMask {
+		uint32_t mask = 0;
+
+		_FORCE_INLINE_ explicit operator bool() const { return mask != 0; }
+		_FORCE_INLINE_ uint32_t lowest() const {
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return index;
+#else
+			return __builtin_ctz(mask);
+#endif
+		}
+		_FORCE_INLINE_ uint32_t leading_zeros() const {
+			// Counted from the top of the 16 bit group mask.
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanReverse(&index, mask);
+			return GROUP_SIZE - 1 - index;
+#else
+			return __builtin_clz(mask) - (32 - GROUP_SIZE);
+#endif
+		}
+		_FORCE_INLINE_ void clear_lowest() { mask &= mask - 1; }
+	};
+
+	// Sixteen consecutive control bytes.
+	struct Group {
+#if defined(FLAT_HASH_MAP_SSE2)
+		__m128i ctrl;
+
+		_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) {
+			ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+		}
+		_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+			return BitMask{ uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(p_h2))))) };
+		}
+		_FORCE_INLINE_ BitMask match_empty() const {
+			return BitMask{ uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(char(CTRL_EMPTY))))) };
+		}
+		_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+			// Full slots have the high bit clear.
+			return BitMask{ uint32_t(_mm_movemask_epi8(ctrl)) };
+		}
+#elif defined(FLAT_HASH_MAP_NEON)
+		uint8x16_t ctrl;
+
+		static _FORCE_INLINE_ uint32_t _movemask(uint8x16_t p_cmp) {
+			// Narrow every byte of the comparison result to a single bit.
+			static const uint8_t bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+			uint8x16_t masked = vandq_u8(p_cmp, vld1q_u8(bits));
+			uint32_t lo = vaddv_u8(vget_low_u8(masked));
+			uint32_t hi = vaddv_u8(vget_high_u8(masked));
+			return lo | (hi << 8);
+		}
+
+		_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) {
+			ctrl = vld1q_u8(p_ctrl);
+		}
+		_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+			return BitMask{ _movemask(vceqq_u8(ctrl, vdupq_n_u8(p_h2))) };
+		}
+		_FORCE_INLINE_ BitMask match_empty() const {
+			return BitMask{ _movemask(vceqq_u8(ctrl, vdupq_n_u8(CTRL_EMPTY))) };
+		}
+		_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+			return BitMask{ _movemask(vcgeq_u8(ctrl, vdupq_n_u8(0x80))) };
+		}
+#else
+		const uint8_t *ctrl = nullptr;
+
+		_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) {
+			ctrl = p_ctrl;
+		}
+		_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= uint32_t(ctrl[i] == p_h2) << i;
+			}
+			return BitMask{ mask };
+		}
+		_FORCE_INLINE_ BitMask match_empty() const {
+			return match(CTRL_EMPTY);
+		}
+		_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < GROUP_SIZE; i++) {
+				mask |= uint32_t(ctrl[i] >> 7) << i;
+			}
+			return BitMask{ mask };
+		}
+#endif
+	};
+
+	// Control bytes, `capacity + GROUP_SIZE` of them. The last group mirrors
+	// the first one, so a group can be loaded at any position without wrapping.
+	uint8_t *ctrl = nullptr;
+	Slot *slots = nullptr;
+	Link *links = nullptr;
+	uint32_t head = INVALID_POS;
+	uint32_t tail = INVALID_POS;
+
+	uint32_t capacity = 0; // Zero or a power of two.
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can still be filled before rehashing.
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		// Mix the hash, the low bits go to the control byte and the high bits
+		// select the starting group, so both need to be well distributed.
+		return hash_fmix32(Hasher::hash(p_key));
+	}
+
+	static _FORCE_INLINE_ uint8_t _h2(uint32_t p_hash) {
+		return p_hash & 0x7F;
+	}
+
+	static _FORCE_INLINE_ uint32_t _max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	_FORCE_INLINE_ void _link(uint32_t p_pos) {
+		links[p_pos].prev = tail;
+		links[p_pos].next = INVALID_POS;
+		if (tail != INVALID_POS) {
+			links[tail].next = p_pos;
+		} else {
+			head = p_pos;
+		}
+		tail = p_pos;
+	}
+
+	_FORCE_INLINE_ void _unlink(uint32_t p_pos) {
+		const Link &link = links[p_pos];
+		if (link.prev != INVALID_POS) {
+			links[link.prev].next = link.next;
+		} else {
+			head = link.next;
+		}
+		if (link.next != INVALID_POS) {
+			links[link.next].prev = link.prev;
+		} else {
+			tail = link.prev;
+		}
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_pos, uint8_t p_value) {
+		ctrl[p_pos] = p_value;
+		// Keep the mirrored tail in sync.
+		ctrl[((p_pos - GROUP_SIZE) & (capacity - 1)) + GROUP_SIZE] = p_value;
+	}
+
+	uint32_t _lookup_pos(const TKey &p_key) const {
+		if (num_elements == 0) {
+			return INVALID_POS;
+		}
+
+		const uint32_t mask = capacity - 1;
+		const uint32_t hash = _hash(p_key);
+		const uint8_t h2 = _h2(hash);
+		uint32_t pos = (hash >> 7) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			Group group(ctrl + pos);
+			for (BitMask match = group.match(h2); match; match.clear_lowest()) {
+				uint32_t candidate = (pos + match.lowest()) & mask;
+				if (Comparator::compare(slots[candidate].key, p_key)) {
+					return candidate;
+				}
+			}
+			if (group.match_empty()) {
+				return INVALID_POS;
+			}
+			// Triangular probing visits every group when the group count is a power of two.
+			step += GROUP_SIZE;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_insert_pos(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = (p_hash >> 7) & mask;
+		uint32_t step = 0;
+
+		while (true) {
+			BitMask match = Group(ctrl + pos).match_empty_or_deleted();
+			if (match) {
+				return (pos + match.lowest()) & mask;
+			}
+			step += GROUP_SIZE;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		uint8_t *old_ctrl = ctrl;
+		Slot *old_slots = slots;
+		Link *old_links = links;
+		uint32_t old_head = head;
+
+		capacity = p_new_capacity;
+		ctrl = static_cast<uint8_t *>(Memory::alloc_static(capacity + GROUP_SIZE));
+		slots = static_cast<Slot *>(Memory::alloc_static(sizeof(Slot) * capacity));
+		links = static_cast<Link *>(Memory::alloc_static(sizeof(Link) * capacity));
+		memset(ctrl, CTRL_EMPTY, capacity + GROUP_SIZE);
+		growth_left = _max_load(capacity) - num_elements;
+		head = INVALID_POS;
+		tail = INVALID_POS;
+
+		if (old_ctrl == nullptr) {
+			return;
+		}
+
+		// Reinserted in insertion order, so it's kept.
+		for (uint32_t i = old_head; i != INVALID_POS; i = old_links[i].next) {
+			Slot &old_slot = old_slots[i];
+			uint32_t hash = _hash(old_slot.key);
+			uint32_t pos = _find_insert_pos(hash);
+			_set_ctrl(pos, _h2(hash));
+			memnew_placement(&slots[pos], Slot(std::move(const_cast<TKey &>(old_slot.key)), std::move(old_slot.value)));
+			_link(pos);
+			old_slot.~Slot();
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+		Memory::free_static(old_links);
+	}
+
+	void _grow_for_insert() {
+		// Too many tombstones get cleaned up by rehashing in place, otherwise
+		// the table doubles.
+		if (capacity != 0 && num_elements < _max_load(capacity) / 2) {
+			_resize_and_rehash(capacity);
+		} else {
+			_resize_and_rehash(capacity == 0 ? MIN_CAPACITY : capacity * 2);
+		}
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t hash = _hash(p_key);
+		if (unlikely(capacity == 0)) {
+			_grow_for_insert();
+		}
+		uint32_t pos = _find_insert_pos(hash);
+		if (unlikely(growth_left == 0 && ctrl[pos] == CTRL_EMPTY)) {
+			_grow_for_insert();
+			pos = _find_insert_pos(hash);
+		}
+
+		if (ctrl[pos] == CTRL_EMPTY) {
+			growth_left--;
+		}
+		_set_ctrl(pos, _h2(hash));
+		memnew_placement(&slots[pos], Slot(p_key, p_value));
+		_link(pos);
+		num_elements++;
+		return pos;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		_unlink(p_pos);
+		slots[p_pos].~Slot();
+		num_elements--;
+
+		// If no group that contains this slot was ever full, lookups can't have
+		// probed past it and it can be marked empty instead of deleted.
+		const uint32_t mask = capacity - 1;
+		BitMask empty_before = Group(ctrl + ((p_pos - GROUP_SIZE) & mask)).match_empty();
+		BitMask empty_after = Group(ctrl + p_pos).match_empty();
+		if (empty_before && empty_after && empty_after.lowest() + empty_before.leading_zeros() < GROUP_SIZE) {
+			_set_ctrl(p_pos, CTRL_EMPTY);
+			growth_left++;
+		} else {
+			_set_ctrl(p_pos, CTRL_DELETED);
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (num_elements == 0 && growth_left == _max_load(capacity)) {
+			return;
+		}
+		for (uint32_t i = head; i != INVALID_POS; i = links[i].next) {
+			slots[i].~Slot();
+		}
+		memset(ctrl, CTRL_EMPTY, capacity + GROUP_SIZE);
+		head = INVALID_POS;
+		tail = INVALID_POS;
+		num_elements = 0;
+		growth_left = _max_load(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = _lookup_pos(p_key);
+		CRASH_COND_MSG(pos == INVALID_POS, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = _lookup_pos(p_key);
+		CRASH_COND_MSG(pos == INVALID_POS, "FlatHashMap key not found.");
+		return slots[pos].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = _lookup_pos(p_key);
+		if (pos != INVALID_POS) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = _lookup_pos(p_key);
+		if (pos != INVALID_POS) {
+			return &slots[pos].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		return _lookup_pos(p_key) != INVALID_POS;
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = _lookup_pos(p_key);
+		if (pos == INVALID_POS) {
+			return false;
+		}
+		_erase_pos(pos);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = MAX(capacity, MIN_CAPACITY);
+		while (_max_load(new_capacity) < p_new_capacity) {
+			new_capacity *= 2;
+		}
+		if (new_capacity == capacity) {
+			return; // Already big enough.
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[pos];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const {
+			return &map->slots[pos];
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pos = map->links[pos].next;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && pos != INVALID_POS;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->slots[pos];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const {
+			return &map->slots[pos];
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pos = map->links[pos].next;
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pos == b.pos; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pos != b.pos; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && pos != INVALID_POS;
+		}
+
+		_FORCE_INLINE_ Iterator(FlatHashMap *p_map, uint32_t p_pos) {
+			map = p_map;
+			pos = p_pos;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, pos);
+		}
+
+	private:
+		FlatHashMap *map = nullptr;
+		uint32_t pos = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, head);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, INVALID_POS);
+	}
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, head);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, INVALID_POS);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		return ConstIterator(this, _lookup_pos(p_key));
+	}
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		return Iterator(this, _lookup_pos(p_key));
+	}
+
+	_FORCE_INLINE_ void remove(const ConstIterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	// Inserts an element, replacing the value if the key already exists.
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = _lookup_pos(p_key);
+		if (pos != INVALID_POS) {
+			slots[pos].value = p_value;
+		} else {
+			pos = _insert(p_key, p_value);
+		}
+		return Iterator(this, pos);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = _lookup_pos(p_key);
+		CRASH_COND(pos == INVALID_POS);
+		return slots[pos].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = _lookup_pos(p_key);
+		if (pos == INVALID_POS) {
+			pos = _insert(p_key, TValue());
+		}
+		return slots[pos].value;
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		if (p_other.num_elements == 0) {
+			return;
+		}
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			_insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+		reserve(p_other.num_elements);
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			_insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			Memory::free_static(links);
+		}
+	}
+};
+
+#endif // FLAT_HASH_MAP_H
@@ -33,6 +33,9 @@
 
 #include "core/templates/hashfuncs.h"
 #include "core/typedefs.h"
+
+#include <utility>
+
 template <typename F, typename S>
 struct Pair {
 	F first;
@@ -92,6 +95,10 @@ struct KeyValue {
 			key(p_key),
 			value(p_value) {
 	}
+	_FORCE_INLINE_ KeyValue(K &&p_key, V &&p_value) :
+			key(std::move(p_key)),
+			value(std::move(p_value)) {
+	}
 };
 
 template <typename K, typename V>
@@ -44,6 +44,7 @@
 
 #include <climits>
 #include <initializer_list>
+#include <utility>
 
 template <typename T>
 class VectorWriteProxy {
@@ -147,6 +148,9 @@ public:
 	inline void operator=(const Vector &p_from) {
 		_cowdata._ref(p_from._cowdata);
 	}
+	inline void operator=(Vector &&p_from) {
+		_cowdata = std::move(p_from._cowdata);
+	}
 
 	Vector<uint8_t> to_byte_array() const {
 		Vector<uint8_t> ret;
@@ -287,6 +291,8 @@ public:
 		}
 	}
 	_FORCE_INLINE_ Vector(const Vector &p_from) { _cowdata._ref(p_from._cowdata); }
+	_FORCE_INLINE_ Vector(Vector &&p_from) :
+			_cowdata(std::move(p_from._cowdata)) {}
 
 	_FORCE_INLINE_ ~Vector() {}
 };
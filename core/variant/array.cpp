@@ -35,15 +35,20 @@
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
 #include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/search_array.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
 #include "core/variant/variant.h"
+#include "core/variant/variant_internal.h"
 
 class ArrayPrivate {
 public:
 	SafeRefCount refcount;
+	// Boxed even in typed arrays of scalars and vectors, as references and pointers to the elements
+	// are handed out (operator[], iterators, GDExtension's array_operator_index). Sorting copies the
+	// values out unboxed, min()/max() compare them in place without going through Variant operators.
 	Vector<Variant> array;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
 	ContainerTypeValidate typed;
@@ -627,8 +632,117 @@ struct _ArrayVariantSort {
 	}
 };
 
+// Typed arrays of scalars and vectors only hold values of a single type, so
+// they can be sorted and compared as a flat buffer of unboxed values (laid
+// out like the matching packed array) instead of dispatching a Variant
+// operator for every comparison. The comparisons are the same as the ones
+// registered for OP_LESS and OP_GREATER, so results don't change.
+// Elements written without validation (through operator[]) may not match the
+// array type, in which case these return false and the generic path is used.
+
+template <typename T>
+static bool _sort_unboxed(Vector<Variant> &p_array, Variant::Type p_type) {
+	const int size = p_array.size();
+	LocalVector<T> values;
+	values.resize(size);
+
+	const Variant *src = p_array.ptr();
+	for (int i = 0; i < size; i++) {
+		if (unlikely(src[i].get_type() != p_type)) {
+			return false;
+		}
+		values[i] = *VariantGetInternalPtr<T>::get_ptr(&src[i]);
+	}
+
+	values.sort();
+
+	Variant *dst = p_array.ptrw();
+	for (int i = 0; i < size; i++) {
+		*VariantGetInternalPtr<T>::get_ptr(&dst[i]) = values[i];
+	}
+	return true;
+}
+
+template <typename T>
+static bool _min_max_unboxed(const Vector<Variant> &p_array, Variant::Type p_type, bool p_max, Variant &r_result) {
+	const int size = p_array.size();
+	if (size == 0) {
+		return false;
+	}
+
+	const Variant *src = p_array.ptr();
+	int result = 0;
+
+	for (int i = 0; i < size; i++) {
+		if (unlikely(src[i].get_type() != p_type)) {
+			return false;
+		}
+		const T &value = *VariantGetInternalPtr<T>::get_ptr(&src[i]);
+		const T &current = *VariantGetInternalPtr<T>::get_ptr(&src[result]);
+		if (p_max ? value > current : value < current) {
+			result = i;
+		}
+	}
+
+	r_result = src[result];
+	return true;
+}
+
+static bool _sort_typed(Vector<Variant> &p_array, Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return _sort_unboxed<bool>(p_array, p_type);
+		case Variant::INT:
+			return _sort_unboxed<int64_t>(p_array, p_type);
+		case Variant::FLOAT:
+			return _sort_unboxed<double>(p_array, p_type);
+		case Variant::VECTOR2:
+			return _sort_unboxed<Vector2>(p_array, p_type);
+		case Variant::VECTOR2I:
+			return _sort_unboxed<Vector2i>(p_array, p_type);
+		case Variant::VECTOR3:
+			return _sort_unboxed<Vector3>(p_array, p_type);
+		case Variant::VECTOR3I:
+			return _sort_unboxed<Vector3i>(p_array, p_type);
+		case Variant::VECTOR4:
+			return _sort_unboxed<Vector4>(p_array, p_type);
+		case Variant::VECTOR4I:
+			return _sort_unboxed<Vector4i>(p_array, p_type);
+		default:
+			return false;
+	}
+}
+
+static bool _min_max_typed(const Vector<Variant> &p_array, Variant::Type p_type, bool p_max, Variant &r_result) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return _min_max_unboxed<bool>(p_array, p_type, p_max, r_result);
+		case Variant::INT:
+			return _min_max_unboxed<int64_t>(p_array, p_type, p_max, r_result);
+		case Variant::FLOAT:
+			return _min_max_unboxed<double>(p_array, p_type, p_max, r_result);
+		case Variant::VECTOR2:
+			return _min_max_unboxed<Vector2>(p_array, p_type, p_max, r_result);
+		case Variant::VECTOR2I:
+			return _min_max_unboxed<Vector2i>(p_array, p_type, p_max, r_result);
+		case Variant::VECTOR3:
+			return _min_max_unboxed<Vector3>(p_array, p_type, p_max, r_result);
+		case Variant::VECTOR3I:
+			return _min_max_unboxed<Vector3i>(p_array, p_type, p_max, r_result);
+		case Variant::VECTOR4:
+			return _min_max_unboxed<Vector4>(p_array, p_type, p_max, r_result);
+		case Variant::VECTOR4I:
+			return _min_max_unboxed<Vector4i>(p_array, p_type, p_max, r_result);
+		default:
+			return false;
+	}
+}
+
 void Array::sort() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->array.size() < 2 || _sort_typed(_p->array, _p->typed.type)) {
+		return;
+	}
 	_p->array.sort_custom<_ArrayVariantSort>();
 }
 
@@ -727,6 +841,9 @@ Variant Array::pop_at(int p_pos) {
 
 Variant Array::min() const {
 	Variant minval;
+	if (_min_max_typed(_p->array, _p->typed.type, false, minval)) {
+		return minval;
+	}
 	for (int i = 0; i < size(); i++) {
 		if (i == 0) {
 			minval = get(i);
@@ -749,6 +866,9 @@ Variant Array::min() const {
 
 Variant Array::max() const {
 	Variant maxval;
+	if (_min_max_typed(_p->array, _p->typed.type, true, maxval)) {
+		return maxval;
+	}
 	for (int i = 0; i < size(); i++) {
 		if (i == 0) {
 			maxval = get(i);
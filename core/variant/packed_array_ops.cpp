@@ -0,0 +1,356 @@
+/**************************************************************************/
+/*  packed_array_ops.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "packed_array_ops.h"
+
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PACKED_ARRAY_OPS_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define PACKED_ARRAY_OPS_NEON
+#endif
+
+// Vector registers for each element type. Types without a specialization are processed one element at
+// a time, in loops simple enough for the compiler to vectorize on its own.
+template <typename T>
+struct _Lanes {
+	static constexpr int SIZE = 0;
+};
+
+#if defined(PACKED_ARRAY_OPS_SSE2)
+
+template <>
+struct _Lanes<float> {
+	typedef __m128 Reg;
+	static constexpr int SIZE = 4;
+	static _FORCE_INLINE_ Reg load(const float *p_src) { return _mm_loadu_ps(p_src); }
+	static _FORCE_INLINE_ void store(float *p_dst, Reg p_value) { _mm_storeu_ps(p_dst, p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return _mm_add_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg subtract(Reg p_a, Reg p_b) { return _mm_sub_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg multiply(Reg p_a, Reg p_b) { return _mm_mul_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return _mm_min_ps(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return _mm_max_ps(p_a, p_b); }
+};
+
+template <>
+struct _Lanes<double> {
+	typedef __m128d Reg;
+	static constexpr int SIZE = 2;
+	static _FORCE_INLINE_ Reg load(const double *p_src) { return _mm_loadu_pd(p_src); }
+	static _FORCE_INLINE_ void store(double *p_dst, Reg p_value) { _mm_storeu_pd(p_dst, p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return _mm_add_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg subtract(Reg p_a, Reg p_b) { return _mm_sub_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg multiply(Reg p_a, Reg p_b) { return _mm_mul_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return _mm_min_pd(p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return _mm_max_pd(p_a, p_b); }
+};
+
+#elif defined(PACKED_ARRAY_OPS_NEON)
+
+// vminq/vmaxq propagate NaN, select instead to match MIN()/MAX() and the scalar loops.
+template <>
+struct _Lanes<float> {
+	typedef float32x4_t Reg;
+	static constexpr int SIZE = 4;
+	static _FORCE_INLINE_ Reg load(const float *p_src) { return vld1q_f32(p_src); }
+	static _FORCE_INLINE_ void store(float *p_dst, Reg p_value) { vst1q_f32(p_dst, p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return vaddq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg subtract(Reg p_a, Reg p_b) { return vsubq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg multiply(Reg p_a, Reg p_b) { return vmulq_f32(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return vbslq_f32(vcltq_f32(p_a, p_b), p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return vbslq_f32(vcgtq_f32(p_a, p_b), p_a, p_b); }
+};
+
+template <>
+struct _Lanes<double> {
+	typedef float64x2_t Reg;
+	static constexpr int SIZE = 2;
+	static _FORCE_INLINE_ Reg load(const double *p_src) { return vld1q_f64(p_src); }
+	static _FORCE_INLINE_ void store(double *p_dst, Reg p_value) { vst1q_f64(p_dst, p_value); }
+	static _FORCE_INLINE_ Reg add(Reg p_a, Reg p_b) { return vaddq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg subtract(Reg p_a, Reg p_b) { return vsubq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg multiply(Reg p_a, Reg p_b) { return vmulq_f64(p_a, p_b); }
+	static _FORCE_INLINE_ Reg min(Reg p_a, Reg p_b) { return vbslq_f64(vcltq_f64(p_a, p_b), p_a, p_b); }
+	static _FORCE_INLINE_ Reg max(Reg p_a, Reg p_b) { return vbslq_f64(vcgtq_f64(p_a, p_b), p_a, p_b); }
+};
+
+#endif
+
+// Integers wrap around on overflow, like int operators in scripts.
+template <typename T, bool t_integral = std::is_integral_v<T>>
+struct _WrappingType {
+	typedef T Type;
+};
+
+template <typename T>
+struct _WrappingType<T, true> {
+	typedef std::make_unsigned_t<T> Type;
+};
+
+template <typename T>
+using _Wrapping = typename _WrappingType<T>::Type;
+
+struct _OpAdd {
+	template <typename T>
+	static _FORCE_INLINE_ T scalar(T p_a, T p_b) { return T(_Wrapping<T>(p_a) + _Wrapping<T>(p_b)); }
+	template <typename L>
+	static _FORCE_INLINE_ typename L::Reg simd(typename L::Reg p_a, typename L::Reg p_b) { return L::add(p_a, p_b); }
+};
+
+struct _OpSubtract {
+	template <typename T>
+	static _FORCE_INLINE_ T scalar(T p_a, T p_b) { return T(_Wrapping<T>(p_a) - _Wrapping<T>(p_b)); }
+	template <typename L>
+	static _FORCE_INLINE_ typename L::Reg simd(typename L::Reg p_a, typename L::Reg p_b) { return L::subtract(p_a, p_b); }
+};
+
+struct _OpMultiply {
+	template <typename T>
+	static _FORCE_INLINE_ T scalar(T p_a, T p_b) { return T(_Wrapping<T>(p_a) * _Wrapping<T>(p_b)); }
+	template <typename L>
+	static _FORCE_INLINE_ typename L::Reg simd(typename L::Reg p_a, typename L::Reg p_b) { return L::multiply(p_a, p_b); }
+};
+
+struct _OpMin {
+	template <typename T>
+	static _FORCE_INLINE_ T scalar(T p_a, T p_b) { return MIN(p_a, p_b); }
+	template <typename L>
+	static _FORCE_INLINE_ typename L::Reg simd(typename L::Reg p_a, typename L::Reg p_b) { return L::min(p_a, p_b); }
+};
+
+struct _OpMax {
+	template <typename T>
+	static _FORCE_INLINE_ T scalar(T p_a, T p_b) { return MAX(p_a, p_b); }
+	template <typename L>
+	static _FORCE_INLINE_ typename L::Reg simd(typename L::Reg p_a, typename L::Reg p_b) { return L::max(p_a, p_b); }
+};
+
+template <typename Op, typename T>
+static _FORCE_INLINE_ void _binary_op(const T *p_a, const T *p_b, T *r_dst, int64_t p_count) {
+	int64_t i = 0;
+	if constexpr (_Lanes<T>::SIZE > 0) {
+		typedef _Lanes<T> L;
+		for (; i + 2 * L::SIZE <= p_count; i += 2 * L::SIZE) {
+			typename L::Reg a0 = L::load(p_a + i);
+			typename L::Reg a1 = L::load(p_a + i + L::SIZE);
+			typename L::Reg b0 = L::load(p_b + i);
+			typename L::Reg b1 = L::load(p_b + i + L::SIZE);
+			L::store(r_dst + i, Op::template simd<L>(a0, b0));
+			L::store(r_dst + i + L::SIZE, Op::template simd<L>(a1, b1));
+		}
+	}
+	for (; i < p_count; i++) {
+		r_dst[i] = Op::scalar(p_a[i], p_b[i]);
+	}
+}
+
+#define PACKED_ARRAY_BINARY_OP(m_name, m_op)                                                               \
+	void PackedArrayOps::m_name(const float *p_a, const float *p_b, float *r_dst, int64_t p_count) {       \
+		_binary_op<m_op>(p_a, p_b, r_dst, p_count);                                                        \
+	}                                                                                                      \
+	void PackedArrayOps::m_name(const double *p_a, const double *p_b, double *r_dst, int64_t p_count) {    \
+		_binary_op<m_op>(p_a, p_b, r_dst, p_count);                                                        \
+	}                                                                                                      \
+	void PackedArrayOps::m_name(const int32_t *p_a, const int32_t *p_b, int32_t *r_dst, int64_t p_count) { \
+		_binary_op<m_op>(p_a, p_b, r_dst, p_count);                                                        \
+	}                                                                                                      \
+	void PackedArrayOps::m_name(const int64_t *p_a, const int64_t *p_b, int64_t *r_dst, int64_t p_count) { \
+		_binary_op<m_op>(p_a, p_b, r_dst, p_count);                                                        \
+	}
+
+PACKED_ARRAY_BINARY_OP(add, _OpAdd)
+PACKED_ARRAY_BINARY_OP(subtract, _OpSubtract)
+PACKED_ARRAY_BINARY_OP(multiply, _OpMultiply)
+PACKED_ARRAY_BINARY_OP(min, _OpMin)
+PACKED_ARRAY_BINARY_OP(max, _OpMax)
+
+#undef PACKED_ARRAY_BINARY_OP
+
+// Floating-point reductions. When p_b is null, the elements of p_a are summed instead of the products.
+
+template <bool t_dot>
+static double _reduce(const float *p_a, const float *p_b, int64_t p_count) {
+	int64_t i = 0;
+	double result = 0.0;
+#if defined(PACKED_ARRAY_OPS_SSE2)
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 a = _mm_loadu_ps(p_a + i);
+		__m128d lo = _mm_cvtps_pd(a);
+		__m128d hi = _mm_cvtps_pd(_mm_movehl_ps(a, a));
+		if constexpr (t_dot) {
+			__m128 b = _mm_loadu_ps(p_b + i);
+			lo = _mm_mul_pd(lo, _mm_cvtps_pd(b));
+			hi = _mm_mul_pd(hi, _mm_cvtps_pd(_mm_movehl_ps(b, b)));
+		}
+		acc0 = _mm_add_pd(acc0, lo);
+		acc1 = _mm_add_pd(acc1, hi);
+	}
+	acc0 = _mm_add_pd(acc0, acc1);
+	result = _mm_cvtsd_f64(_mm_add_sd(acc0, _mm_unpackhi_pd(acc0, acc0)));
+#elif defined(PACKED_ARRAY_OPS_NEON)
+	float64x2_t acc0 = vdupq_n_f64(0.0);
+	float64x2_t acc1 = vdupq_n_f64(0.0);
+	for (; i + 4 <= p_count; i += 4) {
+		float32x4_t a = vld1q_f32(p_a + i);
+		float64x2_t lo = vcvt_f64_f32(vget_low_f32(a));
+		float64x2_t hi = vcvt_high_f64_f32(a);
+		if constexpr (t_dot) {
+			float32x4_t b = vld1q_f32(p_b + i);
+			lo = vmulq_f64(lo, vcvt_f64_f32(vget_low_f32(b)));
+			hi = vmulq_f64(hi, vcvt_high_f64_f32(b));
+		}
+		acc0 = vaddq_f64(acc0, lo);
+		acc1 = vaddq_f64(acc1, hi);
+	}
+	result = vaddvq_f64(vaddq_f64(acc0, acc1));
+#endif
+	for (; i < p_count; i++) {
+		if constexpr (t_dot) {
+			result += double(p_a[i]) * double(p_b[i]);
+		} else {
+			result += double(p_a[i]);
+		}
+	}
+	return result;
+}
+
+template <bool t_dot>
+static double _reduce(const double *p_a, const double *p_b, int64_t p_count) {
+	int64_t i = 0;
+	double result = 0.0;
+#if defined(PACKED_ARRAY_OPS_SSE2)
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	for (; i + 4 <= p_count; i += 4) {
+		__m128d a0 = _mm_loadu_pd(p_a + i);
+		__m128d a1 = _mm_loadu_pd(p_a + i + 2);
+		if constexpr (t_dot) {
+			a0 = _mm_mul_pd(a0, _mm_loadu_pd(p_b + i));
+			a1 = _mm_mul_pd(a1, _mm_loadu_pd(p_b + i + 2));
+		}
+		acc0 = _mm_add_pd(acc0, a0);
+		acc1 = _mm_add_pd(acc1, a1);
+	}
+	acc0 = _mm_add_pd(acc0, acc1);
+	result = _mm_cvtsd_f64(_mm_add_sd(acc0, _mm_unpackhi_pd(acc0, acc0)));
+#elif defined(PACKED_ARRAY_OPS_NEON)
+	float64x2_t acc0 = vdupq_n_f64(0.0);
+	float64x2_t acc1 = vdupq_n_f64(0.0);
+	for (; i + 4 <= p_count; i += 4) {
+		float64x2_t a0 = vld1q_f64(p_a + i);
+		float64x2_t a1 = vld1q_f64(p_a + i + 2);
+		if constexpr (t_dot) {
+			a0 = vmulq_f64(a0, vld1q_f64(p_b + i));
+			a1 = vmulq_f64(a1, vld1q_f64(p_b + i + 2));
+		}
+		acc0 = vaddq_f64(acc0, a0);
+		acc1 = vaddq_f64(acc1, a1);
+	}
+	result = vaddvq_f64(vaddq_f64(acc0, acc1));
+#endif
+	for (; i < p_count; i++) {
+		if constexpr (t_dot) {
+			result += p_a[i] * p_b[i];
+		} else {
+			result += p_a[i];
+		}
+	}
+	return result;
+}
+
+template <bool t_dot, typename T>
+static int64_t _reduce_int(const T *p_a, const T *p_b, int64_t p_count) {
+	uint64_t result = 0;
+	for (int64_t i = 0; i < p_count; i++) {
+		if constexpr (t_dot) {
+			result += uint64_t(int64_t(p_a[i])) * uint64_t(int64_t(p_b[i]));
+		} else {
+			result += uint64_t(int64_t(p_a[i]));
+		}
+	}
+	return int64_t(result);
+}
+
+double PackedArrayOps::sum(const float *p_src, int64_t p_count) {
+	return _reduce<false>(p_src, nullptr, p_count);
+}
+
+double PackedArrayOps::sum(const double *p_src, int64_t p_count) {
+	return _reduce<false>(p_src, nullptr, p_count);
+}
+
+int64_t PackedArrayOps::sum(const int32_t *p_src, int64_t p_count) {
+	return _reduce_int<false>(p_src, (const int32_t *)nullptr, p_count);
+}
+
+int64_t PackedArrayOps::sum(const int64_t *p_src, int64_t p_count) {
+	return _reduce_int<false>(p_src, (const int64_t *)nullptr, p_count);
+}
+
+template <typename T>
+static void _sum_strided(const T *p_src, int64_t p_count, int p_stride, double *r_sums) {
+	for (int j = 0; j < p_stride; j++) {
+		r_sums[j] = 0.0;
+	}
+	for (int64_t i = 0; i < p_count; i += p_stride) {
+		for (int j = 0; j < p_stride; j++) {
+			r_sums[j] += double(p_src[i + j]);
+		}
+	}
+}
+
+void PackedArrayOps::sum_strided(const float *p_src, int64_t p_count, int p_stride, double *r_sums) {
+	_sum_strided(p_src, p_count, p_stride, r_sums);
+}
+
+void PackedArrayOps::sum_strided(const double *p_src, int64_t p_count, int p_stride, double *r_sums) {
+	_sum_strided(p_src, p_count, p_stride, r_sums);
+}
+
+double PackedArrayOps::dot(const float *p_a, const float *p_b, int64_t p_count) {
+	return _reduce<true>(p_a, p_b, p_count);
+}
+
+double PackedArrayOps::dot(const double *p_a, const double *p_b, int64_t p_count) {
+	return _reduce<true>(p_a, p_b, p_count);
+}
+
+int64_t PackedArrayOps::dot(const int32_t *p_a, const int32_t *p_b, int64_t p_count) {
+	return _reduce_int<true>(p_a, p_b, p_count);
+}
+
+int64_t PackedArrayOps::dot(const int64_t *p_a, const int64_t *p_b, int64_t p_count) {
+	return _reduce_int<true>(p_a, p_b, p_count);
+}
@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  packed_array_ops.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PACKED_ARRAY_OPS_H
+#define PACKED_ARRAY_OPS_H
+
+#include "core/typedefs.h"
+
+// Element-wise operations and reductions over the contents of packed arrays,
+// using SSE2 or NEON for floating-point data where available.
+// Floating-point reductions accumulate in double precision.
+class PackedArrayOps {
+public:
+	static void add(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void add(const double *p_a, const double *p_b, double *r_dst, int64_t p_count);
+	static void add(const int32_t *p_a, const int32_t *p_b, int32_t *r_dst, int64_t p_count);
+	static void add(const int64_t *p_a, const int64_t *p_b, int64_t *r_dst, int64_t p_count);
+
+	static void subtract(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void subtract(const double *p_a, const double *p_b, double *r_dst, int64_t p_count);
+	static void subtract(const int32_t *p_a, const int32_t *p_b, int32_t *r_dst, int64_t p_count);
+	static void subtract(const int64_t *p_a, const int64_t *p_b, int64_t *r_dst, int64_t p_count);
+
+	static void multiply(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void multiply(const double *p_a, const double *p_b, double *r_dst, int64_t p_count);
+	static void multiply(const int32_t *p_a, const int32_t *p_b, int32_t *r_dst, int64_t p_count);
+	static void multiply(const int64_t *p_a, const int64_t *p_b, int64_t *r_dst, int64_t p_count);
+
+	static void min(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void min(const double *p_a, const double *p_b, double *r_dst, int64_t p_count);
+	static void min(const int32_t *p_a, const int32_t *p_b, int32_t *r_dst, int64_t p_count);
+	static void min(const int64_t *p_a, const int64_t *p_b, int64_t *r_dst, int64_t p_count);
+
+	static void max(const float *p_a, const float *p_b, float *r_dst, int64_t p_count);
+	static void max(const double *p_a, const double *p_b, double *r_dst, int64_t p_count);
+	static void max(const int32_t *p_a, const int32_t *p_b, int32_t *r_dst, int64_t p_count);
+	static void max(const int64_t *p_a, const int64_t *p_b, int64_t *r_dst, int64_t p_count);
+
+	static double sum(const float *p_src, int64_t p_count);
+	static double sum(const double *p_src, int64_t p_count);
+	static int64_t sum(const int32_t *p_src, int64_t p_count);
+	static int64_t sum(const int64_t *p_src, int64_t p_count);
+
+	// Sums every p_stride-th element starting at each of the first p_stride elements into r_sums,
+	// which is used to add up vectors component by component.
+	static void sum_strided(const float *p_src, int64_t p_count, int p_stride, double *r_sums);
+	static void sum_strided(const double *p_src, int64_t p_count, int p_stride, double *r_sums);
+
+	static double dot(const float *p_a, const float *p_b, int64_t p_count);
+	static double dot(const double *p_a, const double *p_b, int64_t p_count);
+	static int64_t dot(const int32_t *p_a, const int32_t *p_b, int64_t p_count);
+	static int64_t dot(const int64_t *p_a, const int64_t *p_b, int64_t p_count);
+};
+
+#endif // PACKED_ARRAY_OPS_H
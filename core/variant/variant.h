@@ -218,6 +218,9 @@ private:
 		static _FORCE_INLINE_ PackedArrayRef<T> *create(const Vector<T> &p_from) {
 			return memnew(PackedArrayRef<T>(p_from));
 		}
+		static _FORCE_INLINE_ PackedArrayRef<T> *create(Vector<T> &&p_from) {
+			return memnew(PackedArrayRef<T>(std::move(p_from)));
+		}
 
 		static _FORCE_INLINE_ const Vector<T> &get_array(PackedArrayRefBase *p_base) {
 			return static_cast<PackedArrayRef<T> *>(p_base)->array;
@@ -230,6 +233,10 @@ private:
 			array = p_from;
 			refcount.init();
 		}
+		_FORCE_INLINE_ PackedArrayRef(Vector<T> &&p_from) :
+				array(std::move(p_from)) {
+			refcount.init();
+		}
 		_FORCE_INLINE_ PackedArrayRef() {
 			refcount.init();
 		}
@@ -445,6 +452,7 @@ public:
 	Variant(double p_double);
 	Variant(const ObjectID &p_id);
 	Variant(const String &p_string);
+	Variant(String &&p_string);
 	Variant(const StringName &p_string);
 	Variant(const char *const p_cstring);
 	Variant(const char32_t *p_wstring);
@@ -482,6 +490,16 @@ public:
 	Variant(const PackedVector3Array &p_vector3_array);
 	Variant(const PackedColorArray &p_color_array);
 	Variant(const PackedVector4Array &p_vector4_array);
+	Variant(PackedByteArray &&p_byte_array);
+	Variant(PackedInt32Array &&p_int32_array);
+	Variant(PackedInt64Array &&p_int64_array);
+	Variant(PackedFloat32Array &&p_float32_array);
+	Variant(PackedFloat64Array &&p_float64_array);
+	Variant(PackedStringArray &&p_string_array);
+	Variant(PackedVector2Array &&p_vector2_array);
+	Variant(PackedVector3Array &&p_vector3_array);
+	Variant(PackedColorArray &&p_color_array);
+	Variant(PackedVector4Array &&p_vector4_array);
 
 	Variant(const Vector<::RID> &p_array); // helper
 	Variant(const Vector<Plane> &p_array); // helper
@@ -792,11 +810,17 @@ public:
 	static void construct_from_string(const String &p_string, Variant &r_value, ObjectConstruct p_obj_construct = nullptr, void *p_construct_ud = nullptr);
 
 	void operator=(const Variant &p_variant); // only this is enough for all the other types
+	void operator=(Variant &&p_variant);
 
 	static void register_types();
 	static void unregister_types();
 
 	Variant(const Variant &p_variant);
+	// Takes over the contents of p_variant, leaving it as NIL.
+	_FORCE_INLINE_ Variant(Variant &&p_variant) :
+			type(p_variant.type), _data(p_variant._data) {
+		p_variant.type = NIL;
+	}
 	_FORCE_INLINE_ Variant() :
 			type(NIL) {}
 	_FORCE_INLINE_ ~Variant() {
@@ -38,6 +38,7 @@
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/oa_hash_map.h"
+#include "core/variant/packed_array_ops.h"
 
 typedef void (*VariantFunc)(Variant &r_ret, Variant &p_self, const Variant **p_args);
 typedef void (*VariantConstructFunc)(Variant &r_ret, const Variant **p_args);
@@ -657,6 +658,58 @@ static _FORCE_INLINE_ void vc_ptrcall(void (*method)(T *, P...), void *p_base, c
 		}                                                                                                                                                         \
 	};
 
+// Describes how the contents of the packed arrays supporting element-wise operations are passed to PackedArrayOps.
+template <typename T>
+struct PackedArrayOpsTraits;
+
+template <>
+struct PackedArrayOpsTraits<PackedInt32Array> {
+	typedef int32_t Scalar;
+	typedef int64_t Result;
+	typedef int64_t Sum;
+	static constexpr int COMPONENTS = 1;
+};
+
+template <>
+struct PackedArrayOpsTraits<PackedInt64Array> {
+	typedef int64_t Scalar;
+	typedef int64_t Result;
+	typedef int64_t Sum;
+	static constexpr int COMPONENTS = 1;
+};
+
+template <>
+struct PackedArrayOpsTraits<PackedFloat32Array> {
+	typedef float Scalar;
+	typedef double Result;
+	typedef double Sum;
+	static constexpr int COMPONENTS = 1;
+};
+
+template <>
+struct PackedArrayOpsTraits<PackedFloat64Array> {
+	typedef double Scalar;
+	typedef double Result;
+	typedef double Sum;
+	static constexpr int COMPONENTS = 1;
+};
+
+template <>
+struct PackedArrayOpsTraits<PackedVector2Array> {
+	typedef real_t Scalar;
+	typedef double Result;
+	typedef Vector2 Sum;
+	static constexpr int COMPONENTS = 2;
+};
+
+template <>
+struct PackedArrayOpsTraits<PackedVector3Array> {
+	typedef real_t Scalar;
+	typedef double Result;
+	typedef Vector3 Sum;
+	static constexpr int COMPONENTS = 3;
+};
+
 struct _VariantCall {
 	static String func_PackedByteArray_get_string_from_ascii(PackedByteArray *p_instance) {
 		String s;
@@ -1018,6 +1071,73 @@ struct _VariantCall {
 		return len;
 	}
 
+	template <typename T>
+	using PackedArrayKernel = void (*)(const typename PackedArrayOpsTraits<T>::Scalar *, const typename PackedArrayOpsTraits<T>::Scalar *, typename PackedArrayOpsTraits<T>::Scalar *, int64_t);
+
+	template <typename T>
+	static T _packed_array_binary_op(const T *p_instance, const T &p_with, PackedArrayKernel<T> p_kernel) {
+		typedef typename PackedArrayOpsTraits<T>::Scalar S;
+		T dest;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), dest, vformat("Array sizes don't match (%d and %d).", p_instance->size(), p_with.size()));
+		if (p_instance->is_empty()) {
+			return dest;
+		}
+		dest.resize(p_instance->size());
+		ERR_FAIL_COND_V(dest.is_empty(), dest); // Avoid UB in case resize failed.
+		p_kernel((const S *)p_instance->ptr(), (const S *)p_with.ptr(), (S *)dest.ptrw(), int64_t(dest.size()) * PackedArrayOpsTraits<T>::COMPONENTS);
+		return dest;
+	}
+
+	template <typename T>
+	static T func_PackedArray_add(T *p_instance, const T &p_with) {
+		return _packed_array_binary_op<T>(p_instance, p_with, &PackedArrayOps::add);
+	}
+
+	template <typename T>
+	static T func_PackedArray_subtract(T *p_instance, const T &p_with) {
+		return _packed_array_binary_op<T>(p_instance, p_with, &PackedArrayOps::subtract);
+	}
+
+	template <typename T>
+	static T func_PackedArray_multiply(T *p_instance, const T &p_with) {
+		return _packed_array_binary_op<T>(p_instance, p_with, &PackedArrayOps::multiply);
+	}
+
+	template <typename T>
+	static T func_PackedArray_min(T *p_instance, const T &p_with) {
+		return _packed_array_binary_op<T>(p_instance, p_with, &PackedArrayOps::min);
+	}
+
+	template <typename T>
+	static T func_PackedArray_max(T *p_instance, const T &p_with) {
+		return _packed_array_binary_op<T>(p_instance, p_with, &PackedArrayOps::max);
+	}
+
+	template <typename T>
+	static typename PackedArrayOpsTraits<T>::Sum func_PackedArray_sum(T *p_instance) {
+		typedef typename PackedArrayOpsTraits<T>::Scalar S;
+		const S *src = (const S *)p_instance->ptr();
+		const int64_t count = int64_t(p_instance->size()) * PackedArrayOpsTraits<T>::COMPONENTS;
+		if constexpr (PackedArrayOpsTraits<T>::COMPONENTS == 1) {
+			return PackedArrayOps::sum(src, count);
+		} else {
+			double sums[PackedArrayOpsTraits<T>::COMPONENTS];
+			PackedArrayOps::sum_strided(src, count, PackedArrayOpsTraits<T>::COMPONENTS, sums);
+			typename PackedArrayOpsTraits<T>::Sum result;
+			for (int i = 0; i < PackedArrayOpsTraits<T>::COMPONENTS; i++) {
+				result[i] = sums[i];
+			}
+			return result;
+		}
+	}
+
+	template <typename T>
+	static typename PackedArrayOpsTraits<T>::Result func_PackedArray_dot(T *p_instance, const T &p_with) {
+		typedef typename PackedArrayOpsTraits<T>::Scalar S;
+		ERR_FAIL_COND_V_MSG(p_instance->size() != p_with.size(), 0, vformat("Array sizes don't match (%d and %d).", p_instance->size(), p_with.size()));
+		return PackedArrayOps::dot((const S *)p_instance->ptr(), (const S *)p_with.ptr(), int64_t(p_instance->size()) * PackedArrayOpsTraits<T>::COMPONENTS);
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2406,6 +2526,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedInt32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedInt32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedInt32Array, count, sarray("value"), varray());
+	bind_function(PackedInt32Array, add, _VariantCall::func_PackedArray_add<PackedInt32Array>, sarray("with"), varray());
+	bind_function(PackedInt32Array, subtract, _VariantCall::func_PackedArray_subtract<PackedInt32Array>, sarray("with"), varray());
+	bind_function(PackedInt32Array, multiply, _VariantCall::func_PackedArray_multiply<PackedInt32Array>, sarray("with"), varray());
+	bind_function(PackedInt32Array, min, _VariantCall::func_PackedArray_min<PackedInt32Array>, sarray("with"), varray());
+	bind_function(PackedInt32Array, max, _VariantCall::func_PackedArray_max<PackedInt32Array>, sarray("with"), varray());
+	bind_function(PackedInt32Array, sum, _VariantCall::func_PackedArray_sum<PackedInt32Array>, sarray(), varray());
+	bind_function(PackedInt32Array, dot, _VariantCall::func_PackedArray_dot<PackedInt32Array>, sarray("with"), varray());
 
 	/* Int64 Array */
 
@@ -2430,6 +2557,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedInt64Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedInt64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedInt64Array, count, sarray("value"), varray());
+	bind_function(PackedInt64Array, add, _VariantCall::func_PackedArray_add<PackedInt64Array>, sarray("with"), varray());
+	bind_function(PackedInt64Array, subtract, _VariantCall::func_PackedArray_subtract<PackedInt64Array>, sarray("with"), varray());
+	bind_function(PackedInt64Array, multiply, _VariantCall::func_PackedArray_multiply<PackedInt64Array>, sarray("with"), varray());
+	bind_function(PackedInt64Array, min, _VariantCall::func_PackedArray_min<PackedInt64Array>, sarray("with"), varray());
+	bind_function(PackedInt64Array, max, _VariantCall::func_PackedArray_max<PackedInt64Array>, sarray("with"), varray());
+	bind_function(PackedInt64Array, sum, _VariantCall::func_PackedArray_sum<PackedInt64Array>, sarray(), varray());
+	bind_function(PackedInt64Array, dot, _VariantCall::func_PackedArray_dot<PackedInt64Array>, sarray("with"), varray());
 
 	/* Float32 Array */
 
@@ -2454,6 +2588,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_function(PackedFloat32Array, add, _VariantCall::func_PackedArray_add<PackedFloat32Array>, sarray("with"), varray());
+	bind_function(PackedFloat32Array, subtract, _VariantCall::func_PackedArray_subtract<PackedFloat32Array>, sarray("with"), varray());
+	bind_function(PackedFloat32Array, multiply, _VariantCall::func_PackedArray_multiply<PackedFloat32Array>, sarray("with"), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedArray_min<PackedFloat32Array>, sarray("with"), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedArray_max<PackedFloat32Array>, sarray("with"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedArray_sum<PackedFloat32Array>, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedArray_dot<PackedFloat32Array>, sarray("with"), varray());
 
 	/* Float64 Array */
 
@@ -2478,6 +2619,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat64Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat64Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat64Array, count, sarray("value"), varray());
+	bind_function(PackedFloat64Array, add, _VariantCall::func_PackedArray_add<PackedFloat64Array>, sarray("with"), varray());
+	bind_function(PackedFloat64Array, subtract, _VariantCall::func_PackedArray_subtract<PackedFloat64Array>, sarray("with"), varray());
+	bind_function(PackedFloat64Array, multiply, _VariantCall::func_PackedArray_multiply<PackedFloat64Array>, sarray("with"), varray());
+	bind_function(PackedFloat64Array, min, _VariantCall::func_PackedArray_min<PackedFloat64Array>, sarray("with"), varray());
+	bind_function(PackedFloat64Array, max, _VariantCall::func_PackedArray_max<PackedFloat64Array>, sarray("with"), varray());
+	bind_function(PackedFloat64Array, sum, _VariantCall::func_PackedArray_sum<PackedFloat64Array>, sarray(), varray());
+	bind_function(PackedFloat64Array, dot, _VariantCall::func_PackedArray_dot<PackedFloat64Array>, sarray("with"), varray());
 
 	/* String Array */
 
@@ -2526,6 +2674,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector2Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector2Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector2Array, count, sarray("value"), varray());
+	bind_function(PackedVector2Array, add, _VariantCall::func_PackedArray_add<PackedVector2Array>, sarray("with"), varray());
+	bind_function(PackedVector2Array, subtract, _VariantCall::func_PackedArray_subtract<PackedVector2Array>, sarray("with"), varray());
+	bind_function(PackedVector2Array, multiply, _VariantCall::func_PackedArray_multiply<PackedVector2Array>, sarray("with"), varray());
+	bind_function(PackedVector2Array, min, _VariantCall::func_PackedArray_min<PackedVector2Array>, sarray("with"), varray());
+	bind_function(PackedVector2Array, max, _VariantCall::func_PackedArray_max<PackedVector2Array>, sarray("with"), varray());
+	bind_function(PackedVector2Array, sum, _VariantCall::func_PackedArray_sum<PackedVector2Array>, sarray(), varray());
+	bind_function(PackedVector2Array, dot, _VariantCall::func_PackedArray_dot<PackedVector2Array>, sarray("with"), varray());
 
 	/* Vector3 Array */
 
@@ -2550,6 +2705,13 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_function(PackedVector3Array, add, _VariantCall::func_PackedArray_add<PackedVector3Array>, sarray("with"), varray());
+	bind_function(PackedVector3Array, subtract, _VariantCall::func_PackedArray_subtract<PackedVector3Array>, sarray("with"), varray());
+	bind_function(PackedVector3Array, multiply, _VariantCall::func_PackedArray_multiply<PackedVector3Array>, sarray("with"), varray());
+	bind_function(PackedVector3Array, min, _VariantCall::func_PackedArray_min<PackedVector3Array>, sarray("with"), varray());
+	bind_function(PackedVector3Array, max, _VariantCall::func_PackedArray_max<PackedVector3Array>, sarray("with"), varray());
+	bind_function(PackedVector3Array, sum, _VariantCall::func_PackedArray_sum<PackedVector3Array>, sarray(), varray());
+	bind_function(PackedVector3Array, dot, _VariantCall::func_PackedArray_dot<PackedVector3Array>, sarray("with"), varray());
 
 	/* Color Array */
 
@@ -39,15 +39,10 @@
 Error ImageLoaderPNG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
 	const uint64_t buffer_size = f->get_length();
 	Vector<uint8_t> file_buffer;
-	Error err = file_buffer.resize(buffer_size);
-	if (err) {
-		return err;
-	}
-	{
-		uint8_t *writer = file_buffer.ptrw();
-		f->get_buffer(writer, buffer_size);
+	const uint8_t *reader = f->get_buffer_view(buffer_size, file_buffer);
+	if (reader == nullptr) {
+		return ERR_FILE_CORRUPT;
 	}
-	const uint8_t *reader = file_buffer.ptr();
 	return PNGDriverCommon::png_to_image(reader, buffer_size, p_flags & FLAG_FORCE_LINEAR, p_image);
 }
 
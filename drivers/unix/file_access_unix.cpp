@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +143,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapped) {
+		munmap(mapped, mapped_length);
+		mapped = nullptr;
+		mapped_length = 0;
+	}
+	map_attempted = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -282,6 +290,29 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_buffer(uint64_t &r_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	// Mapped lazily, only for files opened in read-only mode. Not on the web,
+	// where mmap() copies the whole file into memory.
+#ifndef WEB_ENABLED
+	if (!map_attempted && flags == READ) {
+		map_attempted = true;
+		struct stat st = {};
+		if (fstat(fileno(f), &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size <= SIZE_MAX) {
+			void *addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fileno(f), 0);
+			if (addr != MAP_FAILED) {
+				mapped = (uint8_t *)addr;
+				mapped_length = st.st_size;
+			}
+		}
+	}
+#endif
+
+	r_length = mapped_length;
+	return mapped;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,10 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable uint8_t *mapped = nullptr;
+	mutable uint64_t mapped_length = 0;
+	mutable bool map_attempted = false;
+
 	void _close();
 
 public:
@@ -72,6 +76,7 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer(uint64_t &r_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -34,7 +34,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION(_COMPRESSED), FileAccessPack::compress_blocks()
 #include "core/io/zip_io.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
@@ -244,6 +244,17 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 		}
 	}
 
+	// Files worth compressing are stored as compressed blocks, so they can still be read from any position.
+	Vector<uint8_t> compressed_data;
+	for (int i = 0; i < pd->compression_filters.size(); ++i) {
+		if (p_path.matchn(pd->compression_filters[i]) || p_path.replace("res://", "").matchn(pd->compression_filters[i])) {
+			compressed_data = FileAccessPack::compress_blocks(p_data.ptr(), p_data.size());
+			sd.compressed = !compressed_data.is_empty() && compressed_data.size() < p_data.size();
+			break;
+		}
+	}
+	const Vector<uint8_t> &stored_data = sd.compressed ? compressed_data : p_data;
+
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = pd->f;
 
@@ -257,7 +268,7 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	}
 
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	ftmp->store_buffer(stored_data.ptr(), stored_data.size());
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -423,6 +434,63 @@ void EditorExportPlatform::_export_find_dependencies(const String &p_path, HashS
 	}
 }
 
+void EditorExportPlatform::_find_prefetch_closure(const String &p_path, const HashMap<String, Vector<String>> &p_dependencies, HashSet<String> &r_visited, Vector<String> &r_post_order) {
+	if (r_visited.has(p_path)) {
+		return;
+	}
+	r_visited.insert(p_path);
+
+	const Vector<String> *deps = p_dependencies.getptr(p_path);
+	if (deps) {
+		for (const String &dep : *deps) {
+			_find_prefetch_closure(dep, p_dependencies, r_visited, r_post_order);
+		}
+	}
+	r_post_order.push_back(p_path);
+}
+
+HashMap<String, Vector<String>> EditorExportPlatform::_get_prefetch_manifest(const Vector<String> &p_exported_paths) {
+	HashSet<String> exported;
+	for (const String &path : p_exported_paths) {
+		exported.insert(path);
+	}
+
+	HashMap<String, Vector<String>> dependencies;
+	for (const String &path : p_exported_paths) {
+		int file_idx;
+		EditorFileSystemDirectory *dir = EditorFileSystem::get_singleton()->find_file(path, &file_idx);
+		if (!dir) {
+			continue;
+		}
+
+		Vector<String> deps;
+		for (const String &dep : dir->get_file_deps(file_idx)) {
+			if (dep != path && exported.has(dep)) {
+				deps.push_back(dep);
+			}
+		}
+		if (!deps.is_empty()) {
+			dependencies.insert(path, deps);
+		}
+	}
+
+	// Each closure is listed in reverse post-order, so every resource comes before its own
+	// dependencies, and the loads started in that order never have to await an older one.
+	HashMap<String, Vector<String>> manifest;
+	for (const KeyValue<String, Vector<String>> &E : dependencies) {
+		HashSet<String> visited;
+		Vector<String> post_order;
+		_find_prefetch_closure(E.key, dependencies, visited, post_order);
+
+		Vector<String> closure;
+		for (int i = post_order.size() - 2; i >= 0; i--) { // The last one is the resource itself.
+			closure.push_back(post_order[i]);
+		}
+		manifest.insert(E.key, closure);
+	}
+	return manifest;
+}
+
 void EditorExportPlatform::_edit_files_with_filter(Ref<DirAccess> &da, const Vector<String> &p_filters, HashSet<String> &r_list, bool exclude) {
 	da->list_dir_begin();
 	String cur_dir = da->get_current_dir().replace("\\", "/");
@@ -1129,6 +1197,8 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 	// for continue statements without accidentally skipping an increment.
 	int idx = total > 0 ? -1 : 0;
 
+	Vector<String> exported_resources;
+
 	for (const String &E : paths) {
 		idx++;
 		String path = E;
@@ -1337,6 +1407,8 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 				return err;
 			}
 		}
+
+		exported_resources.push_back(path);
 	}
 
 	if (convert_text_to_binary || !customize_resources_plugins.is_empty() || !customize_scenes_plugins.is_empty()) {
@@ -1407,6 +1479,22 @@ Error EditorExportPlatform::export_project_files(const Ref<EditorExportPreset> &
 		}
 	}
 
+	// Lets threaded loads start on everything a resource depends on at once, instead of
+	// discovering it one file at a time.
+	HashMap<String, Vector<String>> prefetch_manifest = _get_prefetch_manifest(exported_resources);
+	if (!prefetch_manifest.is_empty()) {
+		String manifest_tmp = EditorPaths::get_singleton()->get_cache_dir().path_join("tmpprefetch_manifest.bin");
+		err = ResourceLoader::save_prefetch_manifest(manifest_tmp, prefetch_manifest);
+		if (err == OK) {
+			Vector<uint8_t> array = FileAccess::get_file_as_bytes(manifest_tmp);
+			err = p_func(p_udata, ResourceLoader::get_prefetch_manifest_file(), array, idx, total, enc_in_filters, enc_ex_filters, key);
+		}
+		DirAccess::remove_file_or_error(manifest_tmp);
+		if (err != OK) {
+			return err;
+		}
+	}
+
 	Vector<String> forced_export = get_forced_export_files();
 	for (int i = 0; i < forced_export.size(); i++) {
 		Vector<uint8_t> array = FileAccess::get_file_as_bytes(forced_export[i]);
@@ -1570,6 +1658,15 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
 
+	Vector<String> compression_split = String(GLOBAL_GET("editor/export/pck_compression_filter")).split(",");
+	for (int i = 0; i < compression_split.size(); i++) {
+		String f = compression_split[i].strip_edges();
+		if (f.is_empty()) {
+			continue;
+		}
+		pd.compression_filters.push_back(f);
+	}
+
 	Error err = export_project_files(p_preset, p_debug, _save_pack_file, &pd, _add_shared_object);
 
 	// Close temp file.
@@ -1619,8 +1716,14 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	// Older versions can't read block-compressed entries, so only packs with some are marked as newer.
+	bool compressed_entries = false;
+	for (int i = 0; i < pd.file_ofs.size(); i++) {
+		compressed_entries = compressed_entries || pd.file_ofs[i].compressed;
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(compressed_entries ? PACK_FORMAT_VERSION_COMPRESSED : PACK_FORMAT_VERSION);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1710,6 +1813,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
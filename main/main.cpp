@@ -34,6 +34,7 @@
 #include "core/core_globals.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/profile_zones.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -241,6 +242,7 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static String profile_trace_file;
 #ifdef TOOLS_ENABLED
 static bool dump_gdextension_interface = false;
 static bool dump_extension_api = false;
@@ -625,6 +627,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--profile-trace <file>", "Record timings of engine profiling zones and save them to <file> in Chrome trace JSON format when quitting (can be opened with Perfetto).\n");
 
 	print_help_title("Standalone tools");
 	print_help_option("-s, --script <script>", "Run a script.\n");
@@ -722,6 +725,7 @@ Error Main::test_setup() {
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 	ResourceLoader::load_path_remaps();
+	ResourceLoader::load_prefetch_manifest();
 
 	// Initialize ThemeDB early so that scene types can register their theme items.
 	// Default theme will be initialized later, after modules and ScriptServer are ready.
@@ -1673,6 +1677,15 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
 			print_fps = true;
+		} else if (arg == "--profile-trace") {
+			if (N) {
+				profile_trace_file = N->get();
+				N = N->next();
+				ProfileZones::start_capture();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --profile-trace <file>.\n");
+				goto error;
+			}
 		} else if (arg == "--profile-gpu") {
 			profile_gpu = true;
 		} else if (arg == "--disable-crash-handler") {
@@ -2960,6 +2973,7 @@ Error Main::setup2(bool p_show_boot_logo) {
 		ResourceLoader::load_translation_remaps(); //load remaps for resources
 
 		ResourceLoader::load_path_remaps();
+		ResourceLoader::load_prefetch_manifest();
 
 		OS::get_singleton()->benchmark_end_measure("Startup", "Translations and Remaps");
 	}
@@ -3986,13 +4000,19 @@ bool Main::is_iterating() {
 static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
 static uint64_t navigation_process_max = 0;
+static uint64_t message_queue_flush_max = 0;
+static uint32_t message_queue_pages_max = 0;
 
 // Return false means iterating further, returning true means `OS::run`
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
 bool Main::iteration() {
+	GODOT_PROFILE_ZONE("Main::iteration");
 	iterating++;
 
+	// Everything allocated from the main thread's arena during the frame is released when it ends.
+	ThreadArenaScope arena_scope;
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -4015,6 +4035,8 @@ bool Main::iteration() {
 	uint64_t physics_process_ticks = 0;
 	uint64_t process_ticks = 0;
 	uint64_t navigation_process_ticks = 0;
+	const uint64_t message_queue_flush_begin = message_queue->get_flush_time_usec();
+	message_queue->reset_peak_pages_used();
 
 	frame += ticks_elapsed;
 
@@ -4037,6 +4059,8 @@ bool Main::iteration() {
 	NavigationServer3D::get_singleton()->sync();
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		GODOT_PROFILE_ZONE("Physics step");
+
 		if (Input::get_singleton()->is_agile_input_event_flushing()) {
 			Input::get_singleton()->flush_buffered_events();
 		}
@@ -4123,6 +4147,8 @@ bool Main::iteration() {
 
 	process_ticks = OS::get_singleton()->get_ticks_usec() - process_begin;
 	process_max = MAX(process_ticks, process_max);
+	message_queue_flush_max = MAX(message_queue->get_flush_time_usec() - message_queue_flush_begin, message_queue_flush_max);
+	message_queue_pages_max = MAX(message_queue->get_peak_pages_used(), message_queue_pages_max);
 	uint64_t frame_time = OS::get_singleton()->get_ticks_usec() - ticks;
 
 	for (int i = 0; i < ScriptServer::get_language_count(); i++) {
@@ -4156,9 +4182,13 @@ bool Main::iteration() {
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
 		performance->set_navigation_process_time(USEC_TO_SEC(navigation_process_max));
+		performance->set_message_queue_flush_time(USEC_TO_SEC(message_queue_flush_max));
+		performance->set_message_queue_pages_used(message_queue_pages_max);
 		process_max = 0;
 		physics_process_max = 0;
 		navigation_process_max = 0;
+		message_queue_flush_max = 0;
+		message_queue_pages_max = 0;
 
 		frame %= 1000000;
 		frames = 0;
@@ -4234,6 +4264,13 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+	if (ProfileZones::is_capturing()) {
+		ProfileZones::stop_capture();
+		if (ProfileZones::save_chrome_trace(profile_trace_file) == OK) {
+			print_line(vformat("Profile trace saved to \"%s\".", profile_trace_file));
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
@@ -4266,6 +4303,7 @@ void Main::cleanup(bool p_force) {
 
 	ResourceLoader::clear_translation_remaps();
 	ResourceLoader::clear_path_remaps();
+	ResourceLoader::clear_prefetch_manifest();
 
 	ScriptServer::finish_languages();
 
@@ -4372,6 +4410,12 @@ void Main::cleanup(bool p_force) {
 	message_queue->flush();
 	memdelete(message_queue);
 
+#ifdef DEV_ENABLED
+	if (OS::get_singleton()->is_stdout_verbose()) {
+		CowDataCopyStats::print();
+	}
+#endif
+
 #if defined(STEAMAPI_ENABLED)
 	if (steam_tracker) {
 		memdelete(steam_tracker);
@@ -4391,5 +4435,7 @@ void Main::cleanup(bool p_force) {
 	OS::get_singleton()->benchmark_end_measure("Shutdown", "Main::Cleanup");
 	OS::get_singleton()->benchmark_dump();
 
+	ProfileZones::free_buffers();
+
 	OS::get_singleton()->finalize_core();
 }
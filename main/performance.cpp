@@ -91,6 +91,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(TIME_MESSAGE_QUEUE_FLUSH);
+	BIND_ENUM_CONSTANT(MEMORY_MESSAGE_BUFFER_PAGES_USED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -141,6 +143,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation/edges_merged"),
 		PNAME("navigation/edges_connected"),
 		PNAME("navigation/edges_free"),
+		PNAME("time/message_queue_flush"),
+		PNAME("memory/msg_buf_pages_used"),
 
 	};
 
@@ -225,6 +229,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case TIME_MESSAGE_QUEUE_FLUSH:
+			return _message_queue_flush_time;
+		case MEMORY_MESSAGE_BUFFER_PAGES_USED:
+			return _message_queue_pages_used;
 
 		default: {
 		}
@@ -272,6 +280,8 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -290,6 +300,14 @@ void Performance::set_navigation_process_time(double p_pt) {
 	_navigation_process_time = p_pt;
 }
 
+void Performance::set_message_queue_flush_time(double p_ft) {
+	_message_queue_flush_time = p_ft;
+}
+
+void Performance::set_message_queue_pages_used(uint32_t p_pages) {
+	_message_queue_pages_used = p_pages;
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
@@ -337,6 +355,8 @@ Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
 	_navigation_process_time = 0;
+	_message_queue_flush_time = 0;
+	_message_queue_pages_used = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
 }
@@ -51,6 +51,8 @@ class Performance : public Object {
 	double _process_time;
 	double _physics_process_time;
 	double _navigation_process_time;
+	double _message_queue_flush_time;
+	uint32_t _message_queue_pages_used;
 
 	class MonitorCall {
 		Callable _callable;
@@ -100,6 +102,8 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		TIME_MESSAGE_QUEUE_FLUSH,
+		MEMORY_MESSAGE_BUFFER_PAGES_USED,
 		MONITOR_MAX
 	};
 
@@ -117,6 +121,8 @@ public:
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
 	void set_navigation_process_time(double p_pt);
+	void set_message_queue_flush_time(double p_ft);
+	void set_message_queue_pages_used(uint32_t p_pages);
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -98,6 +98,7 @@ complete -c godot -l disable-render-loop -d "Disable render loop so rendering on
 complete -c godot -l disable-crash-handler -d "Disable crash handler when supported by the platform code"
 complete -c godot -l fixed-fps -d "Force a fixed number of frames per second (this setting disables real-time synchronization)" -x
 complete -c godot -l print-fps -d "Print the frames per second to the stdout"
+complete -c godot -l profile-trace -d "Record engine profiling zones and save them to a file in Chrome trace JSON format" -r
 
 # Standalone tools:
 complete -c godot -s s -l script -d "Run a script" -r
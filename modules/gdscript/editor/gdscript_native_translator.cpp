@@ -0,0 +1,735 @@
+/**************************************************************************/
+/*  gdscript_native_translator.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native_translator.h"
+
+#include "../gdscript_byte_optimizer.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/version.h"
+
+struct GDScriptNativeTypedOperator {
+	int opcode;
+	const char *left; // Null for unary operators.
+	const char *op;
+	const char *right;
+	const char *result;
+	const char *result_type;
+};
+
+// Same expressions as the typed operator handlers of the VM.
+static const GDScriptNativeTypedOperator typed_operators[] = {
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_INT, "int", "+", "int", "int", "Variant::INT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT, "int", "-", "int", "int", "Variant::INT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT, "int", "*", "int", "int", "Variant::INT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT, "int", "==", "int", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT, "int", "!=", "int", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_INT, "int", "<", "int", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT, "int", "<=", "int", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_INT, "int", ">", "int", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT, "int", ">=", "int", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_NEGATE_INT, nullptr, "-", "int", "int", "Variant::INT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT, "float", "+", "float", "float", "Variant::FLOAT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT, "float", "-", "float", "float", "Variant::FLOAT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT, "float", "*", "float", "float", "Variant::FLOAT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT, "float", "/", "float", "float", "Variant::FLOAT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT, "float", "==", "float", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT, "float", "!=", "float", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT, "float", "<", "float", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT, "float", "<=", "float", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT, "float", ">", "float", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT, "float", ">=", "float", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_NEGATE_FLOAT, nullptr, "-", "float", "float", "Variant::FLOAT" },
+	{ GDScriptFunction::OPCODE_OPERATOR_EQUAL_BOOL, "bool", "==", "bool", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_BOOL, "bool", "!=", "bool", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_NOT_BOOL, nullptr, "!", "bool", "bool", "Variant::BOOL" },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2, "vector2", "+", "vector2", "vector2", "Variant::VECTOR2" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2, "vector2", "-", "vector2", "vector2", "Variant::VECTOR2" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2, "vector2", "*", "vector2", "vector2", "Variant::VECTOR2" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT, "vector2", "*", "float", "vector2", "Variant::VECTOR2" },
+	{ GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3, "vector3", "+", "vector3", "vector3", "Variant::VECTOR3" },
+	{ GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3, "vector3", "-", "vector3", "vector3", "Variant::VECTOR3" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3, "vector3", "*", "vector3", "vector3", "Variant::VECTOR3" },
+	{ GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT, "vector3", "*", "float", "vector3", "Variant::VECTOR3" },
+};
+
+struct GDScriptNativeCompareJump {
+	int opcode;
+	const char *type;
+	const char *test; // Applied to `left` and `right`.
+};
+
+static const GDScriptNativeCompareJump compare_jumps[] = {
+	{ GDScriptFunction::OPCODE_JUMP_IF_EQUAL_INT, "int", "%s == %s" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT, "int", "%s != %s" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT, "int", "!(%s < %s)" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT, "int", "!(%s <= %s)" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_EQUAL_FLOAT, "float", "%s == %s" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT, "float", "%s != %s" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_FLOAT, "float", "!(%s < %s)" },
+	{ GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT, "float", "!(%s <= %s)" },
+};
+
+// Adjusted types are in the order of Variant::Type.
+static_assert(GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL == Variant::PACKED_VECTOR4_ARRAY - Variant::BOOL, "Type adjust instructions changed.");
+
+static const char *extension_sconstruct = R"(#!/usr/bin/env python
+# Generated when exporting the project, do not edit.
+#
+# Builds the GDScript native code GDExtension. The code works on engine types directly, so it has
+# to be built against the sources of the engine running the game, with the same target and precision:
+#
+#     scons godot_path=<engine sources> target=template_release [precision=double] [arch=arm64]
+
+import os
+import sys
+
+opts = Variables()
+opts.Add(PathVariable("godot_path", "Path to the engine sources", "", PathVariable.PathIsDir))
+opts.Add(EnumVariable("target", "Compilation target", "template_release", ("editor", "template_debug", "template_release")))
+opts.Add(EnumVariable("precision", "Floating-point precision", "single", ("single", "double")))
+opts.Add("arch", "CPU architecture", "x86_64")
+
+env = Environment(ENV=os.environ, variables=opts)
+
+if sys.platform.startswith("win"):
+    platform = "windows"
+elif sys.platform == "darwin":
+    platform = "macos"
+else:
+    platform = "linux"
+
+env.Append(CPPPATH=[env["godot_path"]])
+if env["target"] == "editor":
+    env.Append(CPPDEFINES=["TOOLS_ENABLED"])
+if env["target"] != "template_release":
+    env.Append(CPPDEFINES=["DEBUG_ENABLED"])
+else:
+    env.Append(CPPDEFINES=["NDEBUG"])
+if env["precision"] == "double":
+    env.Append(CPPDEFINES=["REAL_T_IS_DOUBLE"])
+
+if platform == "windows" and env.get("CC") == "cl":
+    env.Append(CPPDEFINES=["WINDOWS_ENABLED", "TYPED_METHOD_BIND", "NOMINMAX"])
+    env.Append(CXXFLAGS=["/std:c++17", "/O2"])
+else:
+    env.Append(CPPDEFINES=["WINDOWS_ENABLED" if platform == "windows" else "UNIX_ENABLED"])
+    env.Append(CXXFLAGS=["-std=c++17", "-O2", "-fno-exceptions"])
+
+name = "gdscript_native.{}.{}".format(platform, env["target"])
+if platform != "macos":
+    name += "." + env["arch"]
+env["SHLIBPREFIX"] = ""
+env.SharedLibrary("bin/lib" + name, ["gdscript_native.cpp"])
+)";
+
+static const char *extension_library_entry = R"(
+#ifdef _WIN32
+#define GDSCRIPT_NATIVE_EXPORT __declspec(dllexport)
+#else
+#define GDSCRIPT_NATIVE_EXPORT __attribute__((visibility("default")))
+#endif
+
+static void _deinitialize(void *p_userdata, GDExtensionInitializationLevel p_level) {
+	if (p_level != GDEXTENSION_INITIALIZATION_CORE) {
+		return;
+	}
+
+	api->clear();
+}
+
+extern "C" {
+GDSCRIPT_NATIVE_EXPORT GDExtensionBool gdscript_native_library_init(GDExtensionInterfaceGetProcAddress p_get_proc_address, GDExtensionClassLibraryPtr p_library, GDExtensionInitialization *r_initialization) {
+	GDScriptNativeGetAPI get_api = (GDScriptNativeGetAPI)p_get_proc_address("gdscript_native_get_api");
+	if (!get_api) {
+		return false;
+	}
+	api = get_api(GDScriptNativeAPI::VERSION, GDScriptNativeAPI::get_build());
+	if (!api) {
+		return false;
+	}
+
+	r_initialization->minimum_initialization_level = GDEXTENSION_INITIALIZATION_CORE;
+	r_initialization->userdata = nullptr;
+	r_initialization->initialize = _initialize;
+	r_initialization->deinitialize = _deinitialize;
+	return true;
+}
+}
+)";
+
+static String _label(int p_position) {
+	return "L" + itos(p_position);
+}
+
+String GDScriptNativeTranslator::_get_address(Function &p_function, int p_address) {
+	const int index = p_address & GDScriptFunction::ADDR_MASK;
+	switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+		case GDScriptFunction::ADDR_TYPE_STACK:
+			if (index >= p_function.function->_stack_size) {
+				break;
+			}
+			p_function.uses_stack = true;
+			return "&stack[" + itos(index) + "]";
+		case GDScriptFunction::ADDR_TYPE_CONSTANT:
+			if (index >= p_function.function->_constant_count) {
+				break;
+			}
+			p_function.uses_constants = true;
+			return "&constants[" + itos(index) + "]";
+		case GDScriptFunction::ADDR_TYPE_MEMBER:
+			// Checked once on entry, as static functions have no members.
+			p_function.uses_members = true;
+			p_function.uses_line = true;
+			return "&members[" + itos(index) + "]";
+		default:
+			break;
+	}
+	p_function.valid = false;
+	return String();
+}
+
+String GDScriptNativeTranslator::_get_arguments(Function &p_function, const int *p_arguments, int p_argcount) {
+	if (p_argcount == 0) {
+		return "\t\tconst Variant **args = nullptr;";
+	}
+	String arguments;
+	for (int i = 0; i < p_argcount; i++) {
+		arguments += (i == 0 ? "" : ", ") + _get_address(p_function, p_arguments[i]);
+	}
+	return "\t\tconst Variant *args[] = { " + arguments + " };";
+}
+
+bool GDScriptNativeTranslator::_check_index(int p_index, int p_count) {
+	return p_index >= 0 && p_index < p_count;
+}
+
+bool GDScriptNativeTranslator::_collect_labels(Function &p_function) {
+	const GDScriptFunction *function = p_function.function;
+	const int *code = function->_code_ptr;
+	const int code_size = function->_code_size;
+
+	HashSet<int> instructions;
+	LocalVector<int> targets;
+	int ip = 0;
+	while (ip < code_size) {
+		const int size = GDScriptByteCodeOptimizer::_get_instruction_size(code, ip, code_size);
+		if (size <= 0 || ip + size > code_size) {
+			return false;
+		}
+		instructions.insert(ip);
+		const int jump_operand = GDScriptByteCodeOptimizer::_get_jump_operand(code[ip]);
+		if (jump_operand > 0) {
+			targets.push_back(code[ip + jump_operand]);
+		}
+		ip += size;
+	}
+	instructions.insert(code_size);
+
+	for (int i = 0; i < function->_default_arg_count; i++) {
+		targets.push_back(function->_default_arg_ptr[i]);
+	}
+	for (int target : targets) {
+		if (!instructions.has(target)) {
+			return false;
+		}
+		p_function.labels.insert(target);
+	}
+	return true;
+}
+
+bool GDScriptNativeTranslator::_translate_instruction(Function &p_function, const int *p_code, int p_size) {
+	const GDScriptFunction *function = p_function.function;
+	LocalVector<String> &lines = p_function.lines;
+	const int opcode = p_code[0];
+
+#define ADDRESS(m_index) _get_address(p_function, p_code[m_index])
+
+	for (const GDScriptNativeTypedOperator &E : typed_operators) {
+		if (E.opcode != opcode) {
+			continue;
+		}
+		lines.push_back("\t{");
+		if (E.left) {
+			lines.push_back(vformat("\t\tauto result = *VariantInternal::get_%s(%s) %s *VariantInternal::get_%s(%s);", E.left, ADDRESS(1), E.op, E.right, ADDRESS(2)));
+		} else {
+			lines.push_back(vformat("\t\tauto result = %s(*VariantInternal::get_%s(%s));", E.op, E.right, ADDRESS(1)));
+		}
+		lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_SET_TYPE(%s, %s);", ADDRESS(3), E.result_type));
+		lines.push_back(vformat("\t\t*VariantInternal::get_%s(%s) = result;", E.result, ADDRESS(3)));
+		lines.push_back("\t}");
+		return p_function.valid;
+	}
+
+	for (const GDScriptNativeCompareJump &E : compare_jumps) {
+		if (E.opcode != opcode) {
+			continue;
+		}
+		String left = vformat("*VariantInternal::get_%s(%s)", E.type, ADDRESS(1));
+		String right = vformat("*VariantInternal::get_%s(%s)", E.type, ADDRESS(2));
+		lines.push_back(vformat("\tif (%s) {", vformat(E.test, left, right)));
+		lines.push_back("\t\tgoto " + _label(p_code[3]) + ";");
+		lines.push_back("\t}");
+		return p_function.valid;
+	}
+
+	if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+		lines.push_back(vformat("\tp_context.api->type_adjust(%s, Variant::Type(%d));", ADDRESS(1), Variant::BOOL + opcode - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL));
+		return p_function.valid;
+	}
+
+	// Instructions with a variable number of arguments.
+	const int instruction_argcount = p_size > 1 ? p_code[1] : 0;
+	const int *arguments = p_code + 2;
+	const int argcount = p_size > 2 + instruction_argcount ? p_code[2 + instruction_argcount] : 0;
+	const int argument_index = p_size > 3 + instruction_argcount ? p_code[3 + instruction_argcount] : 0;
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			if (!_check_index(p_code[4], function->_operator_funcs_count)) {
+				return false;
+			}
+			lines.push_back(vformat("\tp_context.operator_funcs[%d](%s, %s, %s);", p_code[4], ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN: {
+			if (!_check_index(p_code[3], Variant::VARIANT_MAX)) {
+				return false;
+			}
+			lines.push_back("\t{");
+			lines.push_back(vformat("\t\tconst bool result = (%s)->get_type() == Variant::Type(%d);", ADDRESS(2), p_code[3]));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_SET_TYPE(%s, Variant::BOOL);", ADDRESS(1)));
+			lines.push_back(vformat("\t\t*VariantInternal::get_bool(%s) = result;", ADDRESS(1)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+			if (!_check_index(p_code[4], function->_keyed_setters_count)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back("\t{");
+			lines.push_back("\t\tbool valid;");
+			lines.push_back(vformat("\t\tp_context.keyed_setters[%d](%s, %s, %s, &valid);", p_code[4], ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_DEBUG_CHECK(valid || p_context.api->fail_set_keyed(p_context, %s, %s, %s));", ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			if (!_check_index(p_code[4], function->_indexed_setters_count)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back("\t{");
+			lines.push_back("\t\tbool oob;");
+			lines.push_back(vformat("\t\tp_context.indexed_setters[%d](%s, *VariantInternal::get_int(%s), %s, &oob);", p_code[4], ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_DEBUG_CHECK(!oob || p_context.api->fail_set_indexed(p_context, %s, %s));", ADDRESS(1), ADDRESS(2)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+			if (!_check_index(p_code[4], function->_keyed_getters_count)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			if (p_code[3] == p_code[1] || p_code[3] == p_code[2]) {
+				// Like the VM, goes through a temporary when the result overwrites an operand.
+				lines.push_back(vformat("\tGDSCRIPT_NATIVE_CHECK(p_context.api->get_keyed_aliased(p_context, %d, %s, %s, %s));", p_code[4], ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+				break;
+			}
+			lines.push_back("\t{");
+			lines.push_back("\t\tbool valid;");
+			lines.push_back(vformat("\t\tp_context.keyed_getters[%d](%s, %s, %s, &valid);", p_code[4], ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_DEBUG_CHECK(valid || p_context.api->fail_get_keyed(p_context, %s, %s));", ADDRESS(1), ADDRESS(2)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			if (!_check_index(p_code[4], function->_indexed_getters_count)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back("\t{");
+			lines.push_back("\t\tbool oob;");
+			lines.push_back(vformat("\t\tp_context.indexed_getters[%d](%s, *VariantInternal::get_int(%s), %s, &oob);", p_code[4], ADDRESS(1), ADDRESS(2), ADDRESS(3)));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_DEBUG_CHECK(!oob || p_context.api->fail_get_indexed(p_context, %s, %s));", ADDRESS(1), ADDRESS(2)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			if (!_check_index(p_code[3], function->_setters_count)) {
+				return false;
+			}
+			lines.push_back(vformat("\tp_context.setters[%d](%s, %s);", p_code[3], ADDRESS(1), ADDRESS(2)));
+		} break;
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			if (!_check_index(p_code[3], function->_getters_count)) {
+				return false;
+			}
+			lines.push_back(vformat("\tp_context.getters[%d](%s, %s);", p_code[3], ADDRESS(1), ADDRESS(2)));
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			lines.push_back(vformat("\tp_context.api->assign(%s, %s);", ADDRESS(1), ADDRESS(2)));
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL: {
+			lines.push_back(vformat("\tp_context.api->initialize(%s, Variant::NIL);", ADDRESS(1)));
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			lines.push_back(vformat("\tGDSCRIPT_NATIVE_SET_TYPE(%s, Variant::BOOL);", ADDRESS(1)));
+			lines.push_back(vformat("\t*VariantInternal::get_bool(%s) = %s;", ADDRESS(1), opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE ? "true" : "false"));
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			if (!_check_index(p_code[3], Variant::VARIANT_MAX)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back(vformat("\tGDSCRIPT_NATIVE_CHECK(p_context.api->assign_typed_builtin(p_context, %s, %s, Variant::Type(%d)));", ADDRESS(1), ADDRESS(2), p_code[3]));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			if (argcount + 1 != instruction_argcount || !_check_index(argument_index, function->_constructors_count)) {
+				return false;
+			}
+			lines.push_back("\t{");
+			lines.push_back(_get_arguments(p_function, arguments, argcount));
+			lines.push_back(vformat("\t\tp_context.constructors[%d](%s, args);", argument_index, ADDRESS(2 + argcount)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN: {
+			const bool has_return = opcode == GDScriptFunction::OPCODE_CALL_RETURN;
+			if (argcount + (has_return ? 2 : 1) != instruction_argcount || !_check_index(argument_index, function->_global_names_count)) {
+				return false;
+			}
+			const int inline_cache = p_code[4 + instruction_argcount];
+			if (!_check_index(inline_cache, function->_inline_caches_count)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back("\t{");
+			lines.push_back(_get_arguments(p_function, arguments, argcount));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_CHECK(p_context.api->call(p_context, %d, %s, p_context.global_names[%d], args, %d, %s));", inline_cache, ADDRESS(2 + argcount), argument_index, argcount, has_return ? ADDRESS(3 + argcount) : String("nullptr")));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			if (argcount + 1 != instruction_argcount || !_check_index(argument_index, function->_utilities_count)) {
+				return false;
+			}
+			lines.push_back("\t{");
+			lines.push_back(_get_arguments(p_function, arguments, argcount));
+			lines.push_back(vformat("\t\tp_context.utilities[%d](%s, args, %d);", argument_index, ADDRESS(2 + argcount), argcount));
+			lines.push_back("\t}");
+		} break;
+#ifdef DEBUG_ENABLED
+		// Utility names are only kept in debug builds, and are needed to report errors.
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+			if (argcount + 1 != instruction_argcount || !_check_index(argument_index, function->_gds_utilities_count) || !_check_index(argument_index, function->gds_utilities_names.size())) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back("\t{");
+			lines.push_back(_get_arguments(p_function, arguments, argcount));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_CHECK(p_context.api->call_gdscript_utility(p_context, %d, \"%s\", %s, args, %d));", argument_index, function->gds_utilities_names[argument_index].c_escape(), ADDRESS(2 + argcount), argcount));
+			lines.push_back("\t}");
+		} break;
+#endif
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			if (argcount + 2 != instruction_argcount || !_check_index(argument_index, function->_builtin_methods_count)) {
+				return false;
+			}
+			lines.push_back("\t{");
+			lines.push_back(_get_arguments(p_function, arguments, argcount));
+			lines.push_back(vformat("\t\tp_context.builtin_methods[%d](%s, args, %d, %s);", argument_index, ADDRESS(2 + argcount), argcount, ADDRESS(3 + argcount)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+			if (argcount + 2 != instruction_argcount || !_check_index(argument_index, function->_methods_count)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back("\t{");
+			lines.push_back(vformat("\t\tMethodBind *method = p_context.methods[%d];", argument_index));
+			lines.push_back("\t\tObject *object;");
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_CHECK(p_context.api->get_method_base(p_context, %s, method, object));", ADDRESS(2 + argcount)));
+			lines.push_back(_get_arguments(p_function, arguments, argcount));
+			if (opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN) {
+				lines.push_back(vformat("\t\tmethod->validated_call(object, args, %s);", ADDRESS(3 + argcount)));
+			} else {
+				lines.push_back(vformat("\t\tp_context.api->initialize(%s, Variant::NIL);", ADDRESS(3 + argcount)));
+				lines.push_back("\t\tmethod->validated_call(object, args, nullptr);");
+			}
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			lines.push_back("\tgoto " + _label(p_code[1]) + ";");
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			lines.push_back(vformat("\tif (%sp_context.api->booleanize(%s)) {", opcode == GDScriptFunction::OPCODE_JUMP_IF_NOT ? "!" : "", ADDRESS(1)));
+			lines.push_back("\t\tgoto " + _label(p_code[2]) + ";");
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL: {
+			lines.push_back(vformat("\tif (%s*VariantInternal::get_bool(%s)) {", opcode == GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL ? "!" : "", ADDRESS(1)));
+			lines.push_back("\t\tgoto " + _label(p_code[2]) + ";");
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+			lines.push_back(vformat("\tif (p_context.api->is_shared(%s)) {", ADDRESS(1)));
+			lines.push_back("\t\tgoto " + _label(p_code[2]) + ";");
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			lines.push_back("\tswitch (p_context.default_argument) {");
+			for (int i = 0; i < function->_default_arg_count; i++) {
+				lines.push_back(vformat("\t\tcase %d:", i));
+				lines.push_back("\t\t\tgoto " + _label(function->_default_arg_ptr[i]) + ";");
+			}
+			lines.push_back("\t\tdefault:");
+			lines.push_back("\t\t\tbreak;");
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			lines.push_back(vformat("\tp_context.api->assign(p_context.result, %s);", ADDRESS(1)));
+			lines.push_back("\treturn true;");
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			if (!_check_index(p_code[2], Variant::VARIANT_MAX)) {
+				return false;
+			}
+			p_function.uses_line = true;
+			lines.push_back(vformat("\tGDSCRIPT_NATIVE_CHECK(p_context.api->return_typed_builtin(p_context, %s, Variant::Type(%d)));", ADDRESS(1), p_code[2]));
+			lines.push_back("\treturn true;");
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT: {
+			lines.push_back("\t{");
+			lines.push_back(vformat("\t\tconst int64_t size = *VariantInternal::get_int(%s);", ADDRESS(2)));
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_SET_TYPE(%s, Variant::INT);", ADDRESS(1)));
+			lines.push_back(vformat("\t\t*VariantInternal::get_int(%s) = 0;", ADDRESS(1)));
+			lines.push_back("\t\tif (size <= 0) {");
+			lines.push_back("\t\t\tgoto " + _label(p_code[4]) + ";");
+			lines.push_back("\t\t}");
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_SET_TYPE(%s, Variant::INT);", ADDRESS(3)));
+			lines.push_back(vformat("\t\t*VariantInternal::get_int(%s) = 0;", ADDRESS(3)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			lines.push_back("\t{");
+			lines.push_back(vformat("\t\tint64_t *count = VariantInternal::get_int(%s);", ADDRESS(1)));
+			lines.push_back("\t\t(*count)++;");
+			lines.push_back(vformat("\t\tif (*count >= *VariantInternal::get_int(%s)) {", ADDRESS(2)));
+			lines.push_back("\t\t\tgoto " + _label(p_code[4]) + ";");
+			lines.push_back("\t\t}");
+			lines.push_back(vformat("\t\t*VariantInternal::get_int(%s) = *count;", ADDRESS(3)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY: {
+			lines.push_back("\t{");
+			lines.push_back(vformat("\t\tGDSCRIPT_NATIVE_SET_TYPE(%s, Variant::INT);", ADDRESS(1)));
+			lines.push_back(vformat("\t\t*VariantInternal::get_int(%s) = 0;", ADDRESS(1)));
+			lines.push_back(vformat("\t\tif (p_context.api->array_size(%s) == 0) {", ADDRESS(2)));
+			lines.push_back("\t\t\tgoto " + _label(p_code[4]) + ";");
+			lines.push_back("\t\t}");
+			lines.push_back(vformat("\t\tp_context.api->array_get(%s, 0, %s);", ADDRESS(2), ADDRESS(3)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_ARRAY: {
+			lines.push_back("\t{");
+			lines.push_back(vformat("\t\tint64_t *index = VariantInternal::get_int(%s);", ADDRESS(1)));
+			lines.push_back("\t\t(*index)++;");
+			lines.push_back(vformat("\t\tif (*index >= p_context.api->array_size(%s)) {", ADDRESS(2)));
+			lines.push_back("\t\t\tgoto " + _label(p_code[4]) + ";");
+			lines.push_back("\t\t}");
+			lines.push_back(vformat("\t\tp_context.api->array_get(%s, *index, %s);", ADDRESS(2), ADDRESS(3)));
+			lines.push_back("\t}");
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			// Dropped again if nothing can fail, see `_translate()`.
+			lines.push_back("\tline = " + itos(p_code[1]) + ";");
+		} break;
+		case GDScriptFunction::OPCODE_BREAKPOINT: {
+			// Native code never runs while debugging.
+		} break;
+		case GDScriptFunction::OPCODE_END: {
+			lines.push_back("\treturn true;");
+		} break;
+		default: {
+			// Everything else depends on state the VM keeps locally, or is too rare in
+			// statically typed code to be worth it.
+			return false;
+		}
+	}
+
+#undef ADDRESS
+
+	return p_function.valid;
+}
+
+bool GDScriptNativeTranslator::_translate(const GDScriptFunction *p_function, const String &p_symbol, String &r_code) {
+	Function function;
+	function.function = p_function;
+	if (!_collect_labels(function)) {
+		return false;
+	}
+
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	int ip = 0;
+	while (ip < code_size) {
+		const int size = GDScriptByteCodeOptimizer::_get_instruction_size(code, ip, code_size);
+		if (function.labels.has(ip)) {
+			function.lines.push_back(_label(ip) + ":");
+		}
+		if (!_translate_instruction(function, code + ip, size)) {
+			return false;
+		}
+		ip += size;
+	}
+	if (function.labels.has(code_size)) {
+		function.lines.push_back(_label(code_size) + ":");
+		function.lines.push_back("\treturn true;");
+	}
+
+	r_code = "// " + GDScriptNative::get_function_key(p_function) + "\n";
+	r_code += "static bool " + p_symbol + "(GDScriptNativeContext &p_context) {\n";
+	if (function.uses_stack) {
+		r_code += "\tVariant *stack = p_context.stack;\n";
+	}
+	if (function.uses_constants) {
+		r_code += "\tVariant *constants = p_context.constants;\n";
+	}
+	if (function.uses_members) {
+		r_code += "\tVariant *members = p_context.members;\n";
+	}
+	if (function.uses_line) {
+		r_code += "\tint line = " + itos(p_function->_initial_line) + ";\n";
+	}
+	if (function.uses_members) {
+		r_code += "\tGDSCRIPT_NATIVE_CHECK(members || p_context.api->fail_member_access(p_context));\n";
+	}
+	r_code += "\n";
+
+	for (const String &line : function.lines) {
+		if (!function.uses_line && line.begins_with("\tline = ")) {
+			continue;
+		}
+		r_code += line + "\n";
+	}
+	r_code += "}\n";
+
+	return true;
+}
+
+void GDScriptNativeTranslator::_add_function(const GDScriptFunction *p_function) {
+	if (!p_function) {
+		return;
+	}
+
+	const String symbol = "_gdscript_native_" + itos(translated_count);
+	String code;
+	if (_translate(p_function, symbol, code)) {
+		functions_code += "\n" + code;
+		registrations_code += vformat("\tapi->register_function(\"%s\", &%s);\n", GDScriptNative::get_function_key(p_function).c_escape(), symbol);
+		translated_count++;
+	} else {
+		skipped_count++;
+	}
+
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		_add_function(lambda);
+	}
+}
+
+void GDScriptNativeTranslator::add_script(const Ref<GDScript> &p_script) {
+	ERR_FAIL_COND(p_script.is_null());
+
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_add_function(E.value);
+	}
+	_add_function(p_script->implicit_initializer);
+	_add_function(p_script->implicit_ready);
+	_add_function(p_script->static_initializer);
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		add_script(E.value);
+	}
+}
+
+Error GDScriptNativeTranslator::write_extension(const String &p_path) const {
+	const String path = p_path.path_join("gdscript_native");
+	Error err = DirAccess::make_dir_recursive_absolute(path);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Can't create the GDScript native code directory "%s".)", path));
+
+	String code = "/* Generated when exporting the project, do not edit. */\n\n";
+	code += "#include \"modules/gdscript/gdscript_native.h\"\n\n";
+	code += "#include \"core/extension/gdextension_interface.h\"\n";
+	code += "#include \"core/object/method_bind.h\"\n";
+	code += "#include \"core/variant/variant_internal.h\"\n";
+	code += functions_code;
+	// Only used to register the functions, the ones they call come with the context.
+	code += "\nstatic const GDScriptNativeAPI *api = nullptr;\n\n";
+	code += "static void _initialize(void *p_userdata, GDExtensionInitializationLevel p_level) {\n";
+	code += "\tif (p_level != GDEXTENSION_INITIALIZATION_CORE) {\n\t\treturn;\n\t}\n\n";
+	code += registrations_code;
+	code += "}\n";
+	code += extension_library_entry;
+
+	// Libraries are looked up next to the configuration, where the SConstruct builds them.
+	String configuration = "; Generated when exporting the project, do not edit.\n\n";
+	configuration += "[configuration]\n\n";
+	configuration += "entry_symbol = \"gdscript_native_library_init\"\n";
+	configuration += vformat("compatibility_minimum = \"%d.%d\"\n", VERSION_MAJOR, VERSION_MINOR);
+	configuration += "\n[libraries]\n\n";
+	const char *targets[] = { "editor", "template_debug", "template_release" };
+	for (const char *target : targets) {
+		for (const char *arch : { "x86_64", "arm64" }) {
+			configuration += vformat("linux.%s.%s = \"bin/libgdscript_native.linux.%s.%s.so\"\n", target, arch, target, arch);
+			configuration += vformat("windows.%s.%s = \"bin/libgdscript_native.windows.%s.%s.dll\"\n", target, arch, target, arch);
+		}
+		configuration += vformat("macos.%s = \"bin/libgdscript_native.macos.%s.dylib\"\n", target, target);
+	}
+
+	const String files[][2] = {
+		{ "SConstruct", extension_sconstruct },
+		{ "gdscript_native.gdextension", configuration },
+		{ "gdscript_native.cpp", code },
+	};
+	for (const String *file : files) {
+		Ref<FileAccess> f = FileAccess::open(path.path_join(file[0]), FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Can't write the GDScript native code file "%s".)", path.path_join(file[0])));
+		f->store_string(file[1]);
+	}
+
+	return OK;
+}
+
+void GDScriptNativeTranslator::clear() {
+	functions_code = String();
+	registrations_code = String();
+	translated_count = 0;
+	skipped_count = 0;
+}
@@ -0,0 +1,85 @@
+/**************************************************************************/
+/*  gdscript_native_translator.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_TRANSLATOR_H
+#define GDSCRIPT_NATIVE_TRANSLATOR_H
+
+#include "../gdscript.h"
+
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+// Lowers the bytecode of script functions to C++, for the projects that export their scripts
+// compiled and build their own export templates. Only instructions with a direct native
+// equivalent are handled, which covers most of what the compiler emits for statically typed
+// code; functions using anything else are left out and keep running as bytecode.
+//
+// The output is a GDExtension registering every translated function with GDScriptNative. It's
+// built against the engine headers, and calls into the engine through GDScriptNativeAPI only.
+// Generated code addresses the stack, constants and dispatch tables exactly like the bytecode
+// does, so it has to match the bytecode the game loads, which is checked by hash at runtime.
+class GDScriptNativeTranslator {
+	struct Function {
+		const GDScriptFunction *function = nullptr;
+		HashSet<int> labels;
+		LocalVector<String> lines;
+		bool uses_stack = false;
+		bool uses_constants = false;
+		bool uses_members = false;
+		bool uses_line = false;
+		bool valid = true; // Cleared when an operand can't be translated.
+	};
+
+	String functions_code;
+	String registrations_code;
+	int translated_count = 0;
+	int skipped_count = 0;
+
+	static String _get_address(Function &p_function, int p_address);
+	static String _get_arguments(Function &p_function, const int *p_arguments, int p_argcount);
+	static bool _check_index(int p_index, int p_count);
+	static bool _collect_labels(Function &p_function);
+	static bool _translate_instruction(Function &p_function, const int *p_code, int p_size);
+	static bool _translate(const GDScriptFunction *p_function, const String &p_symbol, String &r_code);
+
+	void _add_function(const GDScriptFunction *p_function);
+
+public:
+	void add_script(const Ref<GDScript> &p_script);
+	int get_translated_count() const { return translated_count; }
+	int get_skipped_count() const { return skipped_count; }
+
+	// Writes the extension source, its SConstruct and its `.gdextension` file to a `gdscript_native`
+	// directory inside `p_path`. Once built, the directory is used as is, from within the project.
+	Error write_extension(const String &p_path) const;
+	void clear();
+};
+
+#endif // GDSCRIPT_NATIVE_TRANSLATOR_H
@@ -31,10 +31,12 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_byte_serializer.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -799,6 +801,24 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	GDScriptFunction::invalidate_inline_caches();
+
+	if (!compiled_bytecode.is_empty() && !has_instances) {
+		// Exported scripts may come already compiled, skipping the parser and the analyzer.
+		if (GDScriptByteCodeSerializer::load(this, compiled_bytecode) == OK) {
+			if (ScriptServer::is_scripting_enabled() || is_tool()) {
+				Error err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+		// Some reference couldn't be resolved, the tokens are still there to compile from.
+		compiled_bytecode.clear();
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -998,14 +1018,9 @@ bool GDScript::_set(const StringName &p_name, const Variant &p_value) {
 		HashMap<StringName, MemberInfo>::ConstIterator E = top->static_variables_indices.find(p_name);
 		if (E) {
 			const MemberInfo *member = &E->value;
-			Variant value = p_value;
-			if (member->data_type.has_type && !member->data_type.is_type(value)) {
-				const Variant *args = &p_value;
-				Callable::CallError err;
-				Variant::construct(member->data_type.builtin_type, value, &args, 1, err);
-				if (err.error != Callable::CallError::CALL_OK || !member->data_type.is_type(value)) {
-					return false;
-				}
+			Variant value;
+			if (!member->data_type.convert_for_set(p_value, value)) {
+				return false;
 			}
 			if (likely(top->valid) && member->setter) {
 				const Variant *args = &value;
@@ -1125,6 +1140,10 @@ const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
 	return binary_tokens;
 }
 
+void GDScript::set_compiled_bytecode(const Vector<uint8_t> &p_compiled_bytecode) {
+	compiled_bytecode = p_compiled_bytecode;
+}
+
 Vector<uint8_t> GDScript::get_as_binary_tokens() const {
 	GDScriptTokenizerBuffer tokenizer;
 	return tokenizer.parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
@@ -1518,6 +1537,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptFunction::invalidate_inline_caches();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -1651,14 +1671,9 @@ bool GDScriptInstance::set(const StringName &p_name, const Variant &p_value) {
 		HashMap<StringName, GDScript::MemberInfo>::Iterator E = script->member_indices.find(p_name);
 		if (E) {
 			const GDScript::MemberInfo *member = &E->value;
-			Variant value = p_value;
-			if (member->data_type.has_type && !member->data_type.is_type(value)) {
-				const Variant *args = &p_value;
-				Callable::CallError err;
-				Variant::construct(member->data_type.builtin_type, value, &args, 1, err);
-				if (err.error != Callable::CallError::CALL_OK || !member->data_type.is_type(value)) {
-					return false;
-				}
+			Variant value;
+			if (!member->data_type.convert_for_set(p_value, value)) {
+				return false;
 			}
 			if (likely(script->valid) && member->setter) {
 				const Variant *args = &value;
@@ -1678,14 +1693,9 @@ bool GDScriptInstance::set(const StringName &p_name, const Variant &p_value) {
 			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = sptr->static_variables_indices.find(p_name);
 			if (E) {
 				const GDScript::MemberInfo *member = &E->value;
-				Variant value = p_value;
-				if (member->data_type.has_type && !member->data_type.is_type(value)) {
-					const Variant *args = &p_value;
-					Callable::CallError err;
-					Variant::construct(member->data_type.builtin_type, value, &args, 1, err);
-					if (err.error != Callable::CallError::CALL_OK || !member->data_type.is_type(value)) {
-						return false;
-					}
+				Variant value;
+				if (!member->data_type.convert_for_set(p_value, value)) {
+					return false;
 				}
 				if (likely(sptr->valid) && member->setter) {
 					const Variant *args = &value;
@@ -2205,6 +2215,8 @@ void GDScriptLanguage::remove_named_global_constant(const StringName &p_name) {
 }
 
 void GDScriptLanguage::init() {
+	GDScriptFunctionState::init_stack_pool();
+
 	//populate global constants
 	int gcc = CoreConstants::get_global_constant_count();
 	for (int i = 0; i < gcc; i++) {
@@ -2255,6 +2267,13 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	if (sampling_profiler) {
+		memdelete(sampling_profiler);
+		sampling_profiler = nullptr;
+	}
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2290,6 +2309,7 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFunctionState::clear_stack_pool();
 
 	finishing = false;
 }
@@ -2314,7 +2334,18 @@ void GDScriptLanguage::profiling_start() {
 		elem = elem->next();
 	}
 
-	profiling = true;
+	if (sampling_profiler) {
+		memdelete(sampling_profiler);
+		sampling_profiler = nullptr;
+	}
+
+	if (GLOBAL_GET("debug/settings/gdscript/sampling_profiler")) {
+		// Functions are not timed individually in this mode, so calls run without profiling overhead.
+		sampling_profiler = memnew(GDScriptSamplingProfiler);
+		sampling_profiler->start(GLOBAL_GET("debug/settings/gdscript/sampling_profiler_interval_usec"));
+	} else {
+		profiling = true;
+	}
 #endif
 }
 
@@ -2330,6 +2361,17 @@ void GDScriptLanguage::profiling_stop() {
 	MutexLock lock(mutex);
 
 	profiling = false;
+
+	if (sampling_profiler) {
+		// Kept until profiling starts again, so the accumulated data can still be queried.
+		sampling_profiler->stop();
+		sampling_profiler->collect(function_list);
+
+		String folded_stacks_path = GLOBAL_GET("debug/settings/gdscript/sampling_profiler_folded_stacks_path");
+		if (!folded_stacks_path.is_empty()) {
+			sampling_profiler->save_folded_stacks(folded_stacks_path);
+		}
+	}
 #endif
 }
 
@@ -2339,6 +2381,11 @@ int GDScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr,
 
 	MutexLock lock(mutex);
 
+	if (sampling_profiler) {
+		sampling_profiler->collect(function_list);
+		return sampling_profiler->get_accumulated_data(p_info_arr, p_info_max);
+	}
+
 	profiling_collate_native_call_data(true);
 	SelfList<GDScriptFunction> *elem = function_list.first();
 	while (elem) {
@@ -2377,6 +2424,10 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 #ifdef DEBUG_ENABLED
 	MutexLock lock(mutex);
 
+	if (sampling_profiler) {
+		return sampling_profiler->get_frame_data(p_info_arr, p_info_max);
+	}
+
 	profiling_collate_native_call_data(false);
 	SelfList<GDScriptFunction> *elem = function_list.first();
 	while (elem) {
@@ -2646,6 +2697,12 @@ void GDScriptLanguage::frame() {
 		}
 	}
 
+	if (sampling_profiler) {
+		MutexLock lock(mutex);
+
+		sampling_profiler->collect(function_list);
+		sampling_profiler->frame();
+	}
 #endif
 }
 
@@ -2839,6 +2896,18 @@ String GDScriptLanguage::get_global_class_name(const String &p_path, String *r_b
 }
 
 thread_local GDScriptLanguage::CallStack GDScriptLanguage::_call_stack;
+Mutex GDScriptLanguage::call_stacks_mutex;
+LocalVector<GDScriptLanguage::CallStack *> GDScriptLanguage::call_stacks;
+
+void GDScriptLanguage::_register_call_stack(CallStack *p_call_stack) {
+	MutexLock lock(call_stacks_mutex);
+	call_stacks.push_back(p_call_stack);
+}
+
+void GDScriptLanguage::_unregister_call_stack(CallStack *p_call_stack) {
+	MutexLock lock(call_stacks_mutex);
+	call_stacks.erase(p_call_stack);
+}
 
 GDScriptLanguage::GDScriptLanguage() {
 	calls = 0;
@@ -2870,7 +2939,13 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	optimize_bytecode = GLOBAL_DEF("debug/settings/gdscript/optimize_bytecode", true);
+
 #ifdef DEBUG_ENABLED
+	GLOBAL_DEF("debug/settings/gdscript/sampling_profiler", false);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/gdscript/sampling_profiler_interval_usec", PROPERTY_HINT_RANGE, "50,100000,1"), 1000);
+	GLOBAL_DEF("debug/settings/gdscript/sampling_profiler_folded_stacks_path", "");
+
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
 	for (int i = 0; i < (int)GDScriptWarning::WARNING_MAX; i++) {
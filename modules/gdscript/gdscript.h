@@ -39,8 +39,11 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_set.h"
 
+class GDScriptSamplingProfiler;
+
 class GDScriptNativeClass : public RefCounted {
 	GDCLASS(GDScriptNativeClass, RefCounted);
 
@@ -84,11 +87,13 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptByteCodeSerializer;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
+	friend class GDScriptNativeTranslator;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	Ref<GDScriptNativeClass> native;
@@ -178,6 +183,7 @@ private:
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> compiled_bytecode;
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -306,6 +312,7 @@ public:
 
 	void set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens);
 	const Vector<uint8_t> &get_binary_tokens_source() const;
+	void set_compiled_bytecode(const Vector<uint8_t> &p_compiled_bytecode);
 	Vector<uint8_t> get_as_binary_tokens() const;
 
 	bool get_property_default_value(const StringName &p_property, Variant &r_value) const override;
@@ -408,6 +415,8 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
+	friend class TestGDScriptLanguageInternalsAccessor;
 
 	static GDScriptLanguage *singleton;
 
@@ -435,7 +444,8 @@ class GDScriptLanguage : public ScriptLanguage {
 
 		void free() {
 			if (levels) {
-				memdelete(levels);
+				_unregister_call_stack(this);
+				memdelete_arr(levels);
 				levels = nullptr;
 			}
 		}
@@ -447,6 +457,13 @@ class GDScriptLanguage : public ScriptLanguage {
 	static thread_local CallStack _call_stack;
 	int _debug_max_call_stack = 0;
 
+	// Every thread's call stack, so they can be inspected from other threads while sampling.
+	static Mutex call_stacks_mutex;
+	static LocalVector<CallStack *> call_stacks;
+	static void _register_call_stack(CallStack *p_call_stack);
+	static void _unregister_call_stack(CallStack *p_call_stack);
+	bool optimize_bytecode = true;
+
 	void _add_global(const StringName &p_name, const Variant &p_value);
 
 	friend class GDScriptInstance;
@@ -462,6 +479,9 @@ class GDScriptLanguage : public ScriptLanguage {
 	bool profiling;
 	bool profile_native_calls;
 	uint64_t script_frame_time;
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler *sampling_profiler = nullptr;
+#endif
 
 	HashMap<String, ObjectID> orphan_subclasses;
 
@@ -474,6 +494,7 @@ public:
 	_FORCE_INLINE_ void enter_function(GDScriptInstance *p_instance, GDScriptFunction *p_function, Variant *p_stack, int *p_ip, int *p_line) {
 		if (unlikely(_call_stack.levels == nullptr)) {
 			_call_stack.levels = memnew_arr(CallLevel, _debug_max_call_stack + 1);
+			_register_call_stack(&_call_stack);
 		}
 
 		if (EngineDebugger::get_script_debugger()->get_lines_left() > 0 && EngineDebugger::get_script_debugger()->get_depth() >= 0) {
@@ -545,6 +566,7 @@ public:
 	Variant get_any_global_constant(const StringName &p_name);
 
 	_FORCE_INLINE_ static GDScriptLanguage *get_singleton() { return singleton; }
+	_FORCE_INLINE_ bool is_bytecode_optimization_enabled() const { return optimize_bytecode; }
 
 	virtual String get_name() const override;
 
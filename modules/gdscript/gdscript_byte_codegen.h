@@ -98,6 +98,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -383,6 +384,18 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		instr_args_max = MAX(instr_args_max, p_argument_count);
 	}
 
+	bool write_typed_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand, const Address &p_right_operand);
+
+	void append_jump_if(bool p_value, const Address &p_condition) {
+		// Known booleans don't need to be converted to test them.
+		if (p_condition.type.has_type && p_condition.type.kind == GDScriptDataType::BUILTIN && p_condition.type.builtin_type == Variant::BOOL) {
+			append_opcode(p_value ? GDScriptFunction::OPCODE_JUMP_IF_BOOL : GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL);
+		} else {
+			append_opcode(p_value ? GDScriptFunction::OPCODE_JUMP_IF : GDScriptFunction::OPCODE_JUMP_IF_NOT);
+		}
+		append(p_condition);
+	}
+
 	void append(int p_code) {
 		opcodes.push_back(p_code);
 	}
@@ -447,6 +460,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	// Each untyped named access or call gets its own slot in GDScriptFunction::inline_caches.
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
 	}
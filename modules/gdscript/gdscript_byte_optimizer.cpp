@@ -0,0 +1,1155 @@
+/**************************************************************************/
+/*  gdscript_byte_optimizer.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_byte_optimizer.h"
+
+// Upper bound on the rounds of passes; each round usually only exposes a handful of new opportunities.
+#define MAX_OPTIMIZATION_ROUNDS 8
+// Upper bound on how many instructions a jump is followed through when threading it.
+#define MAX_THREADING_STEPS 16
+
+int GDScriptByteCodeOptimizer::_get_instruction_size(const int *p_code, int p_position, int p_code_size) {
+	const int opcode = p_code[p_position];
+
+	if (opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+		return 4;
+	}
+	if (opcode >= GDScriptFunction::OPCODE_JUMP_IF_EQUAL_INT && opcode <= GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT) {
+		return 4;
+	}
+	if (opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+		return 5;
+	}
+	if (opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+		return 2;
+	}
+
+	const int extra = _get_variadic_extra(opcode);
+	if (extra > 0) {
+		// Instructions with a variable number of arguments store the count first, followed by
+		// the arguments and a fixed amount of extra data.
+		if (p_position + 1 >= p_code_size) {
+			return 0;
+		}
+		return 1 + p_code[p_position + 1] + extra;
+	}
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+			return 7 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+		case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY:
+			return 6;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+			return 5;
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE:
+		case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT:
+			return 4;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_STORE_GLOBAL:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL:
+		case GDScriptFunction::OPCODE_ASSERT:
+			return 3;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_AWAIT:
+		case GDScriptFunction::OPCODE_AWAIT_RESUME:
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_LINE:
+			return 2;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+int GDScriptByteCodeOptimizer::_get_variadic_extra(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY:
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY:
+			return 2;
+		case GDScriptFunction::OPCODE_CONSTRUCT:
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+		case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA:
+			return 3;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_ASYNC:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+int GDScriptByteCodeOptimizer::_get_jump_operand(int p_opcode) {
+	if (p_opcode >= GDScriptFunction::OPCODE_JUMP_IF_EQUAL_INT && p_opcode <= GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT) {
+		return 3;
+	}
+	if (p_opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && p_opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+		return 4;
+	}
+
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+			return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return 2;
+		default:
+			return 0;
+	}
+}
+
+// Offset of the operand that an instruction overwrites without reading it first, or 0.
+// Only instructions whose destination can safely be redirected or dropped are listed.
+int GDScriptByteCodeOptimizer::_get_destination_operand(const int *p_instruction) {
+	const int opcode = p_instruction[0];
+
+	if (opcode >= GDScriptFunction::OPCODE_OPERATOR_ADD_INT && opcode <= GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT) {
+		return 3;
+	}
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+			return 3;
+		case GDScriptFunction::OPCODE_GET_NAMED:
+			return 2;
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			return 1;
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+			// The return value is the last instruction argument.
+			return 1 + p_instruction[1];
+		default:
+			return 0;
+	}
+}
+
+// Range of the words that may hold addresses. Other words are indices, counts or type
+// identifiers, which could otherwise be mistaken for stack addresses.
+void GDScriptByteCodeOptimizer::_get_address_operands(const int *p_instruction, int p_size, int &r_begin, int &r_end) {
+	const int opcode = p_instruction[0];
+	r_begin = 1;
+	r_end = p_size;
+
+	if (_get_variadic_extra(opcode) > 0) {
+		// Only the instruction arguments, the trailing data is never an address.
+		r_begin = 2;
+		r_end = 2 + p_instruction[1];
+		return;
+	}
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_LINE:
+			r_end = 1;
+			return;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_STORE_GLOBAL:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL:
+			r_end = 2;
+			return;
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN:
+			r_end = 3;
+			return;
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			r_end = 4;
+			return;
+		default:
+			return;
+	}
+}
+
+bool GDScriptByteCodeOptimizer::_get_typed_operator(int p_opcode, Variant::Operator &r_operator) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_ADD_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_ADD_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_ADD_VECTOR3:
+			r_operator = Variant::OP_ADD;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_SUBTRACT_VECTOR3:
+			r_operator = Variant::OP_SUBTRACT;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2:
+		case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3:
+		case GDScriptFunction::OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT:
+			r_operator = Variant::OP_MULTIPLY;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_DIVIDE_FLOAT:
+			r_operator = Variant::OP_DIVIDE;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_EQUAL_BOOL:
+			r_operator = Variant::OP_EQUAL;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_BOOL:
+			r_operator = Variant::OP_NOT_EQUAL;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT:
+			r_operator = Variant::OP_LESS;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+			r_operator = Variant::OP_LESS_EQUAL;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT:
+			r_operator = Variant::OP_GREATER;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+			r_operator = Variant::OP_GREATER_EQUAL;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_NEGATE_INT:
+		case GDScriptFunction::OPCODE_OPERATOR_NEGATE_FLOAT:
+			r_operator = Variant::OP_NEGATE;
+			return true;
+		case GDScriptFunction::OPCODE_OPERATOR_NOT_BOOL:
+			r_operator = Variant::OP_NOT;
+			return true;
+		default:
+			return false;
+	}
+}
+
+int GDScriptByteCodeOptimizer::_get_temporary(int p_address) const {
+	if ((p_address & GDScriptFunction::ADDR_TYPE_MASK) != (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS)) {
+		return -1;
+	}
+	const int index = (p_address & GDScriptFunction::ADDR_MASK) - first_temporary;
+	if (index < 0 || index >= temporary_count) {
+		return -1;
+	}
+	return index;
+}
+
+bool GDScriptByteCodeOptimizer::_is_typed_temporary(int p_address) const {
+	return _get_temporary(p_address) >= 0 && temporary_slots.has(p_address & GDScriptFunction::ADDR_MASK);
+}
+
+bool GDScriptByteCodeOptimizer::_get_constant(int p_address, Variant &r_value) const {
+	if ((p_address & GDScriptFunction::ADDR_TYPE_MASK) != (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS)) {
+		return false;
+	}
+	const uint32_t index = p_address & GDScriptFunction::ADDR_MASK;
+	if (index >= constants.size()) {
+		return false;
+	}
+	r_value = constants[index];
+	return true;
+}
+
+int GDScriptByteCodeOptimizer::_add_constant(const Variant &p_value) {
+	int index;
+	if (constant_map.has(p_value)) {
+		index = constant_map[p_value];
+	} else {
+		index = constant_map.size();
+		constant_map[p_value] = index;
+		constants.push_back(p_value);
+	}
+	return index | (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS);
+}
+
+// Removed instructions forward to the next one that survives, which is where jumps into them land.
+int GDScriptByteCodeOptimizer::_resolve(int p_index) const {
+	while (p_index < (int)instructions.size() && instructions[p_index].removed) {
+		p_index++;
+	}
+	return p_index;
+}
+
+int GDScriptByteCodeOptimizer::_get_next(int p_index) const {
+	return _resolve(p_index + 1);
+}
+
+int GDScriptByteCodeOptimizer::_get_previous(int p_index) const {
+	p_index--;
+	while (p_index >= 0 && instructions[p_index].removed) {
+		p_index--;
+	}
+	return p_index;
+}
+
+void GDScriptByteCodeOptimizer::_get_successors(int p_index, LocalVector<int> &r_successors) const {
+	r_successors.clear();
+
+	const int *instruction = &words[instructions[p_index].offset];
+	const int opcode = instruction[0];
+	const int next = _get_next(p_index);
+	const bool has_next = next < (int)instructions.size();
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_END:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+			return;
+		case GDScriptFunction::OPCODE_JUMP:
+			r_successors.push_back(_resolve(instruction[1]));
+			return;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+			for (const int &E : default_argument_indices) {
+				r_successors.push_back(_resolve(E));
+			}
+			return;
+		case GDScriptFunction::OPCODE_AWAIT:
+			// When the awaited value is not a signal, execution skips the resume instruction.
+			if (has_next) {
+				r_successors.push_back(next);
+				const int after_resume = _get_next(next);
+				if (after_resume < (int)instructions.size()) {
+					r_successors.push_back(after_resume);
+				}
+			}
+			return;
+		default:
+			break;
+	}
+
+	if (has_next) {
+		r_successors.push_back(next);
+	}
+	const int jump = _get_jump_operand(opcode);
+	if (jump) {
+		r_successors.push_back(_resolve(instruction[jump]));
+	}
+}
+
+bool GDScriptByteCodeOptimizer::_is_live_in(int p_index, int p_temporary) const {
+	if (p_index >= (int)instructions.size()) {
+		return false;
+	}
+	return live_in[p_index * live_stride + (p_temporary >> 5)] & (1u << (p_temporary & 31));
+}
+
+bool GDScriptByteCodeOptimizer::_is_live_out(int p_index, int p_temporary) const {
+	return live_out[p_index * live_stride + (p_temporary >> 5)] & (1u << (p_temporary & 31));
+}
+
+void GDScriptByteCodeOptimizer::_set_jump_target(int p_index, int p_target) {
+	int *instruction = _get_words(p_index);
+	const int jump = _get_jump_operand(instruction[0]);
+	ERR_FAIL_COND(jump == 0);
+
+	instructions[_resolve(instruction[jump])].incoming--;
+	instructions[p_target].incoming++;
+	instruction[jump] = p_target;
+}
+
+void GDScriptByteCodeOptimizer::_replace(int p_index, const int *p_words, int p_size) {
+	Instruction &instruction = instructions[p_index];
+
+	const int old_jump = _get_jump_operand(words[instruction.offset]);
+	if (old_jump) {
+		instructions[_resolve(words[instruction.offset + old_jump])].incoming--;
+	}
+
+	if (p_size > instruction.size) {
+		instruction.offset = words.size();
+		words.resize(words.size() + p_size);
+	}
+	instruction.size = p_size;
+	for (int i = 0; i < p_size; i++) {
+		words[instruction.offset + i] = p_words[i];
+	}
+
+	const int new_jump = _get_jump_operand(p_words[0]);
+	if (new_jump) {
+		instructions[_resolve(p_words[new_jump])].incoming++;
+	}
+}
+
+void GDScriptByteCodeOptimizer::_remove(int p_index) {
+	Instruction &instruction = instructions[p_index];
+
+	const int jump = _get_jump_operand(words[instruction.offset]);
+	if (jump) {
+		instructions[_resolve(words[instruction.offset + jump])].incoming--;
+	}
+
+	instruction.removed = true;
+	const int next = _resolve(p_index);
+	if (next < (int)instructions.size()) {
+		instructions[next].incoming += instruction.incoming;
+	}
+	instruction.incoming = 0;
+}
+
+bool GDScriptByteCodeOptimizer::_decode() {
+	const int code_size = code.size();
+	const int *code_ptr = code.ptr();
+
+	// Maps code positions to instruction indices, with the end of the code as one past the last instruction.
+	LocalVector<int> index_at;
+	index_at.resize(code_size + 1);
+	for (int i = 0; i <= code_size; i++) {
+		index_at[i] = -1;
+	}
+
+	int position = 0;
+	while (position < code_size) {
+		const int size = _get_instruction_size(code_ptr, position, code_size);
+		ERR_FAIL_COND_V_MSG(size <= 0 || position + size > code_size, false, vformat("Unexpected bytecode at position %d, skipping optimization.", position));
+
+		index_at[position] = instructions.size();
+
+		Instruction instruction;
+		instruction.offset = words.size();
+		instruction.size = size;
+		instructions.push_back(instruction);
+		for (int i = 0; i < size; i++) {
+			words.push_back(code_ptr[position + i]);
+		}
+		position += size;
+	}
+	index_at[code_size] = instructions.size();
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		int *instruction = _get_words(i);
+		const int jump = _get_jump_operand(instruction[0]);
+		if (jump == 0) {
+			continue;
+		}
+		const int target = instruction[jump];
+		ERR_FAIL_COND_V(target < 0 || target >= code_size || index_at[target] < 0, false);
+		instruction[jump] = index_at[target];
+		instructions[index_at[target]].incoming++;
+	}
+
+	instructions[0].incoming++;
+	for (int i = 0; i < default_arguments.size(); i++) {
+		const int target = default_arguments[i];
+		ERR_FAIL_COND_V(target < 0 || target >= code_size || index_at[target] < 0, false);
+		default_argument_indices.push_back(index_at[target]);
+		instructions[index_at[target]].incoming++;
+	}
+
+	constants.resize(constant_map.size());
+	for (const KeyValue<Variant, int> &E : constant_map) {
+		constants[E.value] = E.key;
+	}
+
+	return true;
+}
+
+void GDScriptByteCodeOptimizer::_encode() {
+	// Removed instructions take no space, so they end up at the position of the next surviving one.
+	LocalVector<int> position_of;
+	position_of.resize(instructions.size() + 1);
+	int position = 0;
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		position_of[i] = position;
+		if (!instructions[i].removed) {
+			position += instructions[i].size;
+		}
+	}
+	position_of[instructions.size()] = position;
+
+	code.resize(position);
+	int *code_ptr = code.ptrw();
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed) {
+			continue;
+		}
+		const int *instruction = _get_words(i);
+		for (int j = 0; j < instructions[i].size; j++) {
+			code_ptr[position_of[i] + j] = instruction[j];
+		}
+		const int jump = _get_jump_operand(instruction[0]);
+		if (jump) {
+			code_ptr[position_of[i] + jump] = position_of[instruction[jump]];
+		}
+	}
+
+	for (int i = 0; i < default_arguments.size(); i++) {
+		default_arguments.write[i] = position_of[default_argument_indices[i]];
+	}
+}
+
+void GDScriptByteCodeOptimizer::_compute_liveness() {
+	const uint32_t count = instructions.size();
+	live_stride = (temporary_count + 31) / 32;
+	if (live_stride == 0) {
+		return;
+	}
+
+	// Uses are over-approximated: every operand that names a temporary counts as a read,
+	// except the destination of the few instructions known to only write it.
+	LocalVector<uint32_t> uses;
+	LocalVector<int> definitions;
+	uses.resize(count * live_stride);
+	definitions.resize(count);
+	live_in.resize(count * live_stride);
+	live_out.resize(count * live_stride);
+	for (uint32_t i = 0; i < count * live_stride; i++) {
+		uses[i] = 0;
+		live_in[i] = 0;
+		live_out[i] = 0;
+	}
+
+	for (uint32_t i = 0; i < count; i++) {
+		definitions[i] = -1;
+		if (instructions[i].removed) {
+			continue;
+		}
+		const int *instruction = _get_words(i);
+		const int jump = _get_jump_operand(instruction[0]);
+		const int destination = _get_destination_operand(instruction);
+		int begin, end;
+		_get_address_operands(instruction, instructions[i].size, begin, end);
+		for (int j = begin; j < end; j++) {
+			if (j == jump || j == destination) {
+				continue;
+			}
+			const int temporary = _get_temporary(instruction[j]);
+			if (temporary >= 0) {
+				uses[i * live_stride + (temporary >> 5)] |= 1u << (temporary & 31);
+			}
+		}
+		if (destination) {
+			const int temporary = _get_temporary(instruction[destination]);
+			if (temporary >= 0 && !(uses[i * live_stride + (temporary >> 5)] & (1u << (temporary & 31)))) {
+				definitions[i] = temporary;
+			}
+		}
+	}
+
+	LocalVector<int> successors;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int i = count - 1; i >= 0; i--) {
+			if (instructions[i].removed) {
+				continue;
+			}
+			uint32_t *out = &live_out[i * live_stride];
+			uint32_t *in = &live_in[i * live_stride];
+
+			_get_successors(i, successors);
+			for (const int &successor : successors) {
+				const uint32_t *successor_in = &live_in[successor * live_stride];
+				for (uint32_t j = 0; j < live_stride; j++) {
+					out[j] |= successor_in[j];
+				}
+			}
+
+			for (uint32_t j = 0; j < live_stride; j++) {
+				uint32_t live = out[j];
+				if (definitions[i] >= 0 && (uint32_t)(definitions[i] >> 5) == j) {
+					live &= ~(1u << (definitions[i] & 31));
+				}
+				live |= uses[i * live_stride + j];
+				if (live != in[j]) {
+					in[j] = live;
+					changed = true;
+				}
+			}
+		}
+	}
+}
+
+// Evaluates typed operators on constants, and conditional jumps on constant conditions.
+bool GDScriptByteCodeOptimizer::_fold_constants() {
+	bool changed = false;
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed) {
+			continue;
+		}
+		const int *instruction = _get_words(i);
+		const int opcode = instruction[0];
+
+		Variant::Operator op;
+		if (_get_typed_operator(opcode, op)) {
+			Variant left, right;
+			if (!_get_constant(instruction[1], left)) {
+				continue;
+			}
+			if (op != Variant::OP_NEGATE && op != Variant::OP_NOT && !_get_constant(instruction[2], right)) {
+				continue;
+			}
+
+			Variant result;
+			bool valid = false;
+			Variant::evaluate(op, left, right, result, valid);
+			if (!valid) {
+				continue;
+			}
+
+			const int assign[3] = { GDScriptFunction::OPCODE_ASSIGN, instruction[3], _add_constant(result) };
+			_replace(i, assign, 3);
+			changed = true;
+			continue;
+		}
+
+		bool jump_if_true;
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+				jump_if_true = true;
+				break;
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+				jump_if_true = false;
+				break;
+			default:
+				continue;
+		}
+
+		Variant condition;
+		if (!_get_constant(instruction[1], condition)) {
+			continue;
+		}
+
+		if (condition.booleanize() == jump_if_true) {
+			const int jump[2] = { GDScriptFunction::OPCODE_JUMP, instruction[2] };
+			_replace(i, jump, 2);
+		} else {
+			_remove(i);
+		}
+		changed = true;
+	}
+
+	return changed;
+}
+
+// Retargets jumps whose destination is another jump, or a conditional jump on a value that is
+// already known when arriving there. This is what `and`, `or` and `while true` loops produce:
+// a temporary set to true or false right before jumping to a test of that same temporary.
+bool GDScriptByteCodeOptimizer::_thread_jumps() {
+	bool changed = false;
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed) {
+			continue;
+		}
+		const int opcode = _get_opcode(i);
+		const int jump = _get_jump_operand(opcode);
+		if (jump == 0) {
+			continue;
+		}
+
+		// Temporary holding a known boolean, and whether an assignment to it has been skipped,
+		// in which case the threaded path must not reach any of its reads.
+		int known = -1;
+		bool known_value = false;
+		bool skipped_assign = false;
+
+		if (opcode == GDScriptFunction::OPCODE_JUMP && instructions[i].incoming == 0) {
+			const int previous = _get_previous(i);
+			if (previous >= 0) {
+				const int *assign = _get_words(previous);
+				if ((assign[0] == GDScriptFunction::OPCODE_ASSIGN_TRUE || assign[0] == GDScriptFunction::OPCODE_ASSIGN_FALSE) && _get_temporary(assign[1]) >= 0) {
+					known = assign[1];
+					known_value = assign[0] == GDScriptFunction::OPCODE_ASSIGN_TRUE;
+				}
+			}
+		}
+
+		const int original = _resolve(_get_words(i)[jump]);
+		int destination = original;
+		int best = original;
+
+		for (int step = 0; step < MAX_THREADING_STEPS && destination < (int)instructions.size(); step++) {
+			const int *target = _get_words(destination);
+
+			if (target[0] == GDScriptFunction::OPCODE_JUMP) {
+				destination = _resolve(target[1]);
+				if (!skipped_assign) {
+					best = destination;
+				}
+				continue;
+			}
+
+			if ((target[0] == GDScriptFunction::OPCODE_ASSIGN_TRUE || target[0] == GDScriptFunction::OPCODE_ASSIGN_FALSE) && _get_temporary(target[1]) >= 0 && !skipped_assign) {
+				known = target[1];
+				known_value = target[0] == GDScriptFunction::OPCODE_ASSIGN_TRUE;
+				skipped_assign = true;
+				destination = _get_next(destination);
+				continue;
+			}
+
+			bool jump_if_true;
+			switch (target[0]) {
+				case GDScriptFunction::OPCODE_JUMP_IF:
+				case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+					jump_if_true = true;
+					break;
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+					jump_if_true = false;
+					break;
+				default:
+					jump_if_true = false;
+					destination = -1;
+					break;
+			}
+			if (destination < 0 || known < 0 || target[1] != known) {
+				break;
+			}
+
+			const int outcome = known_value == jump_if_true ? _resolve(target[2]) : _get_next(destination);
+			if (skipped_assign) {
+				if (_is_live_in(outcome, _get_temporary(known))) {
+					break;
+				}
+				skipped_assign = false;
+			}
+			destination = outcome;
+			best = destination;
+		}
+
+		if (best != original && best < (int)instructions.size() && best != (int)i) {
+			_set_jump_target(i, best);
+			changed = true;
+		}
+	}
+
+	// A conditional jump right after its condition was set to a constant always goes the same way.
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed || instructions[i].incoming > 0) {
+			continue;
+		}
+		const int *instruction = _get_words(i);
+		bool jump_if_true;
+		switch (instruction[0]) {
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+				jump_if_true = true;
+				break;
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+				jump_if_true = false;
+				break;
+			default:
+				continue;
+		}
+
+		const int previous = _get_previous(i);
+		if (previous < 0) {
+			continue;
+		}
+		const int *assign = _get_words(previous);
+		if ((assign[0] != GDScriptFunction::OPCODE_ASSIGN_TRUE && assign[0] != GDScriptFunction::OPCODE_ASSIGN_FALSE) || assign[1] != instruction[1]) {
+			continue;
+		}
+
+		if ((assign[0] == GDScriptFunction::OPCODE_ASSIGN_TRUE) == jump_if_true) {
+			const int jump[2] = { GDScriptFunction::OPCODE_JUMP, instruction[2] };
+			_replace(i, jump, 2);
+		} else {
+			_remove(i);
+		}
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool GDScriptByteCodeOptimizer::_remove_unreachable() {
+	LocalVector<bool> reachable;
+	reachable.resize(instructions.size());
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		reachable[i] = false;
+	}
+
+	LocalVector<int> pending;
+	LocalVector<int> successors;
+	const int entry = _resolve(0);
+	if (entry < (int)instructions.size()) {
+		pending.push_back(entry);
+		reachable[entry] = true;
+	}
+	while (!pending.is_empty()) {
+		const int index = pending[pending.size() - 1];
+		pending.remove_at(pending.size() - 1);
+
+		_get_successors(index, successors);
+		for (const int &successor : successors) {
+			if (!reachable[successor]) {
+				reachable[successor] = true;
+				pending.push_back(successor);
+			}
+		}
+	}
+
+	bool changed = false;
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (!instructions[i].removed && !reachable[i]) {
+			_remove(i);
+			changed = true;
+		}
+	}
+	return changed;
+}
+
+// Writes results straight into their final destination instead of going through a temporary:
+// `temp = a + b; x = temp` becomes `x = a + b`.
+bool GDScriptByteCodeOptimizer::_coalesce_assignments() {
+	bool changed = false;
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed || instructions[i].incoming > 0) {
+			continue;
+		}
+		const int *assign = _get_words(i);
+		if (assign[0] != GDScriptFunction::OPCODE_ASSIGN) {
+			continue;
+		}
+
+		const int target = assign[1];
+		const int source = assign[2];
+		const int temporary = _get_temporary(source);
+		if (temporary < 0 || _is_live_out(i, temporary) || target == source) {
+			continue;
+		}
+		if ((target & GDScriptFunction::ADDR_TYPE_MASK) != (GDScriptFunction::ADDR_TYPE_STACK << GDScriptFunction::ADDR_BITS) || (target & GDScriptFunction::ADDR_MASK) < GDScriptFunction::FIXED_ADDRESSES_MAX) {
+			continue;
+		}
+
+		const int producer = _get_previous(i);
+		if (producer < 0) {
+			continue;
+		}
+		int *instruction = _get_words(producer);
+		const int destination = _get_destination_operand(instruction);
+		if (destination == 0 || instruction[destination] != source) {
+			continue;
+		}
+
+		// Besides typed operators, which compute their result before writing it, the producer
+		// must not read the target, since it may start writing its result before its last read.
+		Variant::Operator op;
+		if (!_get_typed_operator(instruction[0], op)) {
+			bool aliased = false;
+			int begin, end;
+			_get_address_operands(instruction, instructions[producer].size, begin, end);
+			for (int j = begin; j < end; j++) {
+				if (instruction[j] == target) {
+					aliased = true;
+					break;
+				}
+			}
+			if (aliased) {
+				continue;
+			}
+		}
+
+		instruction[destination] = target;
+		_remove(i);
+		changed = true;
+	}
+
+	return changed;
+}
+
+// Replaces a typed comparison feeding a conditional jump with a single compare-and-jump instruction.
+bool GDScriptByteCodeOptimizer::_fuse_compare_and_jump() {
+	bool changed = false;
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed || instructions[i].incoming > 0) {
+			continue;
+		}
+		const int *branch = _get_words(i);
+		if (branch[0] != GDScriptFunction::OPCODE_JUMP_IF_BOOL && branch[0] != GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL) {
+			continue;
+		}
+		const int temporary = _get_temporary(branch[1]);
+		if (temporary < 0 || _is_live_out(i, temporary)) {
+			continue;
+		}
+
+		const int compare = _get_previous(i);
+		if (compare < 0) {
+			continue;
+		}
+		const int *instruction = _get_words(compare);
+
+		// Express every comparison as one of equal, not equal, not less and not less or equal.
+		// Inverting an ordered comparison is only valid for integers, as NaN makes every float comparison false.
+		const bool jump_if_true = branch[0] == GDScriptFunction::OPCODE_JUMP_IF_BOOL;
+		int left = instruction[1];
+		int right = instruction[2];
+		int fused = -1;
+		bool swap = false;
+
+		switch (instruction[0]) {
+			case GDScriptFunction::OPCODE_OPERATOR_EQUAL_INT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_EQUAL_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_INT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_INT : GDScriptFunction::OPCODE_JUMP_IF_EQUAL_INT;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_LESS_INT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT;
+				swap = jump_if_true;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_INT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT;
+				swap = jump_if_true;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_GREATER_INT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT;
+				swap = !jump_if_true;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_INT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_INT : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT;
+				swap = !jump_if_true;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_EQUAL_FLOAT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_EQUAL_FLOAT : GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+				fused = jump_if_true ? GDScriptFunction::OPCODE_JUMP_IF_NOT_EQUAL_FLOAT : GDScriptFunction::OPCODE_JUMP_IF_EQUAL_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_LESS_FLOAT:
+				fused = jump_if_true ? -1 : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_LESS_EQUAL_FLOAT:
+				fused = jump_if_true ? -1 : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_GREATER_FLOAT:
+				fused = jump_if_true ? -1 : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_FLOAT;
+				swap = true;
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_GREATER_EQUAL_FLOAT:
+				fused = jump_if_true ? -1 : GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT;
+				swap = true;
+				break;
+			default:
+				break;
+		}
+		if (fused < 0 || instruction[3] != branch[1]) {
+			continue;
+		}
+		if (swap) {
+			SWAP(left, right);
+		}
+
+		const int replacement[4] = { fused, left, right, branch[2] };
+		_remove(i);
+		_replace(compare, replacement, 4);
+		changed = true;
+	}
+
+	return changed;
+}
+
+// Drops side-effect free writes to typed temporaries that are never read.
+// Untyped temporaries are left alone, as clearing them is what releases the objects they hold.
+bool GDScriptByteCodeOptimizer::_remove_dead_stores() {
+	bool changed = false;
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed) {
+			continue;
+		}
+		const int *instruction = _get_words(i);
+		const int opcode = instruction[0];
+
+		int destination;
+		Variant::Operator op;
+		if (opcode == GDScriptFunction::OPCODE_ASSIGN || opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE || opcode == GDScriptFunction::OPCODE_ASSIGN_FALSE) {
+			destination = instruction[1];
+		} else if (_get_typed_operator(opcode, op)) {
+			destination = instruction[3];
+		} else {
+			continue;
+		}
+
+		if (!_is_typed_temporary(destination) || _is_live_out(i, _get_temporary(destination))) {
+			continue;
+		}
+
+		_remove(i);
+		changed = true;
+	}
+
+	return changed;
+}
+
+bool GDScriptByteCodeOptimizer::_remove_redundant_jumps() {
+	bool changed = false;
+
+	for (uint32_t i = 0; i < instructions.size(); i++) {
+		if (instructions[i].removed) {
+			continue;
+		}
+		const int *instruction = _get_words(i);
+		const int opcode = instruction[0];
+		switch (opcode) {
+			case GDScriptFunction::OPCODE_JUMP:
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+			case GDScriptFunction::OPCODE_JUMP_IF_BOOL:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT_BOOL:
+				break;
+			default:
+				if (opcode < GDScriptFunction::OPCODE_JUMP_IF_EQUAL_INT || opcode > GDScriptFunction::OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT) {
+					continue;
+				}
+		}
+
+		if (_resolve(instruction[_get_jump_operand(opcode)]) == _get_next(i)) {
+			_remove(i);
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+int GDScriptByteCodeOptimizer::optimize() {
+	if (code.is_empty() || !_decode()) {
+		return 0;
+	}
+
+	bool modified = false;
+	for (int round = 0; round < MAX_OPTIMIZATION_ROUNDS; round++) {
+		bool changed = _fold_constants();
+		changed = _remove_unreachable() || changed;
+
+		// Jump threading, fusion and dead store removal only ever shrink live ranges, so the
+		// liveness computed here stays a safe over-approximation while they run. Coalescing
+		// moves definitions earlier, which extends live ranges, so it has to be recomputed.
+		_compute_liveness();
+		changed = _thread_jumps() || changed;
+		if (_coalesce_assignments()) {
+			_compute_liveness();
+			changed = true;
+		}
+		changed = _fuse_compare_and_jump() || changed;
+		changed = _remove_dead_stores() || changed;
+		changed = _remove_redundant_jumps() || changed;
+
+		if (!changed) {
+			break;
+		}
+		modified = true;
+	}
+
+	if (!modified) {
+		return 0;
+	}
+
+	_encode();
+	return instructions.size();
+}
+
+GDScriptByteCodeOptimizer::GDScriptByteCodeOptimizer(Vector<int> &r_code, Vector<int> &r_default_arguments, HashMap<Variant, int, VariantHasher, VariantComparator> &r_constant_map, const HashMap<int, Variant::Type> &p_temporary_slots, int p_first_temporary, int p_temporary_count) :
+		code(r_code),
+		default_arguments(r_default_arguments),
+		constant_map(r_constant_map),
+		temporary_slots(p_temporary_slots),
+		first_temporary(p_first_temporary),
+		temporary_count(p_temporary_count) {
+}
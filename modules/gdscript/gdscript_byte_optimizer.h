@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  gdscript_byte_optimizer.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTE_OPTIMIZER_H
+#define GDSCRIPT_BYTE_OPTIMIZER_H
+
+#include "gdscript_function.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Peephole and dataflow passes over the bytecode of a single function.
+// Runs once the generator has resolved temporaries to stack slots, so every address is final.
+// Only temporaries are analyzed: locals and members may be observed by the debugger, by
+// `await` resumption, or by other functions, so writes to them are never removed.
+class GDScriptByteCodeOptimizer {
+	friend class GDScriptByteCodeSerializer;
+	friend class GDScriptNativeTranslator;
+
+	struct Instruction {
+		int offset = 0; // Start of the instruction in `words`.
+		int size = 0;
+		int incoming = 0; // Jumps landing here, plus one per entry point.
+		bool removed = false;
+	};
+
+	Vector<int> &code;
+	Vector<int> &default_arguments;
+	HashMap<Variant, int, VariantHasher, VariantComparator> &constant_map;
+	const HashMap<int, Variant::Type> &temporary_slots;
+	int first_temporary = 0;
+	int temporary_count = 0;
+
+	// Instructions are decoded into `words` with jump targets replaced by instruction indices,
+	// so passes can rewrite and remove instructions without relocating anything until the end.
+	LocalVector<Instruction> instructions;
+	LocalVector<int> words;
+	LocalVector<int> default_argument_indices;
+	LocalVector<Variant> constants;
+
+	// Live temporaries before and after each instruction, one bit per temporary.
+	uint32_t live_stride = 0;
+	LocalVector<uint32_t> live_in;
+	LocalVector<uint32_t> live_out;
+
+	static int _get_instruction_size(const int *p_code, int p_position, int p_code_size);
+	static int _get_variadic_extra(int p_opcode);
+	static int _get_jump_operand(int p_opcode);
+	static int _get_destination_operand(const int *p_instruction);
+	static void _get_address_operands(const int *p_instruction, int p_size, int &r_begin, int &r_end);
+	static bool _get_typed_operator(int p_opcode, Variant::Operator &r_operator);
+
+	_FORCE_INLINE_ int *_get_words(int p_index) { return &words[instructions[p_index].offset]; }
+	_FORCE_INLINE_ int _get_opcode(int p_index) const { return words[instructions[p_index].offset]; }
+
+	int _get_temporary(int p_address) const;
+	bool _is_typed_temporary(int p_address) const;
+	bool _get_constant(int p_address, Variant &r_value) const;
+	int _add_constant(const Variant &p_value);
+
+	int _resolve(int p_index) const;
+	int _get_next(int p_index) const;
+	int _get_previous(int p_index) const;
+	void _get_successors(int p_index, LocalVector<int> &r_successors) const;
+	bool _is_live_out(int p_index, int p_temporary) const;
+	bool _is_live_in(int p_index, int p_temporary) const;
+
+	void _set_jump_target(int p_index, int p_target);
+	void _replace(int p_index, const int *p_words, int p_size);
+	void _remove(int p_index);
+
+	bool _decode();
+	void _encode();
+	void _compute_liveness();
+
+	bool _fold_constants();
+	bool _thread_jumps();
+	bool _remove_unreachable();
+	bool _coalesce_assignments();
+	bool _fuse_compare_and_jump();
+	bool _remove_dead_stores();
+	bool _remove_redundant_jumps();
+
+public:
+	// Returns the number of instructions before optimizing, or 0 if the code was left untouched.
+	int optimize();
+
+	GDScriptByteCodeOptimizer(Vector<int> &r_code, Vector<int> &r_default_arguments, HashMap<Variant, int, VariantHasher, VariantComparator> &r_constant_map, const HashMap<int, Variant::Type> &p_temporary_slots, int p_first_temporary, int p_temporary_count);
+};
+
+#endif // GDSCRIPT_BYTE_OPTIMIZER_H
@@ -0,0 +1,1399 @@
+/**************************************************************************/
+/*  gdscript_byte_serializer.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_byte_serializer.h"
+
+#include "gdscript_analyzer.h"
+#include "gdscript_byte_optimizer.h"
+#include "gdscript_cache.h"
+#include "gdscript_compiler.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/compression.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/version.h"
+
+// Container layout, all integers little endian:
+//   "GDBC" | format version | compatibility hash | token size | tokens | compiled size | ZSTD compressed classes
+static constexpr int HEADER_SIZE = 16;
+
+enum VariantTag {
+	VARIANT_VALUE,
+	VARIANT_NULL_OBJECT,
+	VARIANT_ARRAY,
+	VARIANT_DICTIONARY,
+	VARIANT_SCRIPT,
+	VARIANT_NATIVE_CLASS,
+	VARIANT_RESOURCE,
+};
+
+enum ScriptTag {
+	SCRIPT_NONE,
+	SCRIPT_GDSCRIPT,
+	SCRIPT_RESOURCE,
+};
+
+class GDScriptByteCodeSerializer::Writer {
+public:
+	Vector<uint8_t> buffer;
+
+	void put_8(uint8_t p_value) {
+		buffer.push_back(p_value);
+	}
+
+	void put_32(uint32_t p_value) {
+		int ofs = buffer.size();
+		buffer.resize(ofs + 4);
+		encode_uint32(p_value, &buffer.write[ofs]);
+	}
+
+	void put_data(const uint8_t *p_data, int p_size) {
+		if (p_size == 0) {
+			return;
+		}
+		int ofs = buffer.size();
+		buffer.resize(ofs + p_size);
+		memcpy(buffer.ptrw() + ofs, p_data, p_size);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		put_data((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+};
+
+class GDScriptByteCodeSerializer::Reader {
+public:
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int position = 0;
+	bool error = false;
+	GDScript *root = nullptr; // Script being loaded, references to its path resolve here.
+
+	bool has(int p_size) {
+		if (error || p_size < 0 || position + p_size > size) {
+			error = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[position++];
+	}
+
+	uint32_t get_32() {
+		if (!has(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[position]);
+		position += 4;
+		return value;
+	}
+
+	// Element counts are checked against the remaining data, so corrupt files can't trigger huge allocations.
+	int get_count(int p_min_element_size = 1) {
+		uint32_t count = get_32();
+		if (error || count > uint32_t(size - position) / p_min_element_size) {
+			error = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		int length = get_count();
+		if (length == 0) {
+			return String();
+		}
+		String string;
+		string.parse_utf8((const char *)&data[position], length);
+		position += length;
+		return string;
+	}
+
+	StringName get_string_name() {
+		String string = get_string();
+		return string.is_empty() ? StringName() : StringName(string);
+	}
+};
+
+uint32_t GDScriptByteCodeSerializer::_get_compatibility_hash() {
+	// Opcode numbering and instruction sizes are only stable within a single engine build.
+	uint32_t hash = hash_murmur3_one_32(VERSION_HEX);
+	hash = hash_murmur3_one_32(String(VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::ADDR_BITS, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	hash = hash_murmur3_one_32(sizeof(Variant::ValidatedOperatorEvaluator), hash);
+
+	// The instruction layout, as far as it can be seen from outside the VM: the size of each opcode
+	// (with no arguments for the variadic ones) and where its jump target is.
+	int instruction[2] = { 0, 0 };
+	for (int opcode = 0; opcode <= GDScriptFunction::OPCODE_END; opcode++) {
+		instruction[0] = opcode;
+		hash = hash_murmur3_one_32(GDScriptByteCodeOptimizer::_get_instruction_size(instruction, 0, 2), hash);
+		hash = hash_murmur3_one_32(GDScriptByteCodeOptimizer::_get_jump_operand(opcode), hash);
+	}
+	return hash_fmix32(hash);
+}
+
+const GDScriptByteCodeSerializer::FunctionSymbols &GDScriptByteCodeSerializer::_get_function_symbols() {
+	static const FunctionSymbols symbols = []() {
+		FunctionSymbols s;
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = Variant::Type(i);
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+					if (evaluator != nullptr && !s.operators.has(evaluator)) {
+						s.operators.insert(evaluator, (op << 16) | (i << 8) | j);
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &E : members) {
+				Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, E);
+				if (setter != nullptr) {
+					s.setters.insert(setter, Pair<Variant::Type, StringName>(type, E));
+				}
+				Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, E);
+				if (getter != nullptr) {
+					s.getters.insert(getter, Pair<Variant::Type, StringName>(type, E));
+				}
+			}
+
+			if (Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type)) {
+				s.keyed_setters.insert(keyed_setter, type);
+			}
+			if (Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type)) {
+				s.keyed_getters.insert(keyed_getter, type);
+			}
+			if (Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type)) {
+				s.indexed_setters.insert(indexed_setter, type);
+			}
+			if (Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type)) {
+				s.indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &E : methods) {
+				Variant::ValidatedBuiltInMethod method = Variant::get_validated_builtin_method(type, E);
+				if (method != nullptr) {
+					s.builtin_methods.insert(method, Pair<Variant::Type, StringName>(type, E));
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+				if (constructor != nullptr) {
+					s.constructors.insert(constructor, Pair<Variant::Type, int>(type, j));
+				}
+			}
+		}
+
+		List<StringName> utilities;
+		Variant::get_utility_function_list(&utilities);
+		for (const StringName &E : utilities) {
+			Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(E);
+			if (utility != nullptr) {
+				s.utilities.insert(utility, E);
+			}
+		}
+
+		List<StringName> gds_utilities;
+		GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+		for (const StringName &E : gds_utilities) {
+			s.gds_utilities.insert(GDScriptUtilityFunctions::get_function(E), E);
+		}
+		return s;
+	}();
+	return symbols;
+}
+
+/* Saving */
+
+bool GDScriptByteCodeSerializer::_write_script_reference(Writer &p_writer, const Script *p_script) {
+	if (p_script == nullptr) {
+		p_writer.put_8(SCRIPT_NONE);
+		return true;
+	}
+
+	const GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	String path = gdscript ? gdscript->path : p_script->get_path();
+	if (path.is_empty() || path.contains("::")) {
+		return false; // Built-in scripts can't be looked up by path.
+	}
+
+	if (gdscript) {
+		p_writer.put_8(SCRIPT_GDSCRIPT);
+		p_writer.put_string(path);
+		p_writer.put_string(gdscript->fully_qualified_name);
+	} else {
+		p_writer.put_8(SCRIPT_RESOURCE);
+		p_writer.put_string(path);
+	}
+	return true;
+}
+
+bool GDScriptByteCodeSerializer::_write_variant(Writer &p_writer, const Variant &p_variant, int p_depth) {
+	ERR_FAIL_COND_V(p_depth > MAX_RECURSION, false);
+
+	switch (p_variant.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_variant.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_8(VARIANT_NULL_OBJECT);
+				return true;
+			}
+			if (const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+				p_writer.put_8(VARIANT_NATIVE_CLASS);
+				p_writer.put_string(native_class->get_name());
+				return true;
+			}
+			if (const Script *script = Object::cast_to<Script>(object)) {
+				p_writer.put_8(VARIANT_SCRIPT);
+				return _write_script_reference(p_writer, script);
+			}
+			const Resource *resource = Object::cast_to<Resource>(object);
+			if (resource == nullptr || resource->get_path().is_empty() || resource->get_path().contains("::")) {
+				return false; // Only resources that can be loaded again by path.
+			}
+			p_writer.put_8(VARIANT_RESOURCE);
+			p_writer.put_string(resource->get_path());
+			return true;
+		}
+		case Variant::ARRAY: {
+			Array array = p_variant;
+			p_writer.put_8(VARIANT_ARRAY);
+			p_writer.put_8(array.is_read_only());
+			p_writer.put_32(array.get_typed_builtin());
+			p_writer.put_string(array.get_typed_class_name());
+			Ref<Script> script = array.get_typed_script();
+			if (!_write_script_reference(p_writer, script.ptr())) {
+				return false;
+			}
+			p_writer.put_32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				if (!_write_variant(p_writer, array[i], p_depth + 1)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary dictionary = p_variant;
+			p_writer.put_8(VARIANT_DICTIONARY);
+			p_writer.put_8(dictionary.is_read_only());
+			p_writer.put_32(dictionary.size());
+			for (const Variant &key : dictionary.keys()) {
+				if (!_write_variant(p_writer, key, p_depth + 1) || !_write_variant(p_writer, dictionary[key], p_depth + 1)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+			// Only meaningful in the process that created them, unless empty.
+			if (p_variant.booleanize()) {
+				return false;
+			}
+			[[fallthrough]];
+		default: {
+			int length = 0;
+			Error err = encode_variant(p_variant, nullptr, length);
+			ERR_FAIL_COND_V(err != OK, false);
+			p_writer.put_8(VARIANT_VALUE);
+			p_writer.put_32(length);
+			int ofs = p_writer.buffer.size();
+			p_writer.buffer.resize(ofs + length);
+			encode_variant(p_variant, &p_writer.buffer.write[ofs], length);
+			return true;
+		}
+	}
+}
+
+bool GDScriptByteCodeSerializer::_write_data_type(Writer &p_writer, const GDScriptDataType &p_data_type) {
+	p_writer.put_8(p_data_type.kind);
+	p_writer.put_8(p_data_type.has_type);
+	p_writer.put_32(p_data_type.builtin_type);
+	p_writer.put_string(p_data_type.native_type);
+	if (p_data_type.kind == GDScriptDataType::SCRIPT || p_data_type.kind == GDScriptDataType::GDSCRIPT) {
+		if (!_write_script_reference(p_writer, p_data_type.script_type)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_data_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_data_type.container_element_types) {
+		if (!_write_data_type(p_writer, element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptByteCodeSerializer::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_32(p_info.usage);
+}
+
+bool GDScriptByteCodeSerializer::_write_method_info(Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	p_writer.put_32(p_info.flags);
+	p_writer.put_32(p_info.id);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!_write_variant(p_writer, default_argument)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptByteCodeSerializer::_write_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info) {
+	p_writer.put_string(p_name);
+	p_writer.put_32(p_info.index);
+	p_writer.put_string(p_info.setter);
+	p_writer.put_string(p_info.getter);
+	_write_property_info(p_writer, p_info.property_info);
+	return _write_data_type(p_writer, p_info.data_type);
+}
+
+bool GDScriptByteCodeSerializer::_write_function(Writer &p_writer, const GDScript *p_script, const GDScriptFunction *p_function) {
+	const FunctionSymbols &symbols = _get_function_symbols();
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_8(p_function->_static);
+	p_writer.put_32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		if (!_write_data_type(p_writer, argument_type)) {
+			return false;
+		}
+	}
+	if (!_write_data_type(p_writer, p_function->return_type) || !_write_method_info(p_writer, p_function->method_info) || !_write_variant(p_writer, p_function->rpc_config)) {
+		return false;
+	}
+
+	p_writer.put_32(p_function->_initial_line);
+	p_writer.put_32(p_function->_argument_count);
+	p_writer.put_32(p_function->_stack_size);
+	p_writer.put_32(p_function->_instruction_args_size);
+	p_writer.put_32(p_function->_inline_caches_count);
+
+	p_writer.put_32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_32(E.key);
+		p_writer.put_32(E.value);
+	}
+
+	p_writer.put_32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &E : p_function->stack_debug) {
+		p_writer.put_32(E.line);
+		p_writer.put_32(E.pos);
+		p_writer.put_8(E.added);
+		p_writer.put_string(E.identifier);
+	}
+
+	// The untyped operator caches its resolved evaluator inside the instruction, reset it to the state the generator left it in.
+	// Global indices depend on what the running process registered, so they are stored by name.
+	Vector<int> code = p_function->code;
+	int *code_ptr = code.ptrw();
+	Vector<Pair<int, StringName>> globals;
+	for (int ip = 0; ip < code.size();) {
+		int size = GDScriptByteCodeOptimizer::_get_instruction_size(code_ptr, ip, code.size());
+		if (size <= 0 || ip + size > code.size()) {
+			return false;
+		}
+		if (code_ptr[ip] == GDScriptFunction::OPCODE_OPERATOR) {
+			for (int i = 5; i < size; i++) {
+				code_ptr[ip + i] = 0;
+			}
+		} else if (code_ptr[ip] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			StringName global_name;
+			for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+				if (E.value == code_ptr[ip + 2]) {
+					global_name = E.key;
+					break;
+				}
+			}
+			if (global_name == StringName()) {
+				return false;
+			}
+			globals.push_back(Pair<int, StringName>(ip + 2, global_name));
+		}
+		ip += size;
+	}
+	p_writer.put_32(code.size());
+	for (int word : code) {
+		p_writer.put_32(word);
+	}
+	p_writer.put_32(globals.size());
+	for (const Pair<int, StringName> &E : globals) {
+		p_writer.put_32(E.first);
+		p_writer.put_string(E.second);
+	}
+
+	p_writer.put_32(p_function->default_arguments.size());
+	for (int position : p_function->default_arguments) {
+		p_writer.put_32(position);
+	}
+
+	p_writer.put_32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!_write_variant(p_writer, constant)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+#define WRITE_SYMBOLS(m_vector, m_map, m_write)             \
+	p_writer.put_32(p_function->m_vector.size());           \
+	for (const auto &function_ptr : p_function->m_vector) { \
+		const auto *E = symbols.m_map.find(function_ptr);   \
+		if (E == nullptr) {                                 \
+			return false;                                   \
+		}                                                   \
+		const auto *symbol = &E->value();                   \
+		m_write;                                            \
+	}
+
+	WRITE_SYMBOLS(operator_funcs, operators, p_writer.put_32(*symbol));
+	WRITE_SYMBOLS(setters, setters, p_writer.put_32(symbol->first); p_writer.put_string(symbol->second));
+	WRITE_SYMBOLS(getters, getters, p_writer.put_32(symbol->first); p_writer.put_string(symbol->second));
+	WRITE_SYMBOLS(keyed_setters, keyed_setters, p_writer.put_32(*symbol));
+	WRITE_SYMBOLS(keyed_getters, keyed_getters, p_writer.put_32(*symbol));
+	WRITE_SYMBOLS(indexed_setters, indexed_setters, p_writer.put_32(*symbol));
+	WRITE_SYMBOLS(indexed_getters, indexed_getters, p_writer.put_32(*symbol));
+	WRITE_SYMBOLS(builtin_methods, builtin_methods, p_writer.put_32(symbol->first); p_writer.put_string(symbol->second));
+	WRITE_SYMBOLS(constructors, constructors, p_writer.put_32(symbol->first); p_writer.put_32(symbol->second));
+	WRITE_SYMBOLS(utilities, utilities, p_writer.put_string(*symbol));
+	WRITE_SYMBOLS(gds_utilities, gds_utilities, p_writer.put_string(*symbol));
+
+#undef WRITE_SYMBOLS
+
+	p_writer.put_32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		if (!_write_function(p_writer, lambda->_script, lambda)) {
+			return false;
+		}
+	}
+
+	const GDScript::LambdaInfo *lambda_info = p_script->lambda_info.getptr(const_cast<GDScriptFunction *>(p_function));
+	p_writer.put_8(lambda_info != nullptr);
+	if (lambda_info) {
+		p_writer.put_32(lambda_info->capture_count);
+		p_writer.put_8(lambda_info->use_self);
+	}
+	return true;
+}
+
+void GDScriptByteCodeSerializer::_write_class_tree(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+	p_writer.put_32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		p_writer.put_string(E.key);
+		_write_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+bool GDScriptByteCodeSerializer::_write_class(Writer &p_writer, const GDScript *p_script) {
+	if (!p_script->valid || p_script->native.is_null()) {
+		return false;
+	}
+
+	p_writer.put_8(p_script->tool);
+	p_writer.put_string(p_script->native->get_name());
+	if (!_write_script_reference(p_writer, p_script->base.ptr())) {
+		return false;
+	}
+
+	p_writer.put_32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		if (!_write_member_info(p_writer, E.key, E.value)) {
+			return false;
+		}
+	}
+	p_writer.put_32(p_script->members.size());
+	for (const StringName &E : p_script->members) {
+		p_writer.put_string(E);
+	}
+	p_writer.put_32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		if (!_write_member_info(p_writer, E.key, E.value)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		if (!_write_variant(p_writer, E.value)) {
+			return false;
+		}
+	}
+
+	p_writer.put_32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		if (!_write_method_info(p_writer, E.value)) {
+			return false;
+		}
+	}
+
+	if (!_write_variant(p_writer, p_script->rpc_config)) {
+		return false;
+	}
+
+	// Implicit functions aren't in `member_functions`, so they follow separately.
+	p_writer.put_32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!_write_function(p_writer, p_script, E.value)) {
+			return false;
+		}
+	}
+	const GDScriptFunction *implicit_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : implicit_functions) {
+		p_writer.put_8(function != nullptr);
+		if (function && !_write_function(p_writer, p_script, function)) {
+			return false;
+		}
+	}
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (!_write_class(p_writer, E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+Ref<GDScript> GDScriptByteCodeSerializer::compile_for_export(const String &p_path, const Vector<uint8_t> &p_binary_tokens, bool p_debug, bool &r_static_script) {
+	GDScriptParser parser;
+	Error err = parser.parse_binary(p_binary_tokens, p_path);
+	if (err == OK) {
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
+	}
+	if (err != OK) {
+		return Ref<GDScript>();
+	}
+
+	// The path is only set on the copy, the script loaded from it stays the one in the resource cache.
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path_cache(p_path);
+	script->path = p_path;
+	script->path_valid = true;
+
+	GDScriptCompiler compiler;
+	compiler.set_export_target(p_debug);
+	if (compiler.compile(&parser, script.ptr()) != OK) {
+		free_export_copy(script);
+		return Ref<GDScript>();
+	}
+	r_static_script = compiler.is_static_script();
+	return script;
+}
+
+void GDScriptByteCodeSerializer::free_export_copy(const Ref<GDScript> &p_script) {
+	ERR_FAIL_COND(p_script.is_null());
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		free_export_copy(E.value);
+	}
+	p_script->subclasses.clear();
+	_clear_class(p_script.ptr());
+}
+
+Vector<uint8_t> GDScriptByteCodeSerializer::save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, bool p_static_script) {
+	ERR_FAIL_COND_V(p_script.is_null(), Vector<uint8_t>());
+
+	Writer writer;
+	_write_class_tree(writer, p_script.ptr());
+	writer.put_8(p_static_script);
+	if (!_write_class(writer, p_script.ptr())) {
+		return Vector<uint8_t>();
+	}
+
+	const Vector<uint8_t> &contents = writer.buffer;
+	Vector<uint8_t> compressed;
+	compressed.resize(Compression::get_max_compressed_buffer_size(contents.size(), Compression::MODE_ZSTD));
+	int compressed_size = Compression::compress(compressed.ptrw(), contents.ptr(), contents.size(), Compression::MODE_ZSTD);
+	ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Error compressing compiled GDScript.");
+	compressed.resize(compressed_size);
+
+	Vector<uint8_t> buf;
+	buf.resize(HEADER_SIZE);
+	buf.write[0] = 'G';
+	buf.write[1] = 'D';
+	buf.write[2] = 'B';
+	buf.write[3] = 'C';
+	encode_uint32(FORMAT_VERSION, &buf.write[4]);
+	encode_uint32(_get_compatibility_hash(), &buf.write[8]);
+	encode_uint32(p_binary_tokens.size(), &buf.write[12]);
+	buf.append_array(p_binary_tokens);
+
+	int ofs = buf.size();
+	buf.resize(ofs + 4);
+	encode_uint32(contents.size(), &buf.write[ofs]);
+	buf.append_array(compressed);
+
+	return buf;
+}
+
+/* Loading */
+
+bool GDScriptByteCodeSerializer::unpack(const Vector<uint8_t> &p_buffer, Vector<uint8_t> &r_binary_tokens, Vector<uint8_t> &r_compiled) {
+	if (p_buffer.size() < HEADER_SIZE || p_buffer[0] != 'G' || p_buffer[1] != 'D' || p_buffer[2] != 'B' || p_buffer[3] != 'C') {
+		return false;
+	}
+
+	const uint8_t *buf = p_buffer.ptr();
+	uint32_t token_size = decode_uint32(&buf[12]);
+	ERR_FAIL_COND_V_MSG(token_size > uint32_t(p_buffer.size() - HEADER_SIZE), false, "Invalid compiled GDScript file.");
+	r_binary_tokens = p_buffer.slice(HEADER_SIZE, HEADER_SIZE + token_size);
+	r_compiled.clear();
+
+	// Anything built by another engine version only keeps its tokens.
+	if (decode_uint32(&buf[4]) != FORMAT_VERSION || decode_uint32(&buf[8]) != _get_compatibility_hash()) {
+		print_verbose(vformat("GDScript: Ignoring compiled code built by a different engine version, compiling from tokens instead."));
+		return true;
+	}
+
+	int ofs = HEADER_SIZE + token_size;
+	if (ofs + 4 > p_buffer.size()) {
+		return true;
+	}
+	int decompressed_size = decode_uint32(&buf[ofs]);
+	ofs += 4;
+	r_compiled.resize(decompressed_size);
+	int result = Compression::decompress(r_compiled.ptrw(), r_compiled.size(), &buf[ofs], p_buffer.size() - ofs, Compression::MODE_ZSTD);
+	if (result != decompressed_size) {
+		ERR_PRINT("Error decompressing compiled GDScript.");
+		r_compiled.clear();
+	}
+	return true;
+}
+
+Ref<Script> GDScriptByteCodeSerializer::_read_script_reference(Reader &p_reader, bool *r_local) {
+	if (r_local) {
+		*r_local = false;
+	}
+
+	switch (p_reader.get_8()) {
+		case SCRIPT_NONE:
+			return Ref<Script>();
+		case SCRIPT_GDSCRIPT: {
+			String path = p_reader.get_string();
+			String fqcn = p_reader.get_string();
+			if (p_reader.error) {
+				return Ref<Script>();
+			}
+
+			Ref<GDScript> root;
+			if (path == p_reader.root->path) {
+				root = Ref<GDScript>(p_reader.root);
+				if (r_local) {
+					*r_local = true;
+				}
+			} else {
+				// Registers the dependency, so `GDScriptCache::finish_compiling()` fully loads it afterwards.
+				Error err = OK;
+				root = GDScriptCache::get_shallow_script(path, err, p_reader.root->path);
+			}
+
+			GDScript *script = root.is_valid() ? root->find_class(fqcn) : nullptr;
+			if (script == nullptr) {
+				p_reader.error = true;
+				return Ref<Script>();
+			}
+			return Ref<Script>(script);
+		}
+		case SCRIPT_RESOURCE: {
+			Ref<Script> script = ResourceLoader::load(p_reader.get_string());
+			if (script.is_null()) {
+				p_reader.error = true;
+			}
+			return script;
+		}
+		default:
+			p_reader.error = true;
+			return Ref<Script>();
+	}
+}
+
+Variant GDScriptByteCodeSerializer::_read_variant(Reader &p_reader, int p_depth) {
+	if (p_depth > MAX_RECURSION) {
+		p_reader.error = true;
+		return Variant();
+	}
+
+	switch (p_reader.get_8()) {
+		case VARIANT_VALUE: {
+			int length = p_reader.get_count();
+			if (p_reader.error) {
+				return Variant();
+			}
+			Variant value;
+			if (decode_variant(value, &p_reader.data[p_reader.position], length) != OK) {
+				p_reader.error = true;
+			}
+			p_reader.position += length;
+			return value;
+		}
+		case VARIANT_NULL_OBJECT:
+			return Variant((Object *)nullptr);
+		case VARIANT_ARRAY: {
+			bool read_only = p_reader.get_8();
+			Variant::Type builtin_type = Variant::Type(p_reader.get_32());
+			StringName class_name = p_reader.get_string_name();
+			Ref<Script> script = _read_script_reference(p_reader);
+			int size = p_reader.get_count();
+			if (p_reader.error || builtin_type >= Variant::VARIANT_MAX) {
+				p_reader.error = true;
+				return Variant();
+			}
+
+			Array array;
+			if (builtin_type != Variant::NIL) {
+				array.set_typed(builtin_type, class_name, script);
+			}
+			array.resize(size);
+			for (int i = 0; i < size && !p_reader.error; i++) {
+				array[i] = _read_variant(p_reader, p_depth + 1);
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case VARIANT_DICTIONARY: {
+			bool read_only = p_reader.get_8();
+			int size = p_reader.get_count(2);
+			Dictionary dictionary;
+			for (int i = 0; i < size && !p_reader.error; i++) {
+				Variant key = _read_variant(p_reader, p_depth + 1);
+				dictionary[key] = _read_variant(p_reader, p_depth + 1);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		case VARIANT_SCRIPT:
+			return _read_script_reference(p_reader);
+		case VARIANT_NATIVE_CLASS: {
+			StringName name = p_reader.get_string_name();
+			const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+			if (p_reader.error || !global_map.has(name)) {
+				p_reader.error = true;
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[global_map[name]];
+		}
+		case VARIANT_RESOURCE: {
+			Ref<Resource> resource = ResourceLoader::load(p_reader.get_string());
+			if (resource.is_null()) {
+				p_reader.error = true;
+			}
+			return resource;
+		}
+		default:
+			p_reader.error = true;
+			return Variant();
+	}
+}
+
+GDScriptDataType GDScriptByteCodeSerializer::_read_data_type(Reader &p_reader) {
+	GDScriptDataType data_type;
+	data_type.kind = GDScriptDataType::Kind(p_reader.get_8());
+	data_type.has_type = p_reader.get_8();
+	data_type.builtin_type = Variant::Type(p_reader.get_32());
+	data_type.native_type = p_reader.get_string_name();
+	if (data_type.kind == GDScriptDataType::SCRIPT || data_type.kind == GDScriptDataType::GDSCRIPT) {
+		bool local = false;
+		Ref<Script> script = _read_script_reference(p_reader, &local);
+		data_type.script_type = script.ptr();
+		// Same as the compiler: classes of the same file are not held strongly, to avoid cycles.
+		if (!local) {
+			data_type.script_type_ref = script;
+		}
+	}
+	int element_count = p_reader.get_count();
+	for (int i = 0; i < element_count && !p_reader.error; i++) {
+		data_type.container_element_types.push_back(_read_data_type(p_reader));
+	}
+	return data_type;
+}
+
+PropertyInfo GDScriptByteCodeSerializer::_read_property_info(Reader &p_reader) {
+	PropertyInfo info;
+	info.type = Variant::Type(p_reader.get_32());
+	info.name = p_reader.get_string();
+	info.class_name = p_reader.get_string_name();
+	info.hint = PropertyHint(p_reader.get_32());
+	info.hint_string = p_reader.get_string();
+	info.usage = p_reader.get_32();
+	return info;
+}
+
+MethodInfo GDScriptByteCodeSerializer::_read_method_info(Reader &p_reader) {
+	MethodInfo info;
+	info.name = p_reader.get_string();
+	info.flags = p_reader.get_32();
+	info.id = p_reader.get_32();
+	info.return_val = _read_property_info(p_reader);
+	int argument_count = p_reader.get_count();
+	for (int i = 0; i < argument_count && !p_reader.error; i++) {
+		info.arguments.push_back(_read_property_info(p_reader));
+	}
+	int default_argument_count = p_reader.get_count();
+	for (int i = 0; i < default_argument_count && !p_reader.error; i++) {
+		info.default_arguments.push_back(_read_variant(p_reader));
+	}
+	return info;
+}
+
+void GDScriptByteCodeSerializer::_read_member_info(Reader &p_reader, StringName &r_name, GDScript::MemberInfo &r_info) {
+	r_name = p_reader.get_string_name();
+	r_info.index = p_reader.get_32();
+	r_info.setter = p_reader.get_string_name();
+	r_info.getter = p_reader.get_string_name();
+	r_info.property_info = _read_property_info(p_reader);
+	r_info.data_type = _read_data_type(p_reader);
+}
+
+GDScriptFunction *GDScriptByteCodeSerializer::_read_function(Reader &p_reader, GDScript *p_script, ClassData &r_data) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+	function->name = p_reader.get_string_name();
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+	function->_static = p_reader.get_8();
+
+	int argument_count = p_reader.get_count();
+	for (int i = 0; i < argument_count && !p_reader.error; i++) {
+		function->argument_types.push_back(_read_data_type(p_reader));
+	}
+	function->return_type = _read_data_type(p_reader);
+	function->method_info = _read_method_info(p_reader);
+	function->rpc_config = _read_variant(p_reader);
+
+	function->_initial_line = p_reader.get_32();
+	function->_argument_count = p_reader.get_32();
+	function->_stack_size = p_reader.get_32();
+	function->_instruction_args_size = p_reader.get_32();
+	int inline_cache_count = p_reader.get_32();
+
+	int temporary_count = p_reader.get_count(8);
+	for (int i = 0; i < temporary_count; i++) {
+		int slot = p_reader.get_32();
+		function->temporary_slots[slot] = Variant::Type(p_reader.get_32());
+	}
+
+	int stack_debug_count = p_reader.get_count(13);
+	for (int i = 0; i < stack_debug_count; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_reader.get_32();
+		stack_debug.pos = p_reader.get_32();
+		stack_debug.added = p_reader.get_8();
+		stack_debug.identifier = p_reader.get_string_name();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+	function->code.resize(p_reader.get_count(4));
+	for (int &word : function->code) {
+		word = p_reader.get_32();
+	}
+	int global_count = p_reader.get_count(8);
+	for (int i = 0; i < global_count; i++) {
+		int position = p_reader.get_32();
+		StringName global_name = p_reader.get_string_name();
+		const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+		if (position < 0 || position >= function->code.size() || !global_map.has(global_name)) {
+			p_reader.error = true;
+			break;
+		}
+		function->code.write[position] = global_map[global_name];
+	}
+	function->default_arguments.resize(p_reader.get_count(4));
+	for (int &position : function->default_arguments) {
+		position = p_reader.get_32();
+	}
+
+	function->constants.resize(p_reader.get_count());
+	for (int i = 0; i < function->constants.size() && !p_reader.error; i++) {
+		function->constants.write[i] = _read_variant(p_reader);
+	}
+	function->global_names.resize(p_reader.get_count(4));
+	for (StringName &global_name : function->global_names) {
+		global_name = p_reader.get_string_name();
+	}
+
+	int count = p_reader.get_count(4);
+	for (int i = 0; i < count; i++) {
+		uint32_t key = p_reader.get_32();
+		Variant::Operator op = Variant::Operator(key >> 16);
+		Variant::Type type_a = Variant::Type((key >> 8) & 0xFF);
+		Variant::Type type_b = Variant::Type(key & 0xFF);
+		if (op >= Variant::OP_MAX || type_a >= Variant::VARIANT_MAX || type_b >= Variant::VARIANT_MAX) {
+			p_reader.error = true;
+			break;
+		}
+		function->operator_funcs.push_back(Variant::get_validated_operator_evaluator(op, type_a, type_b));
+#ifdef DEBUG_ENABLED
+		function->operator_names.push_back(Variant::get_operator_name(op));
+#endif
+	}
+
+	count = p_reader.get_count(8);
+	for (int i = 0; i < count; i++) {
+		Variant::Type type = Variant::Type(p_reader.get_32());
+		StringName member = p_reader.get_string_name();
+		function->setters.push_back(type < Variant::VARIANT_MAX && Variant::has_member(type, member) ? Variant::get_member_validated_setter(type, member) : nullptr);
+#ifdef DEBUG_ENABLED
+		function->setter_names.push_back(member);
+#endif
+	}
+	count = p_reader.get_count(8);
+	for (int i = 0; i < count; i++) {
+		Variant::Type type = Variant::Type(p_reader.get_32());
+		StringName member = p_reader.get_string_name();
+		function->getters.push_back(type < Variant::VARIANT_MAX && Variant::has_member(type, member) ? Variant::get_member_validated_getter(type, member) : nullptr);
+#ifdef DEBUG_ENABLED
+		function->getter_names.push_back(member);
+#endif
+	}
+
+#define READ_TYPE_SYMBOLS(m_vector, m_getter)                                                          \
+	count = p_reader.get_count(4);                                                                     \
+	for (int i = 0; i < count; i++) {                                                                  \
+		Variant::Type type = Variant::Type(p_reader.get_32());                                         \
+		function->m_vector.push_back(type < Variant::VARIANT_MAX ? Variant::m_getter(type) : nullptr); \
+	}
+
+	READ_TYPE_SYMBOLS(keyed_setters, get_member_validated_keyed_setter);
+	READ_TYPE_SYMBOLS(keyed_getters, get_member_validated_keyed_getter);
+	READ_TYPE_SYMBOLS(indexed_setters, get_member_validated_indexed_setter);
+	READ_TYPE_SYMBOLS(indexed_getters, get_member_validated_indexed_getter);
+
+#undef READ_TYPE_SYMBOLS
+
+	count = p_reader.get_count(8);
+	for (int i = 0; i < count; i++) {
+		Variant::Type type = Variant::Type(p_reader.get_32());
+		StringName method = p_reader.get_string_name();
+		function->builtin_methods.push_back(type < Variant::VARIANT_MAX && Variant::has_builtin_method(type, method) ? Variant::get_validated_builtin_method(type, method) : nullptr);
+#ifdef DEBUG_ENABLED
+		function->builtin_methods_names.push_back(method);
+#endif
+	}
+	count = p_reader.get_count(8);
+	for (int i = 0; i < count; i++) {
+		Variant::Type type = Variant::Type(p_reader.get_32());
+		int index = p_reader.get_32();
+		bool valid = type < Variant::VARIANT_MAX && index >= 0 && index < Variant::get_constructor_count(type);
+		function->constructors.push_back(valid ? Variant::get_validated_constructor(type, index) : nullptr);
+#ifdef DEBUG_ENABLED
+		function->constructors_names.push_back(valid ? Variant::get_type_name(type) : String());
+#endif
+	}
+	count = p_reader.get_count(4);
+	for (int i = 0; i < count; i++) {
+		StringName utility = p_reader.get_string_name();
+		function->utilities.push_back(Variant::has_utility_function(utility) ? Variant::get_validated_utility_function(utility) : nullptr);
+#ifdef DEBUG_ENABLED
+		function->utilities_names.push_back(utility);
+#endif
+	}
+	count = p_reader.get_count(4);
+	for (int i = 0; i < count; i++) {
+		StringName utility = p_reader.get_string_name();
+		function->gds_utilities.push_back(GDScriptUtilityFunctions::function_exists(utility) ? GDScriptUtilityFunctions::get_function(utility) : nullptr);
+#ifdef DEBUG_ENABLED
+		function->gds_utilities_names.push_back(utility);
+#endif
+	}
+	count = p_reader.get_count(8);
+	for (int i = 0; i < count; i++) {
+		StringName class_name = p_reader.get_string_name();
+		StringName method = p_reader.get_string_name();
+		function->methods.push_back(p_reader.error ? nullptr : ClassDB::get_method(class_name, method));
+	}
+
+	count = p_reader.get_count();
+	for (int i = 0; i < count && !p_reader.error; i++) {
+		if (GDScriptFunction *lambda = _read_function(p_reader, p_script, r_data)) {
+			function->lambdas.push_back(lambda);
+		}
+	}
+
+	if (p_reader.get_8()) {
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_32();
+		info.use_self = p_reader.get_8();
+		r_data.lambda_info.insert(function, info);
+	}
+
+	// Every symbol must resolve, a null function pointer would only fail once the instruction runs.
+	bool resolved = function->operator_funcs.find(nullptr) == -1 && function->setters.find(nullptr) == -1 && function->getters.find(nullptr) == -1 &&
+			function->keyed_setters.find(nullptr) == -1 && function->keyed_getters.find(nullptr) == -1 && function->indexed_setters.find(nullptr) == -1 &&
+			function->indexed_getters.find(nullptr) == -1 && function->builtin_methods.find(nullptr) == -1 && function->constructors.find(nullptr) == -1 &&
+			function->utilities.find(nullptr) == -1 && function->gds_utilities.find(nullptr) == -1 && function->methods.find(nullptr) == -1;
+	// Each cache is referenced by one instruction word.
+	if (p_reader.error || !resolved || inline_cache_count < 0 || inline_cache_count > function->code.size()) {
+		p_reader.error = true;
+		r_data.lambda_info.erase(function);
+		memdelete(function);
+		return nullptr;
+	}
+
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_count = MAX(0, function->default_arguments.size() - 1);
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+
+#define SET_POINTER(m_vector, m_ptr, m_count)      \
+	function->m_count = function->m_vector.size(); \
+	function->m_ptr = function->m_vector.is_empty() ? nullptr : function->m_vector.ptr();
+
+	SET_POINTER(operator_funcs, _operator_funcs_ptr, _operator_funcs_count);
+	SET_POINTER(setters, _setters_ptr, _setters_count);
+	SET_POINTER(getters, _getters_ptr, _getters_count);
+	SET_POINTER(keyed_setters, _keyed_setters_ptr, _keyed_setters_count);
+	SET_POINTER(keyed_getters, _keyed_getters_ptr, _keyed_getters_count);
+	SET_POINTER(indexed_setters, _indexed_setters_ptr, _indexed_setters_count);
+	SET_POINTER(indexed_getters, _indexed_getters_ptr, _indexed_getters_count);
+	SET_POINTER(builtin_methods, _builtin_methods_ptr, _builtin_methods_count);
+	SET_POINTER(constructors, _constructors_ptr, _constructors_count);
+	SET_POINTER(utilities, _utilities_ptr, _utilities_count);
+	SET_POINTER(gds_utilities, _gds_utilities_ptr, _gds_utilities_count);
+
+#undef SET_POINTER
+
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	function->inline_caches.resize(inline_cache_count);
+	function->_inline_caches_count = inline_cache_count;
+	function->_inline_caches_ptr = function->inline_caches.is_empty() ? nullptr : function->inline_caches.ptr();
+	function->native_function = GDScriptNative::get_function(function);
+
+#ifdef DEBUG_ENABLED
+	if (EngineDebugger::is_active()) {
+		String signature = p_script->get_script_path() + "::" + itos(function->_initial_line);
+		if (p_script->local_name != StringName()) {
+			signature += "::" + String(p_script->local_name) + "." + String(function->name);
+		} else {
+			signature += "::" + String(function->name);
+		}
+		function->profile.signature = signature;
+	}
+#endif
+
+	return function;
+}
+
+void GDScriptByteCodeSerializer::_read_class_tree(Reader &p_reader, GDScript *p_script) {
+	p_script->fully_qualified_name = p_reader.get_string();
+	p_script->local_name = p_reader.get_string_name();
+	p_script->global_name = p_reader.get_string_name();
+	p_script->simplified_icon_path = p_reader.get_string();
+
+	// Existing inner classes are kept, like a compiler reload with `p_keep_state`.
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	int subclass_count = p_reader.get_count();
+	for (int i = 0; i < subclass_count && !p_reader.error; i++) {
+		StringName name = p_reader.get_string_name();
+		String fqcn = p_script->fully_qualified_name + "::" + String(name);
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fqcn);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		_read_class_tree(p_reader, subclass.ptr());
+	}
+}
+
+void GDScriptByteCodeSerializer::_clear_class(GDScript *p_script) {
+	// Mirrors `GDScriptCompiler::_prepare_compilation()`.
+	GDScriptFunction::invalidate_inline_caches();
+	p_script->clearing = true;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+
+	HashMap<StringName, Variant> constants = p_script->constants;
+	p_script->constants.clear();
+	constants.clear();
+
+	HashMap<StringName, GDScriptFunction *> member_functions = p_script->member_functions;
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->member_functions.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+
+	p_script->clearing = false;
+}
+
+void GDScriptByteCodeSerializer::_read_class(Reader &p_reader, GDScript *p_script, LocalVector<ClassData> &r_classes) {
+	// Nothing is stored in the script yet, a failure must leave it as it was.
+	r_classes.push_back(ClassData());
+	ClassData &data = r_classes[r_classes.size() - 1];
+	data.script = p_script;
+
+	data.tool = p_reader.get_8();
+
+	StringName native_name = p_reader.get_string_name();
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	if (p_reader.error || !global_map.has(native_name)) {
+		p_reader.error = true;
+		return;
+	}
+	data.native = GDScriptLanguage::get_singleton()->get_global_array()[global_map[native_name]];
+	data.base = _read_script_reference(p_reader);
+
+	int count = p_reader.get_count();
+	for (int i = 0; i < count && !p_reader.error; i++) {
+		StringName name;
+		GDScript::MemberInfo info;
+		_read_member_info(p_reader, name, info);
+		data.member_indices[name] = info;
+	}
+	count = p_reader.get_count();
+	for (int i = 0; i < count; i++) {
+		data.members.insert(p_reader.get_string_name());
+	}
+	count = p_reader.get_count();
+	for (int i = 0; i < count && !p_reader.error; i++) {
+		StringName name;
+		GDScript::MemberInfo info;
+		_read_member_info(p_reader, name, info);
+		data.static_variables_indices[name] = info;
+	}
+
+	count = p_reader.get_count();
+	for (int i = 0; i < count && !p_reader.error; i++) {
+		StringName name = p_reader.get_string_name();
+		data.constants.insert(name, _read_variant(p_reader));
+	}
+	count = p_reader.get_count();
+	for (int i = 0; i < count && !p_reader.error; i++) {
+		StringName name = p_reader.get_string_name();
+		data.signals[name] = _read_method_info(p_reader);
+	}
+	data.rpc_config = _read_variant(p_reader);
+
+	count = p_reader.get_count();
+	for (int i = 0; i < count && !p_reader.error; i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_script, data);
+		if (function) {
+			data.member_functions[function->name] = function;
+		}
+	}
+	if (p_reader.error) {
+		return;
+	}
+	if (p_reader.get_8()) {
+		data.implicit_initializer = _read_function(p_reader, p_script, data);
+	}
+	if (p_reader.get_8()) {
+		data.implicit_ready = _read_function(p_reader, p_script, data);
+	}
+	if (p_reader.get_8()) {
+		data.static_initializer = _read_function(p_reader, p_script, data);
+	}
+
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (p_reader.error) {
+			return;
+		}
+		// May reallocate `r_classes`, `data` isn't used past this point.
+		_read_class(p_reader, E.value.ptr(), r_classes);
+	}
+}
+
+void GDScriptByteCodeSerializer::_commit_class(ClassData &p_data) {
+	GDScript *script = p_data.script;
+	_clear_class(script);
+
+	script->tool = p_data.tool;
+	script->native = p_data.native;
+	script->base = p_data.base;
+	script->_base = p_data.base.ptr();
+	script->member_indices = p_data.member_indices;
+	script->members = p_data.members;
+	script->static_variables_indices = p_data.static_variables_indices;
+	script->static_variables.resize(script->static_variables_indices.size());
+	script->constants = p_data.constants;
+	script->_signals = p_data.signals;
+	script->rpc_config = p_data.rpc_config;
+	script->member_functions = p_data.member_functions;
+	if (GDScriptFunction **initializer = script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init)) {
+		script->initializer = *initializer;
+	}
+	script->implicit_initializer = p_data.implicit_initializer;
+	script->implicit_ready = p_data.implicit_ready;
+	script->static_initializer = p_data.static_initializer;
+	script->lambda_info = p_data.lambda_info;
+
+	script->_static_default_init();
+	script->valid = true;
+}
+
+void GDScriptByteCodeSerializer::_free_class(ClassData &p_data) {
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_data.member_functions) {
+		memdelete(E.value);
+	}
+	GDScriptFunction *implicit_functions[] = { p_data.implicit_initializer, p_data.implicit_ready, p_data.static_initializer };
+	for (GDScriptFunction *function : implicit_functions) {
+		if (function) {
+			memdelete(function);
+		}
+	}
+}
+
+Error GDScriptByteCodeSerializer::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_compiled) {
+	Reader reader;
+	reader.data = p_compiled.ptr();
+	reader.size = p_compiled.size();
+	reader.root = p_script;
+	_read_class_tree(reader, p_script);
+	return reader.error ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptByteCodeSerializer::load(GDScript *p_script, const Vector<uint8_t> &p_compiled) {
+	Reader reader;
+	reader.data = p_compiled.ptr();
+	reader.size = p_compiled.size();
+	reader.root = p_script;
+
+	// The class tree is read again, in case the inner classes changed since the shallow load.
+	// Like `GDScriptCompiler::make_scripts()`, it only names the classes, which a compile from the tokens does again.
+	_read_class_tree(reader, p_script);
+	p_script->_owner = nullptr;
+	bool add_static_script = reader.get_8();
+	LocalVector<ClassData> classes;
+	_read_class(reader, p_script, classes);
+
+	if (reader.error || reader.position != reader.size) {
+		for (ClassData &data : classes) {
+			_free_class(data);
+		}
+		return ERR_FILE_CORRUPT;
+	}
+	for (ClassData &data : classes) {
+		_commit_class(data);
+	}
+
+	if (add_static_script) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	return GDScriptCache::finish_compiling(p_script->path);
+}
@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  gdscript_byte_serializer.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTE_SERIALIZER_H
+#define GDSCRIPT_BYTE_SERIALIZER_H
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rb_map.h"
+#include "core/templates/vector.h"
+
+// Stores compiled GDScript classes next to their binary tokens in exported `.gdc` files,
+// so loading them skips the parser, the analyzer, and the code generator entirely.
+// Anything that only exists at runtime (function pointers, objects) is written by name or
+// by resource path and looked up again on load. If something can't be resolved the
+// compiled data is discarded and the script is compiled from its tokens as usual.
+class GDScriptByteCodeSerializer {
+public:
+	enum {
+		FORMAT_VERSION = 2,
+	};
+
+private:
+	class Writer;
+	class Reader;
+
+	struct FunctionSymbols {
+		RBMap<Variant::ValidatedOperatorEvaluator, uint32_t> operators;
+		RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+		RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+		RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+		RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+		RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+		RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+		RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+		RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+		RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+		RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+	};
+
+	// A class read from compiled data, stored in its script only once everything has been read.
+	struct ClassData {
+		GDScript *script = nullptr;
+		bool tool = false;
+		Ref<GDScriptNativeClass> native;
+		Ref<GDScript> base;
+		HashMap<StringName, GDScript::MemberInfo> member_indices;
+		HashSet<StringName> members;
+		HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+		HashMap<StringName, Variant> constants;
+		HashMap<StringName, MethodInfo> signals;
+		Dictionary rpc_config;
+		HashMap<StringName, GDScriptFunction *> member_functions;
+		GDScriptFunction *implicit_initializer = nullptr;
+		GDScriptFunction *implicit_ready = nullptr;
+		GDScriptFunction *static_initializer = nullptr;
+		HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+	};
+
+	static uint32_t _get_compatibility_hash();
+	static const FunctionSymbols &_get_function_symbols();
+
+	static bool _write_script_reference(Writer &p_writer, const Script *p_script);
+	static bool _write_variant(Writer &p_writer, const Variant &p_variant, int p_depth = 0);
+	static bool _write_data_type(Writer &p_writer, const GDScriptDataType &p_data_type);
+	static void _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static bool _write_method_info(Writer &p_writer, const MethodInfo &p_info);
+	static bool _write_member_info(Writer &p_writer, const StringName &p_name, const GDScript::MemberInfo &p_info);
+	static bool _write_function(Writer &p_writer, const GDScript *p_script, const GDScriptFunction *p_function);
+	static void _write_class_tree(Writer &p_writer, const GDScript *p_script);
+	static bool _write_class(Writer &p_writer, const GDScript *p_script);
+
+	static Ref<Script> _read_script_reference(Reader &p_reader, bool *r_local = nullptr);
+	static Variant _read_variant(Reader &p_reader, int p_depth = 0);
+	static GDScriptDataType _read_data_type(Reader &p_reader);
+	static PropertyInfo _read_property_info(Reader &p_reader);
+	static MethodInfo _read_method_info(Reader &p_reader);
+	static void _read_member_info(Reader &p_reader, StringName &r_name, GDScript::MemberInfo &r_info);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_script, ClassData &r_data);
+	static void _read_class_tree(Reader &p_reader, GDScript *p_script);
+	static void _read_class(Reader &p_reader, GDScript *p_script, LocalVector<ClassData> &r_classes);
+	static void _commit_class(ClassData &p_data);
+	static void _free_class(ClassData &p_data);
+	static void _clear_class(GDScript *p_script);
+
+public:
+	// Compiles the script at `p_path` again from its tokens, for an exported debug or release build (see
+	// `GDScriptCompiler::set_export_target()`). The copy is kept out of the caches, and must be freed with
+	// `free_export_copy()`. Returns null if the script doesn't compile.
+	static Ref<GDScript> compile_for_export(const String &p_path, const Vector<uint8_t> &p_binary_tokens, bool p_debug, bool &r_static_script);
+	// Frees the code of an export copy, without `GDScript::clear()` also clearing the scripts it uses.
+	static void free_export_copy(const Ref<GDScript> &p_script);
+	// Returns a `.gdc` file holding both the tokens and the compiled classes of `p_script`,
+	// or an empty buffer if the script can't be stored in compiled form.
+	static Vector<uint8_t> save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, bool p_static_script);
+	// Splits a `.gdc` file. Returns false if it only holds tokens, which are then left untouched.
+	static bool unpack(const Vector<uint8_t> &p_buffer, Vector<uint8_t> &r_binary_tokens, Vector<uint8_t> &r_compiled);
+
+	// Creates the inner class objects, like `GDScriptCompiler::make_scripts()` does from a parse tree.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_compiled);
+	// Replaces `GDScriptCompiler::compile()` for scripts with compiled data.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_compiled);
+};
+
+#endif // GDSCRIPT_BYTE_SERIALIZER_H
@@ -32,12 +32,33 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_byte_serializer.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
+// Doesn't touch the cache state, so it can run on any thread.
+Error GDScriptParserRef::parse_file(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash, bool *r_compiled) {
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> compiled_bytecode;
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path, &compiled_bytecode);
+		if (r_compiled && !compiled_bytecode.is_empty()) {
+			// The compiled bytecode is preferred, parse only when it's actually needed.
+			*r_compiled = true;
+			return OK;
+		}
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	}
+	String source = GDScriptCache::get_source_code(remapped_path);
+	r_source_hash = source.hash();
+	return p_parser->parse(source, p_path, false);
+}
+
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
 }
@@ -75,16 +96,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.get_extension().to_lower() == "gdc") {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = parse_file(get_parser(), path, source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -259,7 +271,7 @@ String GDScriptCache::get_source_code(const String &p_path) {
 	return source;
 }
 
-Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
+Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path, Vector<uint8_t> *r_compiled_bytecode) {
 	Vector<uint8_t> buffer;
 	Error err = OK;
 	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
@@ -270,6 +282,16 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	uint64_t read = f->get_buffer(buffer.ptrw(), buffer.size());
 	ERR_FAIL_COND_V_MSG(read != len, Vector<uint8_t>(), "Failed to read binary GDScript file '" + p_path + "'.");
 
+	// Compiled scripts embed their tokens, which stay available for the parser.
+	Vector<uint8_t> tokens;
+	Vector<uint8_t> compiled;
+	if (GDScriptByteCodeSerializer::unpack(buffer, tokens, compiled)) {
+		buffer = tokens;
+		if (r_compiled_bytecode) {
+			*r_compiled_bytecode = compiled;
+		}
+	}
+
 	return buffer;
 }
 
@@ -290,12 +312,14 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 	Ref<GDScript> script;
 	script.instantiate();
 	script->set_path(p_path, true);
+	Vector<uint8_t> compiled_bytecode;
 	if (remapped_path.get_extension().to_lower() == "gdc") {
-		Vector<uint8_t> buffer = get_binary_tokens(remapped_path);
+		Vector<uint8_t> buffer = get_binary_tokens(remapped_path, &compiled_bytecode);
 		if (buffer.is_empty()) {
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+		script->set_compiled_bytecode(compiled_bytecode);
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -304,15 +328,106 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	if (compiled_bytecode.is_empty() || GDScriptByteCodeSerializer::make_scripts(script.ptr(), compiled_bytecode) != OK) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
 	return script;
 }
 
+void GDScriptCache::_parse_task(uint32_t p_index, ParseTask *p_tasks) {
+	ParseTask &task = p_tasks[p_index];
+	task.result = GDScriptParserRef::parse_file(task.parser, task.path, task.source_hash, &task.compiled);
+}
+
+// Parsing a file needs nothing from other scripts, unlike analyzing it, so the files a script
+// depends on are parsed on worker threads, one layer of the dependency graph at a time.
+// Analysis and compilation then run as usual, finding the parsers already in the map.
+void GDScriptCache::parse_dependencies(const String &p_path, Vector<Ref<GDScriptParserRef>> &r_parsers) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+
+	HashSet<String> visited;
+	Vector<String> pending;
+	pending.push_back(p_path);
+
+	while (!pending.is_empty()) {
+		Vector<ParseTask> tasks;
+		for (const String &path : pending) {
+			if (visited.has(path)) {
+				continue;
+			}
+			visited.insert(path);
+
+			const String extension = path.get_extension().to_lower();
+			if (extension != "gd" && extension != "gdc") {
+				continue;
+			}
+			if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path)) {
+				continue;
+			}
+			if (!FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+
+			ParseTask task;
+			task.path = path;
+			// Created here, as the first parser sets up the shared annotation table.
+			task.parser = memnew(GDScriptParser);
+			tasks.push_back(task);
+		}
+		pending.clear();
+
+		if (tasks.is_empty()) {
+			break;
+		}
+
+		if (tasks.size() == 1 || pool == nullptr || pool->get_thread_count() < 2) {
+			for (int i = 0; i < tasks.size(); i++) {
+				singleton->_parse_task(i, tasks.ptrw());
+			}
+		} else {
+			WorkerThreadPool::GroupID group_task = pool->add_template_group_task(singleton, &GDScriptCache::_parse_task, tasks.ptrw(), tasks.size(), -1, false, SNAME("GDScriptParseDependencies"));
+			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(&singleton->mutex);
+			pool->wait_for_group_task_completion(group_task);
+			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+		}
+
+		for (ParseTask &task : tasks) {
+			// The lock may have been lifted while waiting, so someone else could have parsed it already.
+			if (task.compiled || singleton->parser_map.has(task.path)) {
+				memdelete(task.parser);
+				continue;
+			}
+
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = task.path;
+			ref->parser = task.parser;
+			ref->status = GDScriptParserRef::PARSED;
+			ref->result = task.result;
+			ref->source_hash = task.source_hash;
+			singleton->parser_map[task.path] = ref.ptr();
+			r_parsers.push_back(ref);
+
+			if (task.result != OK) {
+				continue;
+			}
+
+			for (const String &E : task.parser->get_dependencies()) {
+				pending.push_back(E);
+			}
+			const GDScriptParser::ClassNode *head = task.parser->get_tree();
+			if (head->extends_path.is_empty() && !head->extends.is_empty() && ScriptServer::is_global_class(head->extends[0]->name)) {
+				pending.push_back(ScriptServer::get_global_class_path(head->extends[0]->name));
+			}
+		}
+	}
+}
+
 Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_error, const String &p_owner, bool p_update_from_disk) {
 	MutexLock lock(singleton->mutex);
 
@@ -329,7 +444,11 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Keeps the parsers done ahead of time alive until the script is compiled.
+	Vector<Ref<GDScriptParserRef>> parsed_dependencies;
+
 	if (script.is_null()) {
+		parse_dependencies(p_path, parsed_dependencies);
 		script = get_shallow_script(p_path, r_error);
 		// Only exit early if script failed to load, otherwise let reload report errors.
 		if (script.is_null()) {
@@ -339,12 +458,14 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 
 	if (p_update_from_disk) {
 		if (p_path.get_extension().to_lower() == "gdc") {
-			Vector<uint8_t> buffer = get_binary_tokens(p_path);
+			Vector<uint8_t> compiled_bytecode;
+			Vector<uint8_t> buffer = get_binary_tokens(p_path, &compiled_bytecode);
 			if (buffer.is_empty()) {
 				r_error = ERR_FILE_CANT_READ;
 				return script;
 			}
 			script->set_binary_tokens_source(buffer);
+			script->set_compiled_bytecode(compiled_bytecode);
 		} else {
 			r_error = script->load_source_code(p_path);
 			if (r_error) {
@@ -63,6 +63,8 @@ private:
 	friend class GDScriptCache;
 	friend class GDScript;
 
+	static Error parse_file(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash, bool *r_compiled = nullptr);
+
 public:
 	Status get_status() const;
 	String get_path() const;
@@ -86,6 +88,7 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
 	friend class GDScript;
+	friend class GDScriptByteCodeSerializer;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -95,6 +98,17 @@ class GDScriptCache {
 
 	Mutex mutex;
 
+	struct ParseTask {
+		String path;
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+		bool compiled = false;
+	};
+
+	void _parse_task(uint32_t p_index, ParseTask *p_tasks);
+	static void parse_dependencies(const String &p_path, Vector<Ref<GDScriptParserRef>> &r_parsers);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
@@ -102,7 +116,7 @@ public:
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
-	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static Vector<uint8_t> get_binary_tokens(const String &p_path, Vector<uint8_t> *r_compiled_bytecode = nullptr);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	static Ref<GDScript> get_full_script(const String &p_path, Error &r_error, const String &p_owner = String(), bool p_update_from_disk = false);
 	static Ref<GDScript> get_cached_script(const String &p_path);
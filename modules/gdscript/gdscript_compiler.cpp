@@ -251,6 +251,165 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+// Returns the value of a function whose body is a single `return`, or null otherwise.
+static const GDScriptParser::ExpressionNode *_get_single_return_value(const GDScriptParser::FunctionNode *p_function) {
+	if (p_function == nullptr || p_function->body == nullptr || p_function->body->statements.size() != 1) {
+		return nullptr;
+	}
+	const GDScriptParser::Node *statement = p_function->body->statements[0];
+	if (statement->type != GDScriptParser::Node::RETURN) {
+		return nullptr;
+	}
+	return static_cast<const GDScriptParser::ReturnNode *>(statement)->return_value;
+}
+
+// Largest expression, in nodes, that is compiled in place of a call to the function holding it.
+static const int INLINE_EXPRESSION_BUDGET = 16;
+
+// Only expressions that can't run any script code are inlined, so the arguments can be
+// used directly as the parameters without copying them first.
+bool GDScriptCompiler::_is_inlinable_expression(CodeGen &codegen, const GDScriptParser::ExpressionNode *p_expression, const GDScriptParser::FunctionNode *p_function, bool p_allow_members, int &r_budget) {
+	if (p_expression == nullptr || --r_budget < 0) {
+		return false;
+	}
+
+	if (p_expression->is_constant) {
+		return !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS);
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			if (identifier->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER) {
+				return p_function->parameters_indices.has(identifier->name);
+			}
+			if (identifier->source == GDScriptParser::IdentifierNode::MEMBER_VARIABLE && p_allow_members) {
+				// Members behind another accessor would need a call.
+				HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = codegen.script->member_indices.find(identifier->name);
+				return E && (E->value.getter == StringName() || E->value.getter == p_function->identifier->name);
+			}
+			return false;
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			return _is_inlinable_expression(codegen, unary->operand, p_function, p_allow_members, r_budget);
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			if (binary->operation == GDScriptParser::BinaryOpNode::OP_CONTENT_TEST) {
+				return false; // May look up a property on an object.
+			}
+			return _is_inlinable_expression(codegen, binary->left_operand, p_function, p_allow_members, r_budget) && _is_inlinable_expression(codegen, binary->right_operand, p_function, p_allow_members, r_budget);
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			return _is_inlinable_expression(codegen, ternary->condition, p_function, p_allow_members, r_budget) && _is_inlinable_expression(codegen, ternary->true_expr, p_function, p_allow_members, r_budget) && _is_inlinable_expression(codegen, ternary->false_expr, p_function, p_allow_members, r_budget);
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_expression);
+			const GDScriptParser::DataType base_type = subscript->base->get_datatype();
+			if (!base_type.is_hard_type() || base_type.kind != GDScriptParser::DataType::BUILTIN || base_type.builtin_type == Variant::OBJECT) {
+				return false;
+			}
+			if (!subscript->is_attribute && !_is_inlinable_expression(codegen, subscript->index, p_function, p_allow_members, r_budget)) {
+				return false;
+			}
+			return _is_inlinable_expression(codegen, subscript->base, p_function, p_allow_members, r_budget);
+		}
+		default:
+			return false;
+	}
+}
+
+// Compiles p_expression, taken from the body of p_function, into p_target instead of calling p_function.
+// Returns false without emitting anything when the call has to be made as usual.
+bool GDScriptCompiler::_inline_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::FunctionNode *p_function, const StringName &p_function_name, const GDScriptParser::ExpressionNode *p_expression, const Vector<GDScriptCodeGenerator::Address> &p_arguments, const GDScriptCodeGenerator::Address &p_target, bool p_use_conversion) {
+	if (EngineDebugger::is_active() || (exporting && export_debug)) {
+		return false; // Keep every call, so breakpoints in small functions still work.
+	}
+	if (p_function == nullptr || p_function->is_coroutine || p_function->parameters.size() != p_arguments.size()) {
+		return false;
+	}
+
+	int budget = INLINE_EXPRESSION_BUDGET;
+	if (!_is_inlinable_expression(codegen, p_expression, p_function, !p_function->is_static, budget)) {
+		return false;
+	}
+
+	// Arguments are bound as they are when their type already matches, which is the usual case for typed code.
+	// Otherwise only the implicit int to float conversion is done here, anything else is left to the call checks.
+	LocalVector<int> conversions;
+	for (int i = 0; i < p_function->parameters.size(); i++) {
+		GDScriptDataType par_type = _gdtype_from_datatype(p_function->parameters[i]->get_datatype(), codegen.script);
+		const GDScriptDataType &arg_type = p_arguments[i].type;
+		if (!par_type.has_type) {
+			continue;
+		}
+		if (par_type.kind != GDScriptDataType::BUILTIN || !par_type.container_element_types.is_empty() || !arg_type.has_type || arg_type.kind != GDScriptDataType::BUILTIN) {
+			return false;
+		}
+		if (par_type.builtin_type == arg_type.builtin_type) {
+			continue;
+		}
+		if (par_type.builtin_type == Variant::FLOAT && arg_type.builtin_type == Variant::INT) {
+			conversions.push_back(i);
+			continue;
+		}
+		return false;
+	}
+
+	// Expressions consume the temporaries they are given, so arguments held in temporaries, or which
+	// need converting, are copied to locals. Those can't be scoped to a block while temporaries are in
+	// use, so they live until the caller's block ends.
+	HashMap<StringName, GDScriptCodeGenerator::Address> parameters;
+	List<GDScriptCodeGenerator::Address> argument_locals;
+	for (int i = 0; i < p_function->parameters.size(); i++) {
+		const StringName &parameter_name = p_function->parameters[i]->identifier->name;
+		GDScriptCodeGenerator::Address argument = p_arguments[i];
+		bool convert = conversions.has(i);
+		if (convert || argument.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+			GDScriptDataType local_type = convert ? _gdtype_from_datatype(p_function->parameters[i]->get_datatype(), codegen.script) : argument.type;
+			GDScriptCodeGenerator::Address local(GDScriptCodeGenerator::Address::LOCAL_VARIABLE, codegen.generator->add_local("@" + String(parameter_name), local_type), local_type);
+			if (convert) {
+				codegen.generator->write_assign_with_conversion(local, argument);
+			} else {
+				codegen.generator->write_assign(local, argument);
+			}
+			argument_locals.push_back(local);
+			argument = local;
+		}
+		parameters[parameter_name] = argument;
+	}
+
+	// The body only sees its own parameters, and accesses the members behind its property directly.
+	HashMap<StringName, GDScriptCodeGenerator::Address> caller_parameters = codegen.parameters;
+	HashMap<StringName, GDScriptCodeGenerator::Address> caller_locals = codegen.locals;
+	StringName caller_name = codegen.function_name;
+	codegen.parameters = parameters;
+	codegen.locals.clear();
+	codegen.function_name = p_function_name;
+
+	GDScriptCodeGenerator::Address value = _parse_expression(codegen, r_error, p_expression);
+
+	codegen.parameters = caller_parameters;
+	codegen.locals = caller_locals;
+	codegen.function_name = caller_name;
+
+	if (!r_error) {
+		if (p_use_conversion) {
+			codegen.generator->write_assign_with_conversion(p_target, value);
+		} else {
+			codegen.generator->write_assign(p_target, value);
+		}
+		if (value.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+			codegen.generator->pop_temporary();
+		}
+		_clear_block_locals(codegen, argument_locals);
+	}
+
+	return true;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -304,6 +463,16 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 								// Perform getter.
 								GDScriptCodeGenerator::Address temp = codegen.add_temporary(codegen.script->member_indices[identifier].data_type);
 								Vector<GDScriptCodeGenerator::Address> args; // No argument needed.
+								if (codegen.class_node->has_member(identifier)) {
+									// Properties can't be overridden, so a simple getter of this class can be inlined.
+									const GDScriptParser::ClassNode::Member member = codegen.class_node->get_member(identifier);
+									if (member.type == GDScriptParser::ClassNode::Member::VARIABLE && member.variable->property == GDScriptParser::VariableNode::PROP_INLINE) {
+										const GDScriptParser::FunctionNode *getter = member.variable->getter;
+										if (_inline_expression(codegen, r_error, getter, codegen.script->member_indices[identifier].getter, _get_single_return_value(getter), args, temp, temp.type.has_type)) {
+											return temp;
+										}
+									}
+								}
 								gen->write_call_self(temp, codegen.script->member_indices[identifier].getter, args);
 								return temp;
 							} else {
@@ -652,7 +821,19 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 						} else if (call->is_static || codegen.is_static || (codegen.function_node && codegen.function_node->is_static) || call->function_name == "new") {
 							GDScriptCodeGenerator::Address self;
 							self.mode = GDScriptCodeGenerator::Address::CLASS;
-							if (is_awaited) {
+							// Calls on the class always reach its own static function, so a small one can be inlined.
+							const GDScriptParser::FunctionNode *static_function = nullptr;
+							if (!p_root && !is_awaited && codegen.class_node->has_function(call->function_name)) {
+								const GDScriptParser::FunctionNode *function = codegen.class_node->get_member(call->function_name).function;
+								if (function->is_static) {
+									static_function = function;
+								}
+							}
+							if (static_function && _inline_expression(codegen, r_error, static_function, call->function_name, _get_single_return_value(static_function), arguments, result, result.type.has_type)) {
+								if (r_error) {
+									return GDScriptCodeGenerator::Address();
+								}
+							} else if (is_awaited) {
 								gen->write_call_async(result, self, call->function_name, arguments);
 							} else {
 								gen->write_call(result, self, call->function_name, arguments);
@@ -1346,8 +1527,25 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 					// Call setter.
 					Vector<GDScriptCodeGenerator::Address> args;
 					args.push_back(to_assign);
-					GDScriptCodeGenerator::Address call_base = is_static ? GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::CLASS) : GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::SELF);
-					gen->write_call(GDScriptCodeGenerator::Address(), call_base, setter_function, args);
+					bool inlined = false;
+					if (!is_static && codegen.class_node->has_member(var_name)) {
+						// A setter that only stores an expression of its parameter into the property is inlined like getters are.
+						const GDScriptParser::ClassNode::Member class_member = codegen.class_node->get_member(var_name);
+						const GDScriptParser::FunctionNode *setter = class_member.type == GDScriptParser::ClassNode::Member::VARIABLE && class_member.variable->property == GDScriptParser::VariableNode::PROP_INLINE ? class_member.variable->setter : nullptr;
+						if (setter && setter->body && setter->body->statements.size() == 1 && setter->body->statements[0]->type == GDScriptParser::Node::ASSIGNMENT) {
+							const GDScriptParser::AssignmentNode *store = static_cast<const GDScriptParser::AssignmentNode *>(setter->body->statements[0]);
+							if (store->operation == GDScriptParser::AssignmentNode::OP_NONE && store->assignee->type == GDScriptParser::Node::IDENTIFIER && static_cast<const GDScriptParser::IdentifierNode *>(store->assignee)->name == var_name) {
+								inlined = _inline_expression(codegen, r_error, setter, setter_function, store->assigned_value, args, member, store->use_conversion_assign);
+								if (r_error) {
+									return GDScriptCodeGenerator::Address();
+								}
+							}
+						}
+					}
+					if (!inlined) {
+						GDScriptCodeGenerator::Address call_base = is_static ? GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::CLASS) : GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::SELF);
+						gen->write_call(GDScriptCodeGenerator::Address(), call_base, setter_function, args);
+					}
 				} else if (is_static) {
 					GDScriptCodeGenerator::Address temp = codegen.add_temporary(static_var_data_type);
 					if (assignment->use_conversion_assign) {
@@ -1886,7 +2084,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 #ifdef DEBUG_ENABLED
 		// Add a newline before each statement, since the debugger needs those.
-		gen->write_newline(s->start_line);
+		if (_has_debug_code()) {
+			gen->write_newline(s->start_line);
+		}
 #endif
 
 		switch (s->type) {
@@ -1938,7 +2138,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 #ifdef DEBUG_ENABLED
 					// Add a newline before each branch, since the debugger needs those.
-					gen->write_newline(branch->start_line);
+					if (_has_debug_code()) {
+						gen->write_newline(branch->start_line);
+					}
 #endif
 					// For each pattern in branch.
 					GDScriptCodeGenerator::Address pattern_result = codegen.add_temporary();
@@ -2118,6 +2320,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::ASSERT: {
 #ifdef DEBUG_ENABLED
+				if (!_has_debug_code()) {
+					break; // Not even the condition is evaluated in release builds.
+				}
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
@@ -2145,7 +2350,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::BREAKPOINT: {
 #ifdef DEBUG_ENABLED
-				gen->write_breakpoint();
+				if (_has_debug_code()) {
+					gen->write_breakpoint();
+				}
 #endif
 			} break;
 			case GDScriptParser::Node::VARIABLE: {
@@ -2619,6 +2826,8 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	parsing_classes.insert(p_script);
 
+	// Cached lookups may point into the members and functions about to be freed.
+	GDScriptFunction::invalidate_inline_caches();
 	p_script->clearing = true;
 
 	p_script->native = Ref<GDScriptNativeClass>();
@@ -3239,13 +3448,27 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
 
-	if (has_static_data && !root->annotated_static_unload) {
+	static_script = has_static_data && !root->annotated_static_unload;
+	if (exporting) {
+		return OK;
+	}
+
+	if (static_script) {
 		GDScriptCache::add_static_script(p_script);
 	}
 
 	return GDScriptCache::finish_compiling(main_script->path);
 }
 
+void GDScriptCompiler::set_export_target(bool p_debug) {
+	exporting = true;
+	export_debug = p_debug;
+}
+
+bool GDScriptCompiler::is_static_script() const {
+	return static_script;
+}
+
 String GDScriptCompiler::get_error() const {
 	return error;
 }
@@ -151,6 +151,8 @@ class GDScriptCompiler {
 
 	GDScriptDataType _gdtype_from_datatype(const GDScriptParser::DataType &p_datatype, GDScript *p_owner, bool p_handle_metatype = true);
 
+	bool _is_inlinable_expression(CodeGen &codegen, const GDScriptParser::ExpressionNode *p_expression, const GDScriptParser::FunctionNode *p_function, bool p_allow_members, int &r_budget);
+	bool _inline_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::FunctionNode *p_function, const StringName &p_function_name, const GDScriptParser::ExpressionNode *p_expression, const Vector<GDScriptCodeGenerator::Address> &p_arguments, const GDScriptCodeGenerator::Address &p_target, bool p_use_conversion);
 	GDScriptCodeGenerator::Address _parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root = false, bool p_initializer = false);
 	GDScriptCodeGenerator::Address _parse_match_pattern(CodeGen &codegen, Error &r_error, const GDScriptParser::PatternNode *p_pattern, const GDScriptCodeGenerator::Address &p_value_addr, const GDScriptCodeGenerator::Address &p_type_addr, const GDScriptCodeGenerator::Address &p_previous_test, bool p_is_first, bool p_is_nested);
 	List<GDScriptCodeGenerator::Address> _add_block_locals(CodeGen &codegen, const GDScriptParser::SuiteNode *p_block);
@@ -174,12 +176,26 @@ class GDScriptCompiler {
 	String error;
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
+	bool static_script = false;
+
+	// Set by `set_export_target()`.
+	bool exporting = false;
+	bool export_debug = false;
+
+	// Exported release builds leave out the code only debug builds run.
+	bool _has_debug_code() const { return !exporting || export_debug; }
 
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
 
+	// Compiles for an exported debug or release build instead of the running one. Release code has no
+	// asserts, breakpoints or line opcodes, debug code doesn't inline functions so breakpoints in them work.
+	// The script isn't registered in `GDScriptCache`, `is_static_script()` tells whether it should be.
+	void set_export_target(bool p_debug);
+	bool is_static_script() const;
+
 	String get_error() const;
 	int get_error_line() const;
 	int get_error_column() const;
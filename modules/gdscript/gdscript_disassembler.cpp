@@ -100,9 +100,12 @@ static String _disassemble_address(const GDScript *p_script, const GDScriptFunct
 void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 #define DADDR(m_ip) (_disassemble_address(_script, *this, _code_ptr[ip + m_ip]))
 
+	int instruction_count = 0;
+
 	for (int ip = 0; ip < _code_size;) {
 		StringBuilder text;
 		int incr = 0;
+		instruction_count++;
 
 		text += " ";
 		text += itos(ip);
@@ -141,6 +144,154 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_ADD_INT:
+			case OPCODE_OPERATOR_ADD_FLOAT:
+			case OPCODE_OPERATOR_ADD_VECTOR2:
+			case OPCODE_OPERATOR_ADD_VECTOR3: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " + ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_SUBTRACT_INT:
+			case OPCODE_OPERATOR_SUBTRACT_FLOAT:
+			case OPCODE_OPERATOR_SUBTRACT_VECTOR2:
+			case OPCODE_OPERATOR_SUBTRACT_VECTOR3: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " - ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_MULTIPLY_INT:
+			case OPCODE_OPERATOR_MULTIPLY_FLOAT:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR2:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR3:
+			case OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " * ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_EQUAL_INT:
+			case OPCODE_OPERATOR_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_EQUAL_BOOL: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " == ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_NOT_EQUAL_INT:
+			case OPCODE_OPERATOR_NOT_EQUAL_FLOAT:
+			case OPCODE_OPERATOR_NOT_EQUAL_BOOL: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " != ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_LESS_INT:
+			case OPCODE_OPERATOR_LESS_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " < ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_LESS_EQUAL_INT:
+			case OPCODE_OPERATOR_LESS_EQUAL_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " <= ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_GREATER_INT:
+			case OPCODE_OPERATOR_GREATER_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " > ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_GREATER_EQUAL_INT:
+			case OPCODE_OPERATOR_GREATER_EQUAL_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " >= ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_DIVIDE_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " / ";
+				text += DADDR(2);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_NEGATE_INT:
+			case OPCODE_OPERATOR_NEGATE_FLOAT: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = -";
+				text += DADDR(1);
+
+				incr += 4;
+			} break;
+			case OPCODE_OPERATOR_NOT_BOOL: {
+				text += "typed operator ";
+
+				text += DADDR(3);
+				text += " = not ";
+				text += DADDR(1);
+
+				incr += 4;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -267,7 +418,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -288,7 +439,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -597,7 +748,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -945,6 +1096,66 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_JUMP_IF_BOOL: {
+				text += "jump-if-bool ";
+				text += DADDR(1);
+				text += " to ";
+				text += itos(_code_ptr[ip + 2]);
+
+				incr = 3;
+			} break;
+			case OPCODE_JUMP_IF_NOT_BOOL: {
+				text += "jump-if-not-bool ";
+				text += DADDR(1);
+				text += " to ";
+				text += itos(_code_ptr[ip + 2]);
+
+				incr = 3;
+			} break;
+			case OPCODE_JUMP_IF_EQUAL_INT:
+			case OPCODE_JUMP_IF_EQUAL_FLOAT: {
+				text += "jump-if ";
+				text += DADDR(1);
+				text += " == ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 3]);
+
+				incr = 4;
+			} break;
+			case OPCODE_JUMP_IF_NOT_EQUAL_INT:
+			case OPCODE_JUMP_IF_NOT_EQUAL_FLOAT: {
+				text += "jump-if ";
+				text += DADDR(1);
+				text += " != ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 3]);
+
+				incr = 4;
+			} break;
+			case OPCODE_JUMP_IF_NOT_LESS_INT:
+			case OPCODE_JUMP_IF_NOT_LESS_FLOAT: {
+				text += "jump-if-not ";
+				text += DADDR(1);
+				text += " < ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 3]);
+
+				incr = 4;
+			} break;
+			case OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT:
+			case OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT: {
+				text += "jump-if-not ";
+				text += DADDR(1);
+				text += " <= ";
+				text += DADDR(2);
+				text += " to ";
+				text += itos(_code_ptr[ip + 3]);
+
+				incr = 4;
+			} break;
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
@@ -1179,6 +1390,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			print_line(text.as_string());
 		}
 	}
+
+	if (unoptimized_instruction_count > 0) {
+		print_line(vformat(" instructions: %d (%d before optimization)", instruction_count, unoptimized_instruction_count));
+	} else {
+		print_line(vformat(" instructions: %d", instruction_count));
+	}
 }
 
 #endif // DEBUG_ENABLED
@@ -32,6 +32,32 @@
 
 #include "gdscript.h"
 
+bool GDScriptDataType::convert_for_set(const Variant &p_value, Variant &r_value) const {
+	r_value = p_value;
+	if (!has_type || is_type(r_value)) {
+		return true;
+	}
+
+	if (builtin_type == Variant::ARRAY && has_container_element_type(0) && p_value.get_type() == Variant::ARRAY) {
+		// Elements are converted like `Array.assign()` does, instead of failing on an untyped array.
+		const Array source = p_value;
+		const GDScriptDataType &element_type = container_element_types[0];
+		Array array;
+		array.set_typed(element_type.builtin_type, element_type.native_type, element_type.script_type);
+		array.assign(source);
+		if (array.size() != source.size()) {
+			return false;
+		}
+		r_value = array;
+		return true;
+	}
+
+	const Variant *args = &p_value;
+	Callable::CallError err;
+	Variant::construct(builtin_type, r_value, &args, 1, err);
+	return err.error == Callable::CallError::CALL_OK && is_type(r_value);
+}
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -115,7 +141,11 @@ GDScriptFunction::GDScriptFunction() {
 }
 
 GDScriptFunction::~GDScriptFunction() {
-	get_script()->member_functions.erase(name);
+	// A function that was never stored, or was already replaced, may share its name with the one in use.
+	HashMap<StringName, GDScriptFunction *>::Iterator E = get_script()->member_functions.find(name);
+	if (E && E->value == this) {
+		get_script()->member_functions.remove(E);
+	}
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
@@ -246,12 +276,15 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 #endif
 	}
 
+	// Either freed by the call, or handed over to the state it returned when awaiting again.
+	_free_stack();
+
 	return ret;
 }
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
@@ -260,6 +293,75 @@ void GDScriptFunctionState::_clear_stack() {
 	}
 }
 
+SpinLock GDScriptFunctionState::stack_pool_lock;
+LocalVector<uint8_t *> GDScriptFunctionState::stack_pool[STACK_POOL_CLASSES];
+bool GDScriptFunctionState::stack_pool_enabled = true;
+
+int GDScriptFunctionState::_get_stack_pool_class(uint32_t p_size) {
+	const int pool_class = MAX(get_shift_from_power_of_2(next_power_of_2(p_size)), (int)STACK_POOL_MIN_SHIFT) - STACK_POOL_MIN_SHIFT;
+	return pool_class < STACK_POOL_CLASSES ? pool_class : -1;
+}
+
+void GDScriptFunctionState::_allocate_stack(uint32_t p_size) {
+	DEV_ASSERT(state.stack == nullptr);
+
+	const int pool_class = _get_stack_pool_class(p_size);
+	if (pool_class >= 0) {
+		stack_pool_lock.lock();
+		if (!stack_pool[pool_class].is_empty()) {
+			state.stack = stack_pool[pool_class][stack_pool[pool_class].size() - 1];
+			stack_pool[pool_class].remove_at_unordered(stack_pool[pool_class].size() - 1);
+		}
+		stack_pool_lock.unlock();
+
+		if (!state.stack) {
+			state.stack = (uint8_t *)memalloc(1 << (pool_class + STACK_POOL_MIN_SHIFT));
+		}
+	} else {
+		state.stack = (uint8_t *)memalloc(p_size);
+	}
+	state.alloca_size = p_size;
+}
+
+void GDScriptFunctionState::_free_stack() {
+	if (!state.stack) {
+		return;
+	}
+
+	const int pool_class = _get_stack_pool_class(state.alloca_size);
+	if (pool_class >= 0) {
+		stack_pool_lock.lock();
+		if (stack_pool_enabled && stack_pool[pool_class].size() < STACK_POOL_MAX_FREE) {
+			stack_pool[pool_class].push_back(state.stack);
+			state.stack = nullptr;
+		}
+		stack_pool_lock.unlock();
+	}
+
+	if (state.stack) {
+		memfree(state.stack);
+		state.stack = nullptr;
+	}
+}
+
+void GDScriptFunctionState::init_stack_pool() {
+	stack_pool_lock.lock();
+	stack_pool_enabled = true;
+	stack_pool_lock.unlock();
+}
+
+void GDScriptFunctionState::clear_stack_pool() {
+	stack_pool_lock.lock();
+	stack_pool_enabled = false;
+	for (int i = 0; i < STACK_POOL_CLASSES; i++) {
+		for (uint8_t *stack : stack_pool[i]) {
+			memfree(stack);
+		}
+		stack_pool[i].reset();
+	}
+	stack_pool_lock.unlock();
+}
+
 void GDScriptFunctionState::_clear_connections() {
 	List<Object::Connection> conns;
 	get_signals_connected_to_this(&conns);
@@ -288,4 +390,8 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+
+	// Never resumed, so the stack still holds the values saved when awaiting.
+	_clear_stack();
+	_free_stack();
 }
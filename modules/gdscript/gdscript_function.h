@@ -31,12 +31,15 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_native.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
@@ -194,6 +197,10 @@ public:
 		return !container_element_types.is_empty();
 	}
 
+	// Converts a value set on a member of this type from outside the script, as in `object.member = value`.
+	// Returns false if the value can't be stored.
+	bool convert_for_set(const Variant &p_value, Variant &r_value) const;
+
 	GDScriptDataType() = default;
 
 	void operator=(const GDScriptDataType &p_other) {
@@ -218,6 +225,39 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Operators on the payloads of typed values, see GDScriptByteCodeGenerator::write_binary_operator().
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_NEGATE_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NEGATE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_BOOL,
+		OPCODE_OPERATOR_NOT_EQUAL_BOOL,
+		OPCODE_OPERATOR_NOT_BOOL,
+		OPCODE_OPERATOR_ADD_VECTOR2,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_OPERATOR_ADD_VECTOR3,
+		OPCODE_OPERATOR_SUBTRACT_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3,
+		OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -275,6 +315,16 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_BOOL,
+		OPCODE_JUMP_IF_NOT_BOOL,
+		OPCODE_JUMP_IF_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_EQUAL_INT,
+		OPCODE_JUMP_IF_NOT_LESS_INT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT,
+		OPCODE_JUMP_IF_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_EQUAL_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_FLOAT,
+		OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -397,11 +447,60 @@ public:
 		StringName identifier;
 	};
 
+	// How an untyped named access or call was resolved for one kind of receiver.
+	enum InlineCacheKind {
+		INLINE_CACHE_UNCACHEABLE, // Always takes the generic path.
+		INLINE_CACHE_BUILTIN_GETTER,
+		INLINE_CACHE_MEMBER,
+		INLINE_CACHE_SCRIPT_FUNCTION,
+		INLINE_CACHE_METHOD_BIND,
+	};
+
+	enum InlineCacheAccess {
+		INLINE_CACHE_GET,
+		INLINE_CACHE_SET,
+		INLINE_CACHE_CALL,
+	};
+
+	// Plain data only, so it can be copied out of a slot that another thread may be rewriting.
+	struct InlineCacheEntry {
+		uint32_t epoch = 0; // Zero while unused, stale once it differs from inline_cache_epoch.
+		InlineCacheKind kind = INLINE_CACHE_UNCACHEABLE;
+
+		// Receiver key.
+		Variant::Type builtin_type = Variant::NIL;
+		const GDScript *script = nullptr;
+		const StringName *native_class = nullptr; // Object::get_class_name() is one static per class.
+
+		// Resolved target.
+		int index = -1; // Member index, or the index passed to an indexed native setter.
+		const GDScriptDataType *data_type = nullptr;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		Variant::ValidatedGetter getter = nullptr;
+	};
+
+	// Entries are rewritten in place under a sequence lock: the sequence is odd while a writer is
+	// busy, and readers retry another slot if it changed while they were copying the entry.
+	struct InlineCacheSlot {
+		SafeNumeric<uint32_t> sequence;
+		InlineCacheEntry entry;
+	};
+
+	struct InlineCache {
+		static constexpr int SIZE = 4;
+		InlineCacheSlot slots[SIZE];
+		SafeNumeric<uint32_t> megamorphic_epoch;
+	};
+
 private:
 	friend class GDScript;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptByteCodeSerializer;
 	friend class GDScriptLanguage;
+	friend class GDScriptNative;
+	friend class GDScriptNativeTranslator;
 
 	StringName name;
 	StringName source;
@@ -439,6 +538,7 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	LocalVector<InlineCache> inline_caches;
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -457,6 +557,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -475,6 +576,11 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	InlineCache *_inline_caches_ptr = nullptr;
+
+	GDScriptNativeFunction native_function = nullptr; // Compiled at export, runs instead of the bytecode.
+
+	static SafeNumeric<uint32_t> inline_cache_epoch;
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -487,6 +593,7 @@ private:
 	Vector<String> constructors_names;
 	Vector<String> utilities_names;
 	Vector<String> gds_utilities_names;
+	int unoptimized_instruction_count = 0;
 
 	struct Profile {
 		StringName signature;
@@ -512,9 +619,18 @@ private:
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	static void _resolve_inline_cache_entry(InlineCacheAccess p_access, const Variant *p_base, Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry);
+	bool _get_inline_cache_entry(int p_cache, InlineCacheAccess p_access, const Variant *p_base, Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry);
+	bool _inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret);
+	bool _inline_cache_set(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid);
+	bool _inline_cache_call(int p_cache, Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
+	// The type of a value as shown in script errors, also used for the errors of native code.
+	static String _get_var_type(const Variant *p_var);
+
 	struct CallState {
 		GDScript *script = nullptr;
 		GDScriptInstance *instance = nullptr;
@@ -522,8 +638,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
-		int stack_size = 0;
+		uint8_t *stack = nullptr; // Owned by the GDScriptFunctionState holding this.
+		int stack_size = 0; // Number of stack variants still alive, zero once they have been freed or handed over.
 		uint32_t alloca_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -544,6 +660,7 @@ public:
 	StringName get_global_name(int p_idx) const;
 
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
+	static void invalidate_inline_caches();
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
@@ -566,6 +683,22 @@ class GDScriptFunctionState : public RefCounted {
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
+	// Stack snapshots are recycled through free lists of power of two sizes, since coroutines
+	// awaiting every frame would otherwise allocate and free one for every `await`.
+	enum {
+		STACK_POOL_MIN_SHIFT = 8,
+		STACK_POOL_CLASSES = 8, // Up to 32 KiB, larger snapshots are allocated directly.
+		STACK_POOL_MAX_FREE = 128, // Per size class.
+	};
+
+	static SpinLock stack_pool_lock;
+	static LocalVector<uint8_t *> stack_pool[STACK_POOL_CLASSES];
+	static bool stack_pool_enabled;
+
+	static int _get_stack_pool_class(uint32_t p_size);
+	void _allocate_stack(uint32_t p_size);
+	void _free_stack();
+
 protected:
 	static void _bind_methods();
 
@@ -576,6 +709,10 @@ public:
 	void _clear_stack();
 	void _clear_connections();
 
+	// Stacks freed between clear_stack_pool() and init_stack_pool(), as when shutting down, aren't kept.
+	static void init_stack_pool();
+	static void clear_stack_pool();
+
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
 };
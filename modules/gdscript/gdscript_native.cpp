@@ -0,0 +1,364 @@
+/**************************************************************************/
+/*  gdscript_native.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+
+#include "core/extension/gdextension.h"
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+
+HashMap<String, GDScriptNativeFunction> GDScriptNative::functions;
+
+static void _assign(Variant *p_dst, const Variant *p_src) {
+	*p_dst = *p_src;
+}
+
+static void _initialize(Variant *p_value, Variant::Type p_type) {
+	VariantInternal::initialize(p_value, p_type);
+}
+
+static void _type_adjust(Variant *p_value, Variant::Type p_type) {
+	switch (p_type) {
+#define GDSCRIPT_NATIVE_TYPE_ADJUST(m_type, m_name) \
+	case Variant::m_type:                           \
+		VariantTypeAdjust<m_name>::adjust(p_value); \
+		break;
+		GDSCRIPT_NATIVE_TYPE_ADJUST(BOOL, bool)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(INT, int64_t)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(FLOAT, double)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(STRING, String)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(VECTOR2, Vector2)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(VECTOR2I, Vector2i)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(RECT2, Rect2)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(RECT2I, Rect2i)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(VECTOR3, Vector3)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(VECTOR3I, Vector3i)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(TRANSFORM2D, Transform2D)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(VECTOR4, Vector4)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(VECTOR4I, Vector4i)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PLANE, Plane)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(QUATERNION, Quaternion)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(AABB, AABB)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(BASIS, Basis)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(TRANSFORM3D, Transform3D)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PROJECTION, Projection)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(COLOR, Color)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(STRING_NAME, StringName)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(NODE_PATH, NodePath)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(RID, RID)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(OBJECT, Object *)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(CALLABLE, Callable)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(SIGNAL, Signal)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(DICTIONARY, Dictionary)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(ARRAY, Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_BYTE_ARRAY, PackedByteArray)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_INT32_ARRAY, PackedInt32Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_INT64_ARRAY, PackedInt64Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_FLOAT32_ARRAY, PackedFloat32Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_FLOAT64_ARRAY, PackedFloat64Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_STRING_ARRAY, PackedStringArray)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_VECTOR2_ARRAY, PackedVector2Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_VECTOR3_ARRAY, PackedVector3Array)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_COLOR_ARRAY, PackedColorArray)
+		GDSCRIPT_NATIVE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY, PackedVector4Array)
+#undef GDSCRIPT_NATIVE_TYPE_ADJUST
+		default:
+			break;
+	}
+}
+
+static bool _booleanize(const Variant *p_value) {
+	return p_value->booleanize();
+}
+
+static bool _is_shared(const Variant *p_value) {
+	return p_value->is_shared();
+}
+
+static int64_t _array_size(const Variant *p_array) {
+	return VariantInternal::get_array(p_array)->size();
+}
+
+static void _array_get(const Variant *p_array, int64_t p_index, Variant *p_dst) {
+	*p_dst = VariantInternal::get_array(p_array)->get(p_index);
+}
+
+const GDScriptNativeAPI GDScriptNative::api = {
+	&GDScriptNative::_register_function,
+	&GDScriptNative::clear,
+	&_assign,
+	&_initialize,
+	&_type_adjust,
+	&_booleanize,
+	&_is_shared,
+	&_array_size,
+	&_array_get,
+	&GDScriptNative::assign_typed_builtin,
+	&GDScriptNative::return_typed_builtin,
+	&GDScriptNative::get_keyed_aliased,
+	&GDScriptNative::get_method_base,
+	&GDScriptNative::call,
+	&GDScriptNative::call_gdscript_utility,
+	&GDScriptNative::fail_set_keyed,
+	&GDScriptNative::fail_get_keyed,
+	&GDScriptNative::fail_set_indexed,
+	&GDScriptNative::fail_get_indexed,
+	&GDScriptNative::fail_member_access,
+};
+
+static String _get_value_description(const Variant *p_value) {
+	String text = p_value->operator String();
+	if (text.is_empty()) {
+		return "of type '" + GDScriptFunction::_get_var_type(p_value) + "'";
+	}
+	return "'" + text + "'";
+}
+
+// Constants holding objects (preloaded resources, scripts) would hash by address, which changes
+// between the export and the game, so only their class is taken into account.
+static uint32_t _hash_constant(const Variant &p_constant, uint32_t p_hash) {
+	p_hash = hash_murmur3_one_32(p_constant.get_type(), p_hash);
+	if (p_constant.get_type() == Variant::OBJECT) {
+		Object *object = p_constant.get_validated_object();
+		return object ? hash_murmur3_one_32(object->get_class().hash(), p_hash) : p_hash;
+	}
+	return hash_murmur3_one_32(p_constant.recursive_hash(0), p_hash);
+}
+
+uint32_t GDScriptNative::get_function_hash(const GDScriptFunction *p_function) {
+	uint32_t hash = hash_murmur3_one_32(p_function->_stack_size);
+	hash = hash_murmur3_one_32(p_function->_argument_count, hash);
+	hash = hash_murmur3_one_32(p_function->_static, hash);
+
+	for (int i = 0; i < p_function->_code_size; i++) {
+		hash = hash_murmur3_one_32(p_function->_code_ptr[i], hash);
+	}
+	for (int i = 0; i < p_function->_default_arg_count; i++) {
+		hash = hash_murmur3_one_32(p_function->_default_arg_ptr[i], hash);
+	}
+	for (int i = 0; i < p_function->_constant_count; i++) {
+		hash = _hash_constant(p_function->_constants_ptr[i], hash);
+	}
+	for (int i = 0; i < p_function->_global_names_count; i++) {
+		hash = hash_murmur3_one_32(p_function->_global_names_ptr[i].hash(), hash);
+	}
+	for (int i = 0; i < p_function->_methods_count; i++) {
+		const MethodBind *method = p_function->_methods_ptr[i];
+		hash = hash_murmur3_one_32(method->get_instance_class().hash(), hash);
+		hash = hash_murmur3_one_32(method->get_name().hash(), hash);
+	}
+
+	// Slots are stored in a hash map, so combine them independently of their order.
+	uint32_t slots = 0;
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		slots += hash_murmur3_one_32(E.value, hash_murmur3_one_32(E.key));
+	}
+	hash = hash_murmur3_one_32(slots, hash);
+
+	return hash_fmix32(hash);
+}
+
+String GDScriptNative::get_function_key(const GDScriptFunction *p_function) {
+	String script_name = p_function->get_script() ? p_function->get_script()->get_fully_qualified_name() : String(p_function->get_source());
+	return script_name + "::" + String(p_function->get_name()) + "::" + String::num_uint64(get_function_hash(p_function), 16);
+}
+
+void GDScriptNative::register_function(const String &p_key, GDScriptNativeFunction p_function) {
+	functions.insert(p_key, p_function);
+}
+
+GDScriptNativeFunction GDScriptNative::get_function(const GDScriptFunction *p_function) {
+	if (functions.is_empty()) {
+		return nullptr;
+	}
+	HashMap<String, GDScriptNativeFunction>::ConstIterator E = functions.find(get_function_key(p_function));
+	return E ? E->value : nullptr;
+}
+
+void GDScriptNative::clear() {
+	functions.clear();
+}
+
+void GDScriptNative::_register_function(const char *p_key, GDScriptNativeFunction p_function) {
+	register_function(String::utf8(p_key), p_function);
+}
+
+const GDScriptNativeAPI *GDScriptNative::_get_api(uint32_t p_version, uint32_t p_build) {
+	ERR_FAIL_COND_V_MSG(p_version != GDScriptNativeAPI::VERSION || p_build != GDScriptNativeAPI::get_build(), nullptr, "GDScript native code was built for another version of the engine, or with other build options. Scripts will run as bytecode.");
+	return &api;
+}
+
+void GDScriptNative::register_extension_interface() {
+	GDExtension::register_interface_function("gdscript_native_get_api", (GDExtensionInterfaceFunctionPtr)&GDScriptNative::_get_api);
+}
+
+bool GDScriptNative::assign_typed_builtin(GDScriptNativeContext &p_context, Variant *p_dst, Variant *p_src, Variant::Type p_type) {
+	if (likely(p_src->get_type() == p_type)) {
+		*p_dst = *p_src;
+		return true;
+	}
+#ifdef DEBUG_ENABLED
+	if (!Variant::can_convert_strict(p_src->get_type(), p_type)) {
+		p_context.error = "Trying to assign value of type '" + Variant::get_type_name(p_src->get_type()) + "' to a variable of type '" + Variant::get_type_name(p_type) + "'.";
+		return false;
+	}
+#endif
+	Callable::CallError ce;
+	Variant::construct(p_type, *p_dst, const_cast<const Variant **>(&p_src), 1, ce);
+	return true;
+}
+
+bool GDScriptNative::return_typed_builtin(GDScriptNativeContext &p_context, Variant *p_value, Variant::Type p_type) {
+	Callable::CallError ce;
+	if (likely(p_value->get_type() == p_type)) {
+		*p_context.result = *p_value;
+	} else if (Variant::can_convert_strict(p_value->get_type(), p_type)) {
+		Variant::construct(p_type, *p_context.result, const_cast<const Variant **>(&p_value), 1, ce);
+	} else {
+#ifdef DEBUG_ENABLED
+		p_context.error = vformat(R"(Trying to return value of type "%s" from a function whose return type is "%s".)", Variant::get_type_name(p_value->get_type()), Variant::get_type_name(p_type));
+#endif
+		return false;
+	}
+	return true;
+}
+
+bool GDScriptNative::get_keyed_aliased(GDScriptNativeContext &p_context, int p_getter, const Variant *p_base, const Variant *p_key, Variant *p_dst) {
+	// The result overwrites an operand, which is still needed for the error message.
+	Variant ret;
+	bool valid;
+	p_context.keyed_getters[p_getter](p_base, p_key, &ret, &valid);
+#ifdef DEBUG_ENABLED
+	if (!valid) {
+		return fail_get_keyed(p_context, p_base, p_key);
+	}
+#endif
+	*p_dst = ret;
+	return true;
+}
+
+bool GDScriptNative::get_method_base(GDScriptNativeContext &p_context, const Variant *p_base, const MethodBind *p_method, Object *&r_object) {
+#ifdef DEBUG_ENABLED
+	bool was_freed = false;
+	r_object = p_base->get_validated_object_with_check(was_freed);
+	if (unlikely(was_freed)) {
+		p_context.error = "Cannot call method '" + p_method->get_name() + "' on a previously freed instance.";
+		return false;
+	}
+	if (unlikely(!r_object)) {
+		p_context.error = "Cannot call method '" + p_method->get_name() + "' on a null value.";
+		return false;
+	}
+#else
+	r_object = p_base->operator Object *();
+#endif
+	return true;
+}
+
+bool GDScriptNative::call(GDScriptNativeContext &p_context, int p_inline_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret) {
+	Variant discarded;
+	Variant &ret = r_ret ? *r_ret : discarded;
+	Callable::CallError err;
+	if (!p_context.function->_inline_cache_call(p_inline_cache, p_base, p_method, p_args, p_argcount, ret, err)) {
+		p_base->callp(p_method, p_args, p_argcount, ret, err);
+	}
+#ifdef DEBUG_ENABLED
+	if (likely(err.error == Callable::CallError::CALL_OK)) {
+		return true;
+	}
+
+	Object *object = p_base->get_validated_object();
+	String error = object ? Variant::get_call_error_text(object, p_method, p_args, p_argcount, err) : Variant::get_call_error_text(p_method, p_args, p_argcount, err);
+	p_context.error = "Error calling function '" + String(p_method) + "' in base '" + GDScriptFunction::_get_var_type(p_base) + "': " + error;
+	return false;
+#else
+	return true;
+#endif
+}
+
+bool GDScriptNative::call_gdscript_utility(GDScriptNativeContext &p_context, int p_function, const char *p_name, Variant *p_dst, const Variant **p_args, int p_argcount) {
+	Callable::CallError err;
+	p_context.gds_utilities[p_function](p_dst, p_args, p_argcount, err);
+#ifdef DEBUG_ENABLED
+	if (likely(err.error == Callable::CallError::CALL_OK)) {
+		return true;
+	}
+
+	String error;
+	if (p_dst->get_type() == Variant::STRING && !p_dst->operator String().is_empty()) {
+		// The function provided its own error message.
+		error = *p_dst;
+	} else {
+		error = Variant::get_call_error_text(p_name, p_args, p_argcount, err);
+	}
+	p_context.error = vformat(R"*(Error calling GDScript utility function "%s()": %s)*", p_name, error);
+	return false;
+#else
+	return true;
+#endif
+}
+
+bool GDScriptNative::fail_set_keyed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_key, const Variant *p_value) {
+	if (p_base->is_read_only()) {
+		p_context.error = "Invalid assignment on read-only value (on base: '" + GDScriptFunction::_get_var_type(p_base) + "').";
+	} else {
+		p_context.error = "Invalid assignment of property or key " + _get_value_description(p_key) + " with value of type '" + GDScriptFunction::_get_var_type(p_value) + "' on a base object of type '" + GDScriptFunction::_get_var_type(p_base) + "'.";
+	}
+	return false;
+}
+
+bool GDScriptNative::fail_get_keyed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_key) {
+	p_context.error = "Invalid access to property or key " + _get_value_description(p_key) + " on a base object of type '" + GDScriptFunction::_get_var_type(p_base) + "'.";
+	return false;
+}
+
+bool GDScriptNative::fail_set_indexed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_index) {
+	if (p_base->is_read_only()) {
+		p_context.error = "Invalid assignment on read-only value (on base: '" + GDScriptFunction::_get_var_type(p_base) + "').";
+	} else {
+		p_context.error = "Out of bounds set index " + _get_value_description(p_index) + " (on base: '" + GDScriptFunction::_get_var_type(p_base) + "')";
+	}
+	return false;
+}
+
+bool GDScriptNative::fail_get_indexed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_index) {
+	p_context.error = "Out of bounds get index " + _get_value_description(p_index) + " (on base: '" + GDScriptFunction::_get_var_type(p_base) + "')";
+	return false;
+}
+
+bool GDScriptNative::fail_member_access(GDScriptNativeContext &p_context) {
+#ifdef DEBUG_ENABLED
+	p_context.error = "Cannot access member without instance.";
+#endif
+	return false;
+}
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  gdscript_native.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_H
+#define GDSCRIPT_NATIVE_H
+
+#include "gdscript_utility_functions.h"
+
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+class GDScriptFunction;
+class MethodBind;
+struct GDScriptNativeAPI;
+
+// Everything a function compiled ahead of time needs from the VM. The generated code uses the
+// same stack addresses, constants and table indices as the bytecode it was translated from,
+// so these are just the pointers the VM itself would dispatch through.
+struct GDScriptNativeContext {
+	GDScriptFunction *function = nullptr;
+	Variant *stack = nullptr;
+	Variant *constants = nullptr;
+	Variant *members = nullptr; // Null in static functions.
+	Variant *result = nullptr;
+	int default_argument = 0;
+
+	const StringName *global_names = nullptr;
+	const Variant::ValidatedOperatorEvaluator *operator_funcs = nullptr;
+	const Variant::ValidatedSetter *setters = nullptr;
+	const Variant::ValidatedGetter *getters = nullptr;
+	const Variant::ValidatedKeyedSetter *keyed_setters = nullptr;
+	const Variant::ValidatedKeyedGetter *keyed_getters = nullptr;
+	const Variant::ValidatedIndexedSetter *indexed_setters = nullptr;
+	const Variant::ValidatedIndexedGetter *indexed_getters = nullptr;
+	const Variant::ValidatedBuiltInMethod *builtin_methods = nullptr;
+	const Variant::ValidatedConstructor *constructors = nullptr;
+	const Variant::ValidatedUtilityFunction *utilities = nullptr;
+	const GDScriptUtilityFunctions::FunctionPtr *gds_utilities = nullptr;
+	MethodBind *const *methods = nullptr;
+	const GDScriptNativeAPI *api = nullptr;
+
+	// Filled in when the function stops on a script error.
+	String error;
+	int error_line = 0;
+};
+
+// Returns false after a script error, in which case the VM stops the function as it does for
+// errors in bytecode. Debug builds also report it and return the default value of the return type.
+typedef bool (*GDScriptNativeFunction)(GDScriptNativeContext &p_context);
+
+// Leaves a generated function when `m_ok` is false, the generated code keeps the line being
+// executed in `line`.
+#define GDSCRIPT_NATIVE_CHECK(m_ok)  \
+	if (unlikely(!(m_ok))) {         \
+		p_context.error_line = line; \
+		return false;                \
+	}
+
+// For the checks the VM only makes in debug builds. Release builds carry on with whatever the
+// operation left behind, like the bytecode does.
+#ifdef DEBUG_ENABLED
+#define GDSCRIPT_NATIVE_DEBUG_CHECK(m_ok) GDSCRIPT_NATIVE_CHECK(m_ok)
+#else
+#define GDSCRIPT_NATIVE_DEBUG_CHECK(m_ok) (void)line;
+#endif
+
+// Like VariantTypeChanger, for the types the generated code writes in place, which are all
+// freed by changing the type anyway.
+#define GDSCRIPT_NATIVE_SET_TYPE(m_value, m_type)      \
+	if ((m_value)->get_type() != (m_type)) {           \
+		p_context.api->initialize((m_value), (m_type)); \
+	}
+
+// What the generated code calls into the engine for. It's built as a GDExtension, against the
+// engine headers but without linking to the engine, so anything that isn't inline in the headers
+// is reached through this table, which the library gets from `gdscript_native_get_api`.
+struct GDScriptNativeAPI {
+	// Raised whenever this table or GDScriptNativeContext change.
+	static constexpr uint32_t VERSION = 1;
+
+	// The generated code works on engine types directly, so it only runs on an engine built
+	// with the same options that change their layout.
+	static constexpr uint32_t get_build() {
+		uint32_t build = sizeof(Variant);
+#ifdef DEBUG_ENABLED
+		build |= 1 << 16;
+#endif
+#ifdef TOOLS_ENABLED
+		build |= 1 << 17;
+#endif
+		return build;
+	}
+
+	void (*register_function)(const char *p_key, GDScriptNativeFunction p_function);
+	void (*clear)();
+
+	void (*assign)(Variant *p_dst, const Variant *p_src);
+	void (*initialize)(Variant *p_value, Variant::Type p_type);
+	void (*type_adjust)(Variant *p_value, Variant::Type p_type);
+	bool (*booleanize)(const Variant *p_value);
+	bool (*is_shared)(const Variant *p_value);
+	int64_t (*array_size)(const Variant *p_array);
+	void (*array_get)(const Variant *p_array, int64_t p_index, Variant *p_dst);
+
+	bool (*assign_typed_builtin)(GDScriptNativeContext &p_context, Variant *p_dst, Variant *p_src, Variant::Type p_type);
+	bool (*return_typed_builtin)(GDScriptNativeContext &p_context, Variant *p_value, Variant::Type p_type);
+	bool (*get_keyed_aliased)(GDScriptNativeContext &p_context, int p_getter, const Variant *p_base, const Variant *p_key, Variant *p_dst);
+	bool (*get_method_base)(GDScriptNativeContext &p_context, const Variant *p_base, const MethodBind *p_method, Object *&r_object);
+	bool (*call)(GDScriptNativeContext &p_context, int p_inline_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret);
+	bool (*call_gdscript_utility)(GDScriptNativeContext &p_context, int p_function, const char *p_name, Variant *p_dst, const Variant **p_args, int p_argcount);
+
+	bool (*fail_set_keyed)(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_key, const Variant *p_value);
+	bool (*fail_get_keyed)(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_key);
+	bool (*fail_set_indexed)(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_index);
+	bool (*fail_get_indexed)(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_index);
+	bool (*fail_member_access)(GDScriptNativeContext &p_context);
+};
+
+// The signature of `gdscript_native_get_api`. Returns null if the library was built for another
+// version of the table, or with other build options.
+typedef const GDScriptNativeAPI *(*GDScriptNativeGetAPI)(uint32_t p_version, uint32_t p_build);
+
+// Registry of the functions compiled at export, and the runtime support for the generated code.
+// Functions are looked up by name and by a hash of their bytecode, so a script modified after
+// the export, or compiled differently, silently keeps running as bytecode.
+class GDScriptNative {
+	static HashMap<String, GDScriptNativeFunction> functions;
+	static const GDScriptNativeAPI api;
+
+	static void _register_function(const char *p_key, GDScriptNativeFunction p_function);
+	static const GDScriptNativeAPI *_get_api(uint32_t p_version, uint32_t p_build);
+
+public:
+	static uint32_t get_function_hash(const GDScriptFunction *p_function);
+	static String get_function_key(const GDScriptFunction *p_function);
+
+	static void register_function(const String &p_key, GDScriptNativeFunction p_function);
+	static GDScriptNativeFunction get_function(const GDScriptFunction *p_function);
+	static void clear();
+
+	static const GDScriptNativeAPI *get_api() { return &api; }
+	// Lets the library find the table when loaded, so this has to be done before extensions are.
+	static void register_extension_interface();
+
+	// Used by the generated code for what doesn't fit in a few inline statements. Each one
+	// mirrors the VM handler of the same instruction in the same build, and returns false after
+	// a script error. Error messages are only built in debug builds.
+	static bool assign_typed_builtin(GDScriptNativeContext &p_context, Variant *p_dst, Variant *p_src, Variant::Type p_type);
+	static bool return_typed_builtin(GDScriptNativeContext &p_context, Variant *p_value, Variant::Type p_type);
+	static bool get_keyed_aliased(GDScriptNativeContext &p_context, int p_getter, const Variant *p_base, const Variant *p_key, Variant *p_dst);
+	static bool get_method_base(GDScriptNativeContext &p_context, const Variant *p_base, const MethodBind *p_method, Object *&r_object);
+	static bool call(GDScriptNativeContext &p_context, int p_inline_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret);
+	static bool call_gdscript_utility(GDScriptNativeContext &p_context, int p_function, const char *p_name, Variant *p_dst, const Variant **p_args, int p_argcount);
+
+	// Only build the error message, so the generated code stays small where the check is inline.
+	static bool fail_set_keyed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_key, const Variant *p_value);
+	static bool fail_get_keyed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_key);
+	static bool fail_set_indexed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_index);
+	static bool fail_get_indexed(GDScriptNativeContext &p_context, const Variant *p_base, const Variant *p_index);
+	static bool fail_member_access(GDScriptNativeContext &p_context);
+};
+
+#endif // GDSCRIPT_NATIVE_H
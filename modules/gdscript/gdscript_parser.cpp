@@ -865,6 +865,8 @@ void GDScriptParser::parse_extends() {
 	if (match(GDScriptTokenizer::Token::LITERAL)) {
 		if (previous.literal.get_type() != Variant::STRING) {
 			push_error(vformat(R"(Only strings or identifiers can be used after "extends", found "%s" instead.)", Variant::get_type_name(previous.literal.get_type())));
+		} else {
+			add_dependency(previous.literal);
 		}
 		current_class->extends_path = previous.literal;
 
@@ -3345,6 +3347,8 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 
 	if (preload->path == nullptr) {
 		push_error(R"(Expected resource path after "(".)");
+	} else if (preload->path->type == Node::LITERAL && static_cast<LiteralNode *>(preload->path)->value.get_type() == Variant::STRING) {
+		add_dependency(static_cast<LiteralNode *>(preload->path)->value);
 	}
 
 	pop_completion_call();
@@ -3356,6 +3360,21 @@ GDScriptParser::ExpressionNode *GDScriptParser::parse_preload(ExpressionNode *p_
 	return preload;
 }
 
+void GDScriptParser::add_dependency(const String &p_path) {
+	if (p_path.is_empty()) {
+		return;
+	}
+	// Resolved the same way the analyzer resolves `extends` and `preload()` paths.
+	String path = p_path;
+	if (path.is_relative_path()) {
+		path = script_path.get_base_dir().path_join(path);
+	}
+	path = path.simplify_path();
+	if (!dependencies.find(path)) {
+		dependencies.push_back(path);
+	}
+}
+
 GDScriptParser::ExpressionNode *GDScriptParser::parse_lambda(ExpressionNode *p_previous_operand, bool p_can_assign) {
 	LambdaNode *lambda = alloc_node<LambdaNode>();
 	lambda->parent_function = current_function;
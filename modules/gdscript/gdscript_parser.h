@@ -1335,6 +1335,7 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	List<String> dependencies; // Paths named by `extends` and `preload()` literals.
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1541,6 +1542,7 @@ private:
 	ExpressionNode *parse_call(ExpressionNode *p_previous_operand, bool p_can_assign);
 	ExpressionNode *parse_get_node(ExpressionNode *p_previous_operand, bool p_can_assign);
 	ExpressionNode *parse_preload(ExpressionNode *p_previous_operand, bool p_can_assign);
+	void add_dependency(const String &p_path);
 	ExpressionNode *parse_grouping(ExpressionNode *p_previous_operand, bool p_can_assign);
 	ExpressionNode *parse_cast(ExpressionNode *p_previous_operand, bool p_can_assign);
 	ExpressionNode *parse_await(ExpressionNode *p_previous_operand, bool p_can_assign);
@@ -1577,10 +1579,7 @@ public:
 	bool annotation_exists(const String &p_annotation_name) const;
 
 	const List<ParserError> &get_errors() const { return errors; }
-	const List<String> get_dependencies() const {
-		// TODO: Keep track of deps.
-		return List<String>();
-	}
+	const List<String> &get_dependencies() const { return dependencies; }
 #ifdef DEBUG_ENABLED
 	const List<GDScriptWarning> &get_warnings() const { return warnings; }
 	const HashSet<int> &get_unsafe_lines() const { return unsafe_lines; }
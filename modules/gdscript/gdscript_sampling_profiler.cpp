@@ -0,0 +1,223 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/hash_set.h"
+
+void GDScriptSamplingProfiler::_thread_func(void *p_self) {
+	GDScriptSamplingProfiler *self = static_cast<GDScriptSamplingProfiler *>(p_self);
+	Thread::set_name("GDScript Sampling Profiler");
+
+	while (self->running.is_set()) {
+		OS::get_singleton()->delay_usec(self->interval_usec);
+		self->_take_samples();
+	}
+}
+
+void GDScriptSamplingProfiler::_take_samples() {
+	// Call stacks unregister themselves under this lock before their levels are freed, so the
+	// levels can be read here. Their contents are written by the owning thread without
+	// synchronization, which at worst attributes a sample to a neighboring line or call.
+	MutexLock lock(GDScriptLanguage::call_stacks_mutex);
+
+	for (const GDScriptLanguage::CallStack *call_stack : GDScriptLanguage::call_stacks) {
+		int stack_pos = call_stack->stack_pos;
+		if (stack_pos <= 0) {
+			continue;
+		}
+
+		uint32_t write = write_index.get();
+		if (write - read_index.get() >= BUFFER_SIZE) {
+			dropped_samples.increment();
+			continue;
+		}
+
+		Sample &sample = samples[write & (BUFFER_SIZE - 1)];
+		sample.depth = MIN(stack_pos, (int)MAX_DEPTH);
+		for (int i = 0; i < sample.depth; i++) {
+			const GDScriptLanguage::CallLevel &level = call_stack->levels[stack_pos - i - 1];
+			sample.frames[i].function = level.function;
+			sample.frames[i].line = level.line ? *level.line : 0;
+		}
+
+		write_index.set(write + 1);
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	ERR_FAIL_COND(running.is_set());
+
+	interval_usec = MAX(p_interval_usec, (uint64_t)1);
+	running.set();
+	thread.start(_thread_func, this);
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!running.is_set()) {
+		return;
+	}
+
+	running.clear();
+	thread.wait_to_finish();
+
+	if (dropped_samples.get() > 0) {
+		WARN_VERBOSE(vformat("GDScript sampling profiler dropped %d samples. Increase the sampling interval to reduce the loss.", dropped_samples.get()));
+	}
+}
+
+void GDScriptSamplingProfiler::collect(const SelfList<GDScriptFunction>::List &p_functions) {
+	uint32_t read = read_index.get();
+	uint32_t write = write_index.get();
+	if (read == write) {
+		return;
+	}
+
+	HashSet<const GDScriptFunction *> live_functions;
+	for (const SelfList<GDScriptFunction> *E = p_functions.first(); E; E = E->next()) {
+		live_functions.insert(E->self());
+	}
+
+	HashMap<Frame, FrameLabel, FrameHasher, FrameComparator> labels;
+	const FrameLabel *sample_labels[MAX_DEPTH];
+
+	for (; read != write; read++) {
+		const Sample &sample = samples[read & (BUFFER_SIZE - 1)];
+
+		bool valid = true;
+		for (int i = 0; i < sample.depth; i++) {
+			const Frame &sampled = sample.frames[i];
+			HashMap<Frame, FrameLabel, FrameHasher, FrameComparator>::Iterator E = labels.find(sampled);
+			if (!E) {
+				if (!live_functions.has(sampled.function)) {
+					valid = false;
+					break;
+				}
+
+				String path = sampled.function->get_script() ? sampled.function->get_script()->get_script_path() : String();
+				String name = String(sampled.function->get_name()) + ":" + itos(sampled.line);
+
+				FrameLabel label;
+				label.signature = path + "::" + itos(sampled.line) + "::" + name;
+				label.folded = vformat("%s (%s:%d)", sampled.function->get_name(), path, sampled.line).replace(";", ":");
+				E = labels.insert(sampled, label);
+			}
+			sample_labels[i] = &E->value;
+		}
+
+		if (!valid || sample.depth == 0) {
+			continue;
+		}
+
+		frame_lines[sample_labels[0]->signature].self++;
+		accumulated_lines[sample_labels[0]->signature].self++;
+
+		String folded;
+		for (int i = sample.depth - 1; i >= 0; i--) {
+			// Recursion can put the same line on the stack more than once, but it only counts once.
+			bool repeated = false;
+			for (int j = sample.depth - 1; j > i; j--) {
+				if (sample_labels[j] == sample_labels[i]) {
+					repeated = true;
+					break;
+				}
+			}
+			if (!repeated) {
+				frame_lines[sample_labels[i]->signature].total++;
+				accumulated_lines[sample_labels[i]->signature].total++;
+			}
+
+			if (!folded.is_empty()) {
+				folded += ";";
+			}
+			folded += sample_labels[i]->folded;
+		}
+		folded_stacks[folded]++;
+	}
+
+	read_index.set(read);
+}
+
+void GDScriptSamplingProfiler::frame() {
+	last_frame_lines = frame_lines;
+	frame_lines.clear();
+}
+
+int GDScriptSamplingProfiler::_fill_info(const HashMap<StringName, LineHits> &p_lines, ScriptLanguage::ProfilingInfo *p_info_arr, int p_info_max) const {
+	int current = 0;
+	for (const KeyValue<StringName, LineHits> &E : p_lines) {
+		if (current >= p_info_max) {
+			break;
+		}
+		p_info_arr[current].signature = E.key;
+		p_info_arr[current].call_count = E.value.total;
+		p_info_arr[current].self_time = E.value.self * interval_usec;
+		p_info_arr[current].total_time = E.value.total * interval_usec;
+		p_info_arr[current].internal_time = 0;
+		current++;
+	}
+	return current;
+}
+
+int GDScriptSamplingProfiler::get_frame_data(ScriptLanguage::ProfilingInfo *p_info_arr, int p_info_max) const {
+	return _fill_info(last_frame_lines, p_info_arr, p_info_max);
+}
+
+int GDScriptSamplingProfiler::get_accumulated_data(ScriptLanguage::ProfilingInfo *p_info_arr, int p_info_max) const {
+	return _fill_info(accumulated_lines, p_info_arr, p_info_max);
+}
+
+Error GDScriptSamplingProfiler::save_folded_stacks(const String &p_path) const {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot write GDScript profiler stacks to "%s".)", p_path));
+
+	for (const KeyValue<String, uint64_t> &E : folded_stacks) {
+		file->store_line(E.key + " " + itos(E.value));
+	}
+	return OK;
+}
+
+GDScriptSamplingProfiler::GDScriptSamplingProfiler() {
+	samples = memnew_arr(Sample, BUFFER_SIZE);
+}
+
+GDScriptSamplingProfiler::~GDScriptSamplingProfiler() {
+	stop();
+	memdelete_arr(samples);
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,123 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/object/script_language.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/self_list.h"
+
+class GDScriptFunction;
+
+// Statistical alternative to the instrumenting profiler: instead of timing every call, a
+// background thread periodically copies the debugger call stack of each thread running GDScript.
+// Samples are attributed to the line being executed, so hotspots show up per line, and whole
+// stacks are kept so they can be exported in the folded format used by flame graph tools.
+class GDScriptSamplingProfiler {
+public:
+	enum {
+		MAX_DEPTH = 64, // Deeper stacks are truncated at the outermost frames.
+		BUFFER_SIZE = 2048, // Must be a power of two.
+	};
+
+private:
+	struct Frame {
+		GDScriptFunction *function = nullptr;
+		int line = 0;
+	};
+
+	struct Sample {
+		int depth = 0;
+		Frame frames[MAX_DEPTH]; // Innermost first.
+	};
+
+	struct FrameHasher {
+		static _FORCE_INLINE_ uint32_t hash(const Frame &p_frame) { return hash_murmur3_one_32(p_frame.line, hash_murmur3_one_64((uint64_t)p_frame.function)); }
+	};
+
+	struct FrameComparator {
+		static _FORCE_INLINE_ bool compare(const Frame &p_lhs, const Frame &p_rhs) { return p_lhs.function == p_rhs.function && p_lhs.line == p_rhs.line; }
+	};
+
+	struct FrameLabel {
+		StringName signature; // Reported to the debugger, in the same form as function signatures.
+		String folded; // Used when exporting stacks.
+	};
+
+	struct LineHits {
+		uint64_t self = 0;
+		uint64_t total = 0;
+	};
+
+	// Single producer (the sampling thread), single consumer (`collect()`, called with the
+	// language mutex held). The sampler drops samples instead of waiting when the buffer is full.
+	Sample *samples = nullptr;
+	SafeNumeric<uint32_t> write_index;
+	SafeNumeric<uint32_t> read_index;
+	SafeNumeric<uint64_t> dropped_samples;
+
+	Thread thread;
+	SafeFlag running;
+	uint64_t interval_usec = 1000;
+
+	HashMap<StringName, LineHits> frame_lines;
+	HashMap<StringName, LineHits> last_frame_lines;
+	HashMap<StringName, LineHits> accumulated_lines;
+	HashMap<String, uint64_t> folded_stacks;
+
+	static void _thread_func(void *p_self);
+	void _take_samples();
+	int _fill_info(const HashMap<StringName, LineHits> &p_lines, ScriptLanguage::ProfilingInfo *p_info_arr, int p_info_max) const;
+
+public:
+	void start(uint64_t p_interval_usec);
+	void stop();
+
+	// Aggregates the pending samples. Functions that are no longer in `p_functions` may have
+	// been freed after being sampled, so samples referencing them are discarded.
+	void collect(const SelfList<GDScriptFunction>::List &p_functions);
+	void frame();
+
+	int get_frame_data(ScriptLanguage::ProfilingInfo *p_info_arr, int p_info_max) const;
+	int get_accumulated_data(ScriptLanguage::ProfilingInfo *p_info_arr, int p_info_max) const;
+	Error save_folded_stacks(const String &p_path) const;
+
+	GDScriptSamplingProfiler();
+	~GDScriptSamplingProfiler();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
@@ -32,7 +32,9 @@
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
 
+#include "core/config/engine.h"
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -57,7 +59,7 @@ static String _get_element_type(Variant::Type builtin_type, const StringName &na
 	}
 }
 
-static String _get_var_type(const Variant *p_var) {
+String GDScriptFunction::_get_var_type(const Variant *p_var) {
 	String basestr;
 
 	if (p_var->get_type() == Variant::OBJECT) {
@@ -168,6 +170,340 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_epoch(1);
+
+void GDScriptFunction::invalidate_inline_caches() {
+	// Cache entries are only trusted while tagged with the current epoch, and zero marks unused ones.
+	if (inline_cache_epoch.increment() == 0) {
+		inline_cache_epoch.increment();
+	}
+}
+
+// Mirrors the lookup order of Variant::get_named(), Variant::set_named() and Variant::callp(), but only
+// for the cases whose result depends on nothing but the receiver type. Everything else is left
+// uncacheable, so the generic path keeps handling `_get()`, `_set()`, metadata, extensions and so on.
+void GDScriptFunction::_resolve_inline_cache_entry(InlineCacheAccess p_access, const Variant *p_base, Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry) {
+	r_entry.kind = INLINE_CACHE_UNCACHEABLE;
+
+	if (p_object == nullptr) {
+		if (p_access == INLINE_CACHE_GET) {
+			r_entry.getter = Variant::get_member_validated_getter(p_base->get_type(), p_name);
+			if (r_entry.getter) {
+				r_entry.index = Variant::get_member_type(p_base->get_type(), p_name);
+				r_entry.kind = INLINE_CACHE_BUILTIN_GETTER;
+			}
+		}
+		return;
+	}
+
+	if (p_access == INLINE_CACHE_CALL && p_name == CoreStringName(free_)) {
+		return;
+	}
+
+	const ClassDB::ClassInfo *type = ClassDB::classes.getptr(*r_entry.native_class);
+	if (type == nullptr || type->api == ClassDB::API_EXTENSION || type->api == ClassDB::API_EDITOR_EXTENSION) {
+		// Extension method binds don't survive reloading the library, and extensions may also
+		// intercept properties before ClassDB.
+		return;
+	}
+	for (const ClassDB::ClassInfo *check = type; check; check = check->inherits_ptr) {
+		// These override callp() to resolve names before ClassDB does, like static functions and `new()`.
+		if (check->name == GDScriptNativeClass::get_class_static() || check->name == SNAME("Script") || check->name == SNAME("JNISingleton") || check->name == SNAME("JavaClass") || check->name == SNAME("JavaObject")) {
+			return;
+		}
+	}
+
+	const GDScript *script = r_entry.script;
+	if (script) {
+		if (!script->valid) {
+			return;
+		}
+
+		if (p_access == INLINE_CACHE_CALL) {
+			if (p_name == SceneStringName(_ready)) {
+				return; // Also runs the implicit ready functions.
+			}
+			for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+				if (likely(sptr->valid)) {
+					HashMap<StringName, GDScriptFunction *>::ConstIterator E = sptr->member_functions.find(p_name);
+					if (E) {
+						r_entry.function = E->value;
+						r_entry.kind = INLINE_CACHE_SCRIPT_FUNCTION;
+						return;
+					}
+				}
+			}
+		} else {
+			HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+			if (E) {
+				r_entry.index = E->value.index;
+				r_entry.data_type = &E->value.data_type;
+
+				const StringName &accessor = p_access == INLINE_CACHE_GET ? E->value.getter : E->value.setter;
+				if (accessor == StringName()) {
+					r_entry.kind = INLINE_CACHE_MEMBER;
+					return;
+				}
+				if (accessor == SceneStringName(_ready)) {
+					return;
+				}
+				for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+					HashMap<StringName, GDScriptFunction *>::ConstIterator F = sptr->member_functions.find(accessor);
+					if (sptr->valid && F) {
+						r_entry.function = F->value;
+						r_entry.kind = INLINE_CACHE_SCRIPT_FUNCTION;
+						return;
+					}
+				}
+				return;
+			}
+
+			// Any other name the script knows about is resolved by GDScriptInstance.
+			const StringName &fallback = p_access == INLINE_CACHE_GET ? GDScriptLanguage::get_singleton()->strings._get : GDScriptLanguage::get_singleton()->strings._set;
+			for (const GDScript *sptr = script; sptr; sptr = sptr->_base) {
+				if (!sptr->valid || sptr->static_variables_indices.has(p_name)) {
+					return;
+				}
+				if (sptr->member_functions.has(fallback)) {
+					return;
+				}
+				if (p_access == INLINE_CACHE_GET && (sptr->constants.has(p_name) || sptr->_signals.has(p_name) || sptr->member_functions.has(p_name) || sptr->subclasses.has(p_name))) {
+					return;
+				}
+			}
+		}
+	}
+
+	if (p_access == INLINE_CACHE_CALL) {
+		r_entry.method = ClassDB::get_method(*r_entry.native_class, p_name);
+		if (r_entry.method) {
+			r_entry.kind = INLINE_CACHE_METHOD_BIND;
+		}
+		return;
+	}
+
+	for (const ClassDB::ClassInfo *check = type; check; check = check->inherits_ptr) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			if (p_access == INLINE_CACHE_GET) {
+				// Indexed getters are called through Object::callp(), which scripts may override.
+				if (psg->getter != StringName() && psg->index < 0 && psg->_getptr) {
+					r_entry.method = psg->_getptr;
+					r_entry.kind = INLINE_CACHE_METHOD_BIND;
+				}
+			} else if (psg->setter != StringName() && psg->_setptr) {
+				r_entry.method = psg->_setptr;
+				r_entry.index = psg->index;
+				r_entry.kind = INLINE_CACHE_METHOD_BIND;
+			}
+			return;
+		}
+		if (p_access == INLINE_CACHE_GET && (check->constant_map.has(p_name) || check->method_map.has(p_name) || check->signal_map.has(p_name))) {
+			return;
+		}
+	}
+}
+
+bool GDScriptFunction::_get_inline_cache_entry(int p_cache, InlineCacheAccess p_access, const Variant *p_base, Object *p_object, const StringName &p_name, InlineCacheEntry &r_entry) {
+	InlineCache &cache = _inline_caches_ptr[p_cache];
+	const uint32_t epoch = inline_cache_epoch.get();
+
+	const GDScript *script = nullptr;
+	if (p_object) {
+		ScriptInstance *script_instance = p_object->get_script_instance();
+		if (script_instance) {
+			if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+				return false;
+			}
+			script = static_cast<GDScriptInstance *>(script_instance)->script.ptr();
+		}
+	}
+	static const StringName no_class;
+	const StringName *native_class = p_object ? &p_object->get_class_name() : &no_class;
+
+	for (int i = 0; i < InlineCache::SIZE; i++) {
+		InlineCacheSlot &slot = cache.slots[i];
+		const uint32_t sequence = slot.sequence.get();
+		if (sequence & 1) {
+			continue; // Being written.
+		}
+		r_entry = slot.entry;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.sequence.get() != sequence) {
+			continue; // Rewritten while copying, the copy may be torn.
+		}
+		if (r_entry.epoch == epoch && r_entry.builtin_type == p_base->get_type() && r_entry.script == script && r_entry.native_class == native_class) {
+			return r_entry.kind != INLINE_CACHE_UNCACHEABLE;
+		}
+	}
+
+	if (cache.megamorphic_epoch.get() == epoch) {
+		return false;
+	}
+
+	r_entry = InlineCacheEntry();
+	r_entry.builtin_type = p_base->get_type();
+	r_entry.script = script;
+	r_entry.native_class = native_class;
+	_resolve_inline_cache_entry(p_access, p_base, p_object, p_name, r_entry);
+	r_entry.epoch = epoch;
+
+	static Mutex writer_mutex;
+	MutexLock lock(writer_mutex);
+
+	for (int i = 0; i < InlineCache::SIZE; i++) {
+		InlineCacheSlot &slot = cache.slots[i];
+		if (slot.entry.epoch != epoch) {
+			const uint32_t sequence = slot.sequence.get();
+			slot.sequence.set(sequence + 1);
+			std::atomic_thread_fence(std::memory_order_release);
+			slot.entry = r_entry;
+			slot.sequence.set(sequence + 2);
+			return r_entry.kind != INLINE_CACHE_UNCACHEABLE;
+		}
+	}
+
+	// Too many receiver types for this instruction, stop trying until something is reloaded.
+	cache.megamorphic_epoch.set(epoch);
+	return r_entry.kind != INLINE_CACHE_UNCACHEABLE;
+}
+
+bool GDScriptFunction::_inline_cache_get(int p_cache, const Variant *p_base, const StringName &p_name, Variant &r_ret) {
+	Object *object = nullptr;
+	if (p_base->get_type() == Variant::OBJECT) {
+		object = p_base->get_validated_object();
+		if (object == nullptr) {
+			return false;
+		}
+	}
+
+	InlineCacheEntry entry;
+	if (!_get_inline_cache_entry(p_cache, INLINE_CACHE_GET, p_base, object, p_name, entry)) {
+		return false;
+	}
+
+	switch (entry.kind) {
+		case INLINE_CACHE_BUILTIN_GETTER: {
+			Variant ret;
+			VariantInternal::initialize(&ret, Variant::Type(entry.index));
+			entry.getter(p_base, &ret);
+			r_ret = ret;
+			return true;
+		}
+		case INLINE_CACHE_MEMBER: {
+			const GDScriptInstance *instance = static_cast<GDScriptInstance *>(object->get_script_instance());
+			r_ret = instance->members[entry.index];
+			return true;
+		}
+		case INLINE_CACHE_SCRIPT_FUNCTION: {
+			GDScriptInstance *instance = static_cast<GDScriptInstance *>(object->get_script_instance());
+			Callable::CallError err;
+			Variant ret = entry.function->call(instance, nullptr, 0, err);
+			r_ret = err.error == Callable::CallError::CALL_OK ? ret : instance->members[entry.index];
+			return true;
+		}
+		case INLINE_CACHE_METHOD_BIND: {
+			Callable::CallError err;
+			r_ret = entry.method->call(object, nullptr, 0, err);
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+bool GDScriptFunction::_inline_cache_set(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value, bool &r_valid) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false; // Object::set() also marks the object as edited.
+	}
+#endif
+
+	Object *object = p_base->get_validated_object();
+	if (object == nullptr) {
+		return false;
+	}
+
+	InlineCacheEntry entry;
+	if (!_get_inline_cache_entry(p_cache, INLINE_CACHE_SET, p_base, object, p_name, entry)) {
+		return false;
+	}
+
+	switch (entry.kind) {
+		case INLINE_CACHE_MEMBER:
+		case INLINE_CACHE_SCRIPT_FUNCTION: {
+			GDScriptInstance *instance = static_cast<GDScriptInstance *>(object->get_script_instance());
+			Variant value;
+			if (!entry.data_type->convert_for_set(*p_value, value)) {
+				return false; // Other handlers get a chance, as in GDScriptInstance::set().
+			}
+
+			if (entry.kind == INLINE_CACHE_MEMBER) {
+				instance->members.write[entry.index] = value;
+				r_valid = true;
+				return true;
+			}
+
+			// A setter rejecting its argument never runs, so the generic path can retry it.
+			const Variant *args = &value;
+			Callable::CallError err;
+			entry.function->call(instance, &args, 1, err);
+			r_valid = err.error == Callable::CallError::CALL_OK;
+			return r_valid;
+		}
+		case INLINE_CACHE_METHOD_BIND: {
+			Callable::CallError err;
+			if (entry.index >= 0) {
+				Variant index = entry.index;
+				const Variant *args[2] = { &index, p_value };
+				entry.method->call(object, args, 2, err);
+			} else {
+				entry.method->call(object, &p_value, 1, err);
+			}
+			r_valid = err.error == Callable::CallError::CALL_OK;
+			return true;
+		}
+		default:
+			return false;
+	}
+}
+
+bool GDScriptFunction::_inline_cache_call(int p_cache, Variant *p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+
+	Object *object = p_base->get_validated_object();
+	if (object == nullptr) {
+		return false;
+	}
+
+	InlineCacheEntry entry;
+	if (!_get_inline_cache_entry(p_cache, INLINE_CACHE_CALL, p_base, object, p_name, entry)) {
+		return false;
+	}
+
+#ifdef DEBUG_ENABLED
+	_ObjectDebugLock debug_lock(object); // Like Object::callp(), so the callee can't free the object.
+#endif
+
+	switch (entry.kind) {
+		case INLINE_CACHE_SCRIPT_FUNCTION:
+			r_err.error = Callable::CallError::CALL_OK;
+			r_ret = entry.function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), p_args, p_argcount, r_err);
+			return true;
+		case INLINE_CACHE_METHOD_BIND:
+			r_err.error = Callable::CallError::CALL_OK;
+			r_ret = entry.method->call(object, p_args, p_argcount, r_err);
+			return true;
+		default:
+			return false;
+	}
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -215,6 +551,38 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_EQUAL_INT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_LESS_INT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                \
+		&&OPCODE_OPERATOR_GREATER_INT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_NEGATE_INT,                    \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                  \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,                   \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,               \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                    \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,              \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                 \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,           \
+		&&OPCODE_OPERATOR_NEGATE_FLOAT,                  \
+		&&OPCODE_OPERATOR_EQUAL_BOOL,                    \
+		&&OPCODE_OPERATOR_NOT_EQUAL_BOOL,                \
+		&&OPCODE_OPERATOR_NOT_BOOL,                      \
+		&&OPCODE_OPERATOR_ADD_VECTOR2,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR2_FLOAT,        \
+		&&OPCODE_OPERATOR_ADD_VECTOR3,                   \
+		&&OPCODE_OPERATOR_SUBTRACT_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3,              \
+		&&OPCODE_OPERATOR_MULTIPLY_VECTOR3_FLOAT,        \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_NATIVE,                       \
@@ -272,6 +640,16 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                   \
 		&&OPCODE_JUMP_IF,                                \
 		&&OPCODE_JUMP_IF_NOT,                            \
+		&&OPCODE_JUMP_IF_BOOL,                           \
+		&&OPCODE_JUMP_IF_NOT_BOOL,                       \
+		&&OPCODE_JUMP_IF_EQUAL_INT,                      \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_INT,                  \
+		&&OPCODE_JUMP_IF_NOT_LESS_INT,                   \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_INT,             \
+		&&OPCODE_JUMP_IF_EQUAL_FLOAT,                    \
+		&&OPCODE_JUMP_IF_NOT_EQUAL_FLOAT,                \
+		&&OPCODE_JUMP_IF_NOT_LESS_FLOAT,                 \
+		&&OPCODE_JUMP_IF_NOT_LESS_EQUAL_FLOAT,           \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
 		&&OPCODE_RETURN,                                 \
@@ -485,6 +863,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
 	int defarg = 0;
+	Ref<GDScriptFunctionState> stack_owner; // Set once the stack is handed over to a new `await`.
 
 #ifdef DEBUG_ENABLED
 
@@ -499,11 +878,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -680,6 +1059,49 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+	// Functions compiled at export never await, so they only run from the start. Breakpoints
+	// and stepping need the bytecode, so it is used instead whenever a debugger is attached.
+#ifdef DEBUG_ENABLED
+	if (native_function && !p_state && !EngineDebugger::is_active()) {
+#else
+	if (native_function && !p_state) {
+#endif
+		GDScriptNativeContext context;
+		context.function = this;
+		context.stack = stack;
+		context.constants = _constants_ptr;
+		context.members = variant_addresses[ADDR_TYPE_MEMBER];
+		context.result = &retvalue;
+		context.default_argument = defarg;
+		context.global_names = _global_names_ptr;
+		context.operator_funcs = _operator_funcs_ptr;
+		context.setters = _setters_ptr;
+		context.getters = _getters_ptr;
+		context.keyed_setters = _keyed_setters_ptr;
+		context.keyed_getters = _keyed_getters_ptr;
+		context.indexed_setters = _indexed_setters_ptr;
+		context.indexed_getters = _indexed_getters_ptr;
+		context.builtin_methods = _builtin_methods_ptr;
+		context.constructors = _constructors_ptr;
+		context.utilities = _utilities_ptr;
+		context.gds_utilities = _gds_utilities_ptr;
+		context.methods = _methods_ptr;
+		context.api = GDScriptNative::get_api();
+
+		// Like errors in bytecode, these are only reported in debug builds, where the function
+		// also returns the default value of its return type.
+#ifdef DEBUG_ENABLED
+		if (unlikely(!native_function(context))) {
+			String err_file = script && !script->path.is_empty() ? script->path : String("<built-in>");
+			_err_print_error(String(name).utf8().get_data(), err_file.utf8().get_data(), context.error_line, context.error.utf8().get_data(), false, ERR_HANDLER_SCRIPT);
+			retvalue = _get_default_variant_for_data_type(return_type);
+		}
+#else
+		native_function(context);
+#endif
+		goto native_function_exit;
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -792,6 +1214,64 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_opcode, m_left, m_op, m_right, m_result)                         \
+	OPCODE(OPCODE_OPERATOR_##m_opcode) {                                                         \
+		CHECK_SPACE(4);                                                                          \
+		GET_VARIANT_PTR(a, 0);                                                                   \
+		GET_VARIANT_PTR(b, 1);                                                                   \
+		GET_VARIANT_PTR(dst, 2);                                                                 \
+		auto result = *VariantInternal::get_##m_left(a) m_op *VariantInternal::get_##m_right(b); \
+		VariantTypeChanger<decltype(result)>::change(dst);                                       \
+		*VariantInternal::get_##m_result(dst) = result;                                          \
+		ip += 4;                                                                                 \
+	}                                                                                            \
+	DISPATCH_OPCODE
+
+#define OPCODE_OPERATOR_TYPED_UNARY(m_opcode, m_op, m_type)    \
+	OPCODE(OPCODE_OPERATOR_##m_opcode) {                       \
+		CHECK_SPACE(4);                                        \
+		GET_VARIANT_PTR(a, 0);                                 \
+		GET_VARIANT_PTR(dst, 2);                               \
+		auto result = m_op(*VariantInternal::get_##m_type(a)); \
+		VariantTypeChanger<decltype(result)>::change(dst);     \
+		*VariantInternal::get_##m_type(dst) = result;          \
+		ip += 4;                                               \
+	}                                                          \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD_INT, int, +, int, int);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_INT, int, -, int, int);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_INT, int, *, int, int);
+			OPCODE_OPERATOR_TYPED(EQUAL_INT, int, ==, int, bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_INT, int, !=, int, bool);
+			OPCODE_OPERATOR_TYPED(LESS_INT, int, <, int, bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_INT, int, <=, int, bool);
+			OPCODE_OPERATOR_TYPED(GREATER_INT, int, >, int, bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_INT, int, >=, int, bool);
+			OPCODE_OPERATOR_TYPED_UNARY(NEGATE_INT, -, int);
+			OPCODE_OPERATOR_TYPED(ADD_FLOAT, float, +, float, float);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_FLOAT, float, -, float, float);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_FLOAT, float, *, float, float);
+			OPCODE_OPERATOR_TYPED(DIVIDE_FLOAT, float, /, float, float);
+			OPCODE_OPERATOR_TYPED(EQUAL_FLOAT, float, ==, float, bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_FLOAT, float, !=, float, bool);
+			OPCODE_OPERATOR_TYPED(LESS_FLOAT, float, <, float, bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL_FLOAT, float, <=, float, bool);
+			OPCODE_OPERATOR_TYPED(GREATER_FLOAT, float, >, float, bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL_FLOAT, float, >=, float, bool);
+			OPCODE_OPERATOR_TYPED_UNARY(NEGATE_FLOAT, -, float);
+			OPCODE_OPERATOR_TYPED(EQUAL_BOOL, bool, ==, bool, bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL_BOOL, bool, !=, bool, bool);
+			OPCODE_OPERATOR_TYPED_UNARY(NOT_BOOL, !, bool);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR2, vector2, +, vector2, vector2);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR2, vector2, -, vector2, vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2, vector2, *, vector2, vector2);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR2_FLOAT, vector2, *, float, vector2);
+			OPCODE_OPERATOR_TYPED(ADD_VECTOR3, vector3, +, vector3, vector3);
+			OPCODE_OPERATOR_TYPED(SUBTRACT_VECTOR3, vector3, -, vector3, vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3, vector3, *, vector3, vector3);
+			OPCODE_OPERATOR_TYPED(MULTIPLY_VECTOR3_FLOAT, vector3, *, float, vector3);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1106,7 +1586,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1116,8 +1596,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_cache_set(inline_cache, dst, *index, value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1138,7 +1623,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1158,7 +1643,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1168,13 +1653,21 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_caches_count);
+
+				bool valid = true;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret;
+				if (!_inline_cache_get(inline_cache, src, *index, ret)) {
+					ret = src->get_named(*index, valid);
+				}
 
 #else
-				*dst = src->get_named(*index, valid);
+				if (!_inline_cache_get(inline_cache, src, *index, *dst)) {
+					*dst = src->get_named(*index, valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1183,7 +1676,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1719,7 +2212,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1730,6 +2223,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int inline_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= _inline_caches_count);
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1747,7 +2243,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, *ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1777,7 +2275,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!_inline_cache_call(inline_cache, base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1827,7 +2327,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2391,14 +2891,25 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
+					if (p_state) {
+						// Already running on the stack saved by the previous await, which is handed
+						// over as is instead of copying its values again.
+						gdfs->state.stack = p_state->stack;
+						gdfs->state.alloca_size = p_state->alloca_size;
+						p_state->stack = nullptr;
+						p_state->stack_size = 0;
+						// This function keeps running on it until it returns, even if the new state is
+						// dropped first, like when connecting to the signal fails.
+						stack_owner = gdfs;
+					} else {
+						gdfs->_allocate_stack(alloca_size);
 
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						// First 3 stack addresses are special, so we just skip them here.
+						for (int i = 3; i < _stack_size; i++) {
+							memnew_placement(&gdfs->state.stack[sizeof(Variant) * i], Variant(stack[i]));
+						}
 					}
 					gdfs->state.stack_size = _stack_size;
-					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
 					gdfs->state.script = _script;
@@ -2421,7 +2932,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = sig.connect(Callable(gdfs.ptr(), SNAME("_signal_callback")).bind(retvalue), Object::CONNECT_ONE_SHOT);
 					if (err != OK) {
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
@@ -2558,6 +3069,62 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_BOOL) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (*VariantInternal::get_bool(test)) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_BOOL) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (!*VariantInternal::get_bool(test)) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_JUMP_IF_COMPARE(m_opcode, m_type, m_test)      \
+	OPCODE(OPCODE_JUMP_IF_##m_opcode) {                       \
+		CHECK_SPACE(4);                                       \
+		GET_VARIANT_PTR(a, 0);                                \
+		GET_VARIANT_PTR(b, 1);                                \
+		const auto left = *VariantInternal::get_##m_type(a);  \
+		const auto right = *VariantInternal::get_##m_type(b); \
+		if (m_test) {                                         \
+			int to = _code_ptr[ip + 3];                       \
+			GD_ERR_BREAK(to < 0 || to > _code_size);          \
+			ip = to;                                          \
+		} else {                                              \
+			ip += 4;                                          \
+		}                                                     \
+	}                                                         \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_COMPARE(EQUAL_INT, int, left == right);
+			OPCODE_JUMP_IF_COMPARE(NOT_EQUAL_INT, int, left != right);
+			OPCODE_JUMP_IF_COMPARE(NOT_LESS_INT, int, !(left < right));
+			OPCODE_JUMP_IF_COMPARE(NOT_LESS_EQUAL_INT, int, !(left <= right));
+			OPCODE_JUMP_IF_COMPARE(EQUAL_FLOAT, float, left == right);
+			OPCODE_JUMP_IF_COMPARE(NOT_EQUAL_FLOAT, float, left != right);
+			OPCODE_JUMP_IF_COMPARE(NOT_LESS_FLOAT, float, !(left < right));
+			OPCODE_JUMP_IF_COMPARE(NOT_LESS_EQUAL_FLOAT, float, !(left <= right));
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -3672,6 +4239,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+native_function_exit:
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -3693,9 +4261,15 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		}
 #endif
 
-		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		// Free stack, except reserved addresses. When a resumed function awaits again, its stack
+		// now belongs to the new state instead.
+		if (!p_state || p_state->stack_size) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
+			if (p_state) {
+				p_state->stack_size = 0;
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
@@ -3705,6 +4279,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	for (int i = 0; i < FIXED_ADDRESSES_MAX; i++) {
 		stack[i].~Variant();
 	}
+	stack_owner.unref(); // May free the stack, nothing can use it after this.
 
 	call_depth--;
 
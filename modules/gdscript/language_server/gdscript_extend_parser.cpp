@@ -146,6 +146,10 @@ void ExtendGDScriptParser::update_diagnostics() {
 
 	const List<GDScriptWarning> &parser_warnings = get_warnings();
 	for (const GDScriptWarning &warning : parser_warnings) {
+		if ((warning.code == GDScriptWarning::UNUSED_PRIVATE_CLASS_VARIABLE || warning.code == GDScriptWarning::UNUSED_SIGNAL) && !warning.symbols.is_empty() && reused_identifiers.has(warning.symbols[0])) {
+			continue; // Used in a method body that wasn't analyzed again.
+		}
+
 		lsp::Diagnostic diagnostic;
 		diagnostic.severity = lsp::DiagnosticSeverity::Warning;
 		diagnostic.message = "(" + warning.get_name() + "): " + warning.get_message();
@@ -504,6 +508,13 @@ void ExtendGDScriptParser::parse_function_symbol(const GDScriptParser::FunctionN
 		r_symbol.detail += " -> " + p_func->get_datatype().to_string();
 	}
 
+	if (const lsp::DocumentSymbol *reused = reused_function_symbols.getptr(p_func)) {
+		// The body was skipped, keep the locals from the previous parse.
+		r_symbol.range = reused->range;
+		r_symbol.children = reused->children;
+		return;
+	}
+
 	List<GDScriptParser::SuiteNode *> function_nodes;
 
 	List<GDScriptParser::Node *> node_stack;
@@ -621,15 +632,16 @@ void ExtendGDScriptParser::parse_function_symbol(const GDScriptParser::FunctionN
 }
 
 String ExtendGDScriptParser::get_text_for_completion(const lsp::Position &p_cursor) const {
+	const Vector<String> text_lines = get_lines_with_skipped_bodies(p_cursor.line);
 	String longthing;
-	int len = lines.size();
+	int len = text_lines.size();
 	for (int i = 0; i < len; i++) {
 		if (i == p_cursor.line) {
-			longthing += lines[i].substr(0, p_cursor.character);
+			longthing += text_lines[i].substr(0, p_cursor.character);
 			longthing += String::chr(0xFFFF); // Not unicode, represents the cursor.
-			longthing += lines[i].substr(p_cursor.character, lines[i].size());
+			longthing += text_lines[i].substr(p_cursor.character, text_lines[i].size());
 		} else {
-			longthing += lines[i];
+			longthing += text_lines[i];
 		}
 
 		if (i != len - 1) {
@@ -641,13 +653,14 @@ String ExtendGDScriptParser::get_text_for_completion(const lsp::Position &p_curs
 }
 
 String ExtendGDScriptParser::get_text_for_lookup_symbol(const lsp::Position &p_cursor, const String &p_symbol, bool p_func_required) const {
+	const Vector<String> text_lines = get_lines_with_skipped_bodies(p_cursor.line);
 	String longthing;
-	int len = lines.size();
+	int len = text_lines.size();
 	for (int i = 0; i < len; i++) {
 		if (i == p_cursor.line) {
-			String line = lines[i];
+			String line = text_lines[i];
 			String first_part = line.substr(0, p_cursor.character);
-			String last_part = line.substr(p_cursor.character, lines[i].length());
+			String last_part = line.substr(p_cursor.character, text_lines[i].length());
 			if (!p_symbol.is_empty()) {
 				String left_cursor_text;
 				for (int c = p_cursor.character - 1; c >= 0; c--) {
@@ -667,7 +680,7 @@ String ExtendGDScriptParser::get_text_for_lookup_symbol(const lsp::Position &p_c
 			}
 			longthing += last_part;
 		} else {
-			longthing += lines[i];
+			longthing += text_lines[i];
 		}
 
 		if (i != len - 1) {
@@ -1013,11 +1026,373 @@ Dictionary ExtendGDScriptParser::generate_api() const {
 	return api;
 }
 
-Error ExtendGDScriptParser::parse(const String &p_code, const String &p_path) {
+static void _offset_symbol(lsp::DocumentSymbol &r_symbol, int p_offset) {
+	r_symbol.range.start.line += p_offset;
+	r_symbol.range.end.line += p_offset;
+	r_symbol.selectionRange.start.line += p_offset;
+	r_symbol.selectionRange.end.line += p_offset;
+	lsp::DocumentSymbol *children = r_symbol.children.ptrw();
+	for (int i = 0; i < r_symbol.children.size(); i++) {
+		_offset_symbol(children[i], p_offset);
+	}
+}
+
+static const lsp::DocumentSymbol *_find_method_symbol(const lsp::DocumentSymbol &p_class, const String &p_name, int p_line) {
+	for (const lsp::DocumentSymbol &symbol : p_class.children) {
+		if (symbol.kind == lsp::SymbolKind::Class) {
+			const lsp::DocumentSymbol *found = _find_method_symbol(symbol, p_name, p_line);
+			if (found) {
+				return found;
+			}
+		} else if ((symbol.kind == lsp::SymbolKind::Method || symbol.kind == lsp::SymbolKind::Function) && symbol.range.start.line == p_line && symbol.name == p_name) {
+			return &symbol;
+		}
+	}
+	return nullptr;
+}
+
+void ExtendGDScriptParser::collect_functions(const GDScriptParser::ClassNode *p_class, Vector<GDScriptParser::FunctionNode *> &r_functions, int &r_member_count) const {
+	r_member_count += p_class->members.size();
+	for (const ClassNode::Member &member : p_class->members) {
+		if (member.type == ClassNode::Member::FUNCTION) {
+			r_functions.push_back(member.function);
+		} else if (member.type == ClassNode::Member::CLASS) {
+			collect_functions(member.m_class, r_functions, r_member_count);
+		}
+	}
+}
+
+void ExtendGDScriptParser::update_function_extents() {
+	// Called right after parsing, so only syntax errors are recorded.
+	syntax_error_lines.clear();
+	for (const ParserError &error : get_errors()) {
+		syntax_error_lines.push_back(error.line);
+	}
+
+	Vector<GDScriptParser::FunctionNode *> functions;
+	member_count = 0;
+	if (get_tree() != nullptr) {
+		collect_functions(get_tree(), functions, member_count);
+	}
+
+	function_extents.resize(functions.size());
+	FunctionExtents *extents = function_extents.ptrw();
+	for (int i = 0; i < functions.size(); i++) {
+		const GDScriptParser::FunctionNode *function = functions[i];
+		extents[i].name = function->identifier != nullptr ? function->identifier->name : StringName();
+		extents[i].start_line = function->start_line;
+		extents[i].body_line = function->body != nullptr ? function->body->start_line : function->start_line;
+		extents[i].end_line = function->end_line;
+		extents[i].end_column = function->end_column;
+		extents[i].is_coroutine = function->is_coroutine;
+		extents[i].has_return_type = function->return_type != nullptr;
+	}
+}
+
+void ExtendGDScriptParser::restore_class_extents(GDScriptParser::ClassNode *p_class) {
+	// A class ends with its last member, which may have been a blanked out body.
+	for (const ClassNode::Member &member : p_class->members) {
+		if (member.type == ClassNode::Member::CLASS) {
+			restore_class_extents(member.m_class);
+		}
+	}
+	if (p_class->members.is_empty()) {
+		return;
+	}
+	const GDScriptParser::Node *last = p_class->members[p_class->members.size() - 1].get_source_node();
+	if (last != nullptr && (last->end_line > p_class->end_line || (last->end_line == p_class->end_line && last->end_column > p_class->end_column))) {
+		p_class->end_line = last->end_line;
+		p_class->end_column = last->end_column;
+	}
+}
+
+bool ExtendGDScriptParser::parse_incremental(const ExtendGDScriptParser &p_previous, Error &r_error) {
+	const Vector<String> &previous_lines = p_previous.lines;
+	const Vector<FunctionExtents> &previous_extents = p_previous.function_extents;
+
+	const int common_size = MIN(lines.size(), previous_lines.size());
+	int prefix = 0;
+	while (prefix < common_size && lines[prefix] == previous_lines[prefix]) {
+		prefix++;
+	}
+	int suffix = 0;
+	while (suffix < common_size - prefix && lines[lines.size() - suffix - 1] == previous_lines[previous_lines.size() - suffix - 1]) {
+		suffix++;
+	}
+
+	// Edited lines, 1-based and inclusive. A range is empty when lines were only inserted or only removed.
+	const int edit_start = prefix + 1;
+	const int previous_edit_end = previous_lines.size() - suffix;
+	const int edit_end = lines.size() - suffix;
+	const int line_offset = lines.size() - previous_lines.size();
+
+	// The edit must stay inside a single method body, otherwise the class interface may have changed
+	// and every body needs to be analyzed again. Adding lines after the last statement is fine too.
+	int edited = -1;
+	if (previous_edit_end >= edit_start || edit_end >= edit_start) {
+		for (int i = 0; i < previous_extents.size(); i++) {
+			const FunctionExtents &extents = previous_extents[i];
+			if (extents.body_line > extents.start_line && extents.body_line <= edit_start && MAX(previous_edit_end, edit_start - 1) <= extents.end_line) {
+				edited = i;
+				break;
+			}
+		}
+		if (edited == -1) {
+			return false;
+		}
+	}
+
+	if (!p_previous.syntax_error_lines.is_empty()) {
+		// Nothing was analyzed last time, so there are no results to keep for the other bodies.
+		return false;
+	}
+
+	// Blank out the other multiline bodies, keeping the line numbers.
+	Vector<String> source_lines = lines;
+	Vector<bool> skipped; // Whether the body of each method is left out.
+	skipped.resize(previous_extents.size());
+	Vector<int> offsets; // Line offset of each skipped method.
+	offsets.resize(previous_extents.size());
+	int skipped_count = 0;
+	for (int i = 0; i < previous_extents.size(); i++) {
+		const FunctionExtents &extents = previous_extents[i];
+		skipped.write[i] = false;
+		offsets.write[i] = 0;
+		if (i == edited || extents.body_line <= extents.start_line || extents.body_line > extents.end_line) {
+			continue;
+		}
+		const int offset = extents.start_line > previous_edit_end ? line_offset : 0;
+		const int body_index = LINE_NUMBER_TO_INDEX(extents.body_line + offset);
+		const String &first_line = source_lines[body_index];
+		source_lines.write[body_index] = first_line.substr(0, first_line.length() - first_line.strip_edges(true, false).length()) + "pass";
+		for (int j = body_index + 1; j <= LINE_NUMBER_TO_INDEX(extents.end_line + offset); j++) {
+			source_lines.write[j] = String();
+		}
+		skipped.write[i] = true;
+		offsets.write[i] = offset;
+		skipped_count++;
+	}
+	if (skipped_count == 0) {
+		return false;
+	}
+
+	const String source = String("\n").join(source_lines);
+	Error err = GDScriptParser::parse(source, path, false);
+
+	// Make sure the blanked out bodies were parsed back as they were, and that the edit didn't leak out.
+	Vector<GDScriptParser::FunctionNode *> functions;
+	int new_member_count = 0;
+	if (get_tree() != nullptr) {
+		collect_functions(get_tree(), functions, new_member_count);
+	}
+	if (functions.size() != previous_extents.size() || new_member_count != p_previous.member_count) {
+		return false;
+	}
+	for (int i = 0; i < functions.size(); i++) {
+		const GDScriptParser::FunctionNode *function = functions[i];
+		const FunctionExtents &extents = previous_extents[i];
+		const int offset = extents.start_line > previous_edit_end ? line_offset : 0;
+		if (function->identifier == nullptr || function->identifier->name != extents.name || function->start_line != extents.start_line + offset) {
+			return false;
+		}
+		if (skipped[i] && (function->body == nullptr || function->body->statements.size() != 1 || function->end_line != extents.body_line + offset)) {
+			return false;
+		}
+	}
+	if (edited != -1) {
+		const GDScriptParser::FunctionNode *function = functions[edited];
+		if (function->end_line < edit_end || function->is_coroutine != previous_extents[edited].is_coroutine) {
+			// Callers awaiting this method need to be checked again when it stops or starts being a coroutine.
+			return false;
+		}
+		for (const ParserError &error : get_errors()) {
+			if (error.line < function->start_line || error.line > function->end_line) {
+				return false;
+			}
+		}
+	} else if (!get_errors().is_empty()) {
+		return false;
+	}
+
+	syntax_error_lines.clear();
+	for (const ParserError &error : get_errors()) {
+		syntax_error_lines.push_back(error.line);
+	}
+	member_count = new_member_count;
+
+	// Lookup tables for the skipped methods, by line in both versions of the document.
+	Vector<int> skipped_at_line;
+	skipped_at_line.resize(lines.size() + 2);
+	skipped_at_line.fill(-1);
+	Vector<int> previous_skipped_at_line;
+	previous_skipped_at_line.resize(previous_lines.size() + 2);
+	previous_skipped_at_line.fill(-1);
+
+	function_extents.resize(functions.size());
+	FunctionExtents *extents = function_extents.ptrw();
+	for (int i = 0; i < functions.size(); i++) {
+		GDScriptParser::FunctionNode *function = functions[i];
+		if (!skipped[i]) {
+			extents[i].name = function->identifier->name;
+			extents[i].start_line = function->start_line;
+			extents[i].body_line = function->body != nullptr ? function->body->start_line : function->start_line;
+			extents[i].end_line = function->end_line;
+			extents[i].end_column = function->end_column;
+			extents[i].is_coroutine = function->is_coroutine;
+			extents[i].has_return_type = function->return_type != nullptr;
+			continue;
+		}
+
+		const int offset = offsets[i];
+		extents[i] = previous_extents[i];
+		extents[i].start_line += offset;
+		extents[i].body_line += offset;
+		extents[i].end_line += offset;
+		for (int line = previous_extents[i].start_line; line <= previous_extents[i].end_line; line++) {
+			previous_skipped_at_line.write[line] = i;
+			skipped_at_line.write[line + offset] = i;
+		}
+
+		// Restore what the blanked out body would have changed in the analysis.
+		function->end_line = extents[i].end_line;
+		function->end_column = extents[i].end_column;
+		function->is_coroutine = extents[i].is_coroutine;
+		function->body->has_return = true;
+		for (GDScriptParser::ParameterNode *parameter : function->parameters) {
+			parameter->usages = MAX(parameter->usages, 1);
+		}
+
+		const lsp::DocumentSymbol *symbol = _find_method_symbol(p_previous.class_symbol, extents[i].name, LINE_NUMBER_TO_INDEX(previous_extents[i].start_line));
+		if (symbol != nullptr) {
+			lsp::DocumentSymbol &reused = reused_function_symbols.insert(function, *symbol)->value;
+			_offset_symbol(reused, offset);
+		}
+	}
+
+	if (get_tree() != nullptr) {
+		restore_class_extents(get_tree());
+	}
+
+	GDScriptAnalyzer analyzer(this);
+	if (err == OK) {
+		err = analyzer.analyze();
+	}
+
+	// Usages of private members and signals are counted across all bodies.
+	for (const GDScriptWarning &warning : get_warnings()) {
+		if (warning.code != GDScriptWarning::UNUSED_PRIVATE_CLASS_VARIABLE && warning.code != GDScriptWarning::UNUSED_SIGNAL) {
+			continue;
+		}
+		for (int i = 0; i < functions.size(); i++) {
+			if (!skipped[i]) {
+				continue;
+			}
+			GDScriptTokenizerText tokenizer;
+			tokenizer.set_source_code(String("\n").join(lines.slice(LINE_NUMBER_TO_INDEX(extents[i].body_line), extents[i].end_line)));
+			for (GDScriptTokenizer::Token token = tokenizer.scan(); token.type != GDScriptTokenizer::Token::TK_EOF; token = tokenizer.scan()) {
+				if (token.type == GDScriptTokenizer::Token::IDENTIFIER) {
+					reused_identifiers.insert(token.get_identifier());
+				}
+			}
+		}
+		break;
+	}
+
+	update_diagnostics();
+	if (syntax_error_lines.is_empty()) {
+		// The skipped bodies were analyzed last time, keep those results.
+		Vector<lsp::Diagnostic> merged;
+		for (const lsp::Diagnostic &diagnostic : diagnostics) {
+			if (skipped_at_line[CLAMP(diagnostic.range.start.line + 1, 0, lines.size() + 1)] == -1) {
+				merged.push_back(diagnostic);
+			}
+		}
+		for (const lsp::Diagnostic &diagnostic : p_previous.diagnostics) {
+			const int method = previous_skipped_at_line[CLAMP(diagnostic.range.start.line + 1, 0, previous_lines.size() + 1)];
+			if (method == -1) {
+				continue;
+			}
+			lsp::Diagnostic reused = diagnostic;
+			reused.range.start.line += offsets[method];
+			reused.range.end.line += offsets[method];
+			if (reused.severity == lsp::DiagnosticSeverity::Error && err == OK) {
+				err = ERR_PARSE_ERROR;
+			}
+			merged.push_back(reused);
+		}
+		diagnostics = merged;
+	}
+
+	update_symbols();
+
+	update_document_links(source);
+	for (const lsp::DocumentLink &link : p_previous.document_links) {
+		const int line = link.range.start.line + 1;
+		const int method = previous_skipped_at_line[CLAMP(line, 0, previous_lines.size() + 1)];
+		if (method != -1 && line >= previous_extents[method].body_line) {
+			lsp::DocumentLink reused = link;
+			reused.range.start.line += offsets[method];
+			reused.range.end.line += offsets[method];
+			document_links.push_back(reused);
+		}
+	}
+
+	reused_function_symbols.clear();
+	reused_identifiers.clear();
+
+	r_error = err;
+	return true;
+}
+
+Vector<String> ExtendGDScriptParser::get_lines_with_skipped_bodies(int p_line) const {
+	// Completion and lookup only need the method under the cursor and the class interface. Other bodies
+	// are left out to speed up long scripts, except those of untyped methods which are used to guess return types.
+	const int line = p_line + 1;
+	int current = -1;
+	for (int i = 0; i < function_extents.size(); i++) {
+		if (function_extents[i].start_line <= line && line <= function_extents[i].end_line) {
+			current = i;
+			break;
+		}
+	}
+	for (int error_line : syntax_error_lines) {
+		if (current == -1 || error_line < function_extents[current].start_line || error_line > function_extents[current].end_line) {
+			return lines;
+		}
+	}
+
+	Vector<String> result = lines;
+	for (int i = 0; i < function_extents.size(); i++) {
+		const FunctionExtents &extents = function_extents[i];
+		if (i == current || !extents.has_return_type || extents.body_line <= extents.start_line || extents.end_line > lines.size()) {
+			continue;
+		}
+		const int body_index = LINE_NUMBER_TO_INDEX(extents.body_line);
+		const String &first_line = result[body_index];
+		result.write[body_index] = first_line.substr(0, first_line.length() - first_line.strip_edges(true, false).length()) + "pass";
+		for (int j = body_index + 1; j <= LINE_NUMBER_TO_INDEX(extents.end_line); j++) {
+			result.write[j] = String();
+		}
+	}
+	return result;
+}
+
+Error ExtendGDScriptParser::parse(const String &p_code, const String &p_path, const ExtendGDScriptParser *p_previous) {
 	path = p_path;
 	lines = p_code.split("\n");
+	incremental = false;
+
+	if (p_previous != nullptr && p_previous->path == p_path) {
+		Error err = OK;
+		if (parse_incremental(*p_previous, err)) {
+			incremental = true;
+			return err;
+		}
+		reused_function_symbols.clear();
+	}
 
 	Error err = GDScriptParser::parse(p_code, p_path, false);
+	update_function_extents();
 	GDScriptAnalyzer analyzer(this);
 
 	if (err == OK) {
@@ -112,6 +112,20 @@ struct GodotRange {
 };
 
 class ExtendGDScriptParser : public GDScriptParser {
+	/**
+	 * Line extents of a class method, kept in source coordinates so the next parse
+	 * of the same document can skip the bodies that weren't edited.
+	 */
+	struct FunctionExtents {
+		StringName name;
+		int start_line = 0;
+		int body_line = 0; // First line of the body, same as `start_line` for single-line functions.
+		int end_line = 0;
+		int end_column = 0;
+		bool is_coroutine = false;
+		bool has_return_type = false;
+	};
+
 	String path;
 	Vector<String> lines;
 
@@ -121,8 +135,23 @@ class ExtendGDScriptParser : public GDScriptParser {
 	ClassMembers members;
 	HashMap<String, ClassMembers> inner_classes;
 
+	Vector<FunctionExtents> function_extents;
+	Vector<int> syntax_error_lines;
+	int member_count = 0;
+	bool incremental = false;
+
+	// Only used while reusing the results of a previous parse.
+	HashMap<const GDScriptParser::FunctionNode *, lsp::DocumentSymbol> reused_function_symbols;
+	HashSet<StringName> reused_identifiers;
+
 	lsp::Range range_of_node(const GDScriptParser::Node *p_node) const;
 
+	void collect_functions(const GDScriptParser::ClassNode *p_class, Vector<GDScriptParser::FunctionNode *> &r_functions, int &r_member_count) const;
+	void update_function_extents();
+	void restore_class_extents(GDScriptParser::ClassNode *p_class);
+	bool parse_incremental(const ExtendGDScriptParser &p_previous, Error &r_error);
+	Vector<String> get_lines_with_skipped_bodies(int p_line) const;
+
 	void update_diagnostics();
 
 	void update_symbols();
@@ -144,6 +173,7 @@ public:
 	_FORCE_INLINE_ const Vector<lsp::Diagnostic> &get_diagnostics() const { return diagnostics; }
 	_FORCE_INLINE_ const ClassMembers &get_members() const { return members; }
 	_FORCE_INLINE_ const HashMap<String, ClassMembers> &get_inner_classes() const { return inner_classes; }
+	_FORCE_INLINE_ bool is_incremental() const { return incremental; } // Whether the last parse reused the previous one.
 
 	Error get_left_function_call(const lsp::Position &p_position, lsp::Position &r_func_pos, int &r_arg_index) const;
 
@@ -167,7 +197,13 @@ public:
 	const Array &get_member_completions();
 	Dictionary generate_api() const;
 
-	Error parse(const String &p_code, const String &p_path);
+	/**
+	 * When `p_previous` holds the last parse of the same document, only the class methods
+	 * whose body contains the edit are reparsed and analyzed again. The other bodies are
+	 * blanked out, and their diagnostics, symbols and links are carried over from `p_previous`.
+	 * Falls back to a full parse whenever the edit reaches outside a single method body.
+	 */
+	Error parse(const String &p_code, const String &p_path, const ExtendGDScriptParser *p_previous = nullptr);
 };
 
 #endif // GDSCRIPT_EXTEND_PARSER_H
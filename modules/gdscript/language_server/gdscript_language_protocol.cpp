@@ -168,6 +168,8 @@ void GDScriptLanguageProtocol::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_text_document"), &GDScriptLanguageProtocol::get_text_document);
 	ClassDB::bind_method(D_METHOD("get_workspace"), &GDScriptLanguageProtocol::get_workspace);
 	ClassDB::bind_method(D_METHOD("is_initialized"), &GDScriptLanguageProtocol::is_initialized);
+	ClassDB::bind_method(D_METHOD("get_request_metrics"), &GDScriptLanguageProtocol::get_request_metrics);
+	ClassDB::bind_method(D_METHOD("clear_request_metrics"), &GDScriptLanguageProtocol::clear_request_metrics);
 }
 
 Dictionary GDScriptLanguageProtocol::initialize(const Dictionary &p_params) {
@@ -328,6 +330,47 @@ void GDScriptLanguageProtocol::request_client(const String &p_method, const Vari
 	peer->res_queue.push_back(msg.utf8());
 }
 
+Variant GDScriptLanguageProtocol::process_action(const Variant &p_action, bool p_process_arr_elements) {
+	if (p_action.get_type() != Variant::DICTIONARY) {
+		// Batches come back here for each of their messages.
+		return JSONRPC::process_action(p_action, p_process_arr_elements);
+	}
+
+	const String method = Dictionary(p_action).get("method", "");
+	const uint64_t start_usec = OS::get_singleton()->get_ticks_usec();
+	Variant ret = JSONRPC::process_action(p_action, p_process_arr_elements);
+
+	if (!method.is_empty()) {
+		const uint64_t elapsed_usec = OS::get_singleton()->get_ticks_usec() - start_usec;
+		RequestMetrics &metrics = request_metrics[method];
+		metrics.count++;
+		metrics.total_usec += elapsed_usec;
+		metrics.max_usec = MAX(metrics.max_usec, elapsed_usec);
+		metrics.last_usec = elapsed_usec;
+		print_verbose(vformat("GDScript LSP: %s handled in %.2f ms.", method, elapsed_usec / 1000.0));
+	}
+
+	return ret;
+}
+
+Dictionary GDScriptLanguageProtocol::get_request_metrics() const {
+	Dictionary ret;
+	for (const KeyValue<String, RequestMetrics> &E : request_metrics) {
+		Dictionary metrics;
+		metrics["count"] = E.value.count;
+		metrics["total_msec"] = E.value.total_usec / 1000.0;
+		metrics["average_msec"] = E.value.total_usec / 1000.0 / E.value.count;
+		metrics["max_msec"] = E.value.max_usec / 1000.0;
+		metrics["last_msec"] = E.value.last_usec / 1000.0;
+		ret[E.key] = metrics;
+	}
+	return ret;
+}
+
+void GDScriptLanguageProtocol::clear_request_metrics() {
+	request_metrics.clear();
+}
+
 bool GDScriptLanguageProtocol::is_smart_resolve_enabled() const {
 	return bool(_EDITOR_GET("network/language_server/enable_smart_resolve"));
 }
@@ -73,6 +73,13 @@ private:
 		ContentModified = -32801,
 	};
 
+	struct RequestMetrics {
+		uint64_t count = 0;
+		uint64_t total_usec = 0;
+		uint64_t max_usec = 0;
+		uint64_t last_usec = 0;
+	};
+
 	static GDScriptLanguageProtocol *singleton;
 
 	HashMap<int, Ref<LSPeer>> clients;
@@ -88,6 +95,9 @@ private:
 	Error on_client_connected();
 	void on_client_disconnected(const int &p_client_id);
 
+	// Time spent handling each method, requests and notifications alike.
+	HashMap<String, RequestMetrics> request_metrics;
+
 	String process_message(const String &p_text);
 	String format_output(const String &p_text);
 
@@ -112,6 +122,12 @@ public:
 	void notify_client(const String &p_method, const Variant &p_params = Variant(), int p_client_id = -1);
 	void request_client(const String &p_method, const Variant &p_params = Variant(), int p_client_id = -1);
 
+	// Times each message handled, batched ones included.
+	virtual Variant process_action(const Variant &p_action, bool p_process_arr_elements = false) override;
+
+	Dictionary get_request_metrics() const;
+	void clear_request_metrics();
+
 	bool is_smart_resolve_enabled() const;
 	bool is_goto_native_symbols_enabled() const;
 
@@ -82,7 +82,7 @@ void GDScriptTextDocument::didChange(const Variant &p_param) {
 		evt.load(contentChanges[i]);
 		doc.text = evt.text;
 	}
-	sync_script_content(doc.uri, doc.text);
+	sync_script_content(doc.uri, doc.text, true);
 }
 
 void GDScriptTextDocument::willSaveWaitUntil(const Variant &p_param) {
@@ -482,9 +482,9 @@ GDScriptTextDocument::GDScriptTextDocument() {
 	file_checker = FileAccess::create(FileAccess::ACCESS_RESOURCES);
 }
 
-void GDScriptTextDocument::sync_script_content(const String &p_path, const String &p_content) {
+void GDScriptTextDocument::sync_script_content(const String &p_path, const String &p_content, bool p_incremental) {
 	String path = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_file_path(p_path);
-	GDScriptLanguageProtocol::get_singleton()->get_workspace()->parse_script(path, p_content);
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->parse_script(path, p_content, p_incremental);
 
 	EditorFileSystem::get_singleton()->update_file(path);
 }
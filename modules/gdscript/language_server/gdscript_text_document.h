@@ -49,7 +49,7 @@ protected:
 	void willSaveWaitUntil(const Variant &p_param);
 	void didSave(const Variant &p_param);
 
-	void sync_script_content(const String &p_path, const String &p_content);
+	void sync_script_content(const String &p_path, const String &p_content, bool p_incremental = false);
 	void show_native_symbol_in_editor(const String &p_symbol_id);
 
 	Array native_member_completions;
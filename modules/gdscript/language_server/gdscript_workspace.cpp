@@ -420,12 +420,20 @@ Error GDScriptWorkspace::initialize() {
 	return OK;
 }
 
-Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content) {
-	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
-	Error err = parser->parse(p_content, p_path);
+Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content, bool p_incremental) {
 	HashMap<String, ExtendGDScriptParser *>::Iterator last_parser = parse_results.find(p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator last_script = scripts.find(p_path);
 
+	// Another script may have been edited in between, in which case every body is analyzed again.
+	const ExtendGDScriptParser *previous = nullptr;
+	if (p_incremental && last_parser && last_parsed_path == p_path) {
+		previous = last_parser->value;
+	}
+	last_parsed_path = p_path;
+
+	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
+	Error err = parser->parse(p_content, p_path, previous);
+
 	if (err == OK) {
 		remove_cache_parser(p_path);
 		parse_results[p_path] = parser;
@@ -58,6 +58,8 @@ protected:
 
 	void reload_all_workspace_scripts();
 
+	String last_parsed_path;
+
 	ExtendGDScriptParser *get_parse_successed_script(const String &p_path);
 	ExtendGDScriptParser *get_parse_result(const String &p_path);
 
@@ -76,7 +78,7 @@ public:
 public:
 	Error initialize();
 
-	Error parse_script(const String &p_path, const String &p_content);
+	Error parse_script(const String &p_path, const String &p_content, bool p_incremental = false);
 	Error parse_local_script(const String &p_path);
 
 	String get_file_path(const String &p_uri) const;
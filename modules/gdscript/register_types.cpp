@@ -32,13 +32,16 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_byte_serializer.h"
 #include "gdscript_cache.h"
+#include "gdscript_native.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_utility_functions.h"
 
 #ifdef TOOLS_ENABLED
 #include "editor/gdscript_highlighter.h"
+#include "editor/gdscript_native_translator.h"
 #include "editor/gdscript_translation_parser_plugin.h"
 
 #ifndef GDSCRIPT_NO_LSP
@@ -84,17 +87,53 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
+	bool debug_export = false;
+
+	String native_code_path;
+	GDScriptNativeTranslator native_translator;
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_code_path", PROPERTY_HINT_GLOBAL_DIR), ""));
+	}
+
+	virtual String _get_export_option_warning(const Ref<EditorExportPlatform> &p_export_platform, const String &p_option_name) const override {
+		if (p_option_name == "gdscript/native_code_path" && !String(get_option(p_option_name)).is_empty()) {
+			const Ref<EditorExportPreset> &preset = get_export_preset();
+			if (preset.is_valid() && preset->get_script_export_mode() != EditorExportPreset::MODE_SCRIPT_COMPILED) {
+				return TTR("GDScript native code is only used when scripts are exported as compiled bytecode.");
+			}
+		}
+		return String();
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		debug_export = p_debug;
+		native_code_path = String();
+		native_translator.clear();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED) {
+				native_code_path = get_option("gdscript/native_code_path");
+			}
 		}
 	}
 
+	virtual void _export_end() override {
+		if (native_code_path.is_empty()) {
+			return;
+		}
+		// The extension is built with the SConstruct written along with it. Once in the project,
+		// it registers the translated functions, which then run instead of their bytecode.
+		if (native_translator.write_extension(native_code_path) == OK) {
+			print_line(vformat("GDScript: %d functions translated to native code in \"%s\", %d left as bytecode.", native_translator.get_translated_count(), native_code_path.path_join("gdscript_native"), native_translator.get_skipped_count()));
+		}
+		native_translator.clear();
+	}
+
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
 		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
 			return;
@@ -107,12 +146,31 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
-		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
+		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS ? GDScriptTokenizerBuffer::COMPRESS_NONE : GDScriptTokenizerBuffer::COMPRESS_ZSTD;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
 			return;
 		}
 
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_COMPILED) {
+			// Scripts that fail to compile, or reference something that can't be found again at runtime, are exported as tokens only.
+			// The code the editor runs is made for the editor's build, so the script is compiled again for the exported one.
+			bool static_script = false;
+			Ref<GDScript> script = GDScriptByteCodeSerializer::compile_for_export(p_path, file, debug_export, static_script);
+			if (script.is_valid()) {
+				Vector<uint8_t> compiled = GDScriptByteCodeSerializer::save(script, file, static_script);
+				if (!compiled.is_empty()) {
+					file = compiled;
+					if (!native_code_path.is_empty()) {
+						native_translator.add_script(script);
+					}
+				} else {
+					print_verbose(vformat("GDScript: \"%s\" can't be exported as compiled bytecode, exporting its tokens instead.", p_path));
+				}
+				GDScriptByteCodeSerializer::free_export_copy(script);
+			}
+		}
+
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
@@ -142,6 +200,10 @@ static void _editor_init() {
 #endif // TOOLS_ENABLED
 
 void initialize_gdscript_module(ModuleInitializationLevel p_level) {
+	if (p_level == MODULE_INITIALIZATION_LEVEL_CORE) {
+		GDScriptNative::register_extension_interface();
+	}
+
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SERVERS) {
 		GDREGISTER_CLASS(GDScript);
 
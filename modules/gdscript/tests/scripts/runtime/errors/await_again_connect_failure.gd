@@ -0,0 +1,15 @@
+# A resumed function awaiting again runs on the stack it hands over to the new await,
+# which must stay valid while the function exits, even if the await fails.
+
+signal resume
+
+func coroutine(value):
+	await resume
+	var local = [value]
+	await Signal(self, &"missing")
+	print("not reached %s" % local)
+
+func test():
+	coroutine("value")
+	resume.emit()
+	print("done")
@@ -0,0 +1,44 @@
+signal step(value)
+
+class Tracked:
+	var name: String
+
+	func _init(p_name: String) -> void:
+		name = p_name
+
+	func _notification(what: int) -> void:
+		if what == NOTIFICATION_PREDELETE:
+			print("freed ", name)
+
+class Emitter:
+	signal fired
+
+var emitter: Emitter
+
+func accumulate(times: int) -> void:
+	var total := 0
+	var history := []
+	var tracked := Tracked.new("accumulate")
+	for i in times:
+		var value = await step
+		total += value
+		history.append(value)
+	print(total, " ", history, " ", tracked.name)
+
+func wait_forever() -> void:
+	var _tracked := Tracked.new("never resumed")
+	await emitter.fired
+	print("unreachable")
+
+func test():
+	# Locals have to survive each resume, the stack being passed from one await to the next.
+	accumulate(3)
+	step.emit(1)
+	step.emit(10)
+	step.emit(100)
+
+	# Dropping the emitter disconnects the coroutine, which must still release its locals.
+	emitter = Emitter.new()
+	wait_forever()
+	emitter = null
+	print("end")
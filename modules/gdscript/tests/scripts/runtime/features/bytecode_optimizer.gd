@@ -0,0 +1,91 @@
+# Patterns rewritten by the bytecode optimizer, which must behave as if it wasn't there.
+
+static var counter := 0
+
+func test():
+	# Short-circuit conditions, whose result temporaries get threaded through.
+	var hits := 0
+	for i in 12:
+		if i > 2 and i < 9 and i != 5:
+			hits += 1
+		if i == 0 or i == 11 or not (i < 10):
+			hits += 100
+	print(hits)
+
+	var flag := hits > 0 and hits < 1000
+	var other = hits < 0 or hits == 0
+	print(flag, " ", other)
+
+	# Infinite loops left with `break` and `return`.
+	var n := 0
+	while true:
+		n += 3
+		if n > 20:
+			break
+	print(n)
+
+	var find_first := func (values: Array, target: int) -> int:
+		for k in values.size():
+			if values[k] == target:
+				return k
+		return -1
+	print(find_first.call([4, 8, 15, 16], 15), " ", find_first.call([4, 8], 15))
+
+	# Ternaries and comparisons feeding branches directly.
+	var labels := []
+	for value in [-2, 0, 3]:
+		labels.append("neg" if value < 0 else ("zero" if value == 0 else "pos"))
+	print(labels)
+
+	var a := 4
+	var b := 4
+	if a >= b:
+		print("a >= b")
+	if not (a > b):
+		print("not a > b")
+	if a <= b and a != b:
+		print("unreachable")
+
+	# Ordered comparisons with NaN are always false, so they can't be inverted.
+	var nan := NAN
+	var one := 1.0
+	print(nan < one, " ", nan >= one, " ", one > nan, " ", one <= nan)
+	if nan < one:
+		print("nan < 1")
+	if not (nan < one):
+		print("not nan < 1")
+	if nan >= one:
+		print("nan >= 1")
+	if nan == nan:
+		print("nan == nan")
+	if nan != nan:
+		print("nan != nan")
+
+	# Results written straight into typed and untyped locals.
+	var typed_sum := 0
+	var untyped_sum = 0
+	var scaled := 0.0
+	for i in 5:
+		typed_sum = typed_sum + i * 2
+		untyped_sum = untyped_sum + i
+		scaled = scaled + float(i) / 2.0
+	print(typed_sum, " ", untyped_sum, " ", scaled)
+
+	var dict := { "key": [1, 2, 3] }
+	var picked: Array = dict["key"]
+	var size: int = picked.size()
+	var squared := size * size
+	var swapped := squared
+	swapped = squared - swapped + typed_sum
+	print(picked, " ", size, " ", squared, " ", swapped)
+
+	# Constant operands.
+	const LIMIT = 3
+	var limit := LIMIT * 2
+	var capped := limit if limit < LIMIT * 3 else -1
+	print(limit, " ", capped)
+
+	# Compound assignments to static variables, whose result is copied between two temporaries.
+	counter += 5
+	counter *= 3
+	print(counter)
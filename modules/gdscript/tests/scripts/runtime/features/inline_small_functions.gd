@@ -0,0 +1,60 @@
+# Small functions are compiled in place of their calls, which must not change behavior.
+
+var calls := 0
+var _scale := 2.0
+
+var doubled: float:
+	get:
+		return _scale * 2.0
+
+var scale: float:
+	get:
+		return _scale
+	set(value):
+		_scale = value * 0.5
+
+var name_length: int:
+	get:
+		return name_length
+	set(value):
+		name_length = value if value >= 0 else 0
+
+static func square(x: float) -> float:
+	return x * x
+
+static func pick(flag: bool, a, b):
+	return a if flag else b
+
+static func first(values: Array):
+	return values[0]
+
+static func same(value: int) -> int:
+	return value
+
+func next_value() -> int:
+	calls += 1
+	return calls
+
+func test():
+	print(square(3))
+	print(square(1.5))
+	var x := 10
+	print(square(x), " ", x)
+	print(square(x + 1), " ", square(x * 0.5))
+	print(pick(true, "a", "b"), pick(false, "a", "b"))
+	print(first([4, 5]), " ", pick(x > 5, [6], [7]))
+
+	# Arguments are evaluated once, even when the body uses them twice.
+	print(square(next_value()), " ", calls)
+
+	# Returning an argument unchanged.
+	print(same(next_value() + 10))
+
+	print(doubled)
+	scale = 8
+	print(scale, " ", _scale, " ", doubled)
+
+	name_length = -4
+	print(name_length)
+	name_length = 7
+	print(name_length)
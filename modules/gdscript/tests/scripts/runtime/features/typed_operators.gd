@@ -0,0 +1,41 @@
+@warning_ignore("integer_division")
+func test():
+	var a := 7
+	var b := 3
+	print(a + b, " ", a - b, " ", a * b, " ", -a)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x := 2.5
+	var y := 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y, " ", -x)
+	print(x == y, " ", x != y, " ", x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var t := true
+	var f := false
+	print(t == f, " ", t != f, " ", not t, " ", not f)
+
+	var v2 := Vector2(1, 2)
+	var w2 := Vector2(3, 4)
+	print(v2 + w2, " ", v2 - w2, " ", v2 * w2, " ", v2 * x)
+
+	var v3 := Vector3(1, 2, 3)
+	var w3 := Vector3(4, 5, 6)
+	print(v3 + w3, " ", v3 - w3, " ", v3 * w3, " ", v3 * x)
+
+	# Results feeding conditions and loops.
+	var sum := 0
+	var i := 0
+	while i < 10:
+		if i % 2 == 0 and not (i > 6):
+			sum += i * i
+		i += 1
+	print(sum)
+
+	var flag := a > b
+	if flag:
+		print("greater")
+	if not flag:
+		print("not greater")
+
+	# Mixed and integer division keep their usual semantics.
+	print(a / b, " ", a % b, " ", a * x)
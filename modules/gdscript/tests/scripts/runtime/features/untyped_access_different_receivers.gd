@@ -0,0 +1,63 @@
+# The same untyped access or call site must keep working as the receiver type changes.
+
+class A:
+	var value = 1
+	var typed: float = 0.0
+	var numbers: Array[int] = []
+	var accessor = 0:
+		get:
+			return accessor + 100
+		set(new_value):
+			accessor = new_value * 2
+
+	func describe(arg):
+		return "A %s" % [arg + value]
+
+class B extends A:
+	func describe(arg):
+		return "B %s" % [arg * 10]
+
+class C:
+	var value = "c"
+
+	func describe(arg):
+		return "C %s" % [arg]
+
+	func _get(property):
+		if property == &"dynamic":
+			return 42
+		return null
+
+class D:
+	static func get_path():
+		return "static get_path()"
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), Vector2(3, 4), A.new(), C.new()]
+	for receiver in receivers:
+		if receiver is Vector2:
+			print(receiver.x)
+		else:
+			print(receiver.value)
+			print(receiver.describe(2))
+
+	var a = receivers[0]
+	for i in 2:
+		a.typed = i + 1
+		print(a.typed, " ", typeof(a.typed) == TYPE_FLOAT)
+		a.accessor = i
+		print(a.accessor)
+		a.numbers = [i, 2.0]
+		print(a.numbers, " ", a.numbers.is_typed())
+
+	var c = receivers[2]
+	print(c.dynamic)
+	c.value = "changed"
+	print(c.value)
+
+	var scripts = [D, D]
+	for script in scripts:
+		print(script.get_path())
+
+	var ref_counted = RefCounted.new()
+	print(ref_counted.get_reference_count())
@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  test_await.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AWAIT_H
+#define TEST_AWAIT_H
+
+#include "../gdscript.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// Measures how long resuming many coroutines takes, each awaiting the same signal many times.
+// Every resume that awaits again goes through the stack handover and the stack pool.
+TEST_CASE("[Stress][Modules][GDScript] Resume many awaiting coroutines") {
+	const int coroutines = 2000;
+	const int awaits = 50;
+
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(R"(
+extends RefCounted
+
+signal tick(value)
+
+var completed := 0
+var total := 0
+
+func worker(p_times: int) -> void:
+	var sum := 0
+	for i in p_times:
+		sum += await tick
+	total += sum
+	completed += 1
+
+func start(p_count: int, p_times: int) -> void:
+	for i in p_count:
+		worker(p_times)
+)");
+	REQUIRE(script->reload() == OK);
+
+	// Also starts from an empty pool after a shutdown, as when the language is initialized again.
+	GDScriptFunctionState::clear_stack_pool();
+	GDScriptFunctionState::init_stack_pool();
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(script);
+	instance->call("start", coroutines, awaits);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < awaits; i++) {
+		instance->emit_signal("tick", 1);
+	}
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+	MESSAGE(vformat("%d coroutines awaiting %d times resumed in %d ms.", coroutines, awaits, elapsed / 1000));
+
+	CHECK(int(instance->get("completed")) == coroutines);
+	CHECK(int(instance->get("total")) == coroutines * awaits);
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_AWAIT_H
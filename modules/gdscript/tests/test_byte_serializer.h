@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_byte_serializer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BYTE_SERIALIZER_H
+#define TEST_BYTE_SERIALIZER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "../gdscript.h"
+#include "../gdscript_byte_serializer.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static const char *serializer_test_source = R"(
+extends RefCounted
+
+class Counter:
+	var total := 0
+
+	func add(p_value: int, p_times: int = 2) -> int:
+		total += p_value * p_times
+		return total
+
+var calls := 0
+
+func bump() -> bool:
+	calls += 1
+	return true
+
+func run() -> Array:
+	var results := []
+
+	var sum := 0
+	for i in range(10):
+		sum += i * i
+	results.push_back(sum)
+
+	var ratio := 0.0
+	var values: Array[float] = [1.5, 2.5, 4.0]
+	for value in values:
+		ratio += value / 2.0
+	results.push_back(ratio)
+
+	var counter := Counter.new()
+	counter.add(3)
+	results.push_back(counter.add(4, 1))
+
+	var words := ["a", "bc", "def"]
+	var lengths := words.map(func(p_word): return p_word.length())
+	results.push_back(lengths)
+
+	var named := { "x": 1, "y": 2 }
+	var keys := ""
+	for key in named:
+		keys += key
+	results.push_back(keys)
+
+	match sum % 3:
+		0:
+			results.push_back("zero")
+		_:
+			results.push_back("other")
+
+	assert(bump())
+	results.push_back(calls)
+	return results
+)";
+
+static Vector<uint8_t> _compile_for_export(const String &p_path, bool p_debug) {
+	Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(serializer_test_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	bool static_script = false;
+	Ref<GDScript> copy = GDScriptByteCodeSerializer::compile_for_export(p_path, tokens, p_debug, static_script);
+	REQUIRE(copy.is_valid());
+	Vector<uint8_t> file = GDScriptByteCodeSerializer::save(copy, tokens, static_script);
+	GDScriptByteCodeSerializer::free_export_copy(copy);
+
+	Vector<uint8_t> file_tokens;
+	Vector<uint8_t> compiled;
+	REQUIRE(GDScriptByteCodeSerializer::unpack(file, file_tokens, compiled));
+	CHECK(file_tokens == tokens);
+	REQUIRE_FALSE(compiled.is_empty());
+	return compiled;
+}
+
+static Variant _run(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(p_script);
+	return instance->call("run");
+}
+
+TEST_CASE("[Modules][GDScript] Compiled bytecode save and load") {
+	// Compiling resolves the script's own classes through the file, like in the editor.
+	const String path = TestUtils::get_temp_path("test_byte_serializer.gd");
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_string(serializer_test_source);
+	}
+
+	Ref<GDScript> reference = memnew(GDScript);
+	reference->set_source_code(serializer_test_source);
+	ERR_PRINT_OFF;
+	REQUIRE(reference->reload() == OK);
+	ERR_PRINT_ON;
+	const Array expected = _run(reference);
+	REQUIRE(expected.size() == 7);
+	CHECK(int(expected[6]) == 1);
+
+	SUBCASE("Debug exports run the same as the script compiled from source") {
+		Vector<uint8_t> compiled = _compile_for_export(path, true);
+		Ref<GDScript> script = memnew(GDScript);
+		script->set_path(path, true);
+		REQUIRE(GDScriptByteCodeSerializer::load(script.ptr(), compiled) == OK);
+		CHECK(script->is_valid());
+		CHECK(_run(script) == Variant(expected));
+	}
+
+	SUBCASE("Release exports don't evaluate asserts") {
+		Vector<uint8_t> compiled = _compile_for_export(path, false);
+		Ref<GDScript> script = memnew(GDScript);
+		script->set_path(path, true);
+		REQUIRE(GDScriptByteCodeSerializer::load(script.ptr(), compiled) == OK);
+		Array results = _run(script);
+		REQUIRE(results.size() == 7);
+		CHECK(int(results[6]) == 0);
+		results.resize(6);
+		Array expected_before_assert = expected.duplicate();
+		expected_before_assert.resize(6);
+		CHECK(results == expected_before_assert);
+	}
+
+	SUBCASE("A failed load leaves the loaded code in place") {
+		Vector<uint8_t> compiled = _compile_for_export(path, true);
+		Ref<GDScript> script = memnew(GDScript);
+		script->set_path(path, true);
+		REQUIRE(GDScriptByteCodeSerializer::load(script.ptr(), compiled) == OK);
+
+		// Cut short, inside the last class.
+		Vector<uint8_t> truncated = compiled.slice(0, compiled.size() - 16);
+		CHECK(GDScriptByteCodeSerializer::load(script.ptr(), truncated) == ERR_FILE_CORRUPT);
+		CHECK(script->is_valid());
+		CHECK(_run(script) == Variant(expected));
+	}
+}
+
+} // namespace GDScriptTests
+
+#endif // DEBUG_ENABLED
+
+#endif // TEST_BYTE_SERIALIZER_H
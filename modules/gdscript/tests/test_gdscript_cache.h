@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_CACHE_H
+#define TEST_GDSCRIPT_CACHE_H
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static String _write_cache_test_script(const String &p_dir, const String &p_name, const String &p_source) {
+	const String path = p_dir.path_join(p_name);
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_string(p_source);
+	return path;
+}
+
+TEST_CASE("[Modules][GDScript] Dependencies are parsed ahead of loading") {
+	const String dir = TestUtils::get_temp_path("gdscript_cache_dependencies");
+	REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+
+	// `main` extends `base` and preloads `a` and `b`, which both preload `leaf`.
+	const String base = _write_cache_test_script(dir, "base.gd", "extends RefCounted\nfunc base_value():\n\treturn 1\n");
+	const String leaf = _write_cache_test_script(dir, "leaf.gd", "const VALUE = 10\n");
+	const String a = _write_cache_test_script(dir, "a.gd", "const Leaf = preload(\"leaf.gd\")\nconst VALUE = Leaf.VALUE + 1\n");
+	const String b = _write_cache_test_script(dir, "b.gd", "const Leaf = preload(\"./leaf.gd\")\nconst VALUE = Leaf.VALUE + 2\n");
+	const String main_source = "extends \"base.gd\"\nconst A = preload(\"a.gd\")\nconst B = preload(\"" + b + "\")\nfunc total():\n\treturn base_value() + A.VALUE + B.VALUE\n";
+	const String main = _write_cache_test_script(dir, "main.gd", main_source);
+
+	SUBCASE("The parser records the paths of `extends` and `preload()`") {
+		GDScriptParser parser;
+		REQUIRE(parser.parse(main_source, main, false) == OK);
+		Vector<String> dependencies;
+		for (const String &E : parser.get_dependencies()) {
+			dependencies.push_back(E);
+		}
+		CHECK(dependencies.size() == 3);
+		CHECK(dependencies.has(base));
+		CHECK(dependencies.has(a));
+		CHECK(dependencies.has(b));
+	}
+
+	SUBCASE("Loading finds every dependency, shared ones included") {
+		// `a` and `b` form one layer, parsed in parallel when the pool has more than one thread.
+		Error err = FAILED;
+		Ref<GDScript> script = GDScriptCache::get_full_script(main, err);
+		REQUIRE(err == OK);
+		REQUIRE(script.is_valid());
+		CHECK(script->is_valid());
+
+		Ref<RefCounted> instance = memnew(RefCounted);
+		instance->set_script(script);
+		CHECK(int(instance->call("total")) == 1 + 11 + 12);
+
+		for (const String &path : { base, leaf, a, b }) {
+			Ref<GDScript> dependency = GDScriptCache::get_cached_script(path);
+			REQUIRE_MESSAGE(dependency.is_valid(), path);
+			CHECK_MESSAGE(dependency->is_valid(), path);
+		}
+	}
+
+	SUBCASE("A broken dependency fails the load") {
+		_write_cache_test_script(dir, "broken.gd", "const VALUE = \n");
+		const String broken_main = _write_cache_test_script(dir, "broken_main.gd", "const Broken = preload(\"broken.gd\")\nconst A = preload(\"a.gd\")\n");
+
+		Error err = OK;
+		ERR_PRINT_OFF;
+		Ref<GDScript> script = GDScriptCache::get_full_script(broken_main, err);
+		ERR_PRINT_ON;
+		CHECK(err != OK);
+		if (script.is_valid()) {
+			CHECK_FALSE(script->is_valid());
+		}
+
+		GDScriptCache::remove_script(broken_main);
+		GDScriptCache::remove_script(dir.path_join("broken.gd"));
+	}
+
+	for (const String &path : { main, base, leaf, a, b }) {
+		GDScriptCache::remove_script(path);
+	}
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_CACHE_H
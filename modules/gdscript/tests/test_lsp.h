@@ -321,6 +321,71 @@ void test_position_roundtrip(lsp::Position p_lsp, GodotPosition p_gd, const Pack
 	CHECK_EQ(p_lsp, actual_lsp);
 }
 
+const String incremental_source = R"(extends Node
+
+signal finished(value: int)
+signal unused_signal
+
+var _count := 0
+var _unused := 1
+var total: int = 0
+
+func first(p_value: int) -> int:
+	var doubled := p_value * 2
+	_count += doubled
+	return doubled
+
+func second(p_name: String) -> String:
+	var unused_local := 3
+	var path := "res://lsp/enums.gd"
+	return p_name + path
+
+func untyped(p_value):
+	if p_value > 0:
+		return p_value
+	return -p_value
+
+func waits() -> void:
+	await get_tree().process_frame
+	finished.emit(total)
+
+func short() -> int: return 1
+
+class Inner:
+	var inner_value := 0
+
+	func bump(p_amount: int) -> void:
+		inner_value += p_amount
+
+	func read() -> int:
+		return inner_value
+
+func last() -> void:
+	total = first(2) + Inner.new().read() + _count)";
+
+struct IncrementalEdit {
+	String name;
+	String from;
+	String to;
+	bool incremental = false; // Whether only the edited body can be parsed again.
+	String before = incremental_source;
+};
+
+// Diagnostics and links aren't kept in source order, so they are compared sorted.
+String dump_parse_results(const ExtendGDScriptParser &p_parser) {
+	Vector<String> diagnostics;
+	for (const lsp::Diagnostic &diagnostic : p_parser.get_diagnostics()) {
+		diagnostics.push_back(Variant(diagnostic.to_json()).to_json_string());
+	}
+	diagnostics.sort();
+	Vector<String> links;
+	for (const lsp::DocumentLink &link : p_parser.get_document_links()) {
+		links.push_back(Variant(link.to_json()).to_json_string());
+	}
+	links.sort();
+	return String("\n").join(diagnostics) + "\n" + String("\n").join(links) + "\n" + Variant(p_parser.get_symbols().to_json(true)).to_json_string();
+}
+
 // Note:
 // * Cursor is BETWEEN chars
 //	 * `va|r` -> cursor between `a`&`r`
@@ -471,6 +536,59 @@ func f():
 		memdelete(proto);
 		finish_language();
 	}
+
+	TEST_CASE("[workspace][incremental_parse]") {
+		GDScriptLanguageProtocol *proto = initialize(root);
+		REQUIRE(proto);
+
+		const String broken_first = incremental_source.replace_first("\treturn doubled\n", "\treturn doubled +\n");
+		const IncrementalEdit edits[] = {
+			{ "Change a literal in a body", "p_value * 2", "p_value * 3", true },
+			{ "Insert lines in a body", "\t_count += doubled\n", "\t_count += doubled\n\tprint(doubled)\n\tprint(_count)\n", true },
+			{ "Remove a line from a body", "\t_count += doubled\n", "", true },
+			{ "Add an unused local variable", "\t_count += doubled\n", "\t_count += doubled\n\tvar spare := 1\n", true },
+			{ "Use an unused local variable", "\tvar unused_local := 3\n", "\tvar unused_local := 3\n\tprint(unused_local)\n", true },
+			{ "Add a syntax error in a body", "\treturn doubled\n", "\treturn doubled +\n", true },
+			{ "Fix a syntax error in a body", "\treturn doubled +\n", "\treturn doubled\n", false, broken_first },
+			{ "Add a type error in a body", "var doubled := p_value * 2", "var doubled: int = \"text\"", true },
+			{ "Call a missing method", "\treturn doubled\n", "\treturn missing(doubled)\n", true },
+			{ "Use an unused private variable", "var unused_local := 3", "var unused_local := _unused", true },
+			{ "Remove one of two usages of a private variable", "\t_count += doubled\n", "\tprint(doubled)\n", true },
+			{ "Emit an unused signal from a coroutine", "\tfinished.emit(total)\n", "\tfinished.emit(total)\n\tunused_signal.emit()\n", true },
+			{ "Edit a method of an inner class", "inner_value += p_amount", "inner_value -= p_amount", true },
+			{ "Append lines to the last method", " + _count", " + _count\n\tprint(total)\n\tprint(_count)", true },
+			{ "Add a document link in a body", "\t_count += doubled\n", "\t_count += doubled\n\tvar other := \"res://lsp/class.gd\"\n", true },
+			{ "Edit an untyped method", "\t\treturn p_value\n", "\t\treturn p_value * 2\n", true },
+			{ "Add a comment in a body", "\t_count += doubled\n", "\t# Keep count.\n\t_count += doubled\n", true },
+			{ "Make a method a coroutine", "\t_count += doubled\n", "\tawait get_tree().process_frame\n\t_count += doubled\n", false },
+			{ "Change a signature", "func first(p_value: int) -> int:", "func first(p_value: int, p_extra := 0) -> int:", false },
+			{ "Add a member variable", "var total: int = 0\n", "var total: int = 0\nvar added := 2\n", false },
+			{ "Rename a method", "func untyped(", "func renamed(", false },
+			{ "Add a method", "func short() -> int: return 1\n", "func short() -> int: return 1\n\nfunc added() -> void:\n\tpass\n", false },
+			{ "Edit a single-line method", "func short() -> int: return 1", "func short() -> int: return 2", false },
+		};
+
+		const String path = "res://lsp/incremental.gd";
+		for (const IncrementalEdit &edit : edits) {
+			REQUIRE_MESSAGE(edit.before.contains(edit.from), edit.name);
+			const String after = edit.before.replace_first(edit.from, edit.to);
+
+			ExtendGDScriptParser previous;
+			previous.parse(edit.before, path);
+
+			ExtendGDScriptParser full;
+			const Error full_err = full.parse(after, path);
+			ExtendGDScriptParser incremental;
+			const Error incremental_err = incremental.parse(after, path, &previous);
+
+			CHECK_MESSAGE(incremental.is_incremental() == edit.incremental, edit.name);
+			CHECK_MESSAGE(incremental_err == full_err, edit.name);
+			CHECK_MESSAGE(dump_parse_results(incremental) == dump_parse_results(full), edit.name);
+		}
+
+		memdelete(proto);
+		finish_language();
+	}
 }
 
 } // namespace GDScriptTests
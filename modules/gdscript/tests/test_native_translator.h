@@ -0,0 +1,344 @@
+/**************************************************************************/
+/*  test_native_translator.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NATIVE_TRANSLATOR_H
+#define TEST_NATIVE_TRANSLATOR_H
+
+#ifdef TOOLS_ENABLED
+
+#include "../editor/gdscript_native_translator.h"
+#include "../gdscript.h"
+#include "../gdscript_native.h"
+
+#include "core/io/file_access.h"
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static const char *native_translator_source = R"(
+extends RefCounted
+
+func typed_ops(p_a: int, p_b: float) -> float:
+	var scaled := -p_b * 0.5
+	if p_a * 2 > 10:
+		scaled += 1.0
+	return scaled
+
+func iterate(p_values: Array[int], p_count: int) -> int:
+	var total := 0
+	for i in p_count:
+		total += i
+	for value in p_values:
+		total += value
+	return total
+
+func defaults(p_a: int, p_b: int = 10, p_c: int = 100) -> int:
+	return p_a + p_b + p_c
+
+func get_at(p_values: Array[int], p_index: int) -> int:
+	return p_values[p_index]
+)";
+
+// Compiles the given functions, and keeps their source to compare with what the translator
+// writes for `native_translator_source`. Update both together when the compiler changes.
+#define GDSCRIPT_NATIVE_TEST_FUNCTIONS(...)                         \
+	static const char *native_translator_expected = #__VA_ARGS__; \
+	__VA_ARGS__
+
+// clang-format off
+GDSCRIPT_NATIVE_TEST_FUNCTIONS(
+static bool _gdscript_native_0(GDScriptNativeContext &p_context) {
+	Variant *stack = p_context.stack;
+	Variant *constants = p_context.constants;
+
+	{
+		auto result = -(*VariantInternal::get_float(&stack[4]));
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[7], Variant::FLOAT);
+		*VariantInternal::get_float(&stack[7]) = result;
+	}
+	{
+		auto result = *VariantInternal::get_float(&stack[7]) * *VariantInternal::get_float(&constants[0]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[5], Variant::FLOAT);
+		*VariantInternal::get_float(&stack[5]) = result;
+	}
+	{
+		auto result = *VariantInternal::get_int(&stack[3]) * *VariantInternal::get_int(&constants[1]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[9], Variant::INT);
+		*VariantInternal::get_int(&stack[9]) = result;
+	}
+	if (!(*VariantInternal::get_int(&constants[2]) < *VariantInternal::get_int(&stack[9]))) {
+		goto L26;
+	}
+	{
+		auto result = *VariantInternal::get_float(&stack[5]) + *VariantInternal::get_float(&constants[3]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[5], Variant::FLOAT);
+		*VariantInternal::get_float(&stack[5]) = result;
+	}
+L26:
+	p_context.api->assign(p_context.result, &stack[5]);
+	return true;
+}
+
+static bool _gdscript_native_1(GDScriptNativeContext &p_context) {
+	Variant *stack = p_context.stack;
+	Variant *constants = p_context.constants;
+
+	p_context.api->assign(&stack[5], &constants[0]);
+	p_context.api->assign(&stack[8], &stack[4]);
+	{
+		const int64_t size = *VariantInternal::get_int(&stack[8]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[7], Variant::INT);
+		*VariantInternal::get_int(&stack[7]) = 0;
+		if (size <= 0) {
+			goto L30;
+		}
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[6], Variant::INT);
+		*VariantInternal::get_int(&stack[6]) = 0;
+	}
+	goto L22;
+L17:
+	{
+		int64_t *count = VariantInternal::get_int(&stack[7]);
+		(*count)++;
+		if (*count >= *VariantInternal::get_int(&stack[8])) {
+			goto L30;
+		}
+		*VariantInternal::get_int(&stack[6]) = *count;
+	}
+L22:
+	{
+		auto result = *VariantInternal::get_int(&stack[5]) + *VariantInternal::get_int(&stack[6]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[5], Variant::INT);
+		*VariantInternal::get_int(&stack[5]) = result;
+	}
+	goto L17;
+L30:
+	p_context.api->assign(&stack[8], &stack[3]);
+	{
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[7], Variant::INT);
+		*VariantInternal::get_int(&stack[7]) = 0;
+		if (p_context.api->array_size(&stack[8]) == 0) {
+			goto L55;
+		}
+		p_context.api->array_get(&stack[8], 0, &stack[6]);
+	}
+	goto L47;
+L42:
+	{
+		int64_t *index = VariantInternal::get_int(&stack[7]);
+		(*index)++;
+		if (*index >= p_context.api->array_size(&stack[8])) {
+			goto L55;
+		}
+		p_context.api->array_get(&stack[8], *index, &stack[6]);
+	}
+L47:
+	{
+		auto result = *VariantInternal::get_int(&stack[5]) + *VariantInternal::get_int(&stack[6]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[5], Variant::INT);
+		*VariantInternal::get_int(&stack[5]) = result;
+	}
+	goto L42;
+L55:
+	p_context.api->assign(p_context.result, &stack[5]);
+	return true;
+}
+
+static bool _gdscript_native_2(GDScriptNativeContext &p_context) {
+	Variant *stack = p_context.stack;
+	Variant *constants = p_context.constants;
+
+	switch (p_context.default_argument) {
+		case 0:
+			goto L7;
+		case 1:
+			goto L4;
+		default:
+			break;
+	}
+	p_context.api->assign(&stack[4], &constants[0]);
+L4:
+	p_context.api->assign(&stack[5], &constants[1]);
+L7:
+	{
+		auto result = *VariantInternal::get_int(&stack[3]) + *VariantInternal::get_int(&stack[4]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[7], Variant::INT);
+		*VariantInternal::get_int(&stack[7]) = result;
+	}
+	{
+		auto result = *VariantInternal::get_int(&stack[7]) + *VariantInternal::get_int(&stack[5]);
+		GDSCRIPT_NATIVE_SET_TYPE(&stack[6], Variant::INT);
+		*VariantInternal::get_int(&stack[6]) = result;
+	}
+	p_context.api->assign(p_context.result, &stack[6]);
+	return true;
+}
+
+static bool _gdscript_native_3(GDScriptNativeContext &p_context) {
+	Variant *stack = p_context.stack;
+	int line = 21;
+
+	line = 22;
+	{
+		bool oob;
+		p_context.indexed_getters[0](&stack[3], *VariantInternal::get_int(&stack[4]), &stack[5], &oob);
+		GDSCRIPT_NATIVE_DEBUG_CHECK(!oob || p_context.api->fail_get_indexed(p_context, &stack[3], &stack[4]));
+	}
+	p_context.api->assign(p_context.result, &stack[5]);
+	return true;
+}
+
+static bool _gdscript_native_4(GDScriptNativeContext &p_context) {
+
+	return true;
+}
+)
+// clang-format on
+
+#undef GDSCRIPT_NATIVE_TEST_FUNCTIONS
+
+// Without comments, and with whitespace collapsed like in stringized code.
+static String _normalize_native_code(const String &p_code) {
+	Vector<String> words;
+	for (const String &line : p_code.split("\n")) {
+		if (!line.strip_edges().begins_with("//")) {
+			words.append_array(line.split_spaces());
+		}
+	}
+	return String(" ").join(words);
+}
+
+struct NativeTranslatorErrors {
+	ErrorHandlerList handler;
+	Vector<String> errors;
+
+	static void _handle_error(void *p_self, const char *p_function, const char *p_file, int p_line, const char *p_error, const char *p_message, bool p_editor_notify, ErrorHandlerType p_type) {
+		NativeTranslatorErrors *self = (NativeTranslatorErrors *)p_self;
+		self->errors.push_back(vformat("%s (%s:%d): %s", p_function, p_file, p_line, p_error));
+	}
+
+	NativeTranslatorErrors() {
+		handler.errfunc = _handle_error;
+		handler.userdata = this;
+		add_error_handler(&handler);
+	}
+
+	~NativeTranslatorErrors() {
+		remove_error_handler(&handler);
+	}
+};
+
+static Array _typed_int_array(const Vector<int> &p_values) {
+	Array array;
+	array.set_typed(Variant::INT, StringName(), Variant());
+	for (int value : p_values) {
+		array.push_back(value);
+	}
+	return array;
+}
+
+// Calls every function of `native_translator_source`, returning the results and the errors.
+static Array _run_native_translator_calls(const Ref<GDScript> &p_script) {
+	const Array values = _typed_int_array({ 1, 2, 3 });
+	const Array empty = _typed_int_array({});
+
+	Ref<RefCounted> instance = memnew(RefCounted);
+	instance->set_script(p_script);
+
+	NativeTranslatorErrors errors;
+	Array results;
+	ERR_PRINT_OFF;
+	results.push_back(instance->call("typed_ops", 3, 2.0));
+	results.push_back(instance->call("typed_ops", 6, 2.0));
+	results.push_back(instance->call("iterate", values, 4));
+	results.push_back(instance->call("iterate", empty, 0));
+	results.push_back(instance->call("defaults", 1));
+	results.push_back(instance->call("defaults", 1, 2));
+	results.push_back(instance->call("defaults", 1, 2, 3));
+	results.push_back(instance->call("get_at", values, 1));
+	results.push_back(instance->call("get_at", values, 5));
+	ERR_PRINT_ON;
+	results.push_back(Variant(errors.errors));
+	return results;
+}
+
+TEST_CASE("[Modules][GDScript] Native translation runs like the bytecode") {
+	const char *names[] = { "typed_ops", "iterate", "defaults", "get_at" };
+	const GDScriptNativeFunction functions[] = { _gdscript_native_0, _gdscript_native_1, _gdscript_native_2, _gdscript_native_3 };
+
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_source_code(native_translator_source);
+	REQUIRE(script->reload() == OK);
+
+	GDScriptNativeTranslator translator;
+	translator.add_script(script);
+	CHECK(translator.get_translated_count() == 5);
+	CHECK(translator.get_skipped_count() == 0);
+
+	const String extension_path = TestUtils::get_temp_path("native_translator");
+	REQUIRE(translator.write_extension(extension_path) == OK);
+	const String generated = FileAccess::get_file_as_string(extension_path.path_join("gdscript_native/gdscript_native.cpp"));
+	CHECK(_normalize_native_code(generated).contains(_normalize_native_code(native_translator_expected)));
+	const String config = FileAccess::get_file_as_string(extension_path.path_join("gdscript_native/gdscript_native.gdextension"));
+	CHECK(config.contains("entry_symbol = \"gdscript_native_library_init\""));
+	CHECK(generated.contains("gdscript_native_library_init("));
+
+	const Array expected = _run_native_translator_calls(script);
+	CHECK(expected[0] == Variant(-1.0));
+	CHECK(expected[1] == Variant(0.0));
+	CHECK(expected[2] == Variant(12));
+	CHECK(expected[6] == Variant(6));
+	CHECK(Array(expected[9]).size() == 1);
+
+	// The functions bind to the native code when compiled again.
+	for (int i = 0; i < 4; i++) {
+		const String key = GDScriptNative::get_function_key(script->get_member_functions()[names[i]]);
+		CHECK(generated.contains(vformat("api->register_function(\"%s\", &_gdscript_native_%d);", key.c_escape(), i)));
+		GDScriptNative::register_function(key, functions[i]);
+	}
+	REQUIRE(script->reload() == OK);
+	for (int i = 0; i < 4; i++) {
+		CHECK(GDScriptNative::get_function(script->get_member_functions()[names[i]]) == functions[i]);
+	}
+
+	const Array results = _run_native_translator_calls(script);
+	GDScriptNative::clear();
+
+	CHECK(results == expected);
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
+
+#endif // TEST_NATIVE_TRANSLATOR_H
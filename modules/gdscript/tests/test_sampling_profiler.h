@@ -0,0 +1,127 @@
+/**************************************************************************/
+/*  test_sampling_profiler.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SAMPLING_PROFILER_H
+#define TEST_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "../gdscript.h"
+
+#include "core/config/project_settings.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+class TestGDScriptLanguageInternalsAccessor {
+public:
+	// A call stack like the one the VM keeps under the debugger, frozen inside the given functions.
+	class CallStack {
+		GDScriptLanguage::CallStack stack;
+
+	public:
+		void push(GDScriptFunction *p_function, int *p_line) {
+			GDScriptLanguage::CallLevel &level = stack.levels[stack.stack_pos++];
+			level.function = p_function;
+			level.line = p_line;
+		}
+
+		CallStack() {
+			stack.levels = memnew_arr(GDScriptLanguage::CallLevel, 4);
+			GDScriptLanguage::_register_call_stack(&stack);
+		}
+	};
+};
+
+namespace GDScriptTests {
+
+TEST_CASE("[Modules][GDScript] Sampling profiler") {
+	const String path = TestUtils::get_temp_path("test_sampling_profiler.gd");
+	const String stacks_path = TestUtils::get_temp_path("test_sampling_profiler.folded");
+
+	Ref<GDScript> script = memnew(GDScript);
+	script->set_path(path, true);
+	script->set_source_code("func outer():\n\tinner()\n\nfunc inner():\n\tpass\n");
+	REQUIRE(script->reload() == OK);
+	GDScriptFunction *outer = script->get_member_functions()["outer"];
+	GDScriptFunction *inner = script->get_member_functions()["inner"];
+
+	int outer_line = 2;
+	int inner_line = 5;
+	TestGDScriptLanguageInternalsAccessor::CallStack call_stack;
+	call_stack.push(outer, &outer_line);
+	call_stack.push(inner, &inner_line);
+
+	ProjectSettings *settings = ProjectSettings::get_singleton();
+	settings->set_setting("debug/settings/gdscript/sampling_profiler", true);
+	settings->set_setting("debug/settings/gdscript/sampling_profiler_interval_usec", 100);
+	settings->set_setting("debug/settings/gdscript/sampling_profiler_folded_stacks_path", stacks_path);
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	language->profiling_start();
+	OS::get_singleton()->delay_usec(50000);
+	language->profiling_stop();
+
+	settings->set_setting("debug/settings/gdscript/sampling_profiler", false);
+	settings->set_setting("debug/settings/gdscript/sampling_profiler_interval_usec", 1000);
+	settings->set_setting("debug/settings/gdscript/sampling_profiler_folded_stacks_path", "");
+
+	ScriptLanguage::ProfilingInfo info[8];
+	const int count = language->profiling_get_accumulated_data(info, 8);
+	REQUIRE(count == 2);
+
+	const String outer_signature = path + "::2::outer:2";
+	const String inner_signature = path + "::5::inner:5";
+	uint64_t samples = 0;
+	for (int i = 0; i < count; i++) {
+		if (info[i].signature == outer_signature) {
+			// Always on the stack, never the innermost frame.
+			CHECK(info[i].self_time == 0);
+			CHECK(info[i].total_time == info[i].call_count * 100);
+			samples = info[i].call_count;
+		} else {
+			CHECK(String(info[i].signature) == inner_signature);
+			CHECK(info[i].self_time == info[i].total_time);
+			CHECK(info[i].total_time == info[i].call_count * 100);
+		}
+	}
+	CHECK(samples > 0);
+
+	const Vector<String> lines = FileAccess::get_file_as_string(stacks_path).split("\n", false);
+	REQUIRE(lines.size() == 1);
+	CHECK(lines[0] == vformat("outer (%s:2);inner (%s:5) %d", path, path, samples));
+}
+
+} // namespace GDScriptTests
+
+#endif // DEBUG_ENABLED
+
+#endif // TEST_SAMPLING_PROFILER_H
@@ -109,13 +109,11 @@ Error ImageLoaderJPG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField
 	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
-	src_image.resize(src_image_len);
 
-	uint8_t *w = src_image.ptrw();
+	const uint8_t *r = f->get_buffer_view(src_image_len, src_image);
+	ERR_FAIL_NULL_V(r, ERR_FILE_CORRUPT);
 
-	f->get_buffer(&w[0], src_image_len);
-
-	Error err = jpeg_load_image_from_buffer(p_image.ptr(), w, src_image_len);
+	Error err = jpeg_load_image_from_buffer(p_image.ptr(), r, src_image_len);
 
 	return err;
 }
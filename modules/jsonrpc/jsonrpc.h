@@ -59,7 +59,7 @@ public:
 	Dictionary make_notification(const String &p_method, const Variant &p_params);
 	Dictionary make_request(const String &p_method, const Variant &p_params, const Variant &p_id);
 
-	Variant process_action(const Variant &p_action, bool p_process_arr_elements = false);
+	virtual Variant process_action(const Variant &p_action, bool p_process_arr_elements = false);
 	String process_string(const String &p_input);
 
 	void set_scope(const String &p_scope, Object *p_obj);
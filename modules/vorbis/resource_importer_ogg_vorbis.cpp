@@ -124,7 +124,7 @@ void ResourceImporterOggVorbis::_bind_methods() {
 	ClassDB::bind_static_method("ResourceImporterOggVorbis", D_METHOD("load_from_file", "path"), &ResourceImporterOggVorbis::load_from_file);
 }
 
-Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::load_from_buffer(const Vector<uint8_t> &file_data) {
+Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::_load_from_buffer(const uint8_t *p_data, uint64_t p_size) {
 	Ref<AudioStreamOggVorbis> ogg_vorbis_stream;
 	ogg_vorbis_stream.instantiate();
 
@@ -146,7 +146,7 @@ Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::load_from_buffer(const Vect
 		err = ogg_sync_check(&sync_state);
 		ERR_FAIL_COND_V_MSG(err != 0, Ref<AudioStreamOggVorbis>(), "Ogg sync error " + itos(err));
 		while (ogg_sync_pageout(&sync_state, &page) != 1) {
-			if (cursor >= size_t(file_data.size())) {
+			if (cursor >= size_t(p_size)) {
 				done = true;
 				break;
 			}
@@ -155,12 +155,12 @@ Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::load_from_buffer(const Vect
 			char *sync_buf = ogg_sync_buffer(&sync_state, OGG_SYNC_BUFFER_SIZE);
 			err = ogg_sync_check(&sync_state);
 			ERR_FAIL_COND_V_MSG(err != 0, Ref<AudioStreamOggVorbis>(), "Ogg sync error " + itos(err));
-			ERR_FAIL_COND_V(cursor > size_t(file_data.size()), Ref<AudioStreamOggVorbis>());
-			size_t copy_size = file_data.size() - cursor;
+			ERR_FAIL_COND_V(cursor > size_t(p_size), Ref<AudioStreamOggVorbis>());
+			size_t copy_size = p_size - cursor;
 			if (copy_size > OGG_SYNC_BUFFER_SIZE) {
 				copy_size = OGG_SYNC_BUFFER_SIZE;
 			}
-			memcpy(sync_buf, &file_data[cursor], copy_size);
+			memcpy(sync_buf, p_data + cursor, copy_size);
 			ogg_sync_wrote(&sync_state, copy_size);
 			cursor += copy_size;
 			err = ogg_sync_check(&sync_state);
@@ -244,8 +244,17 @@ Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::load_from_buffer(const Vect
 	return ogg_vorbis_stream;
 }
 
+Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::load_from_buffer(const Vector<uint8_t> &file_data) {
+	return _load_from_buffer(file_data.ptr(), file_data.size());
+}
+
 Ref<AudioStreamOggVorbis> ResourceImporterOggVorbis::load_from_file(const String &p_path) {
-	Vector<uint8_t> file_data = FileAccess::get_file_as_bytes(p_path);
-	ERR_FAIL_COND_V_MSG(file_data.is_empty(), Ref<AudioStreamOggVorbis>(), "Cannot open file '" + p_path + "'.");
-	return load_from_buffer(file_data);
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null() || f->get_length() == 0, Ref<AudioStreamOggVorbis>(), "Cannot open file '" + p_path + "'.");
+
+	// Packets are copied out of the mapped file directly when possible.
+	Vector<uint8_t> file_data;
+	const uint8_t *data = f->get_buffer_view(f->get_length(), file_data);
+	ERR_FAIL_NULL_V_MSG(data, Ref<AudioStreamOggVorbis>(), "Cannot read file '" + p_path + "'.");
+	return _load_from_buffer(data, f->get_length());
 }
@@ -42,6 +42,8 @@ class ResourceImporterOggVorbis : public ResourceImporter {
 		OGG_SYNC_BUFFER_SIZE = 8192,
 	};
 
+	static Ref<AudioStreamOggVorbis> _load_from_buffer(const uint8_t *p_data, uint64_t p_size);
+
 protected:
 	static void _bind_methods();
 
@@ -0,0 +1,419 @@
+/**************************************************************************/
+/*  async_file_reader_io_uring.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "async_file_reader_io_uring.h"
+
+#ifdef IO_URING_ENABLED
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Not every libc exposes these yet. The numbers are the same on every architecture
+// this backend is enabled for without them, see the header.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+bool AsyncFileReaderIOUring::_setup_ring() {
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	ring_fd = syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params);
+	if (ring_fd < 0) {
+		// Old kernel, or io_uring disabled by the system or a sandbox.
+		ring_fd = -1;
+		return false;
+	}
+
+	// IORING_OP_READ and IORING_OP_FADVISE need Linux 5.6.
+	size_t probe_size = sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op);
+	io_uring_probe *probe = (io_uring_probe *)memalloc(probe_size);
+	memset(probe, 0, probe_size);
+	bool supported = syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) >= 0 &&
+			probe->last_op >= IORING_OP_FADVISE &&
+			(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) &&
+			(probe->ops[IORING_OP_FADVISE].flags & IO_URING_OP_SUPPORTED);
+	memfree(probe);
+	if (!supported) {
+		_close_ring();
+		return false;
+	}
+
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap) {
+		sq_ring_size = MAX(sq_ring_size, cq_ring_size);
+		cq_ring_size = sq_ring_size;
+	}
+
+	void *ptr = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	if (ptr == MAP_FAILED) {
+		_close_ring();
+		return false;
+	}
+	sq_ring = (uint8_t *)ptr;
+
+	if (single_mmap) {
+		cq_ring = sq_ring;
+	} else {
+		ptr = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if (ptr == MAP_FAILED) {
+			_close_ring();
+			return false;
+		}
+		cq_ring = (uint8_t *)ptr;
+	}
+
+	ptr = mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	if (ptr == MAP_FAILED) {
+		_close_ring();
+		return false;
+	}
+	sqes = (io_uring_sqe *)ptr;
+
+	sq_entries = params.sq_entries;
+	sq_head = (uint32_t *)(sq_ring + params.sq_off.head);
+	sq_tail = (uint32_t *)(sq_ring + params.sq_off.tail);
+	sq_mask = (uint32_t *)(sq_ring + params.sq_off.ring_mask);
+	sq_array = (uint32_t *)(sq_ring + params.sq_off.array);
+	cq_head = (uint32_t *)(cq_ring + params.cq_off.head);
+	cq_tail = (uint32_t *)(cq_ring + params.cq_off.tail);
+	cq_mask = (uint32_t *)(cq_ring + params.cq_off.ring_mask);
+	cqes = (io_uring_cqe *)(cq_ring + params.cq_off.cqes);
+
+	return true;
+}
+
+void AsyncFileReaderIOUring::_close_ring() {
+	if (sqes) {
+		munmap(sqes, sq_entries * sizeof(io_uring_sqe));
+		sqes = nullptr;
+	}
+	if (cq_ring && cq_ring != sq_ring) {
+		munmap(cq_ring, cq_ring_size);
+	}
+	cq_ring = nullptr;
+	if (sq_ring) {
+		munmap(sq_ring, sq_ring_size);
+		sq_ring = nullptr;
+	}
+	if (ring_fd >= 0) {
+		close(ring_fd);
+		ring_fd = -1;
+	}
+}
+
+void AsyncFileReaderIOUring::_flush_queue() {
+	// Only as many operations as the ring holds are in flight, so completions can't overflow.
+	while (queue_head < queue.size() && in_flight < sq_entries) {
+		Operation *op = queue[queue_head++];
+
+		uint32_t tail = *sq_tail;
+		uint32_t index = tail & *sq_mask;
+		io_uring_sqe *sqe = &sqes[index];
+		memset(sqe, 0, sizeof(io_uring_sqe));
+
+		if (op == nullptr) {
+			sqe->opcode = IORING_OP_NOP; // Wakes up the completion thread to exit.
+		} else {
+			switch (op->type) {
+				case OPERATION_READ: {
+					sqe->opcode = IORING_OP_READ;
+					sqe->fd = op->fd;
+					sqe->off = op->offset + op->done;
+					sqe->addr = (uint64_t)(op->buffer + op->done);
+					sqe->len = op->length - op->done;
+				} break;
+				case OPERATION_PREFETCH: {
+					sqe->opcode = IORING_OP_FADVISE;
+					sqe->fd = op->fd;
+					sqe->off = op->offset;
+					sqe->len = op->length;
+					sqe->fadvise_advice = POSIX_FADV_WILLNEED;
+				} break;
+				case OPERATION_NONE: {
+					sqe->opcode = IORING_OP_NOP;
+				} break;
+			}
+		}
+		sqe->user_data = (uint64_t)op;
+
+		sq_array[index] = index;
+		__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+		in_flight++;
+	}
+
+	if (queue_head == queue.size()) {
+		queue.clear();
+		queue_head = 0;
+	}
+
+	uint32_t to_submit = *sq_tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+	while (to_submit > 0) {
+		int ret = syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, 0, nullptr, 0);
+		if (ret < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			// Left in the ring, they're submitted along with the next operations.
+			ERR_FAIL_COND_MSG(errno != EAGAIN && errno != EBUSY, "io_uring submission failed with error " + itos(errno) + ".");
+			return;
+		}
+		if (ret == 0) {
+			return;
+		}
+		to_submit -= MIN((uint32_t)ret, to_submit);
+	}
+}
+
+void AsyncFileReaderIOUring::_operation_finished(Operation *p_operation, int32_t p_result, LocalVector<BatchState *> &r_finished_requests) {
+	if (p_result == -EINTR || p_result == -EAGAIN) {
+		queue.push_back(p_operation);
+		return;
+	}
+
+	BatchState *state = p_operation->state;
+	Request &request = state->batch->requests[p_operation->request];
+
+	if (p_operation->type == OPERATION_READ) {
+		if (p_result < 0) {
+			request.error = ERR_FILE_CANT_READ;
+		} else {
+			p_operation->done += p_result;
+			request.bytes_read += p_result;
+			if (p_result > 0 && p_operation->done < p_operation->length) {
+				// Short read, ask for the rest.
+				queue.push_back(p_operation);
+				return;
+			}
+		}
+	} else if (p_operation->type == OPERATION_PREFETCH && p_result >= 0) {
+		// Prefetching is only a hint, failing to do it isn't an error.
+		request.bytes_read += p_operation->length;
+	}
+
+	if (--state->pending_operations[p_operation->request] > 0) {
+		return;
+	}
+	r_finished_requests.push_back(state);
+
+	if (--state->pending_requests == 0) {
+		for (int fd : state->fds) {
+			close(fd);
+		}
+		state->fds.clear();
+	}
+}
+
+void AsyncFileReaderIOUring::_completion_thread_func(void *p_userdata) {
+	AsyncFileReaderIOUring *reader = (AsyncFileReaderIOUring *)p_userdata;
+	LocalVector<BatchState *> finished_requests;
+
+	while (true) {
+		int ret = syscall(__NR_io_uring_enter, reader->ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+		if (ret < 0 && errno != EINTR) {
+			ERR_PRINT("Waiting for io_uring completions failed with error " + itos(errno) + ".");
+		}
+
+		bool done = false;
+		{
+			MutexLock lock(reader->ring_mutex);
+
+			uint32_t head = *reader->cq_head;
+			uint32_t tail = __atomic_load_n(reader->cq_tail, __ATOMIC_ACQUIRE);
+			while (head != tail) {
+				io_uring_cqe *cqe = &reader->cqes[head & *reader->cq_mask];
+				head++;
+				reader->in_flight--;
+
+				Operation *op = (Operation *)cqe->user_data;
+				if (op != nullptr) {
+					reader->_operation_finished(op, cqe->res, finished_requests);
+				}
+			}
+			__atomic_store_n(reader->cq_head, head, __ATOMIC_RELEASE);
+
+			reader->_flush_queue();
+			done = reader->exiting && reader->in_flight == 0 && reader->queue.is_empty();
+		}
+
+		// Outside of the lock, completion callbacks may submit new batches.
+		for (BatchState *state : finished_requests) {
+			reader->request_completed(state->batch);
+			if (--state->unreported_requests == 0) {
+				memdelete(state);
+			}
+		}
+		finished_requests.clear();
+
+		if (done) {
+			break;
+		}
+	}
+}
+
+bool AsyncFileReaderIOUring::can_prefetch_without_reading(const String &p_path) const {
+	if (ring_fd < 0) {
+		return false;
+	}
+	// Requests that can't be resolved to a plain file are read by the thread pool.
+	Request request;
+	request.path = p_path;
+	Location location;
+	return resolve_request(request, location);
+}
+
+void AsyncFileReaderIOUring::_submit(Batch *p_batch) {
+	if (ring_fd < 0) {
+		AsyncFileReader::_submit(p_batch);
+		return;
+	}
+
+	LocalVector<Location> locations;
+	locations.resize(p_batch->count);
+	for (uint32_t i = 0; i < p_batch->count; i++) {
+		if (!resolve_request(p_batch->requests[i], locations[i])) {
+			AsyncFileReader::_submit(p_batch);
+			return;
+		}
+	}
+
+	BatchState *state = memnew(BatchState);
+	state->batch = p_batch;
+	state->pending_operations.resize(p_batch->count);
+	state->pending_requests = p_batch->count;
+	state->unreported_requests = p_batch->count;
+
+	// Open every file first and count the operations, so `operations` is never reallocated
+	// once pointers to it have been handed to the kernel.
+	HashMap<String, int> opened;
+	LocalVector<int> request_fds;
+	request_fds.resize(p_batch->count);
+	uint32_t operation_count = 0;
+
+	for (uint32_t i = 0; i < p_batch->count; i++) {
+		Location &location = locations[i];
+
+		int fd = -1;
+		HashMap<String, int>::Iterator E = opened.find(location.os_path);
+		if (E) {
+			fd = E->value;
+		} else {
+			fd = open(location.os_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+			if (fd >= 0) {
+				opened.insert(location.os_path, fd);
+				state->fds.push_back(fd);
+			}
+		}
+
+		if (fd < 0) {
+			p_batch->requests[i].error = errno == ENOENT ? ERR_FILE_NOT_FOUND : ERR_FILE_CANT_OPEN;
+			location.length = 0;
+		} else {
+			// No need to queue anything past the end of the file.
+			struct stat st;
+			if (fstat(fd, &st) == 0) {
+				uint64_t file_size = st.st_size;
+				location.length = location.offset < file_size ? MIN(location.length, file_size - location.offset) : 0;
+			}
+		}
+
+		request_fds[i] = fd;
+		uint32_t chunks = MAX((uint64_t)1, (location.length + CHUNK_SIZE - 1) / CHUNK_SIZE);
+		state->pending_operations[i] = chunks;
+		operation_count += chunks;
+	}
+
+	state->operations.resize(operation_count);
+	uint32_t op_index = 0;
+	for (uint32_t i = 0; i < p_batch->count; i++) {
+		const Request &request = p_batch->requests[i];
+		const Location &location = locations[i];
+
+		if (location.length == 0) {
+			Operation &op = state->operations[op_index++];
+			op.state = state;
+			op.request = i;
+			op.type = OPERATION_NONE;
+			continue;
+		}
+
+		for (uint64_t from = 0; from < location.length; from += CHUNK_SIZE) {
+			Operation &op = state->operations[op_index++];
+			op.state = state;
+			op.request = i;
+			op.type = request.buffer ? OPERATION_READ : OPERATION_PREFETCH;
+			op.fd = request_fds[i];
+			op.offset = location.offset + from;
+			op.length = MIN((uint64_t)CHUNK_SIZE, location.length - from);
+			op.buffer = request.buffer ? request.buffer + from : nullptr;
+		}
+	}
+
+	MutexLock lock(ring_mutex);
+	for (Operation &op : state->operations) {
+		queue.push_back(&op);
+	}
+	_flush_queue();
+}
+
+AsyncFileReaderIOUring::AsyncFileReaderIOUring() {
+	if (_setup_ring()) {
+		completion_thread.start(&AsyncFileReaderIOUring::_completion_thread_func, this);
+	}
+}
+
+AsyncFileReaderIOUring::~AsyncFileReaderIOUring() {
+	if (ring_fd < 0) {
+		return;
+	}
+
+	{
+		MutexLock lock(ring_mutex);
+		exiting = true;
+		queue.push_back(nullptr);
+		_flush_queue();
+	}
+	completion_thread.wait_to_finish();
+	_close_ring();
+}
+
+#endif // IO_URING_ENABLED
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  async_file_reader_io_uring.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ASYNC_FILE_READER_IO_URING_H
+#define ASYNC_FILE_READER_IO_URING_H
+
+#if defined(__linux__) && defined(THREADS_ENABLED) && __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+// When libc doesn't define the system calls, their numbers are only known for these architectures.
+#if defined(__NR_io_uring_setup) || (defined(__x86_64__) && !defined(__ILP32__)) || defined(__i386__) || defined(__aarch64__) || defined(__ARM_EABI__) || defined(__riscv) || defined(__powerpc__) || defined(__s390__) || defined(__loongarch__)
+#define IO_URING_ENABLED
+#endif
+#endif
+
+#ifdef IO_URING_ENABLED
+
+#include "core/io/async_file_reader.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// Hands reads to the kernel through an io_uring, talking to it with raw system calls.
+// Falls back to the thread pool when the kernel doesn't provide one, and for requests
+// that can't be mapped to a plain file (such as encrypted pack entries).
+class AsyncFileReaderIOUring : public AsyncFileReader {
+	enum {
+		QUEUE_DEPTH = 256,
+		CHUNK_SIZE = 1024 * 1024, // Large reads are split so they can be serviced in parallel.
+	};
+
+	enum OperationType {
+		OPERATION_READ,
+		OPERATION_PREFETCH,
+		OPERATION_NONE, // Completes a request that has nothing to read.
+	};
+
+	struct BatchState;
+
+	struct Operation {
+		BatchState *state = nullptr;
+		uint32_t request = 0;
+		OperationType type = OPERATION_NONE;
+		int fd = -1;
+		uint64_t offset = 0;
+		uint32_t length = 0;
+		uint32_t done = 0;
+		uint8_t *buffer = nullptr;
+	};
+
+	struct BatchState {
+		Batch *batch = nullptr;
+		LocalVector<int> fds;
+		LocalVector<Operation> operations;
+		LocalVector<uint32_t> pending_operations; // Per request.
+		uint32_t pending_requests = 0;
+		uint32_t unreported_requests = 0; // Only used by the completion thread.
+	};
+
+	int ring_fd = -1;
+	uint8_t *sq_ring = nullptr;
+	uint8_t *cq_ring = nullptr;
+	size_t sq_ring_size = 0;
+	size_t cq_ring_size = 0;
+	io_uring_sqe *sqes = nullptr;
+	io_uring_cqe *cqes = nullptr;
+	uint32_t sq_entries = 0;
+	uint32_t *sq_head = nullptr;
+	uint32_t *sq_tail = nullptr;
+	uint32_t *sq_mask = nullptr;
+	uint32_t *sq_array = nullptr;
+	uint32_t *cq_head = nullptr;
+	uint32_t *cq_tail = nullptr;
+	uint32_t *cq_mask = nullptr;
+
+	// Everything below is protected by `ring_mutex`.
+	Mutex ring_mutex;
+	LocalVector<Operation *> queue; // Waiting for room in the ring.
+	uint32_t queue_head = 0;
+	uint32_t in_flight = 0;
+	bool exiting = false;
+
+	Thread completion_thread;
+
+	bool _setup_ring();
+	void _close_ring();
+	void _flush_queue();
+	void _operation_finished(Operation *p_operation, int32_t p_result, LocalVector<BatchState *> &r_finished_requests);
+	static void _completion_thread_func(void *p_userdata);
+
+protected:
+	virtual void _submit(Batch *p_batch) override;
+
+public:
+	virtual bool can_prefetch_without_reading(const String &p_path) const override;
+
+	AsyncFileReaderIOUring();
+	~AsyncFileReaderIOUring();
+};
+
+#endif // IO_URING_ENABLED
+
+#endif // ASYNC_FILE_READER_IO_URING_H
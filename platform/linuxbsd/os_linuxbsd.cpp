@@ -30,6 +30,7 @@
 
 #include "os_linuxbsd.h"
 
+#include "async_file_reader_io_uring.h"
 #include "core/io/certs_compressed.gen.h"
 #include "core/io/dir_access.h"
 #include "main/main.h"
@@ -137,6 +138,10 @@ void OS_LinuxBSD::initialize() {
 
 	OS_Unix::initialize_core();
 
+#ifdef IO_URING_ENABLED
+	AsyncFileReader::make_default<AsyncFileReaderIOUring>();
+#endif
+
 	system_dir_desktop_cache = get_system_dir(SYSTEM_DIR_DESKTOP);
 }
 
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/profile_zones.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
 #include "core/io/image_loader.h"
@@ -974,6 +975,8 @@ void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
 }
 
 void SceneTree::_process(bool p_physics) {
+	GODOT_PROFILE_ZONE(p_physics ? "SceneTree::_process (physics)" : "SceneTree::_process");
+
 	if (process_groups_dirty) {
 		{
 			// First, remove dirty groups.
@@ -326,18 +326,16 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 				continue;
 			}
 
+			// Decoded in place when the file is mapped.
 			Vector<uint8_t> pv;
-			pv.resize(size);
-			{
-				uint8_t *wr = pv.ptrw();
-				f->get_buffer(wr, size);
-			}
+			const uint8_t *r = f->get_buffer_view(size, pv);
+			ERR_FAIL_NULL_V(r, Ref<Image>());
 
 			Ref<Image> img;
-			if (data_format == DATA_FORMAT_PNG && Image::png_unpacker) {
-				img = Image::png_unpacker(pv);
-			} else if (data_format == DATA_FORMAT_WEBP && Image::webp_unpacker) {
-				img = Image::webp_unpacker(pv);
+			if (data_format == DATA_FORMAT_PNG && Image::_png_mem_unpacker_func) {
+				img = Image::_png_mem_unpacker_func(r, size);
+			} else if (data_format == DATA_FORMAT_WEBP && Image::_webp_mem_loader_func) {
+				img = Image::_webp_mem_loader_func(r, size);
 			}
 
 			if (img.is_null() || img->is_empty()) {
@@ -405,13 +403,12 @@ Ref<Image> CompressedTexture2D::load_image_from_file(Ref<FileAccess> f, int p_si
 			return Ref<Image>();
 		}
 		Vector<uint8_t> pv;
-		pv.resize(size);
-		{
-			uint8_t *wr = pv.ptrw();
-			f->get_buffer(wr, size);
-		}
+		const uint8_t *r = f->get_buffer_view(size, pv);
+		ERR_FAIL_NULL_V(r, Ref<Image>());
 		Ref<Image> img;
-		img = Image::basis_universal_unpacker(pv);
+		if (Image::basis_universal_unpacker_ptr) {
+			img = Image::basis_universal_unpacker_ptr(r, size);
+		}
 		if (img.is_null() || img->is_empty()) {
 			ERR_FAIL_COND_V(img.is_null() || img->is_empty(), Ref<Image>());
 		}
@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/profile_zones.h"
 #include "core/error/error_macros.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_loader.h"
@@ -335,6 +336,8 @@ void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
 }
 
 void AudioServer::_mix_step() {
+	GODOT_PROFILE_ZONE("AudioServer::_mix_step");
+
 	bool solo_mode = false;
 
 	for (int i = 0; i < buses.size(); i++) {
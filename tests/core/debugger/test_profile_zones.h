@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  test_profile_zones.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PROFILE_ZONES_H
+#define TEST_PROFILE_ZONES_H
+
+#include "core/debugger/profile_zones.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestProfileZones {
+
+static void nested_zones() {
+	GODOT_PROFILE_ZONE("outer");
+	{
+		GODOT_PROFILE_ZONE("inner");
+		OS::get_singleton()->delay_usec(100);
+	}
+}
+
+static void thread_zone(void *p_userdata) {
+	GODOT_PROFILE_ZONE("thread");
+}
+
+TEST_CASE("[ProfileZones] Chrome trace export") {
+	{
+		GODOT_PROFILE_ZONE("not captured");
+	}
+
+	ProfileZones::start_capture();
+	nested_zones();
+	Thread thread;
+	thread.start(thread_zone, nullptr);
+	thread.wait_to_finish();
+	ProfileZones::stop_capture();
+
+	{
+		GODOT_PROFILE_ZONE("after capture");
+	}
+
+	const String trace_path = TestUtils::get_temp_path("profile_trace.json");
+	CHECK(ProfileZones::save_chrome_trace(trace_path) == OK);
+	ProfileZones::free_buffers();
+
+	Variant trace = JSON::parse_string(FileAccess::get_file_as_string(trace_path));
+	REQUIRE(trace.get_type() == Variant::DICTIONARY);
+	Array events = Dictionary(trace)["traceEvents"];
+
+	Dictionary outer;
+	Dictionary inner;
+	int thread_names = 0;
+	bool thread_zone_found = false;
+	for (int i = 0; i < events.size(); i++) {
+		Dictionary event = events[i];
+		if (event["ph"] == "M") {
+			thread_names++;
+		} else if (event["name"] == "outer") {
+			outer = event;
+		} else if (event["name"] == "inner") {
+			inner = event;
+		} else if (event["name"] == "thread") {
+			thread_zone_found = true;
+		} else {
+			FAIL("Unexpected event: ", String(event["name"]));
+		}
+	}
+
+	CHECK(thread_names == 2);
+	CHECK(thread_zone_found);
+	REQUIRE(!outer.is_empty());
+	REQUIRE(!inner.is_empty());
+	CHECK(outer["tid"] == inner["tid"]);
+	CHECK(double(inner["dur"]) >= 100.0);
+	CHECK(double(inner["ts"]) >= double(outer["ts"]));
+	CHECK(double(inner["ts"]) + double(inner["dur"]) <= double(outer["ts"]) + double(outer["dur"]));
+}
+
+TEST_CASE("[ProfileZones] Ring buffer keeps the latest events") {
+	ProfileZones::start_capture();
+	for (uint32_t i = 0; i < ProfileZones::EVENT_BUFFER_SIZE + 10; i++) {
+		GODOT_PROFILE_ZONE(i < 10 ? "old" : "new");
+	}
+	ProfileZones::stop_capture();
+
+	const String trace_path = TestUtils::get_temp_path("profile_trace_ring.json");
+	CHECK(ProfileZones::save_chrome_trace(trace_path) == OK);
+	ProfileZones::free_buffers();
+
+	const String trace = FileAccess::get_file_as_string(trace_path);
+	CHECK(trace.find("\"old\"") == -1);
+	CHECK(trace.count("\"new\"") == int(ProfileZones::EVENT_BUFFER_SIZE - 1));
+}
+
+static void record_zones(void *p_userdata) {
+	const SafeFlag *exit = (const SafeFlag *)p_userdata;
+	while (!exit->is_set()) {
+		GODOT_PROFILE_ZONE("racing");
+	}
+}
+
+TEST_CASE("[ProfileZones] Capturing and saving while other threads record") {
+	SafeFlag exit;
+	Thread threads[4];
+	for (Thread &thread : threads) {
+		thread.start(record_zones, &exit);
+	}
+
+	const String trace_path = TestUtils::get_temp_path("profile_trace_racing.json");
+	bool all_saved = true;
+	for (int i = 0; i < 50; i++) {
+		ProfileZones::start_capture();
+		OS::get_singleton()->delay_usec(50);
+		ProfileZones::stop_capture();
+		all_saved = all_saved && ProfileZones::save_chrome_trace(trace_path) == OK;
+		all_saved = all_saved && JSON::parse_string(FileAccess::get_file_as_string(trace_path)).get_type() == Variant::DICTIONARY;
+	}
+	CHECK(all_saved);
+
+	exit.set();
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+	CHECK_FALSE(ProfileZones::is_capturing());
+	ProfileZones::free_buffers();
+}
+
+} // namespace TestProfileZones
+
+#endif // TEST_PROFILE_ZONES_H
@@ -0,0 +1,358 @@
+/**************************************************************************/
+/*  test_async_file_reader.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ASYNC_FILE_READER_H
+#define TEST_ASYNC_FILE_READER_H
+
+#include "core/io/async_file_reader.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+#ifdef LINUXBSD_ENABLED
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace TestAsyncFileReader {
+
+static Vector<uint8_t> make_contents(int p_size) {
+	Vector<uint8_t> contents;
+	contents.resize(p_size);
+	uint8_t *ptr = contents.ptrw();
+	for (int i = 0; i < p_size; i++) {
+		ptr[i] = (i * 7 + (i >> 11)) & 0xFF;
+	}
+	return contents;
+}
+
+static String write_temp_file(const String &p_name, const Vector<uint8_t> &p_contents) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	if (f.is_valid()) {
+		f->store_buffer(p_contents);
+	}
+	return path;
+}
+
+TEST_CASE("[AsyncFileReader] Read ranges of a file") {
+	// Large enough for reads to be split in several operations.
+	const Vector<uint8_t> contents = make_contents(3 * 1024 * 1024 + 123);
+	const String path = write_temp_file("async_file_reader_ranges.bin", contents);
+
+	Vector<uint8_t> buffers[4];
+	AsyncFileReader::Request requests[4];
+
+	requests[0].path = path;
+	requests[0].offset = 10;
+	requests[0].length = 100;
+
+	requests[1].path = path;
+	requests[1].offset = 1024 * 1024 - 10;
+	requests[1].length = 2 * 1024 * 1024 + 20;
+
+	requests[2].path = path;
+	requests[2].offset = contents.size() - 50;
+	requests[2].length = 100;
+
+	requests[3].path = TestUtils::get_temp_path("async_file_reader_missing.bin");
+	requests[3].length = 100;
+
+	for (int i = 0; i < 4; i++) {
+		buffers[i].resize(requests[i].length);
+		requests[i].buffer = buffers[i].ptrw();
+	}
+
+	AsyncFileReader::BatchID batch = AsyncFileReader::get_singleton()->add_read_batch(requests, 4);
+	REQUIRE(batch != AsyncFileReader::INVALID_BATCH_ID);
+	ERR_PRINT_OFF;
+	Error err = AsyncFileReader::get_singleton()->wait_for_read_batch_completion(batch);
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(err == ERR_FILE_NOT_FOUND, "The error of the request for a missing file should be reported.");
+
+	CHECK(requests[0].error == OK);
+	CHECK(requests[0].bytes_read == 100);
+	CHECK(memcmp(buffers[0].ptr(), contents.ptr() + 10, 100) == 0);
+
+	CHECK(requests[1].error == OK);
+	CHECK(requests[1].bytes_read == requests[1].length);
+	CHECK(memcmp(buffers[1].ptr(), contents.ptr() + requests[1].offset, requests[1].length) == 0);
+
+	CHECK_MESSAGE(requests[2].error == OK, "Reading past the end of the file isn't an error.");
+	CHECK(requests[2].bytes_read == 50);
+	CHECK(memcmp(buffers[2].ptr(), contents.ptr() + contents.size() - 50, 50) == 0);
+
+	CHECK(requests[3].error == ERR_FILE_NOT_FOUND);
+	CHECK(requests[3].bytes_read == 0);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(
+			AsyncFileReader::get_singleton()->wait_for_read_batch_completion(batch) == ERR_INVALID_PARAMETER,
+			"A batch can only be waited for once.");
+	ERR_PRINT_ON;
+
+	DirAccess::remove_absolute(path);
+}
+
+struct CallbackData {
+	AsyncFileReader::BatchID batch = AsyncFileReader::INVALID_BATCH_ID;
+	uint64_t bytes_read = 0;
+	Semaphore done;
+};
+
+static void completion_callback(void *p_userdata, AsyncFileReader::BatchID p_batch) {
+	CallbackData *data = (CallbackData *)p_userdata;
+	data->batch = p_batch;
+	data->done.post();
+}
+
+TEST_CASE("[AsyncFileReader] Completion callback and prefetching") {
+	const Vector<uint8_t> contents = make_contents(100000);
+	const String path = write_temp_file("async_file_reader_callback.bin", contents);
+
+	AsyncFileReader::Request requests[2];
+	requests[0].path = path;
+	requests[0].offset = 1000; // No buffer and no length: prefetch up to the end.
+	requests[1].path = path;
+	requests[1].offset = 5000;
+	requests[1].length = 20000;
+
+	CallbackData data;
+	AsyncFileReader::BatchID batch = AsyncFileReader::get_singleton()->add_read_batch(requests, 2, &completion_callback, &data);
+	REQUIRE(batch != AsyncFileReader::INVALID_BATCH_ID);
+	data.done.wait();
+
+	CHECK(data.batch == batch);
+	CHECK(AsyncFileReader::get_singleton()->is_read_batch_completed(batch));
+	CHECK(requests[0].error == OK);
+	CHECK(requests[0].bytes_read == 99000);
+	CHECK(requests[1].error == OK);
+	CHECK(requests[1].bytes_read == 20000);
+
+	DirAccess::remove_absolute(path);
+}
+
+struct WaitingCallbackData {
+	AsyncFileReader::BatchID other_batch = AsyncFileReader::INVALID_BATCH_ID;
+	Error wait_error = OK;
+	Semaphore done;
+};
+
+static void waiting_callback(void *p_userdata, AsyncFileReader::BatchID p_batch) {
+	WaitingCallbackData *data = (WaitingCallbackData *)p_userdata;
+	data->wait_error = AsyncFileReader::get_singleton()->wait_for_read_batch_completion(data->other_batch);
+	data->done.post();
+}
+
+TEST_CASE("[AsyncFileReader] Completion callbacks can't wait for batches") {
+	const Vector<uint8_t> contents = make_contents(10000);
+	const String path = write_temp_file("async_file_reader_waiting_callback.bin", contents);
+
+	Vector<uint8_t> buffers[2];
+	AsyncFileReader::Request requests[2];
+	for (int i = 0; i < 2; i++) {
+		buffers[i].resize(contents.size());
+		requests[i].path = path;
+		requests[i].length = contents.size();
+		requests[i].buffer = buffers[i].ptrw();
+	}
+
+	WaitingCallbackData data;
+	data.other_batch = AsyncFileReader::get_singleton()->add_read_batch(&requests[0], 1);
+	REQUIRE(data.other_batch != AsyncFileReader::INVALID_BATCH_ID);
+
+	ERR_PRINT_OFF;
+	REQUIRE(AsyncFileReader::get_singleton()->add_read_batch(&requests[1], 1, &waiting_callback, &data) != AsyncFileReader::INVALID_BATCH_ID);
+	data.done.wait();
+	ERR_PRINT_ON;
+	CHECK(data.wait_error == ERR_BUSY);
+
+	// Still waitable from anywhere else.
+	CHECK(AsyncFileReader::get_singleton()->wait_for_read_batch_completion(data.other_batch) == OK);
+	CHECK(buffers[0] == contents);
+	CHECK(buffers[1] == contents);
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[AsyncFileReader] Read files from a loaded PCK") {
+	const Vector<uint8_t> contents = make_contents(50000);
+	const String source_path = write_temp_file("async_file_reader_source.bin", contents);
+
+	PCKPacker pck_packer;
+	const String pck_path = TestUtils::get_temp_path("async_file_reader.pck");
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://async_file_reader_test/first.bin", source_path) == OK);
+	REQUIRE(pck_packer.add_file("res://async_file_reader_test/second.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+	Vector<uint8_t> buffers[2];
+	AsyncFileReader::Request requests[2];
+	requests[0].path = "res://async_file_reader_test/first.bin";
+	requests[0].length = contents.size();
+	requests[1].path = "res://async_file_reader_test/second.bin";
+	requests[1].offset = 40000;
+	requests[1].length = 20000; // Must stop at the end of the file, not of the pack.
+	for (int i = 0; i < 2; i++) {
+		buffers[i].resize(requests[i].length);
+		requests[i].buffer = buffers[i].ptrw();
+	}
+
+	AsyncFileReader::BatchID batch = AsyncFileReader::get_singleton()->add_read_batch(requests, 2);
+	CHECK(AsyncFileReader::get_singleton()->wait_for_read_batch_completion(batch) == OK);
+
+	CHECK(requests[0].bytes_read == (uint64_t)contents.size());
+	CHECK(buffers[0] == contents);
+	CHECK(requests[1].bytes_read == 10000);
+	CHECK(memcmp(buffers[1].ptr(), contents.ptr() + 40000, 10000) == 0);
+
+	PackedData::get_singleton()->remove_pack(pck_path);
+}
+
+// Drops the file from the OS cache, returns false if that isn't possible on this platform.
+static bool evict_from_os_cache(const String &p_path) {
+#ifdef LINUXBSD_ENABLED
+	int fd = open(p_path.utf8().get_data(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	// Dirty pages can't be dropped.
+	fdatasync(fd);
+	bool evicted = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+	close(fd);
+	return evicted;
+#else
+	return false;
+#endif
+}
+
+TEST_CASE_PENDING("[AsyncFileReader][Benchmark] Load a 2 GB PCK cold and warm") {
+	const int entry_size = 8 * 1024 * 1024;
+	const int entry_count = 256;
+	const int window = 16; // Entries per batch, two batches are in flight at once.
+
+	const String source_path = write_temp_file("async_file_reader_benchmark_source.bin", make_contents(entry_size));
+
+	PCKPacker pck_packer;
+	const String pck_path = TestUtils::get_temp_path("async_file_reader_benchmark.pck");
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	for (int i = 0; i < entry_count; i++) {
+		REQUIRE(pck_packer.add_file(vformat("res://async_file_reader_benchmark/%d.bin", i), source_path) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+	// Both methods read the same ranges straight from the pack file.
+	LocalVector<uint64_t> offsets;
+	for (int i = 0; i < entry_count; i++) {
+		String pack;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+		REQUIRE(PackedData::get_singleton()->get_file_location(vformat("res://async_file_reader_benchmark/%d.bin", i), pack, offset, size));
+		REQUIRE(size == entry_size);
+		offsets.push_back(offset);
+	}
+
+	Vector<uint8_t> scratch;
+	scratch.resize(2 * window * entry_size);
+
+	auto read_sync = [&]() {
+		Ref<FileAccess> f = FileAccess::open(pck_path, FileAccess::READ);
+		uint64_t total = 0;
+		for (int i = 0; i < entry_count; i++) {
+			f->seek(offsets[i]);
+			total += f->get_buffer(scratch.ptrw(), entry_size);
+		}
+		return total;
+	};
+
+	auto read_async = [&]() {
+		AsyncFileReader::Request requests[2][window];
+		AsyncFileReader::BatchID batches[2] = { AsyncFileReader::INVALID_BATCH_ID, AsyncFileReader::INVALID_BATCH_ID };
+		uint64_t total = 0;
+		for (int start = 0, slot = 0; start < entry_count; start += window, slot = 1 - slot) {
+			if (batches[slot] != AsyncFileReader::INVALID_BATCH_ID) {
+				AsyncFileReader::get_singleton()->wait_for_read_batch_completion(batches[slot]);
+				for (const AsyncFileReader::Request &request : requests[slot]) {
+					total += request.bytes_read;
+				}
+			}
+			for (int i = 0; i < window; i++) {
+				AsyncFileReader::Request &request = requests[slot][i];
+				request.path = pck_path;
+				request.offset = offsets[start + i];
+				request.length = entry_size;
+				request.buffer = scratch.ptrw() + (slot * window + i) * (uint64_t)entry_size;
+			}
+			batches[slot] = AsyncFileReader::get_singleton()->add_read_batch(requests[slot], window);
+		}
+		for (int slot = 0; slot < 2; slot++) {
+			AsyncFileReader::get_singleton()->wait_for_read_batch_completion(batches[slot]);
+			for (const AsyncFileReader::Request &request : requests[slot]) {
+				total += request.bytes_read;
+			}
+		}
+		return total;
+	};
+
+	const uint64_t expected = (uint64_t)entry_size * entry_count;
+	const bool can_evict = evict_from_os_cache(pck_path);
+	if (!can_evict) {
+		MESSAGE("The OS cache can't be dropped on this platform, cold reads are measured warm.");
+	}
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool async = pass == 1;
+		for (int cold = 1; cold >= 0; cold--) {
+			if (cold) {
+				evict_from_os_cache(pck_path);
+			}
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			const uint64_t total = async ? read_async() : read_sync();
+			const uint64_t elapsed = MAX(OS::get_singleton()->get_ticks_usec() - begin, (uint64_t)1);
+			CHECK(total == expected);
+			MESSAGE(vformat("%s, %s: %.1f MB/s", async ? "AsyncFileReader batches" : "Synchronous FileAccess", cold ? "cold" : "warm", (double)total / elapsed));
+		}
+	}
+
+	PackedData::get_singleton()->remove_pack(pck_path);
+	DirAccess::remove_absolute(pck_path);
+	DirAccess::remove_absolute(source_path);
+}
+} // namespace TestAsyncFileReader
+
+#endif // TEST_ASYNC_FILE_READER_H
@@ -107,6 +107,26 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+TEST_CASE("[FileAccess] Buffer view") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("line_endings_lf.test.txt"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+	const Vector<uint8_t> contents = f->get_buffer(f->get_length());
+
+	f->seek(6);
+	Vector<uint8_t> storage;
+	const uint8_t *view = f->get_buffer_view(8, storage);
+	REQUIRE(view != nullptr);
+	CHECK(String::utf8((const char *)view, 8) == "darkness");
+	CHECK(f->get_position() == 14);
+
+	f->seek(0);
+	view = f->get_buffer_view(contents.size(), storage);
+	REQUIRE(view != nullptr);
+	CHECK(memcmp(view, contents.ptr(), contents.size()) == 0);
+
+	f->seek(contents.size() - 4);
+	CHECK_MESSAGE(f->get_buffer_view(8, storage) == nullptr, "A view past the end of the file should fail.");
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -31,6 +31,7 @@
 #ifndef TEST_PCK_PACKER_H
 #define TEST_PCK_PACKER_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
@@ -62,6 +63,10 @@ TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	CHECK_MESSAGE(
 			f->get_length() <= 500,
 			"The generated empty PCK file shouldn't be too large.");
+	CHECK(f->get_32() == PACK_HEADER_MAGIC);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION,
+			"PCK files without compressed entries should stay readable by older versions.");
 }
 
 TEST_CASE("[PCKPacker] Pack empty with zero alignment invalid") {
@@ -117,6 +122,152 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Read files in place from a loaded PCK") {
+	Vector<uint8_t> contents;
+	contents.resize(3000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = i * 7;
+	}
+	const String source_path = TestUtils::get_temp_path("pck_source.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_in_place.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/in_place.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	Ref<FileAccess> f = FileAccess::open("res://pck_packer_test/in_place.bin", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == 3000);
+
+	f->seek(1000);
+	Vector<uint8_t> storage;
+	const uint8_t *view = f->get_buffer_view(1500, storage);
+	REQUIRE(view != nullptr);
+	CHECK(memcmp(view, contents.ptr() + 1000, 1500) == 0);
+	CHECK(f->get_position() == 2500);
+	CHECK(f->get_8() == contents[2500]);
+
+	f->seek(0);
+	CHECK(f->get_buffer(3000) == contents);
+	CHECK(f->eof_reached() == false);
+	CHECK(f->get_buffer(1).is_empty());
+	CHECK(f->eof_reached());
+
+#ifdef UNIX_ENABLED
+	uint64_t length = 0;
+	CHECK_MESSAGE(
+			f->get_mapped_buffer(length) == view - 1000,
+			"Files stored uncompressed should be read from the mapped PCK.");
+	CHECK(length == 3000);
+#endif
+
+	// Replaced by a pack with other contents, then added again.
+	Vector<uint8_t> new_contents = contents.slice(1000);
+	{
+		Ref<FileAccess> source = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(source.is_valid());
+		source->store_buffer(new_contents);
+	}
+	const String new_pck_path = TestUtils::get_temp_path("output_in_place_new.pck");
+	REQUIRE(pck_packer.pck_start(new_pck_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/in_place.bin", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(DirAccess::rename_absolute(new_pck_path, output_pck_path) == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes("res://pck_packer_test/in_place.bin") == new_contents,
+			"Files opened after the pack is added again should be read from the new pack.");
+	f->seek(0);
+	CHECK_MESSAGE(
+			f->get_buffer(3000) == contents,
+			"Files opened before should keep reading from the pack they were opened from.");
+
+	PackedData::get_singleton()->remove_pack(output_pck_path);
+	CHECK_FALSE(FileAccess::exists("res://pck_packer_test/in_place.bin"));
+	CHECK_FALSE(PackedData::get_singleton()->has_directory("res://pck_packer_test"));
+}
+
+TEST_CASE("[PCKPacker] Read block-compressed files from a loaded PCK") {
+	// Ten blocks and a bit, the second half of which is noise that can't be compressed.
+	const int size = PACK_COMPRESSED_BLOCK_SIZE * 10 + 1234;
+	Vector<uint8_t> contents;
+	contents.resize(size);
+	uint32_t noise = 12345;
+	for (int i = 0; i < size; i++) {
+		if (i < size / 2) {
+			contents.write[i] = (i / 64) % 17;
+		} else {
+			noise = noise * 1103515245 + 12345;
+			contents.write[i] = noise >> 24;
+		}
+	}
+	const String source_path = TestUtils::get_temp_path("pck_compressed_source.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	// The directory is encrypted too, as it's written after the entries, in room left for it.
+	REQUIRE(pck_packer.pck_start(output_pck_path, 32, "0000000000000000000000000000000000000000000000000000000000000000", true) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/compressed.bin", source_path, false, true) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_packer_test/compressed_encrypted.bin", source_path, true, true) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	{
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_32() == PACK_HEADER_MAGIC);
+		CHECK_MESSAGE(
+				f->get_32() == PACK_FORMAT_VERSION_COMPRESSED,
+				"PCK files with compressed entries should be marked as such, as older versions can't read them.");
+	}
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(output_pck_path).size() < size + size / 2,
+			"Both copies together should take less space than the source file and a half.");
+
+	for (const String &path : { String("res://pck_packer_test/compressed.bin"), String("res://pck_packer_test/compressed_encrypted.bin") }) {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == (uint64_t)size);
+
+		uint64_t length = 0;
+		CHECK_MESSAGE(
+				f->get_mapped_buffer(length) == nullptr,
+				"Compressed files can't be read in place.");
+
+		// Reads starting and ending inside blocks.
+		f->seek(PACK_COMPRESSED_BLOCK_SIZE * 3 - 10);
+		CHECK(f->get_8() == contents[PACK_COMPRESSED_BLOCK_SIZE * 3 - 10]);
+		Vector<uint8_t> part = f->get_buffer(PACK_COMPRESSED_BLOCK_SIZE * 5);
+		CHECK(part == contents.slice(PACK_COMPRESSED_BLOCK_SIZE * 3 - 9, PACK_COMPRESSED_BLOCK_SIZE * 8 - 9));
+		CHECK(f->get_position() == PACK_COMPRESSED_BLOCK_SIZE * 8 - 9);
+
+		f->seek(size - 100);
+		CHECK(f->get_buffer(100) == contents.slice(size - 100));
+		CHECK(f->eof_reached() == false);
+		CHECK(f->get_buffer(1).is_empty());
+		CHECK(f->eof_reached());
+
+		f->seek(0);
+		CHECK(f->get_buffer(size) == contents);
+		CHECK(f->get_position() == (uint64_t)size);
+	}
+
+	PackedData::get_singleton()->remove_pack(output_pck_path);
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
@@ -31,9 +31,11 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
@@ -42,6 +44,22 @@
 
 namespace TestResource {
 
+// Threaded loads are collected on another thread, as the main thread would sync the rendering server while waiting.
+struct ThreadedLoad {
+	String path;
+	bool use_sub_threads = true;
+	Error error = FAILED;
+	Ref<Resource> resource;
+};
+
+static void load_threaded(void *p_userdata) {
+	ThreadedLoad *load = (ThreadedLoad *)p_userdata;
+	load->error = ResourceLoader::load_threaded_request(load->path, "", load->use_sub_threads);
+	if (load->error == OK) {
+		load->resource = ResourceLoader::load_threaded_get(load->path, &load->error);
+	}
+}
+
 TEST_CASE("[Resource] Duplication") {
 	Ref<Resource> resource = memnew(Resource);
 	resource->set_name("Hello world");
@@ -166,6 +184,324 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+// Remembers how many of its kind existed when it got its value, to tell whether the loader
+// created every sub-resource before decoding any, as it only does when decoding in parallel.
+class _TestDecodeOrderResource : public Resource {
+	GDCLASS(_TestDecodeOrderResource, Resource);
+
+	int value = 0;
+	int instances_when_decoded = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestDecodeOrderResource::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestDecodeOrderResource::get_value);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+	}
+
+public:
+	static inline SafeNumeric<int> instance_count{ 0 };
+
+	void set_value(int p_value) {
+		value = p_value;
+		instances_when_decoded = instance_count.get();
+	}
+	int get_value() const { return value; }
+	int get_instances_when_decoded() const { return instances_when_decoded; }
+
+	_TestDecodeOrderResource() {
+		instance_count.increment();
+	}
+};
+
+TEST_CASE("[Resource] Loading binary sub-resources in parallel") {
+	GDREGISTER_CLASS(_TestDecodeOrderResource);
+
+	// Decoding in parallel is skipped when the pool has a single thread.
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	if (thread_count < 2) {
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init(2);
+	}
+
+	// Every child refers to a shared leaf and to the previous child, so they can only
+	// be decoded in order of dependencies.
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Main");
+	Ref<_TestDecodeOrderResource> leaf = memnew(_TestDecodeOrderResource);
+	leaf->set_name("Leaf");
+	leaf->set_value(1);
+	Array children;
+	for (int i = 0; i < 32; i++) {
+		Ref<_TestDecodeOrderResource> child = memnew(_TestDecodeOrderResource);
+		child->set_name(vformat("Child %d", i));
+		child->set_value(i + 2);
+		child->set_meta("leaf", leaf);
+		if (i > 0) {
+			child->set_meta("previous", children[i - 1]);
+		}
+		children.push_back(child);
+	}
+	resource->set_meta("children", children);
+
+	const String save_path = TestUtils::get_temp_path("resource_parallel.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	_TestDecodeOrderResource::instance_count.set(0);
+	ThreadedLoad load;
+	load.path = save_path;
+	Thread thread;
+	thread.start(load_threaded, &load);
+	thread.wait_to_finish();
+	REQUIRE(load.error == OK);
+	const Ref<Resource> &loaded_resource = load.resource;
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Main");
+	CHECK(_TestDecodeOrderResource::instance_count.get() == 33);
+
+	Array loaded_children = loaded_resource->get_meta("children");
+	REQUIRE(loaded_children.size() == 32);
+	Ref<Resource> loaded_leaf = Ref<Resource>(loaded_children[0])->get_meta("leaf");
+	REQUIRE(loaded_leaf.is_valid());
+	CHECK(loaded_leaf->get_name() == "Leaf");
+
+	for (int i = 0; i < 32; i++) {
+		Ref<_TestDecodeOrderResource> child = loaded_children[i];
+		REQUIRE(child.is_valid());
+		CHECK(child->get_name() == vformat("Child %d", i));
+		CHECK(child->get_value() == i + 2);
+		CHECK_MESSAGE(
+				child->get_instances_when_decoded() == 33,
+				"Sub-resources should be decoded in parallel, once all of them are created.");
+		CHECK_MESSAGE(
+				Ref<Resource>(child->get_meta("leaf")) == loaded_leaf,
+				"Sub-resources referred to several times should be loaded once.");
+		if (i > 0) {
+			Ref<Resource> previous = child->get_meta("previous");
+			CHECK(previous == loaded_children[i - 1]);
+			CHECK_MESSAGE(
+					previous->get_name() == vformat("Child %d", i - 1),
+					"Sub-resources should be fully loaded before the ones referring to them.");
+		}
+	}
+
+	if (thread_count < 2) {
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init(thread_count);
+	}
+}
+
+// Connects to its shader like a material does, noting whether that happened while decoding.
+class _TestMaterialResource : public Resource {
+	GDCLASS(_TestMaterialResource, Resource);
+
+	Ref<Resource> shader;
+	bool within_load_when_set = false;
+	bool connected_when_set = false;
+	int shader_changes = 0;
+
+	void _shader_changed() {
+		shader_changes++;
+	}
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_shader", "shader"), &_TestMaterialResource::set_shader);
+		ClassDB::bind_method(D_METHOD("get_shader"), &_TestMaterialResource::get_shader);
+		ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "shader", PROPERTY_HINT_RESOURCE_TYPE, "Resource"), "set_shader", "get_shader");
+	}
+
+public:
+	void set_shader(const Ref<Resource> &p_shader) {
+		if (shader == p_shader) {
+			return;
+		}
+		if (shader.is_valid()) {
+			shader->disconnect_changed(callable_mp(this, &_TestMaterialResource::_shader_changed));
+		}
+		shader = p_shader;
+		within_load_when_set = ResourceLoader::is_within_load();
+		if (shader.is_valid()) {
+			shader->connect_changed(callable_mp(this, &_TestMaterialResource::_shader_changed));
+			connected_when_set = shader->is_connected(CoreStringName(changed), callable_mp(this, &_TestMaterialResource::_shader_changed));
+		}
+	}
+	Ref<Resource> get_shader() const { return shader; }
+	bool was_within_load_when_set() const { return within_load_when_set; }
+	bool was_connected_when_set() const { return connected_when_set; }
+	int get_shader_changes() const { return shader_changes; }
+};
+
+TEST_CASE("[Resource] Loading binary sub-resources sharing a dependency in parallel") {
+	GDREGISTER_CLASS(_TestMaterialResource);
+
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+	if (thread_count < 2) {
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init(2);
+	}
+
+	// Two materials sharing one shader are decoded by different tasks, which must not connect to it at once.
+	Ref<Resource> resource = memnew(Resource);
+	Ref<Resource> shader = memnew(Resource);
+	shader->set_name("Shader");
+	Array materials;
+	for (int i = 0; i < 2; i++) {
+		Ref<_TestMaterialResource> material = memnew(_TestMaterialResource);
+		material->set_shader(shader);
+		materials.push_back(material);
+	}
+	resource->set_meta("materials", materials);
+
+	const String save_path = TestUtils::get_temp_path("resource_shared_dependency.res");
+	REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+
+	ThreadedLoad load;
+	load.path = save_path;
+	Thread thread;
+	thread.start(load_threaded, &load);
+	thread.wait_to_finish();
+	REQUIRE(load.error == OK);
+	REQUIRE(load.resource.is_valid());
+
+	Array loaded_materials = load.resource->get_meta("materials");
+	REQUIRE(loaded_materials.size() == 2);
+	Ref<Resource> loaded_shader = Ref<_TestMaterialResource>(loaded_materials[0])->get_shader();
+	REQUIRE(loaded_shader.is_valid());
+	CHECK(loaded_shader->get_name() == "Shader");
+
+	List<Object::Connection> connections;
+	loaded_shader->get_signal_connection_list(CoreStringName(changed), &connections);
+	CHECK(connections.size() == 2);
+
+	loaded_shader->emit_changed();
+	for (int i = 0; i < 2; i++) {
+		Ref<_TestMaterialResource> material = loaded_materials[i];
+		REQUIRE(material.is_valid());
+		CHECK(material->get_shader() == loaded_shader);
+		CHECK_MESSAGE(
+				material->was_within_load_when_set(),
+				"Sub-resources decoded in parallel should be set up as part of the load.");
+		CHECK_MESSAGE(
+				!material->was_connected_when_set(),
+				"Connections to shared sub-resources should be deferred while decoding in parallel.");
+		CHECK(material->get_shader_changes() == 1);
+	}
+
+	if (thread_count < 2) {
+		WorkerThreadPool::get_singleton()->finish();
+		WorkerThreadPool::get_singleton()->init(thread_count);
+	}
+}
+
+TEST_CASE("[Resource] Threaded loading with a prefetch manifest") {
+	const String path_a = TestUtils::get_temp_path("resource_prefetch_a.res");
+	const String path_b = TestUtils::get_temp_path("resource_prefetch_b.res");
+	const String path_c = TestUtils::get_temp_path("resource_prefetch_c.res");
+	const String path_unused = TestUtils::get_temp_path("resource_prefetch_unused.res");
+	{
+		Ref<Resource> resource_c = memnew(Resource);
+		resource_c->set_name("C");
+		REQUIRE(ResourceSaver::save(resource_c, path_c) == OK);
+		resource_c->set_path(path_c);
+
+		Ref<Resource> resource_b = memnew(Resource);
+		resource_b->set_name("B");
+		resource_b->set_meta("next", resource_c);
+		REQUIRE(ResourceSaver::save(resource_b, path_b) == OK);
+		resource_b->set_path(path_b);
+
+		Ref<Resource> resource_a = memnew(Resource);
+		resource_a->set_name("A");
+		resource_a->set_meta("next", resource_b);
+		REQUIRE(ResourceSaver::save(resource_a, path_a) == OK);
+
+		Ref<Resource> resource_unused = memnew(Resource);
+		REQUIRE(ResourceSaver::save(resource_unused, path_unused) == OK);
+	}
+
+	// The unused entry stands for a manifest that got out of date.
+	HashMap<String, Vector<String>> manifest;
+	manifest.insert(path_a, { path_b, path_unused, path_c });
+	manifest.insert(path_b, { path_c });
+	const String manifest_path = TestUtils::get_temp_path("prefetch_manifest.bin");
+	REQUIRE(ResourceLoader::save_prefetch_manifest(manifest_path, manifest) == OK);
+	ResourceLoader::load_prefetch_manifest(manifest_path);
+
+	for (bool use_sub_threads : { true, false }) {
+		ThreadedLoad load;
+		load.path = path_a;
+		load.use_sub_threads = use_sub_threads;
+		Thread thread;
+		thread.start(load_threaded, &load);
+		thread.wait_to_finish();
+		REQUIRE(load.error == OK);
+		const Ref<Resource> &loaded_a = load.resource;
+		REQUIRE(loaded_a.is_valid());
+		CHECK(loaded_a->get_name() == "A");
+
+		Ref<Resource> loaded_b = loaded_a->get_meta("next");
+		REQUIRE(loaded_b.is_valid());
+		CHECK(loaded_b->get_name() == "B");
+		Ref<Resource> loaded_c = loaded_b->get_meta("next");
+		REQUIRE(loaded_c.is_valid());
+		CHECK(loaded_c->get_name() == "C");
+		CHECK_MESSAGE(
+				!ResourceCache::has(path_unused),
+				"Loads started ahead that turned out to be unused shouldn't be kept around.");
+	}
+
+	ResourceLoader::clear_prefetch_manifest();
+}
+
+TEST_CASE("[Resource] Unused prefetched loads outliving a failed load") {
+	const String path_broken = TestUtils::get_temp_path("resource_prefetch_broken.res");
+	const String path_slow = TestUtils::get_temp_path("resource_prefetch_slow.res");
+	{
+		Ref<FileAccess> f = FileAccess::open(path_broken, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string("Not a resource.");
+
+		// Many sub-resources, so it's still loading when the broken load is done.
+		Ref<Resource> resource_slow = memnew(Resource);
+		Array children;
+		for (int i = 0; i < 5000; i++) {
+			Ref<Resource> child = memnew(Resource);
+			child->set_name(itos(i));
+			children.push_back(child);
+		}
+		resource_slow->set_meta("children", children);
+		REQUIRE(ResourceSaver::save(resource_slow, path_slow) == OK);
+	}
+
+	HashMap<String, Vector<String>> manifest;
+	manifest.insert(path_broken, { path_slow });
+	const String manifest_path = TestUtils::get_temp_path("prefetch_manifest_broken.bin");
+	REQUIRE(ResourceLoader::save_prefetch_manifest(manifest_path, manifest) == OK);
+	ResourceLoader::load_prefetch_manifest(manifest_path);
+
+	for (int i = 0; i < 4; i++) {
+		ThreadedLoad load;
+		load.path = path_broken;
+		Thread thread;
+		ERR_PRINT_OFF;
+		thread.start(load_threaded, &load);
+		thread.wait_to_finish();
+		ERR_PRINT_ON;
+		CHECK(load.error != OK);
+		CHECK(load.resource.is_null());
+		CHECK_MESSAGE(
+				!ResourceCache::has(path_slow),
+				"Loads started ahead should be awaited and dropped when the load they were started for fails.");
+	}
+
+	ResourceLoader::clear_prefetch_manifest();
+
+	Ref<Resource> loaded_slow = ResourceLoader::load(path_slow);
+	REQUIRE(loaded_slow.is_valid());
+	CHECK(Array(loaded_slow->get_meta("children")).size() == 5000);
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -0,0 +1,308 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/object/object.h"
+#include "core/os/os.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class Recorder : public Object {
+	GDCLASS(Recorder, Object);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == 12345) {
+			notifications++;
+			values.push_back(-1);
+		}
+	}
+
+public:
+	LocalVector<int> threads;
+	LocalVector<int> values;
+	int notifications = 0;
+	CallQueue *queue = nullptr;
+
+	void record(int p_thread, int p_value) {
+		threads.push_back(p_thread);
+		values.push_back(p_value);
+	}
+
+	void record_and_push(int p_value) {
+		record(0, p_value);
+		if (p_value < 10) {
+			queue->push_callable(callable_mp(this, &Recorder::record_and_push), p_value + 1);
+		}
+	}
+};
+
+TEST_CASE("[CallQueue] Messages are flushed in push order") {
+	CallQueue queue;
+	Recorder recorder;
+
+	CHECK_FALSE(queue.has_messages());
+	queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, 1);
+	queue.push_notification(recorder.get_instance_id(), 12345);
+	queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, 2);
+	queue.push_set(recorder.get_instance_id(), "script", Variant());
+	CHECK(queue.has_messages());
+	CHECK(queue.get_pages_used() == 1);
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.get_pages_used() == 0);
+	CHECK(queue.get_peak_pages_used() == 1);
+
+	REQUIRE(recorder.values.size() == 3);
+	CHECK(recorder.values[0] == 1);
+	CHECK(recorder.values[1] == -1);
+	CHECK(recorder.values[2] == 2);
+	CHECK(recorder.notifications == 1);
+}
+
+TEST_CASE("[CallQueue] Messages pushed while flushing are flushed too") {
+	CallQueue queue;
+	Recorder recorder;
+	recorder.queue = &queue;
+
+	queue.push_callable(callable_mp(&recorder, &Recorder::record_and_push), 0);
+	CHECK(queue.flush() == OK);
+
+	REQUIRE(recorder.values.size() == 11);
+	for (uint32_t i = 0; i < recorder.values.size(); i++) {
+		CHECK(recorder.values[i] == int(i));
+	}
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[CallQueue] Clear and page reuse") {
+	CallQueue queue;
+	Recorder recorder;
+
+	// Enough arguments to need several pages.
+	for (int i = 0; i < 1000; i++) {
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, i);
+	}
+	CHECK(queue.get_pages_used() > 1);
+	const int buffer_usage = queue.get_max_buffer_usage();
+
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.flush() == OK);
+	CHECK(recorder.values.is_empty());
+
+	for (int i = 0; i < 1000; i++) {
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, i);
+	}
+	CHECK(queue.flush() == OK);
+	CHECK(recorder.values.size() == 1000);
+	CHECK(queue.get_max_buffer_usage() == buffer_usage);
+}
+
+TEST_CASE("[CallQueue] Out of pages") {
+	CallQueue queue(nullptr, 1);
+	Recorder recorder;
+
+	Error err = OK;
+	int pushed = 0;
+	ERR_PRINT_OFF;
+	while (err == OK) {
+		err = queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, pushed);
+		if (err == OK) {
+			pushed++;
+		}
+	}
+	ERR_PRINT_ON;
+
+	CHECK(err == ERR_OUT_OF_MEMORY);
+	CHECK(queue.get_pages_used() == 1);
+	CHECK(queue.flush() == OK);
+	CHECK(int(recorder.values.size()) == pushed);
+}
+
+struct PushData {
+	CallQueue *queue = nullptr;
+	Recorder *recorder = nullptr;
+	int thread = 0;
+	int count = 0;
+};
+
+static void push_messages(void *p_userdata) {
+	PushData *data = (PushData *)p_userdata;
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable_mp(data->recorder, &Recorder::record), data->thread, i);
+	}
+}
+
+TEST_CASE("[CallQueue] Pushing from several threads") {
+	CallQueue queue;
+	Recorder recorder;
+
+	SUBCASE("Per-thread order is kept") {
+		PushData data[8];
+		Thread threads[8];
+		for (int i = 0; i < 8; i++) {
+			data[i].queue = &queue;
+			data[i].recorder = &recorder;
+			data[i].thread = i;
+			data[i].count = 5000;
+			threads[i].start(push_messages, &data[i]);
+		}
+
+		// Flushing while the other threads are still pushing.
+		for (int i = 0; i < 8; i++) {
+			CHECK(queue.flush() == OK);
+			threads[i].wait_to_finish();
+		}
+		CHECK(queue.flush() == OK);
+
+		REQUIRE(recorder.values.size() == 8 * 5000);
+		int next[8] = {};
+		bool ordered = true;
+		for (uint32_t i = 0; i < recorder.values.size(); i++) {
+			const int thread = recorder.threads[i];
+			ordered = ordered && recorder.values[i] == next[thread];
+			next[thread]++;
+		}
+		CHECK(ordered);
+	}
+
+	SUBCASE("Order between threads is kept") {
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, 0);
+
+		PushData data;
+		data.queue = &queue;
+		data.recorder = &recorder;
+		data.thread = 1;
+		data.count = 1;
+		Thread thread;
+		thread.start(push_messages, &data);
+		thread.wait_to_finish();
+
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, 1);
+		CHECK(queue.flush() == OK);
+
+		REQUIRE(recorder.values.size() == 3);
+		CHECK(recorder.threads[0] == 0);
+		CHECK(recorder.threads[1] == 1);
+		CHECK(recorder.threads[2] == 0);
+		CHECK(recorder.values[2] == 1);
+	}
+}
+
+struct TurnData {
+	CallQueue *queue = nullptr;
+	Recorder *recorder = nullptr;
+	Semaphore turn[2];
+	int count = 0;
+};
+
+// Each push is made right after the other thread's, which a clock may not tell apart.
+static void push_in_turn(void *p_userdata) {
+	TurnData *data = (TurnData *)p_userdata;
+	for (int i = 0; i < data->count; i++) {
+		data->turn[1].wait();
+		data->queue->push_callable(callable_mp(data->recorder, &Recorder::record), 1, i);
+		data->turn[0].post();
+	}
+}
+
+TEST_CASE("[CallQueue] Pushes made in turn by two threads are flushed in turn") {
+	CallQueue queue;
+	Recorder recorder;
+
+	TurnData data;
+	data.queue = &queue;
+	data.recorder = &recorder;
+	data.count = 1000;
+	Thread thread;
+	thread.start(push_in_turn, &data);
+	for (int i = 0; i < data.count; i++) {
+		queue.push_callable(callable_mp(&recorder, &Recorder::record), 0, i);
+		data.turn[1].post();
+		data.turn[0].wait();
+	}
+	thread.wait_to_finish();
+	CHECK(queue.flush() == OK);
+
+	REQUIRE(recorder.values.size() == 2 * 1000);
+	bool in_turn = true;
+	for (uint32_t i = 0; i < recorder.values.size(); i++) {
+		in_turn = in_turn && recorder.threads[i] == int(i % 2) && recorder.values[i] == int(i / 2);
+	}
+	CHECK(in_turn);
+}
+
+static void benchmark_call_queue_contention() {
+	Recorder recorder;
+	const int count = 100000;
+
+	for (int thread_count : { 1, 2, 4, 8, 16 }) {
+		CallQueue queue(nullptr, 1 << 20);
+		PushData *data = memnew_arr(PushData, thread_count);
+		Thread *threads = memnew_arr(Thread, thread_count);
+
+		const uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			data[i].queue = &queue;
+			data[i].recorder = &recorder;
+			data[i].count = count;
+			threads[i].start(push_messages, &data[i]);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		const uint64_t push_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+		queue.flush();
+		recorder.threads.clear();
+		recorder.values.clear();
+
+		memdelete_arr(threads);
+		memdelete_arr(data);
+
+		const uint64_t pushes = uint64_t(thread_count) * count;
+		print_line(vformat("%d threads: %d pushes in %d usec (%d ns per push), flushed in %d usec.", thread_count, pushes, push_usec, push_usec * 1000 / pushes, queue.get_flush_time_usec()));
+	}
+}
+
+REGISTER_TEST_COMMAND("call-queue-contention-benchmark", &benchmark_call_queue_contention);
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
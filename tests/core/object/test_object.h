@@ -34,6 +34,8 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 #include "tests/test_macros.h"
 
@@ -431,6 +433,131 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalReceiver : public Object {
+public:
+	int calls = 0;
+	int last_value = 0;
+	Object *emitter = nullptr;
+	Object *to_delete = nullptr;
+
+	void receive(int p_value) {
+		calls++;
+		last_value = p_value;
+	}
+	void receive_and_disconnect(int p_value) {
+		receive(p_value);
+		emitter->disconnect("value_changed", callable_mp(this, &SignalReceiver::receive_and_disconnect));
+	}
+	void receive_and_delete(int p_value) {
+		receive(p_value);
+		memdelete(to_delete);
+		to_delete = nullptr;
+	}
+
+	SafeNumeric<int> concurrent_calls;
+	void receive_concurrently(int p_value) {
+		concurrent_calls.increment();
+	}
+};
+
+TEST_CASE("[Object] Signal emission") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("value_changed", PropertyInfo(Variant::INT, "value")));
+
+	SUBCASE("Many connections") {
+		LocalVector<SignalReceiver *> receivers;
+		for (int i = 0; i < 5000; i++) {
+			receivers.push_back(memnew(SignalReceiver));
+			emitter.connect("value_changed", callable_mp(receivers[i], &SignalReceiver::receive));
+		}
+
+		CHECK(emitter.emit_signal("value_changed", 1) == OK);
+		CHECK(emitter.emit_signal("value_changed", 2) == OK);
+
+		bool all_received = true;
+		for (SignalReceiver *receiver : receivers) {
+			all_received = all_received && receiver->calls == 2 && receiver->last_value == 2;
+			memdelete(receiver);
+		}
+		CHECK(all_received);
+
+		List<Object::Connection> connections;
+		emitter.get_signal_connection_list("value_changed", &connections);
+		CHECK(connections.is_empty());
+		CHECK(emitter.emit_signal("value_changed", 3) == OK);
+	}
+
+	SUBCASE("Connections changed between emissions") {
+		SignalReceiver a;
+		SignalReceiver b;
+
+		emitter.connect("value_changed", callable_mp(&a, &SignalReceiver::receive));
+		emitter.emit_signal("value_changed", 1);
+		emitter.connect("value_changed", callable_mp(&b, &SignalReceiver::receive));
+		emitter.emit_signal("value_changed", 2);
+		emitter.disconnect("value_changed", callable_mp(&a, &SignalReceiver::receive));
+		emitter.emit_signal("value_changed", 3);
+
+		CHECK(a.calls == 2);
+		CHECK(a.last_value == 2);
+		CHECK(b.calls == 2);
+		CHECK(b.last_value == 3);
+	}
+
+	SUBCASE("One-shot connections and disconnecting during emission") {
+		SignalReceiver a;
+		SignalReceiver b;
+		b.emitter = &emitter;
+
+		emitter.connect("value_changed", callable_mp(&a, &SignalReceiver::receive), Object::CONNECT_ONE_SHOT);
+		emitter.connect("value_changed", callable_mp(&b, &SignalReceiver::receive_and_disconnect));
+		emitter.emit_signal("value_changed", 1);
+		emitter.emit_signal("value_changed", 2);
+
+		CHECK(a.calls == 1);
+		CHECK(b.calls == 1);
+		CHECK_FALSE(emitter.is_connected("value_changed", callable_mp(&a, &SignalReceiver::receive)));
+		CHECK_FALSE(emitter.is_connected("value_changed", callable_mp(&b, &SignalReceiver::receive_and_disconnect)));
+	}
+
+	SUBCASE("Target deleted during emission") {
+		SignalReceiver a;
+		SignalReceiver *b = memnew(SignalReceiver);
+		a.to_delete = b;
+
+		emitter.connect("value_changed", callable_mp(&a, &SignalReceiver::receive_and_delete));
+		emitter.connect("value_changed", callable_mp(b, &SignalReceiver::receive));
+		ERR_PRINT_OFF;
+		CHECK(emitter.emit_signal("value_changed", 1) == OK);
+		ERR_PRINT_ON;
+
+		CHECK(a.calls == 1);
+		List<Object::Connection> connections;
+		emitter.get_signal_connection_list("value_changed", &connections);
+		CHECK(connections.size() == 1);
+	}
+
+	SUBCASE("Emitted from several threads") {
+		SignalReceiver a;
+		emitter.connect("value_changed", callable_mp(&a, &SignalReceiver::receive_concurrently));
+
+		Thread threads[4];
+		for (Thread &thread : threads) {
+			thread.start([](void *p_emitter) {
+				for (int i = 0; i < 1000; i++) {
+					((Object *)p_emitter)->emit_signal("value_changed", i);
+				}
+			},
+					&emitter);
+		}
+		for (Thread &thread : threads) {
+			thread.wait_to_finish();
+		}
+
+		CHECK(a.concurrent_calls.get() == 4000);
+	}
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
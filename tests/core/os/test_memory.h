@@ -0,0 +1,217 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[ThreadArena] Allocations are released when the scope ends") {
+	const uint64_t usage_before = ThreadArena::get_usage();
+	{
+		ThreadArenaScope scope;
+		CHECK(ThreadArena::is_in_scope());
+
+		uint8_t *a = (uint8_t *)ThreadArena::alloc(100);
+		uint8_t *b = (uint8_t *)ThreadArena::alloc(200);
+		CHECK(a != nullptr);
+		CHECK(b != nullptr);
+		CHECK(((uintptr_t)a % alignof(max_align_t)) == 0);
+		CHECK(((uintptr_t)b % alignof(max_align_t)) == 0);
+		memset(a, 1, 100);
+		memset(b, 2, 200);
+		CHECK(a[99] == 1);
+		CHECK(b[0] == 2);
+		CHECK(ThreadArena::get_usage() > usage_before);
+
+		{
+			ThreadArenaScope inner_scope;
+			ThreadArena::alloc(1000);
+		}
+		// The inner scope only released its own allocation.
+		CHECK(b[199] == 2);
+		void *c = ThreadArena::alloc(200);
+		CHECK((uint8_t *)c > b);
+	}
+	CHECK(ThreadArena::get_usage() == usage_before);
+}
+
+TEST_CASE("[ThreadArena] Reallocation and freeing") {
+	ThreadArenaScope scope;
+
+	// The most recent allocation grows and shrinks in place.
+	int *a = (int *)ThreadArena::alloc(sizeof(int) * 4);
+	for (int i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+	int *grown = (int *)ThreadArena::realloc(a, sizeof(int) * 64);
+	CHECK(grown == a);
+
+	// An older allocation has to move, keeping its contents.
+	void *b = ThreadArena::alloc(16);
+	int *moved = (int *)ThreadArena::realloc(a, sizeof(int) * 128);
+	CHECK(moved != a);
+	for (int i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+
+	// Freeing the most recent allocation gives the memory back right away.
+	const uint64_t usage = ThreadArena::get_usage();
+	void *c = ThreadArena::alloc(256);
+	ThreadArena::free(c);
+	CHECK(ThreadArena::get_usage() == usage);
+	CHECK(ThreadArena::alloc(256) == c);
+
+	// Allocations bigger than a chunk work too.
+	uint8_t *big = (uint8_t *)ThreadArena::alloc(1024 * 1024);
+	big[1024 * 1024 - 1] = 42;
+	CHECK(big[1024 * 1024 - 1] == 42);
+	CHECK(b != nullptr);
+}
+
+TEST_CASE("[ThreadArena] Reallocation in nested scopes") {
+	ThreadArenaScope scope;
+
+	uint8_t *a = (uint8_t *)ThreadArena::alloc(16);
+	memset(a, 1, 16);
+	uint8_t *grown = nullptr;
+	{
+		// Neither growing it in place nor moving it to the inner scope would let it outlive that scope.
+		ThreadArenaScope inner_scope;
+		grown = (uint8_t *)ThreadArena::realloc(a, 1024);
+		CHECK(grown != a);
+		memset(grown + 16, 2, 1024 - 16);
+	}
+
+	uint8_t *b = (uint8_t *)ThreadArena::alloc(4096);
+	memset(b, 3, 4096);
+	CHECK(grown[0] == 1);
+	CHECK(grown[1023] == 2);
+	ThreadArena::free(grown);
+}
+
+TEST_CASE("[ThreadArena] Allocations with no scope open") {
+	REQUIRE_FALSE(ThreadArena::is_in_scope());
+	const uint64_t usage_before = ThreadArena::get_usage();
+
+	// These come from the heap, as no scope would ever release them.
+	int *a = (int *)ThreadArena::alloc(sizeof(int) * 4);
+	REQUIRE(a != nullptr);
+	for (int i = 0; i < 4; i++) {
+		a[i] = i;
+	}
+	a = (int *)ThreadArena::realloc(a, sizeof(int) * 1024);
+	CHECK(a[3] == 3);
+	CHECK(ThreadArena::get_usage() == usage_before);
+	{
+		// Still fine to free them later, even from within a scope.
+		ThreadArenaScope scope;
+		ThreadArena::free(a);
+	}
+}
+
+TEST_CASE("[ThreadArena] Containers") {
+	const uint64_t allocations_before = ThreadArena::get_allocation_count();
+	{
+		ThreadArenaScope scope;
+
+		ThreadArenaLocalVector<int> vector;
+		for (int i = 0; i < 1000; i++) {
+			vector.push_back(i);
+		}
+		CHECK(vector.size() == 1000);
+		CHECK(vector[999] == 999);
+
+		HashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, ThreadArenaTypedAllocator<HashMapElement<int, int>>> map;
+		for (int i = 0; i < 1000; i++) {
+			map.insert(i, i * 2);
+		}
+		map.erase(500);
+		CHECK(map.size() == 999);
+		CHECK(map[999] == 1998);
+		CHECK_FALSE(map.has(500));
+	}
+	CHECK(ThreadArena::get_allocation_count() > allocations_before);
+}
+
+static void benchmark_memory_arena() {
+	const int frames = 1000;
+	const int elements = 256;
+
+	// Simulates short-lived per-frame lists, first on the heap and then on the arena.
+	uint64_t heap_usec = 0;
+	uint64_t arena_usec = 0;
+	int64_t checksum = 0;
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int list = 0; list < 16; list++) {
+			LocalVector<int> vector;
+			HashMap<int, int> map;
+			for (int i = 0; i < elements; i++) {
+				vector.push_back(i);
+				map.insert(i, i);
+			}
+			checksum += vector[elements - 1] + map[elements - 1];
+		}
+	}
+	heap_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		ThreadArenaScope frame_scope;
+		for (int list = 0; list < 16; list++) {
+			ThreadArenaLocalVector<int> vector;
+			HashMap<int, int, HashMapHasherDefault, HashMapComparatorDefault<int>, ThreadArenaTypedAllocator<HashMapElement<int, int>>> map;
+			for (int i = 0; i < elements; i++) {
+				vector.push_back(i);
+				map.insert(i, i);
+			}
+			checksum -= vector[elements - 1] + map[elements - 1];
+		}
+	}
+	arena_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	print_line(vformat("Heap: %d usec, arena: %d usec (%d frames, checksum %d).", heap_usec, arena_usec, frames, checksum));
+	print_line(vformat("Arena reserved: %d bytes, peak usage on this thread: %d bytes.", ThreadArena::get_reserved(), ThreadArena::get_max_usage()));
+}
+
+REGISTER_TEST_COMMAND("memory-arena-benchmark", &benchmark_memory_arena);
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
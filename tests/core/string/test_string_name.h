@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = StringName(String("test_string_name_") + "interning");
+
+	CHECK(a == b);
+	CHECK(b == c);
+	CHECK(a.data_unique_pointer() == c.data_unique_pointer());
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+	CHECK(String(a) == "test_string_name_interning");
+	CHECK(a != StringName("test_string_name_other"));
+}
+
+TEST_CASE("[StringName] Search") {
+	CHECK(StringName::search("test_string_name_search") == StringName());
+	{
+		const StringName name = "test_string_name_search";
+		CHECK(StringName::search("test_string_name_search") == name);
+		CHECK(StringName::search(String("test_string_name_search")) == name);
+		CHECK(StringName::search(U"test_string_name_search") == name);
+	}
+	// Released once the last reference is gone.
+	CHECK(StringName::search("test_string_name_search") == StringName());
+}
+
+TEST_CASE("[StringName] Many names, released and recreated") {
+	// More names than the initial table size, so the table has to grow.
+	const int count = 100000;
+	Vector<StringName> names;
+	names.resize(count);
+	for (int i = 0; i < count; i++) {
+		names.write[i] = StringName("test_string_name_" + itos(i));
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < count; i++) {
+		all_found = all_found && StringName::search("test_string_name_" + itos(i)) == names[i];
+	}
+	CHECK(all_found);
+
+	// Release every other name, their entries get recycled for new ones.
+	for (int i = 0; i < count; i += 2) {
+		names.write[i] = StringName();
+	}
+	bool released = true;
+	for (int i = 0; i < count; i += 2) {
+		released = released && StringName::search("test_string_name_" + itos(i)) == StringName();
+	}
+	CHECK(released);
+
+	for (int i = 0; i < count; i += 2) {
+		names.write[i] = StringName("test_string_name_recreated_" + itos(i));
+	}
+	bool consistent = true;
+	for (int i = 0; i < count; i++) {
+		String expected = (i % 2 ? "test_string_name_" : "test_string_name_recreated_") + itos(i);
+		consistent = consistent && String(names[i]) == expected && StringName(expected) == names[i];
+	}
+	CHECK(consistent);
+}
+
+struct ThreadedNamesData {
+	int names_per_thread = 0;
+	SafeNumeric<int> mismatches;
+	const Vector<StringName> *shared = nullptr;
+};
+
+static void threaded_names(void *p_userdata) {
+	ThreadedNamesData *data = (ThreadedNamesData *)p_userdata;
+	for (int i = 0; i < data->names_per_thread; i++) {
+		// Names shared with the other threads, interned concurrently.
+		const int shared_index = i % data->shared->size();
+		StringName shared = String("test_threaded_shared_") + itos(shared_index);
+		if (shared != (*data->shared)[shared_index]) {
+			data->mismatches.increment();
+		}
+		// Short-lived names, created and released concurrently.
+		StringName transient = String("test_threaded_transient_") + itos(i % 1000);
+		if (String(transient) != "test_threaded_transient_" + itos(i % 1000)) {
+			data->mismatches.increment();
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	Vector<StringName> shared;
+	for (int i = 0; i < 256; i++) {
+		shared.push_back(StringName("test_threaded_shared_" + itos(i)));
+	}
+
+	ThreadedNamesData data;
+	data.names_per_thread = 20000;
+	data.shared = &shared;
+
+	Thread threads[8];
+	for (Thread &thread : threads) {
+		thread.start(threaded_names, &data);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(data.mismatches.get() == 0);
+	CHECK(StringName::search("test_threaded_transient_0") == StringName());
+}
+
+static void benchmark_string_name_threads(void *p_userdata) {
+	const Vector<String> *strings = (const Vector<String> *)p_userdata;
+	for (int round = 0; round < 20; round++) {
+		for (const String &string : *strings) {
+			StringName name = string;
+		}
+	}
+}
+
+static void benchmark_string_name_contention() {
+	// Interns existing names from Strings, like loaders and the script
+	// compiler do on worker threads.
+	Vector<String> strings;
+	Vector<StringName> interned;
+	for (int i = 0; i < 10000; i++) {
+		strings.push_back("benchmark_name_" + itos(i));
+		interned.push_back(strings[i]);
+	}
+
+	for (int thread_count : { 1, 2, 4, 8, 16 }) {
+		Thread *threads = memnew_arr(Thread, thread_count);
+		const uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(benchmark_string_name_threads, &strings);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - from;
+		memdelete_arr(threads);
+
+		const uint64_t lookups = uint64_t(thread_count) * 20 * strings.size();
+		print_line(vformat("%d threads: %d lookups in %d usec (%d ns per lookup).", thread_count, lookups, usec, usec * 1000 / lookups));
+	}
+}
+
+REGISTER_TEST_COMMAND("string-name-contention-benchmark", &benchmark_string_name_contention);
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
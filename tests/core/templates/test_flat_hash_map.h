@@ -0,0 +1,270 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK_FALSE(map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Get and getptr") {
+	FlatHashMap<int, int> map;
+	map.insert(1, 10);
+	map.insert(2, 20);
+
+	CHECK(map.get(2) == 20);
+	CHECK(*map.getptr(1) == 10);
+	CHECK(map.getptr(3) == nullptr);
+}
+
+TEST_CASE("[FlatHashMap] Grow, erase and reinsert many elements") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 10000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 10000);
+	CHECK(map.get_capacity() >= 10000);
+
+	bool all_found = true;
+	for (int i = 0; i < 10000; i++) {
+		const int *value = map.getptr(i);
+		all_found = all_found && value && *value == i * 2;
+	}
+	CHECK(all_found);
+
+	// Erase every odd key, leaving tombstones behind.
+	for (int i = 1; i < 10000; i += 2) {
+		map.erase(i);
+	}
+	CHECK(map.size() == 5000);
+
+	bool consistent = true;
+	for (int i = 0; i < 10000; i++) {
+		consistent = consistent && map.has(i) == (i % 2 == 0);
+	}
+	CHECK(consistent);
+
+	// Churn through insertions and erasures, which must reuse or clean up the tombstones.
+	const uint32_t capacity = map.get_capacity();
+	for (int i = 10000; i < 100000; i++) {
+		map.insert(i, i);
+		map.erase(i);
+	}
+	CHECK(map.size() == 5000);
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map.has(9998));
+	CHECK_FALSE(map.has(9999));
+}
+
+TEST_CASE("[FlatHashMap] Iteration") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(i, i);
+	}
+	map.erase(50);
+
+	int count = 0;
+	int sum = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == E.value);
+		count++;
+		sum += E.value;
+	}
+	CHECK(count == 99);
+	CHECK(sum == 4950 - 50);
+}
+
+TEST_CASE("[FlatHashMap] Insertion order") {
+	// Kept through rehashes and erasures, as method and signal lists depend on it.
+	FlatHashMap<StringName, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(itos(999 - i), i);
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		map.erase(itos(999 - i));
+	}
+	map.insert("last", 1000);
+	map.insert(itos(999 - 1), -1); // Replacing a value doesn't move it.
+
+	int expected = 1;
+	bool ordered = true;
+	for (const KeyValue<StringName, int> &E : map) {
+		if (E.key == StringName("last")) {
+			ordered &= expected == 1000;
+			continue;
+		}
+		ordered &= E.key == StringName(itos(999 - expected));
+		expected += expected % 3 == 1 ? 1 : 2;
+	}
+	CHECK(ordered);
+	CHECK(map[itos(999 - 1)] == -1);
+	CHECK((*map.find("last")).value == 1000);
+}
+
+TEST_CASE("[FlatHashMap] Erase while draining from begin") {
+	FlatHashMap<String, int> map;
+	for (int i = 0; i < 50; i++) {
+		map.insert(itos(i), i);
+	}
+
+	while (map.size()) {
+		// The key passed to erase() lives in the slot being erased.
+		KeyValue<String, int> &E = *map.begin();
+		map.erase(E.key);
+	}
+	CHECK(map.is_empty());
+	CHECK(map.begin() == map.end());
+}
+
+TEST_CASE("[FlatHashMap] Copy and clear") {
+	FlatHashMap<StringName, int> map;
+	map["a"] = 1;
+	map["b"] = 2;
+	map["c"] = 3;
+
+	FlatHashMap<StringName, int> copy = map;
+	map.clear();
+
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.has("a"));
+	CHECK(copy.size() == 3);
+	CHECK(copy["a"] == 1);
+	CHECK(copy["b"] == 2);
+	CHECK(copy["c"] == 3);
+
+	map = copy;
+	CHECK(map.size() == 3);
+	CHECK(map["c"] == 3);
+}
+
+TEST_CASE("[FlatHashMap] Variant keys") {
+	FlatHashMap<Variant, int, VariantHasher, VariantComparator> map;
+	map[Variant(1)] = 1;
+	map[Variant("one")] = 2;
+	map[Variant(Vector2(1, 1))] = 3;
+
+	CHECK(map.size() == 3);
+	CHECK(map[Variant(1)] == 1);
+	CHECK(map[Variant("one")] == 2);
+	CHECK(map[Variant(Vector2(1, 1))] == 3);
+	CHECK_FALSE(map.has(Variant(2)));
+}
+
+template <typename TMap, typename TKey>
+static uint64_t _benchmark_lookups(const Vector<TKey> &p_keys, int p_rounds, int64_t &r_checksum) {
+	TMap map;
+	for (int i = 0; i < p_keys.size(); i++) {
+		map.insert(p_keys[i], i);
+	}
+
+	const uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < p_rounds; round++) {
+		for (int i = 0; i < p_keys.size(); i++) {
+			const int *value = map.getptr(p_keys[i]);
+			r_checksum += value ? *value : -1;
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - from;
+}
+
+static void benchmark_flat_hash_map() {
+	const int rounds = 200;
+	int64_t checksum = 0;
+
+	for (int count : { 16, 256, 4096, 65536 }) {
+		Vector<StringName> names;
+		Vector<Variant> variants;
+		for (int i = 0; i < count; i++) {
+			names.push_back(StringName("method_name_" + itos(i)));
+			variants.push_back(i % 2 ? Variant(i) : Variant("key_" + itos(i)));
+		}
+		const int lookup_rounds = MAX(1, rounds * 4096 / count);
+
+		uint64_t name_hash_map = _benchmark_lookups<HashMap<StringName, int>>(names, lookup_rounds, checksum);
+		uint64_t name_flat_map = _benchmark_lookups<FlatHashMap<StringName, int>>(names, lookup_rounds, checksum);
+		uint64_t variant_hash_map = _benchmark_lookups<HashMap<Variant, int, VariantHasher, VariantComparator>>(variants, lookup_rounds, checksum);
+		uint64_t variant_flat_map = _benchmark_lookups<FlatHashMap<Variant, int, VariantHasher, VariantComparator>>(variants, lookup_rounds, checksum);
+
+		print_line(vformat("%d keys, %d lookups each:", count, lookup_rounds));
+		print_line(vformat("  StringName: HashMap %d usec, FlatHashMap %d usec.", name_hash_map, name_flat_map));
+		print_line(vformat("  Variant: HashMap %d usec, FlatHashMap %d usec.", variant_hash_map, variant_flat_map));
+	}
+	print_line(vformat("Checksum: %d.", checksum));
+}
+
+REGISTER_TEST_COMMAND("flat-hash-map-benchmark", &benchmark_flat_hash_map);
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
@@ -532,6 +532,46 @@ TEST_CASE("[Vector] Operators") {
 	CHECK(vector != vector_other);
 }
 
+TEST_CASE("[Vector] Copy and move") {
+	Vector<int> vector;
+	vector.push_back(1);
+	vector.push_back(2);
+	vector.push_back(3);
+	const int *data = vector.ptr();
+
+	// Copies share the buffer until one of them is written to.
+	Vector<int> copy = vector;
+	CHECK(copy.ptr() == data);
+	copy.set(0, 10);
+	CHECK(copy.ptr() != data);
+	CHECK(vector[0] == 1);
+
+	// Moves take over the buffer and leave the source empty.
+	Vector<int> moved = std::move(vector);
+	CHECK(moved.ptr() == data);
+	CHECK(vector.is_empty());
+
+	// Writing to a moved buffer that isn't shared doesn't copy it.
+	moved.set(0, 20);
+	CHECK(moved.ptr() == data);
+
+	Vector<int> assigned;
+	assigned.push_back(5);
+	assigned = std::move(moved);
+	CHECK(assigned.ptr() == data);
+	CHECK(assigned.size() == 3);
+	CHECK(assigned[0] == 20);
+	CHECK(moved.is_empty());
+
+#ifdef DEV_ENABLED
+	CowDataCopyStats::clear();
+	Vector<int> shared = assigned;
+	shared.set(1, 0);
+	assigned.set(1, 0);
+	CHECK(CowDataCopyStats::get_total_copies() == 1);
+#endif
+}
+
 } // namespace TestVector
 
 #endif // TEST_VECTOR_H
@@ -107,6 +107,74 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_chain_test(void *p_arg) {
+	// Each link only counts if all the previous ones already ran.
+	if (counter[0].get() == (int)(uintptr_t)p_arg) {
+		counter[0].increment();
+	}
+}
+static void static_fan_in_test(void *p_arg, uint32_t p_index) {
+	counter[1].increment();
+}
+static void static_callable_fan_out_test(int p_chain_length, int p_count) {
+	// Only counts if the chain and the group already ran.
+	if (counter[0].get() == p_chain_length && counter[1].get() == p_count) {
+		counter[2].increment();
+	}
+}
+TEST_CASE("[WorkerThreadPool] Run tasks and group tasks after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int chain_length = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(3);
+
+		Vector<WorkerThreadPool::TaskID> chain;
+		for (int i = 0; i < chain_length; i++) {
+			Vector<WorkerThreadPool::TaskID> dependencies;
+			if (i > 0) {
+				dependencies.push_back(chain[i - 1]);
+			}
+			chain.push_back(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_chain_test, (void *)(uintptr_t)i, dependencies, !low_priority));
+		}
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_fan_in_test, nullptr, count, chain, -1, low_priority);
+
+		Vector<WorkerThreadPool::TaskID> fan_out;
+		Vector<WorkerThreadPool::TaskID> group_dependency;
+		group_dependency.push_back(group);
+		for (int i = 0; i < 4; i++) {
+			fan_out.push_back(WorkerThreadPool::get_singleton()->add_task_with_dependencies(callable_mp_static(static_callable_fan_out_test).bind(chain_length, count), group_dependency, !low_priority));
+		}
+
+		for (int i = 0; i < fan_out.size(); i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(fan_out[i]);
+		}
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		for (int i = 0; i < chain.size(); i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(chain[i]);
+		}
+
+		CHECK(counter[0].get() == chain_length);
+		CHECK(counter[1].get() == count);
+		CHECK(counter[2].get() == fan_out.size());
+	}
+
+	// A dependency that was already waited for is reported, but doesn't hold the task back.
+	counter.clear();
+	counter.resize(3);
+	WorkerThreadPool::TaskID done = WorkerThreadPool::get_singleton()->add_native_task(static_chain_test, (void *)(uintptr_t)0);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(done);
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(done);
+	ERR_PRINT_OFF;
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_chain_test, (void *)(uintptr_t)1, dependencies);
+	ERR_PRINT_ON;
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+	CHECK(counter[0].get() == 2);
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
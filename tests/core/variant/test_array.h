@@ -246,6 +246,55 @@ TEST_CASE("[Array] max() and min()") {
 	CHECK(min == 2);
 }
 
+TEST_CASE("[Array] Typed sort(), max() and min()") {
+	TypedArray<int> ints;
+	TypedArray<double> floats;
+	TypedArray<Vector2> vectors;
+	Array untyped;
+	for (int i = 0; i < 100; i++) {
+		const int value = (i * 37) % 101 - 50;
+		ints.push_back(value);
+		floats.push_back(value * 0.5);
+		vectors.push_back(Vector2(value % 7, value));
+		untyped.push_back(Vector2(value % 7, value));
+	}
+
+	CHECK(int(ints.min()) == -50);
+	CHECK(int(ints.max()) == 50);
+	CHECK(double(floats.min()) == -25.0);
+	CHECK(double(floats.max()) == 25.0);
+	CHECK(vectors.min() == untyped.min());
+	CHECK(vectors.max() == untyped.max());
+
+	ints.sort();
+	floats.sort();
+	vectors.sort();
+	untyped.sort();
+	bool sorted = true;
+	for (int i = 1; i < 100; i++) {
+		sorted = sorted && int(ints[i - 1]) <= int(ints[i]) && double(floats[i - 1]) <= double(floats[i]);
+	}
+	CHECK(sorted);
+	CHECK(ints[0].get_type() == Variant::INT);
+	CHECK(floats[0].get_type() == Variant::FLOAT);
+	CHECK(vectors == untyped);
+
+	TypedArray<int> empty;
+	CHECK(empty.min() == Variant());
+	CHECK(empty.max() == Variant());
+
+	// Elements written without validation fall back to the generic path.
+	TypedArray<int> mixed;
+	mixed.push_back(3);
+	mixed.push_back(1);
+	mixed.push_back(2);
+	mixed[1] = 1.5;
+	mixed.sort();
+	CHECK(mixed[0] == Variant(1.5));
+	CHECK(mixed[2] == Variant(3));
+	CHECK(mixed.min() == Variant(1.5));
+}
+
 TEST_CASE("[Array] slice()") {
 	Array array;
 	array.push_back(0);
@@ -0,0 +1,273 @@
+/**************************************************************************/
+/*  test_packed_array_ops.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_ARRAY_OPS_H
+#define TEST_PACKED_ARRAY_OPS_H
+
+#include "core/os/os.h"
+#include "core/variant/packed_array_ops.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedArrayOps {
+
+static Variant call_method(const Variant &p_base, const StringName &p_method, const Variant &p_arg = Variant()) {
+	Variant base = p_base;
+	const Variant *args[1] = { &p_arg };
+	Callable::CallError ce;
+	Variant ret;
+	base.callp(p_method, args, p_arg.get_type() == Variant::NIL ? 0 : 1, ret, ce);
+	return ret;
+}
+
+TEST_CASE("[PackedArrayOps] Element-wise operations match scalar loops") {
+	// Odd sizes exercise the tails after the vector loops.
+	for (int size : { 0, 1, 3, 7, 8, 17, 1001 }) {
+		PackedFloat32Array a;
+		PackedFloat32Array b;
+		PackedFloat64Array c;
+		PackedFloat64Array d;
+		PackedInt32Array e;
+		PackedInt32Array f;
+		for (int i = 0; i < size; i++) {
+			a.push_back(i * 0.5f - 3.0f);
+			b.push_back(7.0f - i * 0.25f);
+			c.push_back(i * 0.5 - 3.0);
+			d.push_back(7.0 - i * 0.25);
+			e.push_back(i * 3 - 100);
+			f.push_back(50 - i);
+		}
+
+		PackedFloat32Array result_f32;
+		result_f32.resize(size);
+		PackedFloat64Array result_f64;
+		result_f64.resize(size);
+		PackedInt32Array result_i32;
+		result_i32.resize(size);
+
+		bool matches = true;
+		PackedArrayOps::add(a.ptr(), b.ptr(), result_f32.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_f32[i] == a[i] + b[i];
+		}
+		PackedArrayOps::subtract(c.ptr(), d.ptr(), result_f64.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_f64[i] == c[i] - d[i];
+		}
+		PackedArrayOps::multiply(a.ptr(), b.ptr(), result_f32.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_f32[i] == a[i] * b[i];
+		}
+		PackedArrayOps::min(c.ptr(), d.ptr(), result_f64.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_f64[i] == MIN(c[i], d[i]);
+		}
+		PackedArrayOps::max(a.ptr(), b.ptr(), result_f32.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_f32[i] == MAX(a[i], b[i]);
+		}
+		PackedArrayOps::multiply(e.ptr(), f.ptr(), result_i32.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_i32[i] == e[i] * f[i];
+		}
+		PackedArrayOps::min(e.ptr(), f.ptr(), result_i32.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			matches = matches && result_i32[i] == MIN(e[i], f[i]);
+		}
+		CHECK_MESSAGE(matches, vformat("Element-wise results differ for size %d.", size));
+
+		double sum_f32 = 0.0;
+		double dot_f32 = 0.0;
+		double sum_f64 = 0.0;
+		double dot_f64 = 0.0;
+		int64_t sum_i32 = 0;
+		int64_t dot_i32 = 0;
+		for (int i = 0; i < size; i++) {
+			sum_f32 += a[i];
+			dot_f32 += double(a[i]) * double(b[i]);
+			sum_f64 += c[i];
+			dot_f64 += c[i] * d[i];
+			sum_i32 += e[i];
+			dot_i32 += int64_t(e[i]) * f[i];
+		}
+		CHECK(PackedArrayOps::sum(a.ptr(), size) == doctest::Approx(sum_f32));
+		CHECK(PackedArrayOps::dot(a.ptr(), b.ptr(), size) == doctest::Approx(dot_f32));
+		CHECK(PackedArrayOps::sum(c.ptr(), size) == doctest::Approx(sum_f64));
+		CHECK(PackedArrayOps::dot(c.ptr(), d.ptr(), size) == doctest::Approx(dot_f64));
+		CHECK(PackedArrayOps::sum(e.ptr(), size) == sum_i32);
+		CHECK(PackedArrayOps::dot(e.ptr(), f.ptr(), size) == dot_i32);
+	}
+}
+
+TEST_CASE("[PackedArrayOps] Integer overflow wraps around") {
+	const int32_t a[2] = { INT32_MAX, INT32_MIN };
+	const int32_t b[2] = { 1, 1 };
+	int32_t result[2];
+	PackedArrayOps::add(a, b, result, 2);
+	CHECK(result[0] == INT32_MIN);
+	PackedArrayOps::subtract(a, b, result, 2);
+	CHECK(result[1] == INT32_MAX);
+	CHECK(PackedArrayOps::sum(a, 2) == -1);
+}
+
+TEST_CASE("[PackedArrayOps] Builtin methods") {
+	SUBCASE("PackedInt32Array") {
+		const PackedInt32Array a = { 1, 2, 3 };
+		const PackedInt32Array b = { 10, -20, 30 };
+		CHECK(call_method(a, "add", b) == Variant(PackedInt32Array({ 11, -18, 33 })));
+		CHECK(call_method(a, "subtract", b) == Variant(PackedInt32Array({ -9, 22, -27 })));
+		CHECK(call_method(a, "multiply", b) == Variant(PackedInt32Array({ 10, -40, 90 })));
+		CHECK(call_method(a, "min", b) == Variant(PackedInt32Array({ 1, -20, 3 })));
+		CHECK(call_method(a, "max", b) == Variant(PackedInt32Array({ 10, 2, 30 })));
+		CHECK(int64_t(call_method(a, "sum")) == 6);
+		CHECK(int64_t(call_method(a, "dot", b)) == 60);
+	}
+
+	SUBCASE("PackedInt64Array") {
+		const PackedInt64Array a = { INT64_C(1) << 40, 2 };
+		const PackedInt64Array b = { 3, 4 };
+		CHECK(call_method(a, "add", b) == Variant(PackedInt64Array({ (INT64_C(1) << 40) + 3, 6 })));
+		CHECK(int64_t(call_method(a, "sum")) == (INT64_C(1) << 40) + 2);
+	}
+
+	SUBCASE("PackedFloat64Array") {
+		const PackedFloat64Array a = { 0.5, 1.5, -2.0, 4.0, 8.0 };
+		const PackedFloat64Array b = { 2.0, 2.0, 2.0, 2.0, 2.0 };
+		CHECK(call_method(a, "multiply", b) == Variant(PackedFloat64Array({ 1.0, 3.0, -4.0, 8.0, 16.0 })));
+		CHECK(call_method(a, "max", b) == Variant(PackedFloat64Array({ 2.0, 2.0, 2.0, 4.0, 8.0 })));
+		CHECK(double(call_method(a, "sum")) == doctest::Approx(12.0));
+		CHECK(double(call_method(a, "dot", b)) == doctest::Approx(24.0));
+	}
+
+	SUBCASE("PackedVector2Array and PackedVector3Array") {
+		const PackedVector2Array a = { Vector2(1, 2), Vector2(3, 4), Vector2(-5, 6) };
+		const PackedVector2Array b = { Vector2(2, 2), Vector2(1, 5), Vector2(0, 0) };
+		CHECK(call_method(a, "add", b) == Variant(PackedVector2Array({ Vector2(3, 4), Vector2(4, 9), Vector2(-5, 6) })));
+		CHECK(call_method(a, "min", b) == Variant(PackedVector2Array({ Vector2(1, 2), Vector2(1, 4), Vector2(-5, 0) })));
+		CHECK(Vector2(call_method(a, "sum")).is_equal_approx(Vector2(-1, 12)));
+		CHECK(double(call_method(a, "dot", b)) == doctest::Approx(29.0));
+
+		const PackedVector3Array c = { Vector3(1, 2, 3), Vector3(4, 5, 6) };
+		const PackedVector3Array d = { Vector3(1, 0, -1), Vector3(2, 2, 2) };
+		CHECK(call_method(c, "subtract", d) == Variant(PackedVector3Array({ Vector3(0, 2, 4), Vector3(2, 3, 4) })));
+		CHECK(Vector3(call_method(c, "sum")).is_equal_approx(Vector3(5, 7, 9)));
+		CHECK(double(call_method(c, "dot", d)) == doctest::Approx(28.0));
+	}
+
+	SUBCASE("Mismatched sizes") {
+		const PackedFloat32Array a = { 1, 2, 3 };
+		const PackedFloat32Array b = { 1, 2 };
+		ERR_PRINT_OFF;
+		CHECK(PackedFloat32Array(call_method(a, "add", b)).is_empty());
+		CHECK(double(call_method(a, "dot", b)) == 0.0);
+		ERR_PRINT_ON;
+	}
+}
+
+static void benchmark_packed_array_ops() {
+	const int size = 1 << 20;
+	const int rounds = 50;
+
+	PackedFloat32Array a;
+	PackedFloat32Array b;
+	a.resize(size);
+	b.resize(size);
+	for (int i = 0; i < size; i++) {
+		a.set(i, Math::sin(float(i)));
+		b.set(i, Math::cos(float(i)));
+	}
+	const Variant va = a;
+	const Variant vb = b;
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	double checksum = 0.0;
+	for (int round = 0; round < rounds; round++) {
+		PackedFloat32Array result;
+		result.resize(size);
+		float *w = result.ptrw();
+		const float *ra = a.ptr();
+		const float *rb = b.ptr();
+		for (int i = 0; i < size; i++) {
+			w[i] = ra[i] + rb[i];
+		}
+		checksum += result[round];
+	}
+	print_line(vformat("add, scalar loop: %d usec per %d elements.", (OS::get_singleton()->get_ticks_usec() - from) / rounds, size));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < rounds; round++) {
+		PackedFloat32Array result = call_method(va, "add", vb);
+		checksum += result[round];
+	}
+	print_line(vformat("add, builtin method: %d usec per %d elements.", (OS::get_singleton()->get_ticks_usec() - from) / rounds, size));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < rounds; round++) {
+		double dot = 0.0;
+		const float *ra = a.ptr();
+		const float *rb = b.ptr();
+		for (int i = 0; i < size; i++) {
+			dot += double(ra[i]) * double(rb[i]);
+		}
+		checksum += dot;
+	}
+	print_line(vformat("dot, scalar loop: %d usec per %d elements.", (OS::get_singleton()->get_ticks_usec() - from) / rounds, size));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < rounds; round++) {
+		checksum += double(call_method(va, "dot", vb));
+	}
+	print_line(vformat("dot, builtin method: %d usec per %d elements.", (OS::get_singleton()->get_ticks_usec() - from) / rounds, size));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < rounds; round++) {
+		double sum = 0.0;
+		for (int i = 0; i < size; i++) {
+			sum += a[i];
+		}
+		checksum += sum;
+	}
+	print_line(vformat("sum, scalar loop: %d usec per %d elements.", (OS::get_singleton()->get_ticks_usec() - from) / rounds, size));
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int round = 0; round < rounds; round++) {
+		checksum += double(call_method(va, "sum"));
+	}
+	print_line(vformat("sum, builtin method: %d usec per %d elements.", (OS::get_singleton()->get_ticks_usec() - from) / rounds, size));
+
+	print_line(vformat("Checksum: %f", checksum));
+}
+
+REGISTER_TEST_COMMAND("packed-array-ops-benchmark", &benchmark_packed_array_ops);
+
+} // namespace TestPackedArrayOps
+
+#endif // TEST_PACKED_ARRAY_OPS_H
@@ -2147,6 +2147,39 @@ struct MethodData {
 	bool is_vararg = false;
 };
 
+TEST_CASE("[Variant] Move") {
+	Variant source = String("Godot");
+	Variant moved = std::move(source);
+	CHECK(moved == Variant("Godot"));
+	CHECK(source.get_type() == Variant::NIL);
+
+	PackedInt32Array array;
+	array.push_back(1);
+	array.push_back(2);
+	const int32_t *data = array.ptr();
+	Variant packed = std::move(array);
+	CHECK(array.is_empty());
+	PackedInt32Array unpacked = packed;
+	CHECK(unpacked.ptr() == data);
+	CHECK(unpacked.size() == 2);
+
+	Variant target = 42;
+	target = std::move(packed);
+	CHECK(target.get_type() == Variant::PACKED_INT32_ARRAY);
+	CHECK(packed.get_type() == Variant::NIL);
+	target = std::move(moved);
+	CHECK(target == Variant("Godot"));
+
+	// The source can be owned by the value being replaced.
+	Array outer;
+	outer.push_back(Dictionary());
+	Variant holder = outer;
+	outer = Array();
+	Variant &inner = Array(holder)[0];
+	holder = std::move(inner);
+	CHECK(holder.get_type() == Variant::DICTIONARY);
+}
+
 TEST_CASE("[Variant] Utility functions") {
 	List<MethodData> functions;
 